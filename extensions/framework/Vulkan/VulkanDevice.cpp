@@ -111,6 +111,9 @@ namespace FGC
 	ArrayView<const char*>  VulkanDevice::GetRecomendedDeviceExtensions ()
 	{
 		static const char *	device_extensions[] = {
+			#ifdef VK_EXT_pipeline_creation_feedback
+				VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME,
+			#endif
 			"none"
 		};
 		return device_extensions;
@@ -198,6 +201,12 @@ namespace FGC
 			#ifdef VK_EXT_memory_budget
 				VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
 			#endif
+			#ifdef VK_KHR_timeline_semaphore
+				VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+			#endif
+			#ifdef VK_EXT_pipeline_creation_feedback
+				VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME,
+			#endif
 
 			// Vendor specific extensions
 			#ifdef VK_NV_mesh_shader
@@ -748,6 +757,11 @@ namespace FGC
 			vkGetDeviceQueue( _vkDevice, q.familyIndex, q.queueIndex, OUT &q.handle );
 		}
 
+		_deviceExtensions.clear();
+		for (auto* ext : device_extensions) {
+			_deviceExtensions.insert( ext );
+		}
+
 		_OnLogicalDeviceCreated( std::move(device_extensions) );
 		return true;
 	}
@@ -862,6 +876,15 @@ namespace FGC
 				next_feat	= nextExt				= &_features.descriptorIndexing.pNext;
 				_features.descriptorIndexing.sType	= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
 			}
+		#ifdef VK_KHR_timeline_semaphore
+			else
+			if ( ext == VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME )
+			{
+				*next_feat	= *nextExt				= &_features.timelineSemaphore;
+				next_feat	= nextExt				= &_features.timelineSemaphore.pNext;
+				_features.timelineSemaphore.sType	= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+			}
+		#endif
 		}
 		
 		*next_feat	= *nextExt					= &_features.shaderDrawParameters;
@@ -953,6 +976,7 @@ namespace FGC
 		_vkDevice				= VK_NULL_HANDLE;
 		_usedSharedInstance		= false;
 		_vkQueues.clear();
+		_deviceExtensions.clear();
 
 		_AfterDestroy();
 	}
@@ -53,6 +53,7 @@ namespace FGC
 		bool						_usedSharedInstance;
 
 		VulkanDeviceFnTable			_deviceFnTable;
+		HashSet<String>				_deviceExtensions;		// enabled device extensions
 
 		// enabled features
 		struct {
@@ -79,6 +80,9 @@ namespace FGC
 			VkPhysicalDeviceFragmentShaderBarycentricFeaturesNV		fragmentShaderBarycentric;
 			VkPhysicalDeviceShaderImageFootprintFeaturesNV			shaderImageFootprint;
 			VkPhysicalDeviceShadingRateImageFeaturesNV				shadingRateImage;
+		#ifdef VK_KHR_timeline_semaphore
+			VkPhysicalDeviceTimelineSemaphoreFeaturesKHR			timelineSemaphore;
+		#endif
 
 		}	_features;
 
@@ -120,6 +124,7 @@ namespace FGC
 		ND_ VkDevice					GetVkDevice ()				const	{ return _vkDevice; }
 		ND_ VkSurfaceKHR				GetVkSurface ()				const	{ return _vkSurface; }
 		ND_ ArrayView<VulkanQueue>		GetVkQueues ()				const	{ return _vkQueues; }
+		ND_ bool						HasDeviceExtension (StringView name)	const	{ return _deviceExtensions.count( String{name} ) > 0; }
 
 		ND_ VkPhysicalDeviceFeatures const&								GetDeviceFeatures ()							const	{ return _features.main; }
 		ND_ VkPhysicalDeviceMultiviewFeatures const&					GetDeviceMultiviewFeatures ()					const	{ return _features.multiview; }
@@ -136,6 +141,9 @@ namespace FGC
 		ND_ VkPhysicalDeviceFragmentShaderBarycentricFeaturesNV const&	GetDeviceFragmentShaderBarycentricFeatures ()	const	{ return _features.fragmentShaderBarycentric; }
 		ND_ VkPhysicalDeviceShaderImageFootprintFeaturesNV const&		GetDeviceShaderImageFootprintFeatures ()		const	{ return _features.shaderImageFootprint; }
 		ND_ VkPhysicalDeviceShadingRateImageFeaturesNV const&			GetDeviceShadingRateImageFeatures ()			const	{ return _features.shadingRateImage; }
+	#ifdef VK_KHR_timeline_semaphore
+		ND_ VkPhysicalDeviceTimelineSemaphoreFeaturesKHR const&			GetDeviceTimelineSemaphoreFeatures ()			const	{ return _features.timelineSemaphore; }
+	#endif
 
 		ND_ static ArrayView<const char*>	GetRecomendedInstanceLayers ();
 		ND_ static ArrayView<const char*>	GetRecomendedInstanceExtensions ();
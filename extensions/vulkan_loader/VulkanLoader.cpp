@@ -5,6 +5,7 @@
 #ifndef FG_VULKAN_STATIC
 
 #include "VulkanCheckError.h"
+#include "VulkanNullDriver.h"
 #include "stl/Algorithms/Cast.h"
 #include "stl/Algorithms/StringUtils.h"
 #include "stl/Containers/Singleton.h"
@@ -63,7 +64,8 @@ namespace {
 	{
 		VulkanLib *		lib = Singleton< VulkanLib >();
 		
-		if ( lib->module and lib->refCounter > 0 )
+		// library or null driver is already loaded
+		if ( lib->refCounter > 0 )
 		{
 			++lib->refCounter;
 			return true;
@@ -138,6 +140,46 @@ namespace {
 		return true;
 	}
 	
+/*
+=================================================
+	InitializeNullDriver
+----
+	must be externally synchronized!
+=================================================
+*/
+	bool VulkanLoader::InitializeNullDriver ()
+	{
+		VulkanLib *		lib = Singleton< VulkanLib >();
+
+		if ( lib->refCounter > 0 )
+		{
+			CHECK_ERR( lib->module == null );	// vulkan library is already loaded
+			++lib->refCounter;
+			return true;
+		}
+
+		FG_LOGI( "Vulkan library: null driver" );
+
+		const auto	Load =	[] (OUT auto& outResult, const char *procName, auto dummy)
+							{
+								using FN = decltype(dummy);
+								FN	result = BitCast<FN>( VulkanNullDriver::GetProcAddr( procName ));
+								outResult = result ? result : dummy;
+							};
+		
+		lib->module = null;
+		++lib->refCounter;
+		
+#		define VKLOADER_STAGE_GETADDRESS
+#		 include "fn_vulkan_lib.h"
+#		undef  VKLOADER_STAGE_GETADDRESS
+
+		ASSERT( _var_vkCreateInstance != &Dummy_vkCreateInstance );
+		ASSERT( _var_vkGetInstanceProcAddr != &Dummy_vkGetInstanceProcAddr );
+
+		return true;
+	}
+
 /*
 =================================================
 	LoadInstance
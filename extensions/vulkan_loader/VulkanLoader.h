@@ -106,6 +106,7 @@ namespace FGC
 		VulkanLoader () = delete;
 
 		static bool Initialize (StringView libName = {});
+		static bool InitializeNullDriver ();
 		static void LoadInstance (VkInstance instance);
 		static void Unload ();
 		
@@ -0,0 +1,1032 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VulkanNullDriver.h"
+
+#ifndef FG_VULKAN_STATIC
+
+#include "stl/Algorithms/Cast.h"
+#include "stl/Algorithms/ArrayUtils.h"
+#include "stl/Math/Math.h"
+#include "stl/CompileTime/Hash.h"
+#include "stl/Containers/Singleton.h"
+#include <atomic>
+#include <algorithm>
+#include <tuple>
+
+namespace FGC
+{
+namespace
+{
+	using CommandID = VulkanNullDriver::CommandID;
+
+	enum class EProcKind
+	{
+		Default,
+		Command,	// 'vkCmd*' - recorded into command buffer
+		Create,		// 'vkCreate*' - returns new unique handle
+	};
+
+	static constexpr VkQueueFlags	NullQueueFamilies[] = {
+		VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT,
+		VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT,
+		VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT
+	};
+	static constexpr uint			NullQueuesPerFamily	= 16;
+	static constexpr VkDeviceSize	NullHeapSize		= VkDeviceSize(8) << 30;
+
+
+/*
+=================================================
+	GetProcID
+=================================================
+*/
+	template <size_t N>
+	ND_ constexpr CommandID  GetProcID (const char (&name)[N])
+	{
+		return CommandID(size_t( CT_Hash( name, N-1, 0 )));
+	}
+
+/*
+=================================================
+	GetProcKind
+=================================================
+*/
+	ND_ constexpr bool  IsPrefix (const char *str, const char *prefix)
+	{
+		for (; *prefix; ++str, ++prefix) {
+			if ( *str != *prefix )
+				return false;
+		}
+		return true;
+	}
+
+	template <size_t N>
+	ND_ constexpr EProcKind  GetProcKind (const char (&name)[N])
+	{
+		return	IsPrefix( name, "vkCmd" )		? EProcKind::Command :
+				IsPrefix( name, "vkCreate" )	? EProcKind::Create :
+												  EProcKind::Default;
+	}
+
+/*
+=================================================
+	NullDispatchable
+----
+	dispatchable handle must be a pointer to object
+=================================================
+*/
+	struct NullDispatchable
+	{
+		void *	loaderData	= null;
+	};
+
+/*
+=================================================
+	NullCommandBuffer
+=================================================
+*/
+	struct NullCommandBuffer : NullDispatchable
+	{
+		Array<CommandID>				commands;
+		Array<NullCommandBuffer const*>	secondary;
+
+		void Reset ()
+		{
+			commands.clear();
+			secondary.clear();
+		}
+	};
+
+	struct NullCommandPool
+	{
+		Array<NullCommandBuffer *>		cmdBuffers;
+	};
+
+/*
+=================================================
+	NullBuffer, NullImage, NullMemory
+=================================================
+*/
+	struct NullBuffer
+	{
+		VkDeviceSize		size	= 0;
+	};
+
+	struct NullImage
+	{
+		VkDeviceSize		size	= 0;
+	};
+
+	struct NullMemory
+	{
+		VkDeviceSize		size	= 0;
+		UniquePtr<uint8_t[]>	data;	// allocated on first mapping
+	};
+
+/*
+=================================================
+	NullDriverData
+=================================================
+*/
+	struct NullDriverData
+	{
+		HashMap< StringView, PFN_vkVoidFunction >	procs;
+		HashMap< CommandID, StringView >			commandNames;
+
+		NullDispatchable		instance;
+		NullDispatchable		physicalDevice;
+		NullDispatchable		device;
+		NullDispatchable		queues [CountOf(NullQueueFamilies)] [NullQueuesPerFamily];
+
+		std::atomic<uint64_t>	handleCounter		{0};
+
+		struct {
+			std::atomic<uint64_t>	queueSubmits		{0};
+			std::atomic<uint64_t>	commandBuffers		{0};
+			std::atomic<uint64_t>	commands			{0};
+			std::atomic<uint64_t>	pipelineBarriers	{0};
+			std::atomic<uint64_t>	drawCalls			{0};
+			std::atomic<uint64_t>	dispatchCalls		{0};
+			std::atomic<uint64_t>	createdObjects		{0};
+		}						stat;
+
+		NullDriverData ();
+
+		template <typename FN, CommandID ID, EProcKind Kind>
+		void _AddProc (const char *name);
+
+		template <typename FN>
+		void _Override (FN fn, const char *name);
+	};
+
+	ND_ forceinline NullDriverData&  NullDriver ()
+	{
+		return *Singleton< NullDriverData >();
+	}
+
+/*
+=================================================
+	ToHandle / FromHandle / NewHandle
+=================================================
+*/
+	template <typename H, typename T>
+	ND_ forceinline H  ToHandle (T* ptr)
+	{
+		if constexpr( std::is_pointer_v<H> )
+			return BitCast<H>( ptr );
+		else
+			return H(size_t( ptr ));	// 32 bit non-dispatchable handle
+	}
+
+	template <typename T, typename H>
+	ND_ forceinline T*  FromHandle (H handle)
+	{
+		if constexpr( std::is_pointer_v<H> )
+			return BitCast<T*>( handle );
+		else
+			return reinterpret_cast<T*>(size_t( handle ));
+	}
+
+	template <typename H>
+	ND_ forceinline H  NewHandle ()
+	{
+		const uint64_t	id = ++NullDriver().handleCounter;
+		NullDriver().stat.createdObjects.fetch_add( 1, memory_order_relaxed );
+
+		if constexpr( std::is_pointer_v<H> )
+			return BitCast<H>( size_t(id) );
+		else
+			return H(id);
+	}
+
+/*
+=================================================
+	NullProc
+----
+	default implementation of any vulkan function
+=================================================
+*/
+	template <typename FN, CommandID ID, EProcKind Kind>
+	struct NullProc;
+
+	template <typename Ret, typename ...Args, CommandID ID, EProcKind Kind>
+	struct NullProc< Ret (VKAPI_PTR *)(Args...), ID, Kind >
+	{
+		static VKAPI_ATTR Ret VKAPI_CALL  Call (Args ...args)
+		{
+			if constexpr( Kind == EProcKind::Command )
+			{
+				auto	cmdbuf = std::get<0>( std::tie( args... ));
+				STATIC_ASSERT( IsSameTypes< decltype(cmdbuf), VkCommandBuffer >);
+
+				FromHandle<NullCommandBuffer>( cmdbuf )->commands.push_back( ID );
+			}
+			else
+			if constexpr( Kind == EProcKind::Create )
+			{
+				auto	result = std::get< sizeof...(Args)-1 >( std::tie( args... ));
+				using	H	   = std::remove_pointer_t< decltype(result) >;
+				STATIC_ASSERT( std::is_pointer_v< decltype(result) > and not std::is_const_v<H> );
+
+				*result = NewHandle<H>();
+			}
+			else
+			{
+				((void)args, ...);
+			}
+
+			if constexpr( IsSameTypes< Ret, VkResult >)
+				return VK_SUCCESS;
+			else
+			if constexpr( not IsSameTypes< Ret, void >)
+				return Ret{};
+		}
+	};
+
+/*
+=================================================
+	library functions
+=================================================
+*/
+	static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL  Null_vkGetInstanceProcAddr (VkInstance, const char *pName)
+	{
+		return VulkanNullDriver::GetProcAddr( pName );
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkCreateInstance (const VkInstanceCreateInfo *, const VkAllocationCallbacks *, VkInstance *pInstance)
+	{
+		*pInstance = ToHandle<VkInstance>( &NullDriver().instance );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkEnumerateInstanceVersion (uint32_t *pApiVersion)
+	{
+		*pApiVersion = VK_API_VERSION_1_1;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkEnumerateInstanceLayerProperties (uint32_t *pPropertyCount, VkLayerProperties *)
+	{
+		*pPropertyCount = 0;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkEnumerateInstanceExtensionProperties (const char *, uint32_t *pPropertyCount, VkExtensionProperties *)
+	{
+		*pPropertyCount = 0;
+		return VK_SUCCESS;
+	}
+
+/*
+=================================================
+	instance functions
+=================================================
+*/
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkEnumeratePhysicalDevices (VkInstance, uint32_t *pPhysicalDeviceCount, VkPhysicalDevice *pPhysicalDevices)
+	{
+		if ( pPhysicalDevices == null ) {
+			*pPhysicalDeviceCount = 1;
+			return VK_SUCCESS;
+		}
+		if ( *pPhysicalDeviceCount == 0 )
+			return VK_INCOMPLETE;
+
+		*pPhysicalDeviceCount	= 1;
+		pPhysicalDevices[0]		= ToHandle<VkPhysicalDevice>( &NullDriver().physicalDevice );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceFeatures (VkPhysicalDevice, VkPhysicalDeviceFeatures *pFeatures)
+	{
+		STATIC_ASSERT( sizeof(VkPhysicalDeviceFeatures) % sizeof(VkBool32) == 0 );
+
+		VkBool32 *	features = &pFeatures->robustBufferAccess;
+
+		for (size_t i = 0; i < sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32); ++i) {
+			features[i] = VK_TRUE;
+		}
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceFeatures2 (VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures2 *pFeatures)
+	{
+		Null_vkGetPhysicalDeviceFeatures( physicalDevice, OUT &pFeatures->features );
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceProperties (VkPhysicalDevice, VkPhysicalDeviceProperties *pProperties)
+	{
+		VkPhysicalDeviceProperties	props = {};
+		props.apiVersion		= VK_API_VERSION_1_1;
+		props.driverVersion		= VK_MAKE_VERSION( 1, 0, 0 );
+		props.deviceType		= VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
+		std::strncpy( props.deviceName, "Null Device", sizeof(props.deviceName) );
+
+		auto&	lim = props.limits;
+		lim.maxImageDimension1D						= 16384;
+		lim.maxImageDimension2D						= 16384;
+		lim.maxImageDimension3D						= 2048;
+		lim.maxImageDimensionCube					= 16384;
+		lim.maxImageArrayLayers						= 2048;
+		lim.maxTexelBufferElements					= 1u << 27;
+		lim.maxUniformBufferRange					= 1u << 16;
+		lim.maxStorageBufferRange					= ~0u;
+		lim.maxPushConstantsSize					= 256;
+		lim.maxMemoryAllocationCount				= 1u << 20;
+		lim.maxSamplerAllocationCount				= 4000;
+		lim.bufferImageGranularity					= 1024;
+		lim.sparseAddressSpaceSize					= ~0ull;
+		lim.maxBoundDescriptorSets					= 32;
+		lim.maxPerStageDescriptorSamplers			= 1u << 20;
+		lim.maxPerStageDescriptorUniformBuffers		= 1u << 20;
+		lim.maxPerStageDescriptorStorageBuffers		= 1u << 20;
+		lim.maxPerStageDescriptorSampledImages		= 1u << 20;
+		lim.maxPerStageDescriptorStorageImages		= 1u << 20;
+		lim.maxPerStageDescriptorInputAttachments	= 1u << 20;
+		lim.maxPerStageResources					= 1u << 20;
+		lim.maxDescriptorSetSamplers				= 1u << 20;
+		lim.maxDescriptorSetUniformBuffers			= 1u << 20;
+		lim.maxDescriptorSetUniformBuffersDynamic	= 16;
+		lim.maxDescriptorSetStorageBuffers			= 1u << 20;
+		lim.maxDescriptorSetStorageBuffersDynamic	= 16;
+		lim.maxDescriptorSetSampledImages			= 1u << 20;
+		lim.maxDescriptorSetStorageImages			= 1u << 20;
+		lim.maxDescriptorSetInputAttachments		= 1u << 20;
+		lim.maxVertexInputAttributes				= 32;
+		lim.maxVertexInputBindings					= 32;
+		lim.maxVertexInputAttributeOffset			= 2047;
+		lim.maxVertexInputBindingStride				= 2048;
+		lim.maxVertexOutputComponents				= 128;
+		lim.maxFragmentInputComponents				= 128;
+		lim.maxFragmentOutputAttachments			= 8;
+		lim.maxFragmentCombinedOutputResources		= 1u << 20;
+		lim.maxComputeSharedMemorySize				= 48u << 10;
+		lim.maxComputeWorkGroupCount[0]				= 1u << 31;
+		lim.maxComputeWorkGroupCount[1]				= 1u << 16;
+		lim.maxComputeWorkGroupCount[2]				= 1u << 16;
+		lim.maxComputeWorkGroupInvocations			= 1024;
+		lim.maxComputeWorkGroupSize[0]				= 1024;
+		lim.maxComputeWorkGroupSize[1]				= 1024;
+		lim.maxComputeWorkGroupSize[2]				= 64;
+		lim.maxDrawIndexedIndexValue				= ~0u;
+		lim.maxDrawIndirectCount					= ~0u;
+		lim.maxSamplerLodBias						= 16.0f;
+		lim.maxSamplerAnisotropy					= 16.0f;
+		lim.maxViewports							= 16;
+		lim.maxViewportDimensions[0]				= 16384;
+		lim.maxViewportDimensions[1]				= 16384;
+		lim.viewportBoundsRange[0]					= -32768.0f;
+		lim.viewportBoundsRange[1]					= 32768.0f;
+		lim.minMemoryMapAlignment					= 64;
+		lim.minTexelBufferOffsetAlignment			= 16;
+		lim.minUniformBufferOffsetAlignment			= 256;
+		lim.minStorageBufferOffsetAlignment			= 32;
+		lim.maxFramebufferWidth						= 16384;
+		lim.maxFramebufferHeight					= 16384;
+		lim.maxFramebufferLayers					= 2048;
+		lim.framebufferColorSampleCounts			= VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT | VK_SAMPLE_COUNT_8_BIT;
+		lim.framebufferDepthSampleCounts			= lim.framebufferColorSampleCounts;
+		lim.framebufferStencilSampleCounts			= lim.framebufferColorSampleCounts;
+		lim.framebufferNoAttachmentsSampleCounts	= lim.framebufferColorSampleCounts;
+		lim.maxColorAttachments						= 8;
+		lim.sampledImageColorSampleCounts			= lim.framebufferColorSampleCounts;
+		lim.sampledImageIntegerSampleCounts			= lim.framebufferColorSampleCounts;
+		lim.sampledImageDepthSampleCounts			= lim.framebufferColorSampleCounts;
+		lim.sampledImageStencilSampleCounts			= lim.framebufferColorSampleCounts;
+		lim.storageImageSampleCounts				= lim.framebufferColorSampleCounts;
+		lim.maxSampleMaskWords						= 1;
+		lim.timestampComputeAndGraphics				= VK_TRUE;
+		lim.timestampPeriod							= 1.0f;
+		lim.maxClipDistances						= 8;
+		lim.maxCullDistances						= 8;
+		lim.maxCombinedClipAndCullDistances			= 8;
+		lim.optimalBufferCopyOffsetAlignment		= 1;
+		lim.optimalBufferCopyRowPitchAlignment		= 1;
+		lim.nonCoherentAtomSize						= 64;
+
+		*pProperties = props;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceProperties2 (VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties2 *pProperties)
+	{
+		Null_vkGetPhysicalDeviceProperties( physicalDevice, OUT &pProperties->properties );
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceMemoryProperties (VkPhysicalDevice, VkPhysicalDeviceMemoryProperties *pMemoryProperties)
+	{
+		VkPhysicalDeviceMemoryProperties	props = {};
+
+		props.memoryHeapCount	= 2;
+		props.memoryHeaps[0]	= { NullHeapSize, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT };
+		props.memoryHeaps[1]	= { NullHeapSize, 0 };
+
+		props.memoryTypeCount	= 4;
+		props.memoryTypes[0]	= { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0 };
+		props.memoryTypes[1]	= { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1 };
+		props.memoryTypes[2]	= { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, 1 };
+		props.memoryTypes[3]	= { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0 };
+
+		*pMemoryProperties = props;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceMemoryProperties2 (VkPhysicalDevice physicalDevice, VkPhysicalDeviceMemoryProperties2 *pMemoryProperties)
+	{
+		Null_vkGetPhysicalDeviceMemoryProperties( physicalDevice, OUT &pMemoryProperties->memoryProperties );
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceQueueFamilyProperties (VkPhysicalDevice, uint32_t *pQueueFamilyPropertyCount, VkQueueFamilyProperties *pQueueFamilyProperties)
+	{
+		if ( pQueueFamilyProperties == null ) {
+			*pQueueFamilyPropertyCount = uint32_t(CountOf( NullQueueFamilies ));
+			return;
+		}
+
+		*pQueueFamilyPropertyCount = Min( *pQueueFamilyPropertyCount, uint32_t(CountOf( NullQueueFamilies )));
+
+		for (uint32_t i = 0; i < *pQueueFamilyPropertyCount; ++i)
+		{
+			auto&	props = pQueueFamilyProperties[i];
+			props.queueFlags					= NullQueueFamilies[i];
+			props.queueCount					= NullQueuesPerFamily;
+			props.timestampValidBits			= 64;
+			props.minImageTransferGranularity	= { 1, 1, 1 };
+		}
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetPhysicalDeviceFormatProperties (VkPhysicalDevice, VkFormat, VkFormatProperties *pFormatProperties)
+	{
+		pFormatProperties->linearTilingFeatures		= ~VkFormatFeatureFlags(0);
+		pFormatProperties->optimalTilingFeatures	= ~VkFormatFeatureFlags(0);
+		pFormatProperties->bufferFeatures			= ~VkFormatFeatureFlags(0);
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetPhysicalDeviceImageFormatProperties (VkPhysicalDevice, VkFormat, VkImageType, VkImageTiling, VkImageUsageFlags,
+																						  VkImageCreateFlags, VkImageFormatProperties *pImageFormatProperties)
+	{
+		pImageFormatProperties->maxExtent		= { 16384, 16384, 2048 };
+		pImageFormatProperties->maxMipLevels	= 15;
+		pImageFormatProperties->maxArrayLayers	= 2048;
+		pImageFormatProperties->sampleCounts	= VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT | VK_SAMPLE_COUNT_8_BIT;
+		pImageFormatProperties->maxResourceSize	= NullHeapSize;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkEnumerateDeviceLayerProperties (VkPhysicalDevice, uint32_t *pPropertyCount, VkLayerProperties *)
+	{
+		*pPropertyCount = 0;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkEnumerateDeviceExtensionProperties (VkPhysicalDevice, const char *, uint32_t *pPropertyCount, VkExtensionProperties *)
+	{
+		*pPropertyCount = 0;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkCreateDevice (VkPhysicalDevice, const VkDeviceCreateInfo *, const VkAllocationCallbacks *, VkDevice *pDevice)
+	{
+		*pDevice = ToHandle<VkDevice>( &NullDriver().device );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL  Null_vkGetDeviceProcAddr (VkDevice, const char *pName)
+	{
+		return VulkanNullDriver::GetProcAddr( pName );
+	}
+
+/*
+=================================================
+	device functions
+=================================================
+*/
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetDeviceQueue (VkDevice, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue *pQueue)
+	{
+		ASSERT( queueFamilyIndex < CountOf( NullQueueFamilies ));
+		ASSERT( queueIndex < NullQueuesPerFamily );
+
+		*pQueue = ToHandle<VkQueue>( &NullDriver().queues[ queueFamilyIndex ][ queueIndex ]);
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetDeviceQueue2 (VkDevice device, const VkDeviceQueueInfo2 *pQueueInfo, VkQueue *pQueue)
+	{
+		Null_vkGetDeviceQueue( device, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, OUT pQueue );
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkAllocateMemory (VkDevice, const VkMemoryAllocateInfo *pAllocateInfo, const VkAllocationCallbacks *, VkDeviceMemory *pMemory)
+	{
+		auto*	mem = new NullMemory{};
+		mem->size	= pAllocateInfo->allocationSize;
+		*pMemory	= ToHandle<VkDeviceMemory>( mem );
+
+		NullDriver().stat.createdObjects.fetch_add( 1, memory_order_relaxed );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkFreeMemory (VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks *)
+	{
+		delete FromHandle<NullMemory>( memory );
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkMapMemory (VkDevice, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize, VkMemoryMapFlags, void **ppData)
+	{
+		auto*	mem = FromHandle<NullMemory>( memory );
+		CHECK_ERR( mem and offset < mem->size, VK_ERROR_MEMORY_MAP_FAILED );
+
+		// content is undefined, so don't touch allocated pages
+		if ( not mem->data )
+			mem->data.reset( new uint8_t[ size_t(mem->size) ]);
+
+		*ppData = mem->data.get() + offset;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkCreateBuffer (VkDevice, const VkBufferCreateInfo *pCreateInfo, const VkAllocationCallbacks *, VkBuffer *pBuffer)
+	{
+		auto*	buf = new NullBuffer{};
+		buf->size	= pCreateInfo->size;
+		*pBuffer	= ToHandle<VkBuffer>( buf );
+
+		NullDriver().stat.createdObjects.fetch_add( 1, memory_order_relaxed );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkDestroyBuffer (VkDevice, VkBuffer buffer, const VkAllocationCallbacks *)
+	{
+		delete FromHandle<NullBuffer>( buffer );
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetBufferMemoryRequirements (VkDevice, VkBuffer buffer, VkMemoryRequirements *pMemoryRequirements)
+	{
+		auto*	buf = FromHandle<NullBuffer>( buffer );
+
+		pMemoryRequirements->alignment		= 256;
+		pMemoryRequirements->size			= AlignToLarger( buf->size, pMemoryRequirements->alignment );
+		pMemoryRequirements->memoryTypeBits	= 0xF;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetBufferMemoryRequirements2 (VkDevice device, const VkBufferMemoryRequirementsInfo2 *pInfo, VkMemoryRequirements2 *pMemoryRequirements)
+	{
+		Null_vkGetBufferMemoryRequirements( device, pInfo->buffer, OUT &pMemoryRequirements->memoryRequirements );
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkCreateImage (VkDevice, const VkImageCreateInfo *pCreateInfo, const VkAllocationCallbacks *, VkImage *pImage)
+	{
+		// upper bound, 16 bytes per texel is enough for any uncompressed format
+		const auto&		dim		= pCreateInfo->extent;
+		VkDeviceSize	size	= VkDeviceSize(dim.width) * dim.height * dim.depth * pCreateInfo->arrayLayers * pCreateInfo->samples * 16;
+
+		if ( pCreateInfo->mipLevels > 1 )
+			size += size / 3;
+
+		auto*	img = new NullImage{};
+		img->size	= size;
+		*pImage		= ToHandle<VkImage>( img );
+
+		NullDriver().stat.createdObjects.fetch_add( 1, memory_order_relaxed );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkDestroyImage (VkDevice, VkImage image, const VkAllocationCallbacks *)
+	{
+		delete FromHandle<NullImage>( image );
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetImageMemoryRequirements (VkDevice, VkImage image, VkMemoryRequirements *pMemoryRequirements)
+	{
+		auto*	img = FromHandle<NullImage>( image );
+
+		pMemoryRequirements->alignment		= 4 << 10;
+		pMemoryRequirements->size			= AlignToLarger( img->size, pMemoryRequirements->alignment );
+		pMemoryRequirements->memoryTypeBits	= 0xF;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetImageMemoryRequirements2 (VkDevice device, const VkImageMemoryRequirementsInfo2 *pInfo, VkMemoryRequirements2 *pMemoryRequirements)
+	{
+		Null_vkGetImageMemoryRequirements( device, pInfo->image, OUT &pMemoryRequirements->memoryRequirements );
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkGetAccelerationStructureMemoryRequirementsNV (VkDevice, const VkAccelerationStructureMemoryRequirementsInfoNV *,
+																							VkMemoryRequirements2KHR *pMemoryRequirements)
+	{
+		pMemoryRequirements->memoryRequirements.alignment		= 256;
+		pMemoryRequirements->memoryRequirements.size			= 64 << 10;
+		pMemoryRequirements->memoryRequirements.memoryTypeBits	= 0xF;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetAccelerationStructureHandleNV (VkDevice, VkAccelerationStructureNV, size_t dataSize, void *pData)
+	{
+		std::memset( pData, 0, dataSize );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetRayTracingShaderGroupHandlesNV (VkDevice, VkPipeline, uint32_t, uint32_t, size_t dataSize, void *pData)
+	{
+		std::memset( pData, 0, dataSize );
+		return VK_SUCCESS;
+	}
+
+	template <typename InfoType>
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkCreatePipelines (VkDevice, VkPipelineCache, uint32_t createInfoCount, const InfoType *,
+																   const VkAllocationCallbacks *, VkPipeline *pPipelines)
+	{
+		for (uint32_t i = 0; i < createInfoCount; ++i) {
+			pPipelines[i] = NewHandle<VkPipeline>();
+		}
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetPipelineCacheData (VkDevice, VkPipelineCache, size_t *pDataSize, void *)
+	{
+		*pDataSize = 0;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkAllocateDescriptorSets (VkDevice, const VkDescriptorSetAllocateInfo *pAllocateInfo, VkDescriptorSet *pDescriptorSets)
+	{
+		for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; ++i) {
+			pDescriptorSets[i] = NewHandle<VkDescriptorSet>();
+		}
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetQueryPoolResults (VkDevice, VkQueryPool, uint32_t, uint32_t, size_t dataSize, void *pData, VkDeviceSize, VkQueryResultFlags)
+	{
+		std::memset( pData, 0, dataSize );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetSwapchainImagesKHR (VkDevice, VkSwapchainKHR, uint32_t *pSwapchainImageCount, VkImage *)
+	{
+		*pSwapchainImageCount = 0;
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkGetEventStatus (VkDevice, VkEvent)
+	{
+		return VK_EVENT_SET;
+	}
+
+/*
+=================================================
+	command pool & command buffer
+=================================================
+*/
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkCreateCommandPool (VkDevice, const VkCommandPoolCreateInfo *, const VkAllocationCallbacks *, VkCommandPool *pCommandPool)
+	{
+		*pCommandPool = ToHandle<VkCommandPool>( new NullCommandPool{} );
+
+		NullDriver().stat.createdObjects.fetch_add( 1, memory_order_relaxed );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkDestroyCommandPool (VkDevice, VkCommandPool commandPool, const VkAllocationCallbacks *)
+	{
+		auto*	pool = FromHandle<NullCommandPool>( commandPool );
+		if ( not pool )
+			return;
+
+		for (auto* cmd : pool->cmdBuffers) {
+			delete cmd;
+		}
+		delete pool;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkResetCommandPool (VkDevice, VkCommandPool commandPool, VkCommandPoolResetFlags)
+	{
+		auto*	pool = FromHandle<NullCommandPool>( commandPool );
+
+		for (auto* cmd : pool->cmdBuffers) {
+			cmd->Reset();
+		}
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkAllocateCommandBuffers (VkDevice, const VkCommandBufferAllocateInfo *pAllocateInfo, VkCommandBuffer *pCommandBuffers)
+	{
+		auto*	pool = FromHandle<NullCommandPool>( pAllocateInfo->commandPool );
+
+		for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i)
+		{
+			auto*	cmd = new NullCommandBuffer{};
+			pool->cmdBuffers.push_back( cmd );
+			pCommandBuffers[i] = ToHandle<VkCommandBuffer>( cmd );
+		}
+
+		NullDriver().stat.createdObjects.fetch_add( pAllocateInfo->commandBufferCount, memory_order_relaxed );
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkFreeCommandBuffers (VkDevice, VkCommandPool commandPool, uint32_t commandBufferCount, const VkCommandBuffer *pCommandBuffers)
+	{
+		auto*	pool = FromHandle<NullCommandPool>( commandPool );
+
+		for (uint32_t i = 0; i < commandBufferCount; ++i)
+		{
+			auto*	cmd = FromHandle<NullCommandBuffer>( pCommandBuffers[i] );
+			auto	iter = std::find( pool->cmdBuffers.begin(), pool->cmdBuffers.end(), cmd );
+
+			if ( iter != pool->cmdBuffers.end() )
+			{
+				pool->cmdBuffers.erase( iter );
+				delete cmd;
+			}
+		}
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkBeginCommandBuffer (VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *)
+	{
+		FromHandle<NullCommandBuffer>( commandBuffer )->Reset();
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkResetCommandBuffer (VkCommandBuffer commandBuffer, VkCommandBufferResetFlags)
+	{
+		FromHandle<NullCommandBuffer>( commandBuffer )->Reset();
+		return VK_SUCCESS;
+	}
+
+	static VKAPI_ATTR void VKAPI_CALL  Null_vkCmdExecuteCommands (VkCommandBuffer commandBuffer, uint32_t commandBufferCount, const VkCommandBuffer *pCommandBuffers)
+	{
+		auto*	cmd = FromHandle<NullCommandBuffer>( commandBuffer );
+		cmd->commands.push_back( GetProcID( "vkCmdExecuteCommands" ));
+
+		for (uint32_t i = 0; i < commandBufferCount; ++i) {
+			cmd->secondary.push_back( FromHandle<NullCommandBuffer>( pCommandBuffers[i] ));
+		}
+	}
+
+/*
+=================================================
+	queue
+=================================================
+*/
+	struct SubmitStatistics
+	{
+		uint64_t	commandBuffers		= 0;
+		uint64_t	commands			= 0;
+		uint64_t	pipelineBarriers	= 0;
+		uint64_t	drawCalls			= 0;
+		uint64_t	dispatchCalls		= 0;
+
+		void Add (const NullCommandBuffer &cmd)
+		{
+			++commandBuffers;
+			commands += cmd.commands.size();
+
+			for (auto id : cmd.commands)
+			{
+				switch ( id )
+				{
+					case GetProcID( "vkCmdPipelineBarrier" ) :					++pipelineBarriers;		break;
+
+					case GetProcID( "vkCmdDraw" ) :
+					case GetProcID( "vkCmdDrawIndexed" ) :
+					case GetProcID( "vkCmdDrawIndirect" ) :
+					case GetProcID( "vkCmdDrawIndexedIndirect" ) :
+					case GetProcID( "vkCmdDrawIndirectCountKHR" ) :
+					case GetProcID( "vkCmdDrawIndexedIndirectCountKHR" ) :
+					case GetProcID( "vkCmdDrawMeshTasksNV" ) :
+					case GetProcID( "vkCmdDrawMeshTasksIndirectNV" ) :
+					case GetProcID( "vkCmdDrawMeshTasksIndirectCountNV" ) :	++drawCalls;			break;
+
+					case GetProcID( "vkCmdDispatch" ) :
+					case GetProcID( "vkCmdDispatchBase" ) :
+					case GetProcID( "vkCmdDispatchIndirect" ) :				++dispatchCalls;		break;
+				}
+			}
+
+			for (auto* sec : cmd.secondary) {
+				Add( *sec );
+			}
+		}
+	};
+
+	static VKAPI_ATTR VkResult VKAPI_CALL  Null_vkQueueSubmit (VkQueue, uint32_t submitCount, const VkSubmitInfo *pSubmits, VkFence)
+	{
+		SubmitStatistics	info;
+
+		for (uint32_t i = 0; i < submitCount; ++i)
+		{
+			for (uint32_t j = 0; j < pSubmits[i].commandBufferCount; ++j) {
+				info.Add( *FromHandle<NullCommandBuffer>( pSubmits[i].pCommandBuffers[j] ));
+			}
+		}
+
+		auto&	stat = NullDriver().stat;
+		stat.queueSubmits.fetch_add( 1, memory_order_relaxed );
+		stat.commandBuffers.fetch_add( info.commandBuffers, memory_order_relaxed );
+		stat.commands.fetch_add( info.commands, memory_order_relaxed );
+		stat.pipelineBarriers.fetch_add( info.pipelineBarriers, memory_order_relaxed );
+		stat.drawCalls.fetch_add( info.drawCalls, memory_order_relaxed );
+		stat.dispatchCalls.fetch_add( info.dispatchCalls, memory_order_relaxed );
+		return VK_SUCCESS;
+	}
+
+/*
+=================================================
+	_AddProc
+=================================================
+*/
+	template <typename FN, CommandID ID, EProcKind Kind>
+	void NullDriverData::_AddProc (const char *name)
+	{
+		procs.insert_or_assign( StringView{name}, BitCast<PFN_vkVoidFunction>( &NullProc< FN, ID, Kind >::Call ));
+
+		if constexpr( Kind == EProcKind::Command )
+		{
+			ASSERT( commandNames.count( ID ) == 0 );	// hash collision
+			commandNames.insert_or_assign( ID, StringView{name} );
+		}
+	}
+
+/*
+=================================================
+	_Override
+=================================================
+*/
+	template <typename FN>
+	void NullDriverData::_Override (FN fn, const char *name)
+	{
+		auto	iter = procs.find( StringView{name} );
+		CHECK( iter != procs.end() );
+
+		iter->second = BitCast<PFN_vkVoidFunction>( fn );
+	}
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	NullDriverData::NullDriverData ()
+	{
+		// all device functions are members of the table, declare same names to get function types
+		struct {
+#			define VKLOADER_STAGE_FNPOINTER
+#			 include "fn_vulkan_dev.h"
+#			undef  VKLOADER_STAGE_FNPOINTER
+		}	table;
+
+#		define Load( _out_, _name_, _dummy_ ) \
+			_AddProc< decltype(_out_), GetProcID( _name_ ), GetProcKind( _name_ )>( _name_ )
+
+#		define VKLOADER_STAGE_GETADDRESS
+#		 include "fn_vulkan_lib.h"
+#		 include "fn_vulkan_inst.h"
+#		 include "fn_vulkan_dev.h"
+#		undef  VKLOADER_STAGE_GETADDRESS
+#		undef  Load
+
+#		define VK_OVERRIDE( _name_ )				_Override< PFN_##_name_ >( &Null_##_name_, #_name_ )
+#		define VK_OVERRIDE2( _name_, _fn_ )		_Override< PFN_##_name_ >( &_fn_, #_name_ )
+
+		// library
+		VK_OVERRIDE( vkGetInstanceProcAddr );
+		VK_OVERRIDE( vkCreateInstance );
+		VK_OVERRIDE( vkEnumerateInstanceVersion );
+		VK_OVERRIDE( vkEnumerateInstanceLayerProperties );
+		VK_OVERRIDE( vkEnumerateInstanceExtensionProperties );
+
+		// instance
+		VK_OVERRIDE( vkEnumeratePhysicalDevices );
+		VK_OVERRIDE( vkGetPhysicalDeviceFeatures );
+		VK_OVERRIDE( vkGetPhysicalDeviceFeatures2 );
+		VK_OVERRIDE2( vkGetPhysicalDeviceFeatures2KHR, Null_vkGetPhysicalDeviceFeatures2 );
+		VK_OVERRIDE( vkGetPhysicalDeviceProperties );
+		VK_OVERRIDE( vkGetPhysicalDeviceProperties2 );
+		VK_OVERRIDE2( vkGetPhysicalDeviceProperties2KHR, Null_vkGetPhysicalDeviceProperties2 );
+		VK_OVERRIDE( vkGetPhysicalDeviceMemoryProperties );
+		VK_OVERRIDE( vkGetPhysicalDeviceMemoryProperties2 );
+		VK_OVERRIDE2( vkGetPhysicalDeviceMemoryProperties2KHR, Null_vkGetPhysicalDeviceMemoryProperties2 );
+		VK_OVERRIDE( vkGetPhysicalDeviceQueueFamilyProperties );
+		VK_OVERRIDE( vkGetPhysicalDeviceFormatProperties );
+		VK_OVERRIDE( vkGetPhysicalDeviceImageFormatProperties );
+		VK_OVERRIDE( vkEnumerateDeviceLayerProperties );
+		VK_OVERRIDE( vkEnumerateDeviceExtensionProperties );
+		VK_OVERRIDE( vkCreateDevice );
+		VK_OVERRIDE( vkGetDeviceProcAddr );
+
+		// device
+		VK_OVERRIDE( vkGetDeviceQueue );
+		VK_OVERRIDE( vkGetDeviceQueue2 );
+		VK_OVERRIDE( vkAllocateMemory );
+		VK_OVERRIDE( vkFreeMemory );
+		VK_OVERRIDE( vkMapMemory );
+		VK_OVERRIDE( vkCreateBuffer );
+		VK_OVERRIDE( vkDestroyBuffer );
+		VK_OVERRIDE( vkGetBufferMemoryRequirements );
+		VK_OVERRIDE( vkGetBufferMemoryRequirements2 );
+		VK_OVERRIDE2( vkGetBufferMemoryRequirements2KHR, Null_vkGetBufferMemoryRequirements2 );
+		VK_OVERRIDE( vkCreateImage );
+		VK_OVERRIDE( vkDestroyImage );
+		VK_OVERRIDE( vkGetImageMemoryRequirements );
+		VK_OVERRIDE( vkGetImageMemoryRequirements2 );
+		VK_OVERRIDE2( vkGetImageMemoryRequirements2KHR, Null_vkGetImageMemoryRequirements2 );
+		VK_OVERRIDE( vkGetAccelerationStructureMemoryRequirementsNV );
+		VK_OVERRIDE( vkGetAccelerationStructureHandleNV );
+		VK_OVERRIDE( vkGetRayTracingShaderGroupHandlesNV );
+		VK_OVERRIDE2( vkCreateGraphicsPipelines, Null_vkCreatePipelines<VkGraphicsPipelineCreateInfo> );
+		VK_OVERRIDE2( vkCreateComputePipelines, Null_vkCreatePipelines<VkComputePipelineCreateInfo> );
+		VK_OVERRIDE2( vkCreateRayTracingPipelinesNV, Null_vkCreatePipelines<VkRayTracingPipelineCreateInfoNV> );
+		VK_OVERRIDE( vkGetPipelineCacheData );
+		VK_OVERRIDE( vkAllocateDescriptorSets );
+		VK_OVERRIDE( vkGetQueryPoolResults );
+		VK_OVERRIDE( vkGetSwapchainImagesKHR );
+		VK_OVERRIDE( vkGetEventStatus );
+		VK_OVERRIDE( vkCreateCommandPool );
+		VK_OVERRIDE( vkDestroyCommandPool );
+		VK_OVERRIDE( vkResetCommandPool );
+		VK_OVERRIDE( vkAllocateCommandBuffers );
+		VK_OVERRIDE( vkFreeCommandBuffers );
+		VK_OVERRIDE( vkBeginCommandBuffer );
+		VK_OVERRIDE( vkResetCommandBuffer );
+		VK_OVERRIDE( vkCmdExecuteCommands );
+		VK_OVERRIDE( vkQueueSubmit );
+
+#		undef VK_OVERRIDE
+#		undef VK_OVERRIDE2
+	}
+
+}	// namespace
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	GetProcAddr
+=================================================
+*/
+	PFN_vkVoidFunction  VulkanNullDriver::GetProcAddr (const char *procName)
+	{
+		auto&	procs	= NullDriver().procs;
+		auto	iter	= procs.find( StringView{procName} );
+
+		return iter != procs.end() ? iter->second : null;
+	}
+
+/*
+=================================================
+	GetRecordedCommands
+=================================================
+*/
+	ArrayView<VulkanNullDriver::CommandID>  VulkanNullDriver::GetRecordedCommands (VkCommandBuffer cmdbuf)
+	{
+		auto*	cmd = FromHandle<NullCommandBuffer>( cmdbuf );
+		CHECK_ERR( cmd );
+
+		return cmd->commands;
+	}
+
+/*
+=================================================
+	GetCommandName
+=================================================
+*/
+	StringView  VulkanNullDriver::GetCommandName (CommandID id)
+	{
+		auto&	names	= NullDriver().commandNames;
+		auto	iter	= names.find( id );
+
+		return iter != names.end() ? iter->second : StringView{};
+	}
+
+/*
+=================================================
+	GetStatistics
+=================================================
+*/
+	VulkanNullDriver::Statistics  VulkanNullDriver::GetStatistics ()
+	{
+		auto&		src = NullDriver().stat;
+		Statistics	result;
+
+		result.queueSubmits		= src.queueSubmits.load( memory_order_relaxed );
+		result.commandBuffers	= src.commandBuffers.load( memory_order_relaxed );
+		result.commands			= src.commands.load( memory_order_relaxed );
+		result.pipelineBarriers	= src.pipelineBarriers.load( memory_order_relaxed );
+		result.drawCalls		= src.drawCalls.load( memory_order_relaxed );
+		result.dispatchCalls	= src.dispatchCalls.load( memory_order_relaxed );
+		result.createdObjects	= src.createdObjects.load( memory_order_relaxed );
+		return result;
+	}
+
+/*
+=================================================
+	ResetStatistics
+=================================================
+*/
+	void  VulkanNullDriver::ResetStatistics ()
+	{
+		auto&	stat = NullDriver().stat;
+
+		stat.queueSubmits.store( 0, memory_order_relaxed );
+		stat.commandBuffers.store( 0, memory_order_relaxed );
+		stat.commands.store( 0, memory_order_relaxed );
+		stat.pipelineBarriers.store( 0, memory_order_relaxed );
+		stat.drawCalls.store( 0, memory_order_relaxed );
+		stat.dispatchCalls.store( 0, memory_order_relaxed );
+		stat.createdObjects.store( 0, memory_order_relaxed );
+	}
+
+
+}	// FGC
+
+#endif	// not FG_VULKAN_STATIC
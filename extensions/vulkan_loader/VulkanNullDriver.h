@@ -0,0 +1,59 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Null driver replaces the Vulkan library by in-memory implementation without GPU.
+	Objects are just unique handles, commands are recorded into command buffer and never executed,
+	host visible memory is allocated on first mapping, all waits and queries are completed immediately.
+
+	Use it to profile and test CPU overhead of the frame graph:
+		VulkanLoader::InitializeNullDriver();
+		// create instance and device as usual, then create frame graph
+*/
+
+#pragma once
+
+#include "VulkanLoader.h"
+#include "stl/Containers/ArrayView.h"
+
+#ifndef FG_VULKAN_STATIC
+
+namespace FGC
+{
+
+	//
+	// Vulkan Null Driver
+	//
+
+	struct VulkanNullDriver final
+	{
+	// types
+		struct Statistics
+		{
+			uint64_t	queueSubmits		= 0;
+			uint64_t	commandBuffers		= 0;	// primary and secondary command buffers that was submitted
+			uint64_t	commands			= 0;	// all commands in submitted command buffers
+			uint64_t	pipelineBarriers	= 0;
+			uint64_t	drawCalls			= 0;
+			uint64_t	dispatchCalls		= 0;
+			uint64_t	createdObjects		= 0;
+		};
+
+		using CommandID	= uint;
+
+
+	// methods
+		VulkanNullDriver () = delete;
+
+		ND_ static PFN_vkVoidFunction	GetProcAddr (const char *procName);
+
+		// returns IDs of all commands that was recorded since last 'vkBeginCommandBuffer' or reset
+		ND_ static ArrayView<CommandID>	GetRecordedCommands (VkCommandBuffer cmdbuf);
+		ND_ static StringView			GetCommandName (CommandID id);
+
+		ND_ static Statistics			GetStatistics ();
+			static void					ResetStatistics ();
+	};
+
+
+}	// FGC
+
+#endif	// not FG_VULKAN_STATIC
@@ -249,6 +249,13 @@
 	extern PFN_vkGetSwapchainCounterEXT  _var_vkGetSwapchainCounterEXT;
 
 
+# ifdef VK_KHR_timeline_semaphore
+	extern PFN_vkGetSemaphoreCounterValueKHR  _var_vkGetSemaphoreCounterValueKHR;
+	extern PFN_vkWaitSemaphoresKHR  _var_vkWaitSemaphoresKHR;
+	extern PFN_vkSignalSemaphoreKHR  _var_vkSignalSemaphoreKHR;
+# endif // VK_KHR_timeline_semaphore
+
+
 # ifdef VULKAN_WIN32_H_
 	extern PFN_vkImportSemaphoreWin32HandleKHR  _var_vkImportSemaphoreWin32HandleKHR;
 	extern PFN_vkImportFenceWin32HandleKHR  _var_vkImportFenceWin32HandleKHR;
@@ -517,6 +524,13 @@
 	PFN_vkGetSwapchainCounterEXT  _var_vkGetSwapchainCounterEXT = null;
 
 
+# ifdef VK_KHR_timeline_semaphore
+	PFN_vkGetSemaphoreCounterValueKHR  _var_vkGetSemaphoreCounterValueKHR = null;
+	PFN_vkWaitSemaphoresKHR  _var_vkWaitSemaphoresKHR = null;
+	PFN_vkSignalSemaphoreKHR  _var_vkSignalSemaphoreKHR = null;
+# endif // VK_KHR_timeline_semaphore
+
+
 # ifdef VULKAN_WIN32_H_
 	PFN_vkImportSemaphoreWin32HandleKHR  _var_vkImportSemaphoreWin32HandleKHR = null;
 	PFN_vkImportFenceWin32HandleKHR  _var_vkImportFenceWin32HandleKHR = null;
@@ -785,6 +799,13 @@
 	ND_ VKAPI_ATTR forceinline VkResult vkGetSwapchainCounterEXT (VkDevice device, VkSwapchainKHR swapchain, VkSurfaceCounterFlagBitsEXT counter, uint64_t * pCounterValue) const noexcept								{ return _table->_var_vkGetSwapchainCounterEXT( device, swapchain, counter, pCounterValue ); }
 
 
+# ifdef VK_KHR_timeline_semaphore
+	ND_ VKAPI_ATTR forceinline VkResult vkGetSemaphoreCounterValueKHR (VkDevice device, VkSemaphore semaphore, uint64_t * pValue) const noexcept								{ return _table->_var_vkGetSemaphoreCounterValueKHR( device, semaphore, pValue ); }
+	ND_ VKAPI_ATTR forceinline VkResult vkWaitSemaphoresKHR (VkDevice device, const VkSemaphoreWaitInfoKHR * pWaitInfo, uint64_t timeout) const noexcept								{ return _table->_var_vkWaitSemaphoresKHR( device, pWaitInfo, timeout ); }
+	ND_ VKAPI_ATTR forceinline VkResult vkSignalSemaphoreKHR (VkDevice device, const VkSemaphoreSignalInfoKHR * pSignalInfo) const noexcept								{ return _table->_var_vkSignalSemaphoreKHR( device, pSignalInfo ); }
+# endif // VK_KHR_timeline_semaphore
+
+
 # ifdef VULKAN_WIN32_H_
 	ND_ VKAPI_ATTR forceinline VkResult vkImportSemaphoreWin32HandleKHR (VkDevice device, const VkImportSemaphoreWin32HandleInfoKHR * pImportSemaphoreWin32HandleInfo) const noexcept								{ return _table->_var_vkImportSemaphoreWin32HandleKHR( device, pImportSemaphoreWin32HandleInfo ); }
 	ND_ VKAPI_ATTR forceinline VkResult vkImportFenceWin32HandleKHR (VkDevice device, const VkImportFenceWin32HandleInfoKHR * pImportFenceWin32HandleInfo) const noexcept								{ return _table->_var_vkImportFenceWin32HandleKHR( device, pImportFenceWin32HandleInfo ); }
@@ -1053,6 +1074,13 @@
 	VKAPI_ATTR VkResult VKAPI_CALL Dummy_vkGetSwapchainCounterEXT (VkDevice , VkSwapchainKHR , VkSurfaceCounterFlagBitsEXT , uint64_t * )			{  FG_LOGI( "used dummy function 'vkGetSwapchainCounterEXT'" );  return VkResult(~0u);  }
 
 
+# ifdef VK_KHR_timeline_semaphore
+	VKAPI_ATTR VkResult VKAPI_CALL Dummy_vkGetSemaphoreCounterValueKHR (VkDevice , VkSemaphore , uint64_t * )			{  FG_LOGI( "used dummy function 'vkGetSemaphoreCounterValueKHR'" );  return VkResult(~0u);  }
+	VKAPI_ATTR VkResult VKAPI_CALL Dummy_vkWaitSemaphoresKHR (VkDevice , const VkSemaphoreWaitInfoKHR * , uint64_t )			{  FG_LOGI( "used dummy function 'vkWaitSemaphoresKHR'" );  return VkResult(~0u);  }
+	VKAPI_ATTR VkResult VKAPI_CALL Dummy_vkSignalSemaphoreKHR (VkDevice , const VkSemaphoreSignalInfoKHR * )			{  FG_LOGI( "used dummy function 'vkSignalSemaphoreKHR'" );  return VkResult(~0u);  }
+# endif // VK_KHR_timeline_semaphore
+
+
 # ifdef VULKAN_WIN32_H_
 	VKAPI_ATTR VkResult VKAPI_CALL Dummy_vkImportSemaphoreWin32HandleKHR (VkDevice , const VkImportSemaphoreWin32HandleInfoKHR * )			{  FG_LOGI( "used dummy function 'vkImportSemaphoreWin32HandleKHR'" );  return VkResult(~0u);  }
 	VKAPI_ATTR VkResult VKAPI_CALL Dummy_vkImportFenceWin32HandleKHR (VkDevice , const VkImportFenceWin32HandleInfoKHR * )			{  FG_LOGI( "used dummy function 'vkImportFenceWin32HandleKHR'" );  return VkResult(~0u);  }
@@ -1321,6 +1349,13 @@
 	Load( OUT table._var_vkGetSwapchainCounterEXT, "vkGetSwapchainCounterEXT", Dummy_vkGetSwapchainCounterEXT );
 
 
+# ifdef VK_KHR_timeline_semaphore
+	Load( OUT table._var_vkGetSemaphoreCounterValueKHR, "vkGetSemaphoreCounterValueKHR", Dummy_vkGetSemaphoreCounterValueKHR );
+	Load( OUT table._var_vkWaitSemaphoresKHR, "vkWaitSemaphoresKHR", Dummy_vkWaitSemaphoresKHR );
+	Load( OUT table._var_vkSignalSemaphoreKHR, "vkSignalSemaphoreKHR", Dummy_vkSignalSemaphoreKHR );
+# endif // VK_KHR_timeline_semaphore
+
+
 # ifdef VULKAN_WIN32_H_
 	Load( OUT table._var_vkImportSemaphoreWin32HandleKHR, "vkImportSemaphoreWin32HandleKHR", Dummy_vkImportSemaphoreWin32HandleKHR );
 	Load( OUT table._var_vkImportFenceWin32HandleKHR, "vkImportFenceWin32HandleKHR", Dummy_vkImportFenceWin32HandleKHR );
@@ -9,6 +9,8 @@
 #include "framegraph/Public/FrameGraphDrawTask.h"
 #include "framegraph/Public/DrawCommandBuffer.h"
 #include "framegraph/Public/RenderPassDesc.h"
+#include "framegraph/Public/BufferDesc.h"
+#include "framegraph/Public/ImageDesc.h"
 #include "framegraph/Public/CommandBufferPtr.h"
 #include "framegraph/Public/FGEnums.h"
 
@@ -28,6 +30,7 @@ namespace FG
 		//bool			immutableResources			= true;		// all resources except render targets and storage buffer/image will be immutable
 		//bool			submitImmediately			= true;		// set 'false' to merge commands into some betches
 		EDebugFlags		debugFlags					= Default;
+		uint			recordingThreads			= 0;		// independent transfer task chains will be recorded into secondary command buffers in parallel
 		StringView		name;
 		
 				 CommandBufferDesc () {}
@@ -37,6 +40,7 @@ namespace FG
 		CommandBufferDesc&  SetHostReadableBufferSize (BytesU value)		{ hostReadableBufferSize = value;  return *this; }
 		CommandBufferDesc&  SetHostWritableBufferUsage (EBufferUsage value)	{ hostWritebleBufferUsage = value;  return *this; }
 		CommandBufferDesc&  SetDebugFlags (EDebugFlags value)				{ debugFlags = value;  return *this; }
+		CommandBufferDesc&  SetRecordingThreads (uint value)				{ recordingThreads = value;  return *this; }
 		CommandBufferDesc&  SetDebugName (StringView value)					{ name = value;  return *this; }
 	};
 
@@ -80,6 +84,23 @@ namespace FG
 			// Buffer may be in immutable or mutable state, immutable state disables barrier placement that increases CPU performance.
 			virtual void		AcquireBuffer (RawBufferID id, bool makeMutable) = 0;
 
+			// Allocate space in the staging buffer and add task that copies it to the buffer range.
+			// Data must be written to 'mapped' memory before command buffer execution, this avoids additional copy in 'UpdateBuffer'.
+			// 'size' must not exceed staging ring capacity and 'hostWritableBufferSize', 'mapped' is null on failure.
+		ND_ virtual Task		MapBufferUpdate (RawBufferID dstBuffer, BytesU offset, BytesU size, OUT void* &mapped, ArrayView<Task> dependsOn = Default) = 0;
+
+			// Allocate space in the staging buffer and add task that copies it to the image region.
+			// Data must be written to 'mapped' memory with returned row and slice pitch before command buffer execution.
+			// Total size has the same limits as in 'MapBufferUpdate', 'mapped' is null and pitches are zero on failure.
+		ND_ virtual Task		MapImageUpdate (RawImageID dstImage, const int3 &offset, const uint3 &size, MipmapLevel mipmap, ImageLayer layer, EImageAspect aspect,
+												OUT void* &mapped, OUT BytesU &rowPitch, OUT BytesU &slicePitch, ArrayView<Task> dependsOn = Default) = 0;
+
+			// Create image or buffer that exists only inside current command buffer.
+			// Memory is bound when command buffer is executed, resources with non-overlapping lifetime share the same memory,
+			// so content is undefined before first use. Resource is released after execution, do not use it in any other command buffers.
+		ND_ virtual RawImageID	CreateTransientImage (const ImageDesc &desc, StringView dbgName = Default) = 0;
+		ND_ virtual RawBufferID	CreateTransientBuffer (const BufferDesc &desc, StringView dbgName = Default) = 0;
+
 		// tasks //
 		ND_ virtual Task		AddTask (const SubmitRenderPass &) = 0;
 		ND_ virtual Task		AddTask (const DispatchCompute &) = 0;
@@ -114,8 +135,11 @@ namespace FG
 			// Create render pass.
 		ND_ virtual LogicalPassID  CreateRenderPass (const RenderPassDesc &desc) = 0;
 
-			// Create render pass and begin recording to the secondary buffer.
-		//ND_ virtual CommandBuffer2 BeginSecondary (const RenderPassDesc &desc) = 0;	// TODO
+			// Begin recording draw tasks of the render pass into the secondary command buffer.
+			// Each secondary command buffer can be filled on a separate thread, but current command buffer
+			// must not be used until all secondaries are filled. Draw tasks can not be added directly to this render pass.
+			// Returned pointer is valid until command buffer execution.
+		ND_ virtual IDrawCommandBuffer*  BeginSecondary (LogicalPassID) = 0;
 
 			// Add task to the render pass.
 			virtual void		AddTask (LogicalPassID, const DrawVertices &) = 0;
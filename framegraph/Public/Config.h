@@ -32,6 +32,7 @@ namespace FG
 	
 	// memory
 	static constexpr unsigned	FG_VkDevicePageSizeMb		= 64;
+	static constexpr unsigned	FG_StagingRingSizeMb		= 64;	// for each of host-to-device and device-to-host rings
 
 # else
 
@@ -51,6 +52,7 @@ namespace FG
 
 	// memory
 	static constexpr unsigned	FG_VkDevicePageSizeMb		= 256;
+	static constexpr unsigned	FG_StagingRingSizeMb		= 256;	// for each of host-to-device and device-to-host rings
 
 # endif
 
@@ -66,6 +68,7 @@ namespace FG
 
 	// queue
 	static constexpr unsigned	FG_MaxQueueFamilies			= 32;
+	static constexpr bool		FG_EnableTimelineSemaphore	= true;	// used if 'VulkanDeviceInfo::timelineSemaphore' is set, otherwise fences and binary semaphores are used
 
 	// task
 	static constexpr unsigned	FG_MaxTaskDependencies		= 8;
@@ -75,6 +78,11 @@ namespace FG
 	static constexpr unsigned	FG_MaxResolveRegions		= 8;
 
 
+	// command buffer
+	static constexpr unsigned	FG_MaxRecordingThreads		= 8;
+	static constexpr unsigned	FG_MaxSecondaryCmdBuffers	= 64;	// per command buffer, for all render passes and transfer workers
+
+
 }	// FG
 
 
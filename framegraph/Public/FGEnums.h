@@ -49,4 +49,14 @@ namespace FG
 	FG_BIT_OPERATORS( EDebugFlags );
 
 
+	enum class EDrawOrder : uint
+	{
+		Submission,					// draw tasks are executed in the same order as they were added
+		MinimizeStateChanges,		// (optimization) draw tasks are sorted by pipeline, descriptor sets and vertex buffers,
+									// custom draw tasks are not reordered and split the draw list into independent parts.
+		Unknown		= ~0u,
+		Default		= Submission,
+	};
+
+
 }	// FG
@@ -39,13 +39,17 @@ namespace FG
 		struct RenderingStatistics
 		{
 			uint		descriptorBinds				= 0;
+			uint		descriptorBindsSkipped		= 0;	// descriptor sets that are already bound
 			uint		pushConstants				= 0;
-			uint		pipelineBarriers			= 0;
+			uint		pipelineBarriers			= 0;	// barriers passed to the driver, after merging
+			uint		pipelineBarriersBeforeMerge	= 0;
 			uint		transferOps					= 0;
 
 			uint		indexBufferBindings			= 0;
 			uint		vertexBufferBindings		= 0;
+			uint		vertexBufferBindingsSkipped	= 0;	// vertex buffers that are already bound
 			uint		drawCalls					= 0;
+			uint		drawCallsSkipped			= 0;	// draw tasks with pipeline that is not created yet
 			uint		graphicsPipelineBindings	= 0;
 			uint		dynamicStateChanges			= 0;
 
@@ -56,6 +60,9 @@ namespace FG
 			uint		traceRaysCalls				= 0;
 			uint		buildASCalls				= 0;
 
+			uint		queueSubmits				= 0;	// 'vkQueueSubmit' calls
+			uint		submittedBatches			= 0;	// command batches, each batch is a separate 'VkSubmitInfo'
+
 			Nanoseconds	gpuTime						{0};	// for (currentFrame - ringBufferSize)
 			Nanoseconds	cpuTime						{0};	// for (currentFrame - ringBufferSize)
 		};
@@ -65,6 +72,10 @@ namespace FG
 			uint		newGraphicsPipelineCount	= 0;
 			uint		newComputePipelineCount		= 0;
 			uint		newRayTracingPipelineCount	= 0;
+			uint		pipelineCacheHits			= 0;	// new pipelines that are found in the pipeline cache, requires 'VulkanDeviceInfo::creationFeedback'
+			uint		transientResources			= 0;
+			BytesU		transientMemoryRequired;			// sum of transient resource sizes
+			BytesU		transientMemoryAllocated;			// memory that is allocated for transient resources, the rest is saved by aliasing
 		};
 
 		struct Statistics
@@ -95,6 +106,24 @@ namespace FG
 			// calling 'Task::EnableDebugTrace' and shader compiled with 'EShaderLangFormat::EnableDebugTrace' flag.
 			virtual bool			SetShaderDebugCallback (ShaderDebugCallback_t &&) = 0;
 
+			// Set file that is used as persistent pipeline cache.
+			// Cache is loaded immediately if file exists and was created for the same device and driver version,
+			// otherwise returns false and the file will be replaced.
+			// Cache will be saved in 'Deinitialize' or to the previous file when the file is changed,
+			// pass empty string to save the cache and stop using the file.
+			// Must not be called while command buffers are executed.
+			virtual bool			SetPipelineCacheFile (StringView filename) = 0;
+
+			// Write all instances of alive graphics pipelines (render pass, render state, vertex input) to the file.
+			// File is valid only for the same build of application and framegraph.
+			// Must not be called while command buffers are executed.
+			virtual bool			SavePipelinePermutations (StringView filename) = 0;
+
+			// Create pipeline instances from the recorded permutations to avoid hitches on first draw calls.
+			// Graphics pipelines are matched by shader sources, so they must be created before this call.
+			// Blocks until all instances are created, must not be called while command buffers are executed.
+			virtual bool			PrewarmPipelines (StringView filename) = 0;
+
 			// Returns device info with which framegraph has been crated.
 		ND_ virtual DeviceInfo_t	GetDeviceInfo () const = 0;
 
@@ -110,6 +139,13 @@ namespace FG
 		ND_ virtual RTPipelineID	CreatePipeline (INOUT RayTracingPipelineDesc &desc) = 0;
 		ND_ virtual GPipelineID		CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName = Default) = 0;
 		ND_ virtual CPipelineID		CreatePipeline (INOUT ComputePipelineDesc &desc, StringView dbgName = Default) = 0;
+
+			// Returns pipeline ID immediately, shaders are compiled and pipeline is created on the background thread.
+			// Draw tasks that use pipeline which is not ready yet are skipped, see 'RenderingStatistics::drawCallsSkipped'.
+			// If creation failed then pipeline will never be ready, but ID must be released anyway.
+		ND_ virtual GPipelineID		CreatePipelineAsync (const GraphicsPipelineDesc &desc, StringView dbgName = Default) = 0;
+		ND_ virtual bool			IsPipelineReady (RawGPipelineID id) const = 0;
+
 		ND_ virtual ImageID			CreateImage (const ImageDesc &desc, const MemoryDesc &mem = Default, StringView dbgName = Default) = 0;
 		ND_ virtual BufferID		CreateBuffer (const BufferDesc &desc, const MemoryDesc &mem = Default, StringView dbgName = Default) = 0;
 		ND_ virtual ImageID			CreateImage (const ExternalImageDesc_t &desc, OnExternalImageReleased_t &&, StringView dbgName = Default) = 0;
@@ -170,6 +206,7 @@ namespace FG
 			virtual bool			Flush (EQueueUsage queues = EQueueUsage::All) = 0;
 
 			// Wait until all commands will complete their work on GPU, trigger events for 'ReadImage' and 'ReadBuffer' tasks.
+			// Also waits for asynchronous callbacks that are called on the completion thread.
 			virtual bool			WaitIdle () = 0;
 
 
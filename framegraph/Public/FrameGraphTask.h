@@ -5,6 +5,7 @@
 #include "framegraph/Public/PipelineResources.h"
 #include "framegraph/Public/BufferView.h"
 #include "framegraph/Public/ImageView.h"
+#include "framegraph/Public/Readback.h"
 #include "framegraph/Public/SamplerEnums.h"
 #include "framegraph/Public/RayTracingGeometryDesc.h"
 #include "framegraph/Public/RayTracingSceneDesc.h"
@@ -714,6 +715,7 @@ namespace FG
 		BytesU			offset;
 		BytesU			size;
 		Callback_t		callback;
+		bool			asyncCallback	= false;	// if 'true' then callback is called on the frame graph completion thread
 
 	// methods
 		ReadBuffer () :
@@ -731,9 +733,23 @@ namespace FG
 		template <typename FN>
 		ReadBuffer&  SetCallback (FN &&value)
 		{
-			callback = std::move(value);
+			callback		= std::move(value);
+			asyncCallback	= false;
 			return *this;
 		}
+
+		template <typename FN>
+		ReadBuffer&  SetAsyncCallback (FN &&value)
+		{
+			callback		= std::move(value);
+			asyncCallback	= true;
+			return *this;
+		}
+
+		ReadBuffer&  SetFuture (OUT BufferReadback &result)
+		{
+			return SetAsyncCallback( result._CreateCallback() );
+		}
 	};
 
 
@@ -836,6 +852,7 @@ namespace FG
 		MipmapLevel		mipmapLevel;
 		EImageAspect	aspectMask	= EImageAspect::Color;	// must only have a single bit set
 		Callback_t		callback;
+		bool			asyncCallback	= false;	// if 'true' then callback is called on the frame graph completion thread
 
 		
 	// methods
@@ -876,9 +893,23 @@ namespace FG
 		template <typename FN>
 		ReadImage&  SetCallback (FN &&value)
 		{
-			callback = std::move(value);
+			callback		= std::move(value);
+			asyncCallback	= false;
 			return *this;
 		}
+
+		template <typename FN>
+		ReadImage&  SetAsyncCallback (FN &&value)
+		{
+			callback		= std::move(value);
+			asyncCallback	= true;
+			return *this;
+		}
+
+		ReadImage&  SetFuture (OUT ImageReadback &result)
+		{
+			return SetAsyncCallback( result._CreateCallback() );
+		}
 	};
 
 
@@ -36,6 +36,7 @@ namespace FG
 		size_t				_slicePitch		= 0;
 		uint				_bitsPerPixel	= 0;
 		EPixelFormat		_format			= Default;
+		EImageAspect		_aspect			= Default;
 		LoadRGBA32fFun_t	_loadF4			= null;
 		LoadRGBA32uFun_t	_loadU4			= null;
 		LoadRGBA32iFun_t	_loadI4			= null;
@@ -62,6 +63,7 @@ namespace FG
 		ND_ BytesU					RowSize ()		const	{ return BytesU(_dimension.x * _bitsPerPixel) / 8; }
 		ND_ BytesU					SliseSize ()	const	{ return BytesU(_rowPitch * _dimension.y); }
 		ND_ EPixelFormat			Format ()		const	{ return _format; }
+		ND_ EImageAspect			Aspect ()		const	{ return _aspect; }
 
 
 		// implementation garanties that single row completely placed to solid memory block.
@@ -0,0 +1,187 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Future-like handle for 'ReadBuffer' and 'ReadImage' tasks.
+	Data is copied from the staging memory on the frame graph completion thread,
+	handle becomes ready when command batch complete execution on the GPU.
+*/
+
+#pragma once
+
+#include "framegraph/Public/BufferView.h"
+#include "framegraph/Public/ImageView.h"
+#include <condition_variable>
+#include <functional>
+
+namespace FG
+{
+	namespace _fg_hidden_
+	{
+		//
+		// Readback Future
+		//
+		template <typename ViewType>
+		class ReadbackFuture
+		{
+		// types
+		public:
+			using View_t			= ViewType;
+			using Continuation_t	= std::function< void (const View_t &) >;
+
+		protected:
+			struct State
+			{
+				std::mutex					guard;
+				std::condition_variable		cv;
+				Array< uint8_t >			data;
+				ArrayView< uint8_t >		part;			// 'data' as a single part of the view
+				View_t						view;
+				Array< Continuation_t >		continuations;
+				bool						ready	= false;
+			};
+
+
+		// variables
+		protected:
+			SharedPtr< State >		_state;
+
+
+		// methods
+		public:
+			ReadbackFuture () {}
+
+			ND_ bool  IsValid () const
+			{
+				return _state != null;
+			}
+
+			ND_ bool  IsReady () const
+			{
+				CHECK_ERR( _state );
+				std::unique_lock	lock{ _state->guard };
+				return _state->ready;
+			}
+
+			void  Wait () const
+			{
+				CHECK_ERR( _state, void());
+				std::unique_lock	lock{ _state->guard };
+				_state->cv.wait( lock, [this] () { return _state->ready; });
+			}
+
+			template <typename Rep, typename Period>
+			ND_ bool  WaitFor (const std::chrono::duration<Rep, Period> &timeout) const
+			{
+				CHECK_ERR( _state );
+				std::unique_lock	lock{ _state->guard };
+				return _state->cv.wait_for( lock, timeout, [this] () { return _state->ready; });
+			}
+
+			// blocks until data is ready, view is valid while handle is alive.
+			ND_ View_t const&  Get () const
+			{
+				Wait();
+				return _state->view;
+			}
+
+			// continuation is called on the completion thread,
+			// or immediately if data is already ready.
+			void  Then (Continuation_t &&fn) const
+			{
+				CHECK_ERR( _state and fn, void());
+				std::unique_lock	lock{ _state->guard };
+
+				if ( not _state->ready ) {
+					_state->continuations.push_back( std::move(fn) );
+					return;
+				}
+
+				lock.unlock();
+				fn( _state->view );
+			}
+
+		protected:
+			ND_ static SharedPtr<State>  _CreateState ()
+			{
+				return MakeShared<State>();
+			}
+
+			// copy data into the state and wake up waiting threads.
+			template <typename FN>
+			static void  _Resolve (State &state, const BufferView &src, FN &&createView)
+			{
+				Array< Continuation_t >		continuations;
+				{
+					std::unique_lock	lock{ state.guard };
+					ASSERT( not state.ready );
+
+					state.data.resize( src.size() );
+
+					size_t	pos = 0;
+					for (auto& part : src.Parts())
+					{
+						std::memcpy( state.data.data() + pos, part.data(), part.size() );
+						pos += part.size();
+					}
+
+					state.part	= state.data;
+					state.view	= createView( ArrayView< ArrayView<uint8_t> >{ &state.part, 1 });
+					state.ready	= true;
+
+					std::swap( continuations, state.continuations );
+				}
+				state.cv.notify_all();
+
+				for (auto& fn : continuations) {
+					fn( state.view );
+				}
+			}
+		};
+
+	}	// _fg_hidden_
+
+
+
+	//
+	// Buffer Readback
+	//
+	class BufferReadback final : public _fg_hidden_::ReadbackFuture< BufferView >
+	{
+		friend struct ReadBuffer;
+
+	private:
+		ND_ std::function< void (BufferView) >  _CreateCallback ()
+		{
+			_state = _CreateState();
+
+			return [state = _state] (const BufferView &view)
+			{
+				_Resolve( *state, view, [] (ArrayView<ArrayView<uint8_t>> parts) { return BufferView{ parts }; });
+			};
+		}
+	};
+
+
+
+	//
+	// Image Readback
+	//
+	class ImageReadback final : public _fg_hidden_::ReadbackFuture< ImageView >
+	{
+		friend struct ReadImage;
+
+	private:
+		ND_ std::function< void (const ImageView &) >  _CreateCallback ()
+		{
+			_state = _CreateState();
+
+			return [state = _state] (const ImageView &view)
+			{
+				_Resolve( *state, BufferView{ view.Parts() }, [&view] (ArrayView<ArrayView<uint8_t>> parts) {
+							return ImageView{ parts, view.Dimension(), view.RowPitch(), view.SlicePitch(), view.Format(), view.Aspect() };
+						});
+			};
+		}
+	};
+
+
+}	// FG
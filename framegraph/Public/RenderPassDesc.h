@@ -5,6 +5,7 @@
 #include "framegraph/Public/RenderState.h"
 #include "framegraph/Public/ImageDesc.h"
 #include "framegraph/Public/PipelineResources.h"
+#include "framegraph/Public/FGEnums.h"
 
 namespace FG
 {
@@ -62,6 +63,7 @@ namespace FG
 
 		bool						parallelExecution	= true;		// (optimization) if 'false' all draw and compute tasks will be executed in initial order
 		bool						canBeMerged			= true;		// (optimization) g-buffer render passes can be merged, but don't merge conditional passes
+		EDrawOrder					drawOrder			= Default;
 		// TODO: push constants, specialization constants
 
 
@@ -154,6 +156,8 @@ namespace FG
 
 		RenderPassDesc&  SetShadingRateImage (RawImageID image, ImageLayer layer = Default, MipmapLevel level = Default);
 		
+		RenderPassDesc&  SetDrawOrder (EDrawOrder value);
+		
 		RenderPassDesc&  AddResources (const DescriptorSetID &id, const PipelineResources *res);
 	};
 
@@ -529,6 +533,18 @@ namespace FG
 		return *this;
 	}
 	
+/*
+=================================================
+	SetDrawOrder
+=================================================
+*/
+	inline RenderPassDesc&  RenderPassDesc::SetDrawOrder (EDrawOrder value)
+	{
+		ASSERT( value != EDrawOrder::Unknown );
+		drawOrder = value;
+		return *this;
+	}
+	
 /*
 =================================================
 	AddResources
@@ -59,6 +59,8 @@ namespace FG
 		PhysicalDeviceVk_t	physicalDevice		= null;
 		DeviceVk_t			device				= null;
 		Queues_t			queues;
+		bool				timelineSemaphore	= false;	// set if device is created with 'VK_KHR_timeline_semaphore' extension and 'timelineSemaphore' feature
+		bool				creationFeedback	= false;	// set if device is created with 'VK_EXT_pipeline_creation_feedback' extension
 	};
 
 
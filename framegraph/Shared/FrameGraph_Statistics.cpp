@@ -13,13 +13,17 @@ namespace FG
 	inline void MergeRenderStatistic (const IFrameGraph::RenderingStatistics &src, INOUT IFrameGraph::RenderingStatistics &dst)
 	{
 		dst.descriptorBinds				+= src.descriptorBinds;
+		dst.descriptorBindsSkipped		+= src.descriptorBindsSkipped;
 		dst.pushConstants				+= src.pushConstants;
 		dst.pipelineBarriers			+= src.pipelineBarriers;
+		dst.pipelineBarriersBeforeMerge	+= src.pipelineBarriersBeforeMerge;
 		dst.transferOps					+= src.transferOps;
 
 		dst.indexBufferBindings			+= src.indexBufferBindings;
 		dst.vertexBufferBindings		+= src.vertexBufferBindings;
+		dst.vertexBufferBindingsSkipped	+= src.vertexBufferBindingsSkipped;
 		dst.drawCalls					+= src.drawCalls;
+		dst.drawCallsSkipped			+= src.drawCallsSkipped;
 		dst.graphicsPipelineBindings	+= src.graphicsPipelineBindings;
 		dst.dynamicStateChanges			+= src.dynamicStateChanges;
 		
@@ -30,6 +34,9 @@ namespace FG
 		dst.traceRaysCalls				+= src.traceRaysCalls;
 		dst.buildASCalls				+= src.buildASCalls;
 
+		dst.queueSubmits				+= src.queueSubmits;
+		dst.submittedBatches			+= src.submittedBatches;
+
 		dst.gpuTime						+= src.gpuTime;
 		dst.cpuTime						+= src.cpuTime;
 	}
@@ -44,6 +51,10 @@ namespace FG
 		dst.newComputePipelineCount		+= src.newComputePipelineCount;
 		dst.newGraphicsPipelineCount	+= src.newGraphicsPipelineCount;
 		dst.newRayTracingPipelineCount	+= src.newRayTracingPipelineCount;
+		dst.pipelineCacheHits			+= src.pipelineCacheHits;
+		dst.transientResources			+= src.transientResources;
+		dst.transientMemoryRequired		+= src.transientMemoryRequired;
+		dst.transientMemoryAllocated	+= src.transientMemoryAllocated;
 	}
 
 /*
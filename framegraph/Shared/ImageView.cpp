@@ -271,9 +271,8 @@ namespace {
 	ImageView::ImageView (ArrayView<ArrayView<T>> parts, const uint3 &dim, BytesU rowPitch, BytesU slicePitch, EPixelFormat format, EImageAspect aspect) :
 		_parts{ parts },				_dimension{ dim },
 		_rowPitch{ size_t(rowPitch) },	_slicePitch{ size_t(slicePitch) },
-		_format{ format }
+		_format{ format },				_aspect{ aspect }
 	{
-		FG_UNUSED( aspect );
 		ENABLE_ENUM_CHECKS();
 		switch ( _format )
 		{
@@ -0,0 +1,241 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Sorted array of non-overlapping ranges, used to track state of buffer regions and image subresources.
+	Lookup is a binary search, replacing or erasing range splits boundary records
+	and removes all covered records with single memmove,
+	then adjacent records with equal state are merged to keep the map small.
+
+	Record type must have 'range' field of 'ResourceDataRange<T>' type
+	and 'bool HasEqualState (const Record &) const' method that compares all fields except 'range'.
+*/
+
+#pragma once
+
+#include "framegraph/Shared/ResourceDataRange.h"
+#include "stl/Containers/SmallArray.h"
+
+namespace FG
+{
+
+	//
+	// Resource Range Map
+	//
+
+	template <typename Record, size_t InlineSize>
+	struct ResourceRangeMap
+	{
+	// types
+	public:
+		using Records_t			= SmallArray< Record, InlineSize >;
+		using Range_t			= decltype(Record::range);
+		using iterator			= typename Records_t::iterator;
+		using const_iterator	= typename Records_t::const_iterator;
+		using Self				= ResourceRangeMap< Record, InlineSize >;
+
+
+	// variables
+	private:
+		Records_t		_records;
+
+
+	// methods
+	public:
+		ResourceRangeMap () {}
+
+			void  SetAllocator (LinearAllocator<> &alloc)		{ _records.SetAllocator( alloc ); }
+
+		ND_ operator ArrayView<Record> ()				const	{ return _records; }
+
+		ND_ size_t			size ()						const	{ return _records.size(); }
+		ND_ bool			empty ()					const	{ return _records.empty(); }
+
+		ND_ Record &		front ()							{ return _records.front(); }
+		ND_ Record const&	front ()					const	{ return _records.front(); }
+
+		ND_ iterator		begin ()							{ return _records.begin(); }
+		ND_ const_iterator	begin ()					const	{ return _records.begin(); }
+		ND_ iterator		end ()								{ return _records.end(); }
+		ND_ const_iterator	end ()						const	{ return _records.end(); }
+
+			void			push_back (const Record &value)		{ ASSERT( empty() or _records.back().range.end <= value.range.begin );  _records.push_back( value ); }
+			iterator		insert (const_iterator pos, const Record &value)	{ return _records.insert( pos, value ); }
+			void			clear ()							{ _records.clear(); }
+
+		ND_ iterator		FindFirst (const Range_t &range);
+			iterator		Replace (iterator first, const Record &value);
+			iterator		Erase (iterator first, const Range_t &range);
+
+	private:
+			iterator		_Splice (iterator first, const Range_t &range, const Record *value);
+			bool			_MergeWithNext (size_t index);
+	};
+
+
+
+/*
+=================================================
+	FindFirst
+----
+	returns first record that intersects or touches the range
+=================================================
+*/
+	template <typename R, size_t I>
+	inline typename ResourceRangeMap<R,I>::iterator
+		ResourceRangeMap<R,I>::FindFirst (const Range_t &range)
+	{
+		size_t	left	= 0;
+		size_t	right	= _records.size();
+
+		for (; left < right; )
+		{
+			size_t	mid = (left + right) >> 1;
+
+			if ( _records[mid].range.end < range.begin )
+				left = mid + 1;
+			else
+				right = mid;
+		}
+
+		if ( left < _records.size() and _records[left].range.end >= range.begin )
+			return _records.begin() + left;
+
+		return _records.end();
+	}
+
+/*
+=================================================
+	Replace
+----
+	'first' must be result of 'FindFirst' for the same range.
+	returns iterator to the record that contains inserted value.
+=================================================
+*/
+	template <typename R, size_t I>
+	inline typename ResourceRangeMap<R,I>::iterator
+		ResourceRangeMap<R,I>::Replace (iterator first, const R &value)
+	{
+		return _Splice( first, value.range, &value );
+	}
+
+/*
+=================================================
+	Erase
+----
+	'first' must be result of 'FindFirst' for the same range.
+	returns iterator to the first record after range.
+=================================================
+*/
+	template <typename R, size_t I>
+	inline typename ResourceRangeMap<R,I>::iterator
+		ResourceRangeMap<R,I>::Erase (iterator first, const Range_t &range)
+	{
+		return _Splice( first, range, null );
+	}
+
+/*
+=================================================
+	_Splice
+----
+	replaces all records in 'range' by 'value' (or by nothing),
+	records on the range boundaries are cut,
+	then adjacent records with equal state are merged, including neighbours on both boundaries.
+
+	  |1111|2222|33333|		+
+	     |vvvvvvvvv|		=
+	  |11|vvvvvvvvv|333|
+
+	  |1111|2222|		+
+	     |1111|		=
+	  |1111111|22|
+=================================================
+*/
+	template <typename R, size_t I>
+	inline typename ResourceRangeMap<R,I>::iterator
+		ResourceRangeMap<R,I>::_Splice (iterator first, const Range_t &range, const R *value)
+	{
+		ASSERT( first >= _records.begin() and first <= _records.end() );
+
+		// skip record that only touches the range
+		if ( first != _records.end() and first->range.end <= range.begin )
+			++first;
+
+		iterator	last = first;
+		for (; last != _records.end() and last->range.begin < range.end; ++last) {}
+
+		// build new records
+		R		new_records[3];
+		uint	count	= 0;
+
+		if ( first != last and first->range.begin < range.begin )
+		{
+			new_records[count] = *first;
+			new_records[count].range.end = range.begin;
+			++count;
+		}
+
+		const uint	result_pos = count;
+
+		if ( value )
+			new_records[count++] = *value;
+
+		if ( first != last and (last-1)->range.end > range.end )
+		{
+			new_records[count] = *(last-1);
+			new_records[count].range.begin = range.end;
+			++count;
+		}
+
+		// replace records in single pass
+		const size_t	index		= size_t(first - _records.begin());
+		const size_t	old_count	= size_t(last - first);
+		const size_t	common		= Min( old_count, size_t(count) );
+
+		for (size_t i = 0; i < common; ++i) {
+			first[i] = new_records[i];
+		}
+
+		if ( old_count > count )
+			_records.erase( first + common, last );
+		else
+		if ( count > old_count )
+			_records.insert( first + common, new_records + common, new_records + count );
+
+		// merge new records with each other and with neighbours,
+		// from right to left to keep indices valid
+		size_t	result = index + result_pos;
+
+		for (size_t i = index + count; i > 0 and i >= index; --i)
+		{
+			if ( _MergeWithNext( i-1 ) and result >= i )
+				--result;
+		}
+
+		return _records.begin() + result;
+	}
+
+/*
+=================================================
+	_MergeWithNext
+----
+	merges record with the next one if they touch and have equal state.
+=================================================
+*/
+	template <typename R, size_t I>
+	inline bool  ResourceRangeMap<R,I>::_MergeWithNext (size_t index)
+	{
+		if ( index + 1 >= _records.size() )
+			return false;
+
+		R &			lhs = _records[index];
+		R const&	rhs = _records[index+1];
+
+		if ( lhs.range.end != rhs.range.begin or not lhs.HasEqualState( rhs ) )
+			return false;
+
+		lhs.range.end = rhs.range.end;
+		_records.erase( _records.begin() + index + 1 );
+		return true;
+	}
+
+
+}	// FG
@@ -72,8 +72,43 @@ namespace FG
 		CHECK_ERR( not _memoryId );
 		CHECK_ERR( not desc.isExternal );
 
-		_desc		= desc;
-		_memoryId	= MemoryID{ memId };
+		_memoryId = MemoryID{ memId };
+
+		CHECK_ERR( _CreateBuffer( resMngr.GetDevice(), desc, queueFamilyMask, dbgName ));
+		CHECK_ERR( memObj.AllocateForBuffer( resMngr.GetMemoryManager(), _buffer ));
+
+		return true;
+	}
+	
+/*
+=================================================
+	CreateTransient
+----
+	memory will be bound later, buffer may share memory
+	with other transient resources.
+=================================================
+*/
+	bool VBuffer::CreateTransient (VResourceManager &resMngr, const BufferDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _buffer == VK_NULL_HANDLE );
+		CHECK_ERR( not _memoryId );
+		CHECK_ERR( not desc.isExternal );
+
+		CHECK_ERR( _CreateBuffer( resMngr.GetDevice(), desc, queueFamilyMask, dbgName ));
+
+		_isTransient = true;
+		return true;
+	}
+	
+/*
+=================================================
+	_CreateBuffer
+=================================================
+*/
+	bool VBuffer::_CreateBuffer (const VDevice &dev, const BufferDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName)
+	{
+		_desc = desc;
 
 		// create buffer
 		VkBufferCreateInfo	info = {};
@@ -108,11 +143,8 @@ namespace FG
 			info.queueFamilyIndexCount	= 0;
 		}
 
-		auto&	dev = resMngr.GetDevice();
 		VK_CHECK( dev.vkCreateBuffer( dev.GetVkDevice(), &info, null, OUT &_buffer ));
 
-		CHECK_ERR( memObj.AllocateForBuffer( resMngr.GetMemoryManager(), _buffer ));
-
 		if ( not dbgName.empty() )
 		{
 			dev.SetObjectName( BitCast<uint64_t>(_buffer), dbgName, VK_OBJECT_TYPE_BUFFER );
@@ -125,6 +157,43 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	GetMemoryRequirements
+=================================================
+*/
+	VkMemoryRequirements  VBuffer::GetMemoryRequirements (const VDevice &dev) const
+	{
+		SHAREDLOCK( _drCheck );
+
+		VkMemoryRequirements	mem_req = {};
+		dev.vkGetBufferMemoryRequirements( dev.GetVkDevice(), _buffer, OUT &mem_req );
+		return mem_req;
+	}
+	
+/*
+=================================================
+	BindMemory
+----
+	'offset' is relative to the memory object.
+=================================================
+*/
+	bool VBuffer::BindMemory (VResourceManager &resMngr, RawMemoryID memId, const VMemoryObj &memObj, BytesU offset)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _buffer and _isTransient );
+		CHECK_ERR( not _memoryId );
+
+		VMemoryObj::MemoryInfo	info;
+		CHECK_ERR( memObj.GetInfo( resMngr.GetMemoryManager(), OUT info ));
+
+		auto&	dev = resMngr.GetDevice();
+		VK_CHECK( dev.vkBindBufferMemory( dev.GetVkDevice(), _buffer, info.mem, VkDeviceSize(info.offset + offset) ));
+
+		_memoryId = MemoryID{ memId };
+		return true;
+	}
+
 /*
 =================================================
 	Create
@@ -188,6 +257,7 @@ namespace FG
 		_desc				= Default;
 		_queueFamilyMask	= Default;
 		_onRelease			= {};
+		_isTransient		= false;
 
 		_debugName.clear();
 	}
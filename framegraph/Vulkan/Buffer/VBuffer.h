@@ -30,6 +30,7 @@ namespace FG
 		BufferDesc				_desc;
 		EQueueFamilyMask		_queueFamilyMask	= Default;
 		VkAccessFlags			_readAccessMask		= 0;
+		bool					_isTransient		= false;
 
 		DebugName_t				_debugName;
 		OnRelease_t				_onRelease;
@@ -48,6 +49,9 @@ namespace FG
 
 		bool Create (const VDevice &dev, const VulkanBufferDesc &desc, StringView dbgName, OnRelease_t &&onRelease);
 
+		bool CreateTransient (VResourceManager &, const BufferDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName);
+		bool BindMemory (VResourceManager &, RawMemoryID memId, const VMemoryObj &memObj, BytesU offset);
+
 		void Destroy (VResourceManager &);
 
 		//void Merge (BufferViewMap_t &, OUT AppendableVkResources_t) const;
@@ -55,8 +59,10 @@ namespace FG
 		//ND_ VkBufferView		GetView (const HashedBufferViewDesc &) const;
 		
 		ND_ VulkanBufferDesc	GetApiSpecificDescription () const;
+		ND_ VkMemoryRequirements	GetMemoryRequirements (const VDevice &) const;
 
 		ND_ bool				IsReadOnly ()			const;
+		ND_ bool				IsTransient ()			const	{ SHAREDLOCK( _drCheck );  return _isTransient; }
 
 		ND_ VkBuffer			Handle ()				const	{ SHAREDLOCK( _drCheck );  return _buffer; }
 		ND_ RawMemoryID			GetMemoryID ()			const	{ SHAREDLOCK( _drCheck );  return _memoryId.Get(); }
@@ -69,6 +75,9 @@ namespace FG
 		ND_ bool				IsExclusiveSharing ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask == Default; }
 		ND_ EQueueFamilyMask	GetQueueFamilyMask ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask; }
 		ND_ StringView			GetDebugName ()			const	{ SHAREDLOCK( _drCheck );  return _debugName; }
+
+	private:
+		bool _CreateBuffer (const VDevice &, const BufferDesc &, EQueueFamilyMask queueFamilyMask, StringView dbgName);
 	};
 	
 
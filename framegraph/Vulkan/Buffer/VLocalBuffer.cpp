@@ -24,12 +24,17 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalBuffer::Create (const VBuffer *bufferData)
+	bool VLocalBuffer::Create (const VBuffer *bufferData, uint localIndex, LinearAllocator<> &allocator)
 	{
 		CHECK_ERR( _bufferData == null );
 		CHECK_ERR( bufferData );
 
+		_pendingAccesses.SetAllocator( allocator );
+		_accessForWrite.SetAllocator( allocator );
+		_accessForRead.SetAllocator( allocator );
+
 		_bufferData		= bufferData;
+		_localIndex		= localIndex;
 		_isImmutable	= _bufferData->IsReadOnly();
 
 		return true;
@@ -43,6 +48,7 @@ namespace FG
 	void VLocalBuffer::Destroy ()
 	{
 		_bufferData	= null;
+		_localIndex	= UMax;
 
 		// check for uncommited barriers
 		ASSERT( _pendingAccesses.empty() );
@@ -56,167 +62,19 @@ namespace FG
 
 /*
 =================================================
-	_FindFirstAccess
+	SetAllocator
+----
+	access records will grow in 'allocator',
+	used when resource is recorded on the worker thread.
 =================================================
 */
-	inline VLocalBuffer::AccessIter_t
-		VLocalBuffer::_FindFirstAccess (AccessRecords_t &arr, const BufferRange &otherRange)
+	void VLocalBuffer::SetAllocator (LinearAllocator<> &allocator) const
 	{
-		size_t	left	= 0;
-		size_t	right	= arr.size();
-
-		for (; left < right; )
-		{
-			size_t	mid = (left + right) >> 1;
-
-			if ( arr[mid].range.end < otherRange.begin )
-				left = mid + 1;
-			else
-				right = mid;
-		}
-
-		if ( left < arr.size() and arr[left].range.end >= otherRange.begin )
-			return arr.begin() + left;
-		
-		return arr.end();
+		_pendingAccesses.SetAllocator( allocator );
+		_accessForWrite.SetAllocator( allocator );
+		_accessForRead.SetAllocator( allocator );
 	}
-	
-/*
-=================================================
-	_ReplaceAccessRecords
-=================================================
-*/
-	inline void VLocalBuffer::_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferAccess &barrier)
-	{
-		ASSERT( iter >= arr.begin() and iter <= arr.end() );
-
-		bool replaced = false;
-
-		for (; iter != arr.end();)
-		{
-			if ( iter->range.begin <  barrier.range.begin and
-				 iter->range.end   <= barrier.range.end )
-			{
-				//	|1111111|22222|
-				//     |bbbbb|			+
-				//  |11|....			=
-				iter->range.end = barrier.range.begin;
-				++iter;
-				continue;
-			}
 
-			if ( iter->range.begin < barrier.range.begin and
-				 iter->range.end   > barrier.range.end )
-			{
-				//  |111111111111111|
-				//      |bbbbb|			+
-				//  |111|bbbbb|11111|	=
-
-				const auto	src = *iter;
-
-				iter->range.end = barrier.range.begin;
-
-				iter = arr.insert( iter+1, barrier );
-				replaced = true;
-
-				iter = arr.insert( iter+1, src );
-
-				iter->range.begin = barrier.range.end;
-				break;
-			}
-
-			if ( iter->range.begin >= barrier.range.begin and
-				 iter->range.begin <  barrier.range.end )
-			{
-				if ( iter->range.end > barrier.range.end )
-				{
-					//  ...|22222222222|
-					//   |bbbbbbb|			+
-					//  ...bbbbbb|22222|	=
-					iter->range.begin = barrier.range.end;
-
-					if ( not replaced )
-					{
-						arr.insert( iter, barrier );
-						replaced = true;
-					}
-					break;
-				}
-
-				if ( replaced )
-				{
-					//  ...|22222|33333|
-					//   |bbbbbbbbbbb|		+
-					//  ...|bbbbbbbbb|...	=
-					iter = arr.erase( iter );
-				}
-				else
-				{
-					*iter = barrier;
-					++iter;
-					replaced = true;
-				}
-				continue;
-			}
-
-			break;
-		}
-			
-		if ( not replaced )
-		{
-			arr.insert( iter, barrier );
-		}
-	}
-	
-/*
-=================================================
-	_EraseAccessRecords
-=================================================
-*/
-	inline VLocalBuffer::AccessIter_t
-		VLocalBuffer::_EraseAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferRange &range)
-	{
-		if ( arr.empty() )
-			return iter;
-
-		ASSERT( iter >= arr.begin() and iter <= arr.end() );
-
-		for (; iter != arr.end();)
-		{
-			if ( iter->range.begin < range.begin and
-				 iter->range.end   > range.end )
-			{
-				const auto	src = *iter;
-				iter->range.end = range.begin;
-
-				iter = arr.insert( iter+1, src );
-				iter->range.begin = range.end;
-				break;
-			}
-
-			if ( iter->range.begin < range.begin )
-			{
-				ASSERT( iter->range.end >= range.begin );
-
-				iter->range.end = range.begin;
-				++iter;
-				continue;
-			}
-
-			if ( iter->range.end > range.end )
-			{
-				ASSERT( iter->range.begin <= range.end );
-
-				iter->range.begin = range.end;
-				break;
-			}
-
-			iter = arr.erase( iter );
-		}
-
-		return iter;
-	}
-	
 /*
 =================================================
 	SetInitialState
@@ -255,7 +113,7 @@ namespace FG
 		
 		// merge with pending
 		BufferRange	range	= pending.range;
-		auto		iter	= _FindFirstAccess( _pendingAccesses, range );
+		auto		iter	= _pendingAccesses.FindFirst( range );
 
 		if ( iter != _pendingAccesses.end() and iter->range.begin > range.begin )
 		{
@@ -298,6 +156,14 @@ namespace FG
 		
 		if ( _isImmutable )
 			return;
+		
+		// memory may be already reused by other transient resource
+		if ( _bufferData->IsTransient() )
+		{
+			_accessForWrite.clear();
+			_accessForRead.clear();
+			return;
+		}
 
 		// add full range barrier
 		{
@@ -357,8 +223,8 @@ namespace FG
 
 		for (const auto& pending : _pendingAccesses)
 		{
-			const auto	w_iter	= _FindFirstAccess( _accessForWrite, pending.range );
-			const auto	r_iter	= _FindFirstAccess( _accessForRead, pending.range );
+			const auto	w_iter	= _accessForWrite.FindFirst( pending.range );
+			const auto	r_iter	= _accessForRead.FindFirst( pending.range );
 
 			if ( pending.isWritable )
 			{
@@ -389,8 +255,8 @@ namespace FG
 				}
 				
 				// store to '_accessForWrite'
-				_ReplaceAccessRecords( _accessForWrite, w_iter, pending );
-				_EraseAccessRecords( _accessForRead, r_iter, pending.range );
+				_accessForWrite.Replace( w_iter, pending );
+				_accessForRead.Erase( r_iter, pending.range );
 			}
 			else
 			{
@@ -401,7 +267,7 @@ namespace FG
 				}
 
 				// store to '_accessForRead'
-				_ReplaceAccessRecords( _accessForRead, r_iter, pending );
+				_accessForRead.Replace( r_iter, pending );
 			}
 		}
 
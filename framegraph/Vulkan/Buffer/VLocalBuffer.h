@@ -4,6 +4,7 @@
 
 #include "framegraph/Public/EResourceState.h"
 #include "framegraph/Shared/ResourceDataRange.h"
+#include "framegraph/Shared/ResourceRangeMap.h"
 #include "VBuffer.h"
 
 namespace FG
@@ -48,15 +49,24 @@ namespace FG
 
 		// methods
 			BufferAccess () : isReadable{false}, isWritable{false} {}
+
+			ND_ bool  HasEqualState (const BufferAccess &rhs) const
+			{
+				return	stages		== rhs.stages		and
+						access		== rhs.access		and
+						index		== rhs.index		and
+						isReadable	== rhs.isReadable	and
+						isWritable	== rhs.isWritable;
+			}
 		};
 
-		using AccessRecords_t	= Array< BufferAccess >;	// TODO: fixed size array or custom allocator
-		using AccessIter_t		= AccessRecords_t::iterator;
+		using AccessRecords_t	= ResourceRangeMap< BufferAccess, 4 >;	// spills into command buffer allocator
 
 
 	// variables
 	private:
 		Ptr<VBuffer const>			_bufferData;	// readonly access is thread safe
+		uint						_localIndex		= UMax;
 
 		mutable AccessRecords_t		_pendingAccesses;
 		mutable AccessRecords_t		_accessForWrite;
@@ -70,28 +80,24 @@ namespace FG
 		VLocalBuffer (VLocalBuffer &&) = delete;
 		~VLocalBuffer ();
 
-		bool Create (const VBuffer *);
+		bool Create (const VBuffer *, uint localIndex, LinearAllocator<> &);
 		void Destroy ();
 		
 		void SetInitialState (bool immutable) const;
 		void AddPendingState (const BufferState &state) const;
 		void ResetState (ExeOrderIndex index, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
 		void CommitBarrier (VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
+		void SetAllocator (LinearAllocator<> &allocator) const;
 
 		ND_ bool				IsCreated ()	const	{ return _bufferData != null; }
 		ND_ VkBuffer			Handle ()		const	{ return _bufferData->Handle(); }
 		ND_ VBuffer const*		ToGlobal ()		const	{ return _bufferData.get(); }
+		ND_ uint				LocalIndex ()	const	{ return _localIndex; }
 
 		ND_ BufferDesc const&	Description ()	const	{ return _bufferData->Description(); }
 		ND_ BytesU				Size ()			const	{ return Description().size; }
 		
 		ND_ StringView			GetDebugName ()	const	{ return _bufferData->GetDebugName(); }
-
-
-	private:
-		ND_ static AccessIter_t	_FindFirstAccess (AccessRecords_t &arr, const BufferRange &range);
-			static void			_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferAccess &barrier);
-			static AccessIter_t	_EraseAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferRange &range);
 	};
 
 
@@ -0,0 +1,147 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VStagingRing.h"
+#include "VFrameGraph.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VStagingRing::~VStagingRing ()
+	{
+		CHECK( not _bufferId );
+	}
+
+/*
+=================================================
+	Initialize
+----
+	buffer is created on first allocation.
+=================================================
+*/
+	void  VStagingRing::Initialize (BytesU capacity, EBufferUsage usage, EMemoryType memType, StringView name)
+	{
+		EXLOCK( _guard );
+		ASSERT( not _bufferId );
+
+		_capacity	= capacity;
+		_usage		= usage;
+		_memType	= memType;
+		_name		= name;
+	}
+
+/*
+=================================================
+	Deinitialize
+=================================================
+*/
+	void  VStagingRing::Deinitialize (VResourceManager &resMngr)
+	{
+		EXLOCK( _guard );
+		CHECK( _records.empty() );
+
+		if ( _bufferId )
+			resMngr.ReleaseResource( _bufferId.Release() );
+
+		_buffer		= Default;
+		_records.clear();
+		_head		= 0;
+		_tail		= 0;
+		_firstIndex	= 0;
+	}
+
+/*
+=================================================
+	_Create
+=================================================
+*/
+	bool  VStagingRing::_Create (VFrameGraph &fg)
+	{
+		auto&	rm = fg.GetResourceManager();
+
+		_bufferId = fg.CreateBuffer( BufferDesc{ _capacity, _usage }, MemoryDesc{ _memType }, _name );
+		CHECK_ERR( _bufferId );
+
+		_buffer.bufferId	= _bufferId.Get();
+		_buffer.memoryId	= rm.GetResource( _buffer.bufferId )->GetMemoryID();
+		CHECK_ERR( _buffer.memoryId );
+
+		// memory is persistently mapped
+		VMemoryObj::MemoryInfo	info;
+		CHECK_ERR( rm.GetResource( _buffer.memoryId )->GetInfo( rm.GetMemoryManager(), OUT info ));
+		CHECK_ERR( info.mappedPtr );
+
+		_buffer.mappedPtr	= info.mappedPtr;
+		_buffer.memOffset	= info.offset;
+		_buffer.mem			= info.mem;
+		_buffer.isCoherent	= EnumEq( info.flags, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+		return true;
+	}
+
+/*
+=================================================
+	Alloc
+----
+	returns 'false' if ring is full,
+	in this case the caller should use a dedicated buffer.
+=================================================
+*/
+	bool  VStagingRing::Alloc (VFrameGraph &fg, BytesU size, BytesU align, OUT Block &result)
+	{
+		EXLOCK( _guard );
+
+		if ( size > _capacity or size == 0_b )
+			return false;
+
+		if ( not _bufferId )
+			CHECK_ERR( _Create( fg ));
+
+		const uint64_t	capacity	= uint64_t(_capacity);
+		const uint64_t	pos			= _head % capacity;
+		uint64_t		offset		= AlignToLarger( pos, uint64_t(align) );
+
+		// block must not cross the end of the buffer
+		if ( offset + uint64_t(size) > capacity )
+			offset = capacity;
+
+		const uint64_t	end = _head + (offset - pos) + uint64_t(size);
+
+		if ( end - _tail > capacity )
+			return false;
+
+		result				= _buffer;
+		result.offset		= BytesU{ offset % capacity };
+		result.size			= size;
+		result.index		= _firstIndex + _records.size();
+
+		_records.push_back({ end, false });
+		_head = end;
+		return true;
+	}
+
+/*
+=================================================
+	Release
+=================================================
+*/
+	void  VStagingRing::Release (uint64_t index)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( index >= _firstIndex and index < _firstIndex + _records.size(), void());
+
+		_records[ size_t(index - _firstIndex) ].released = true;
+
+		// memory can be reused only in allocation order
+		for (; not _records.empty() and _records.front().released; ++_firstIndex)
+		{
+			_tail = _records.front().end;
+			_records.pop_front();
+		}
+	}
+
+
+}	// FG
@@ -0,0 +1,86 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Persistently mapped ring buffer that is shared between all command batches.
+	Command batch takes a block from the ring and sub-allocates staging memory from it,
+	block is returned to the ring when batch complete execution on the GPU.
+	Blocks may be released in any order, but memory is reused only in allocation order.
+*/
+
+#pragma once
+
+#include "framegraph/Public/BufferDesc.h"
+#include "framegraph/Public/MemoryDesc.h"
+#include "VCommon.h"
+
+namespace FG
+{
+
+	//
+	// Staging Ring Buffer
+	//
+
+	class VStagingRing final
+	{
+	// types
+	public:
+		struct Block
+		{
+			RawBufferID		bufferId;
+			RawMemoryID		memoryId;
+			BytesU			offset;				// offset in the buffer
+			BytesU			size;
+			void *			mappedPtr	= null;	// pointer to the beginning of the buffer
+			BytesU			memOffset;
+			VkDeviceMemory	mem			= VK_NULL_HANDLE;
+			bool			isCoherent	= false;
+			uint64_t		index		= UMax;
+		};
+
+	private:
+		struct Record
+		{
+			uint64_t	end;			// position in the ring after this block
+			bool		released;
+		};
+
+		using Records_t	= std::deque< Record >;
+
+
+	// variables
+	private:
+		std::mutex		_guard;
+
+		BufferID		_bufferId;
+		Block			_buffer;			// mapped memory of the whole buffer
+
+		BytesU			_capacity;
+		EBufferUsage	_usage			= Default;
+		EMemoryType		_memType		= Default;
+		StringView		_name;
+
+		uint64_t		_head			= 0;	// allocation position, increased by each allocation
+		uint64_t		_tail			= 0;	// memory before this position can be reused
+		Records_t		_records;
+		uint64_t		_firstIndex		= 0;	// index of the first record
+
+
+	// methods
+	public:
+		VStagingRing () {}
+		~VStagingRing ();
+
+		void  Initialize (BytesU capacity, EBufferUsage usage, EMemoryType memType, StringView name);
+		void  Deinitialize (VResourceManager &);
+
+		ND_ bool  Alloc (VFrameGraph &fg, BytesU size, BytesU align, OUT Block &result);
+			void  Release (uint64_t index);
+
+		ND_ BytesU			Capacity ()	const	{ return _capacity; }
+		ND_ EBufferUsage	Usage ()	const	{ return _usage; }
+
+	private:
+		ND_ bool  _Create (VFrameGraph &fg);
+	};
+
+
+}	// FG
@@ -0,0 +1,217 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VBarrierManager.h"
+
+namespace FG
+{
+namespace {
+/*
+=================================================
+	SortAndMerge
+----
+	sort barriers and merge neighbours,
+	'merge' returns false if barriers can't be merged.
+=================================================
+*/
+	template <typename T, typename Less, typename Merge>
+	inline void  SortAndMerge (INOUT Array<T> &arr, Less &&less, Merge &&merge)
+	{
+		if ( arr.size() < 2 )
+			return;
+
+		std::sort( arr.begin(), arr.end(), less );
+
+		size_t	j = 0;
+		for (size_t i = 1; i < arr.size(); ++i)
+		{
+			if ( not merge( INOUT arr[j], arr[i] ))
+				arr[++j] = arr[i];
+		}
+		arr.resize( j+1 );
+	}
+
+/*
+=================================================
+	MergeRange
+----
+	merges [dstBase, dstBase + dstCount) with [srcBase, srcBase + srcCount)
+	if they are adjacent or overlapped, 'src' must not be less than 'dst'.
+=================================================
+*/
+	ND_ inline bool  MergeRange (INOUT uint &dstBase, INOUT uint &dstCount, uint srcBase, uint srcCount)
+	{
+		ASSERT( srcBase >= dstBase );
+
+		// VK_REMAINING_* values are not merged
+		if ( dstCount == UMax or srcCount == UMax )
+			return false;
+
+		const uint	dst_end	= dstBase + dstCount;
+		const uint	src_end	= srcBase + srcCount;
+
+		if ( srcBase > dst_end )
+			return false;
+
+		dstCount = Max( dst_end, src_end ) - dstBase;
+		return true;
+	}
+
+/*
+=================================================
+	ImageTransitionKey
+----
+	barriers with same key can be merged
+=================================================
+*/
+	ND_ inline auto  ImageTransitionKey (const VkImageMemoryBarrier &barrier)
+	{
+		return std::make_tuple( barrier.image, barrier.oldLayout, barrier.newLayout, barrier.srcAccessMask, barrier.dstAccessMask,
+								barrier.srcQueueFamilyIndex, barrier.dstQueueFamilyIndex, barrier.subresourceRange.aspectMask );
+	}
+
+	ND_ inline auto  BufferTransitionKey (const VkBufferMemoryBarrier &barrier)
+	{
+		return std::make_tuple( barrier.buffer, barrier.srcAccessMask, barrier.dstAccessMask,
+								barrier.srcQueueFamilyIndex, barrier.dstQueueFamilyIndex );
+	}
+
+}	// namespace
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	_CmdPipelineBarrier
+=================================================
+*/
+	void VBarrierManager::_CmdPipelineBarrier (const VDevice &dev, VkCommandBuffer cmd, INOUT Statistic_t &stat)
+	{
+		const uint	mem_count = !!(_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask);
+
+		stat.pipelineBarriersBeforeMerge += mem_count + uint(_bufferBarriers.size() + _imageBarriers.size());
+
+		_MergeImageBarriers();
+		_MergeBufferBarriers();
+
+		stat.pipelineBarriers += mem_count + uint(_bufferBarriers.size() + _imageBarriers.size());
+
+		dev.vkCmdPipelineBarrier( cmd, _srcStageMask, _dstStageMask, _dependencyFlags,
+								  mem_count, &_memoryBarrier,
+								  uint(_bufferBarriers.size()), _bufferBarriers.data(),
+								  uint(_imageBarriers.size()), _imageBarriers.data() );
+		ClearBarriers();
+	}
+
+/*
+=================================================
+	_MergeImageBarriers
+----
+	barriers with same image, layouts and access masks are merged
+	if they have same layer range and adjacent mipmap ranges,
+	then if they have same mipmap range and adjacent layer ranges.
+=================================================
+*/
+	void VBarrierManager::_MergeImageBarriers ()
+	{
+		using Barrier_t = VkImageMemoryBarrier;
+
+		// merge mipmaps
+		SortAndMerge( INOUT _imageBarriers,
+			[] (const Barrier_t &lhs, const Barrier_t &rhs)
+			{
+				const auto	lkey = ImageTransitionKey( lhs );
+				const auto	rkey = ImageTransitionKey( rhs );
+
+				if ( lkey != rkey )
+					return lkey < rkey;
+
+				const auto&	l = lhs.subresourceRange;
+				const auto&	r = rhs.subresourceRange;
+				return std::tie( l.baseArrayLayer, l.layerCount, l.baseMipLevel ) < std::tie( r.baseArrayLayer, r.layerCount, r.baseMipLevel );
+			},
+			[] (Barrier_t &dst, const Barrier_t &src)
+			{
+				if ( dst.pNext or src.pNext or ImageTransitionKey( dst ) != ImageTransitionKey( src ))
+					return false;
+
+				auto&		d = dst.subresourceRange;
+				const auto&	s = src.subresourceRange;
+
+				if ( d.baseArrayLayer != s.baseArrayLayer or d.layerCount != s.layerCount )
+					return false;
+
+				return MergeRange( INOUT d.baseMipLevel, INOUT d.levelCount, s.baseMipLevel, s.levelCount );
+			});
+
+		// merge array layers
+		SortAndMerge( INOUT _imageBarriers,
+			[] (const Barrier_t &lhs, const Barrier_t &rhs)
+			{
+				const auto	lkey = ImageTransitionKey( lhs );
+				const auto	rkey = ImageTransitionKey( rhs );
+
+				if ( lkey != rkey )
+					return lkey < rkey;
+
+				const auto&	l = lhs.subresourceRange;
+				const auto&	r = rhs.subresourceRange;
+				return std::tie( l.baseMipLevel, l.levelCount, l.baseArrayLayer ) < std::tie( r.baseMipLevel, r.levelCount, r.baseArrayLayer );
+			},
+			[] (Barrier_t &dst, const Barrier_t &src)
+			{
+				if ( dst.pNext or src.pNext or ImageTransitionKey( dst ) != ImageTransitionKey( src ))
+					return false;
+
+				auto&		d = dst.subresourceRange;
+				const auto&	s = src.subresourceRange;
+
+				if ( d.baseMipLevel != s.baseMipLevel or d.levelCount != s.levelCount )
+					return false;
+
+				return MergeRange( INOUT d.baseArrayLayer, INOUT d.layerCount, s.baseArrayLayer, s.layerCount );
+			});
+	}
+
+/*
+=================================================
+	_MergeBufferBarriers
+----
+	barriers with same buffer and access masks are merged
+	if their ranges are adjacent or overlapped.
+=================================================
+*/
+	void VBarrierManager::_MergeBufferBarriers ()
+	{
+		using Barrier_t = VkBufferMemoryBarrier;
+
+		SortAndMerge( INOUT _bufferBarriers,
+			[] (const Barrier_t &lhs, const Barrier_t &rhs)
+			{
+				const auto	lkey = BufferTransitionKey( lhs );
+				const auto	rkey = BufferTransitionKey( rhs );
+
+				if ( lkey != rkey )
+					return lkey < rkey;
+
+				return lhs.offset < rhs.offset;
+			},
+			[] (Barrier_t &dst, const Barrier_t &src)
+			{
+				if ( dst.pNext or src.pNext or BufferTransitionKey( dst ) != BufferTransitionKey( src ))
+					return false;
+
+				ASSERT( src.offset >= dst.offset );
+
+				if ( dst.size == VK_WHOLE_SIZE )
+					return true;
+
+				if ( src.offset > dst.offset + dst.size )
+					return false;
+
+				dst.size = (src.size == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : Max( dst.offset + dst.size, src.offset + src.size ) - dst.offset);
+				return true;
+			});
+	}
+
+
+}	// FG
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "VDevice.h"
+#include "framegraph/Public/FrameGraph.h"
 
 namespace FG
 {
@@ -13,7 +14,12 @@ namespace FG
 
 	class VBarrierManager final
 	{
+		friend class VBarrierManagerUnitTest;
+
 	// types
+	public:
+		using Statistic_t				= IFrameGraph::RenderingStatistics;
+
 	private:
 		// TODO: custom allocator
 		using ImageMemoryBarriers_t		= Array< VkImageMemoryBarrier >;
@@ -43,35 +49,25 @@ namespace FG
 		}
 
 
-		void Commit (const VDevice &dev, VkCommandBuffer cmd)
+		void Commit (const VDevice &dev, VkCommandBuffer cmd, INOUT Statistic_t &stat)
 		{
 			const uint	mem_count = !!(_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask);
 
 			if ( mem_count or _bufferBarriers.size() or _imageBarriers.size() )
 			{
-				dev.vkCmdPipelineBarrier( cmd, _srcStageMask, _dstStageMask, _dependencyFlags,
-										  mem_count, &_memoryBarrier,
-										  uint(_bufferBarriers.size()), _bufferBarriers.data(),
-										  uint(_imageBarriers.size()), _imageBarriers.data() );
-				ClearBarriers();
+				_CmdPipelineBarrier( dev, cmd, INOUT stat );
 			}
 		}
 		
 
-		void ForceCommit (const VDevice &dev, VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage)
+		void ForceCommit (const VDevice &dev, VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, INOUT Statistic_t &stat)
 		{
-			const uint	mem_count = !!(_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask);
-
 			_srcStageMask |= srcStage;
 			_dstStageMask |= dstStage;
 
 			if ( _srcStageMask and _dstStageMask )
 			{
-				dev.vkCmdPipelineBarrier( cmd, _srcStageMask, _dstStageMask, _dependencyFlags,
-										  mem_count, &_memoryBarrier,
-										  uint(_bufferBarriers.size()), _bufferBarriers.data(),
-										  uint(_imageBarriers.size()), _imageBarriers.data() );
-				ClearBarriers();
+				_CmdPipelineBarrier( dev, cmd, INOUT stat );
 			}
 		}
 
@@ -122,6 +118,12 @@ namespace FG
 			_memoryBarrier.srcAccessMask |= barrier.srcAccessMask;
 			_memoryBarrier.dstAccessMask |= barrier.dstAccessMask;
 		}
+
+
+	private:
+		void _CmdPipelineBarrier (const VDevice &dev, VkCommandBuffer cmd, INOUT Statistic_t &stat);
+		void _MergeImageBarriers ();
+		void _MergeBufferBarriers ();
 	};
 
 }	// FG
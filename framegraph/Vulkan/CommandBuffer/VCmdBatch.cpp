@@ -47,8 +47,11 @@ namespace FG
 
 		ASSERT( _dependencies.empty() );
 		ASSERT( _batch.commands.empty() );
+		ASSERT( _batch.secondaries.empty() );
 		ASSERT( _batch.signalSemaphores.empty() );
 		ASSERT( _batch.waitSemaphores.empty() );
+		ASSERT( _batch.signalValues.empty() );
+		ASSERT( _batch.waitValues.empty() );
 		ASSERT( _staging.hostToDevice.empty() );
 		ASSERT( _staging.deviceToHost.empty() );
 		ASSERT( _staging.onBufferLoadedEvents.empty() );
@@ -57,10 +60,11 @@ namespace FG
 		ASSERT( _swapchains.empty() );
 		ASSERT( _shaderDebugger.buffers.empty() );
 		ASSERT( _shaderDebugger.modes.empty() );
-		ASSERT( _submitted == null );
+		ASSERT( _submitted.load( memory_order_relaxed ) == null );
 		ASSERT( _counter.load( memory_order_relaxed ) == 0 );
 
-		_queueType = type;
+		_queueType		= type;
+		_timelineValue	= 0;
 
 		_state.store( EState::Initial, memory_order_relaxed );
 		
@@ -90,13 +94,14 @@ namespace FG
 	SignalSemaphore
 =================================================
 */
-	void  VCmdBatch::SignalSemaphore (VkSemaphore sem)
+	void  VCmdBatch::SignalSemaphore (VkSemaphore sem, uint64_t value)
 	{
 		EXLOCK( _drCheck );
 		ASSERT( GetState() < EState::Submitted );
 		CHECK_ERR( _batch.signalSemaphores.size() < _batch.signalSemaphores.capacity(), void());
 
 		_batch.signalSemaphores.push_back( sem );
+		_batch.signalValues.push_back( value );
 	}
 	
 /*
@@ -104,13 +109,14 @@ namespace FG
 	WaitSemaphore
 =================================================
 */
-	void  VCmdBatch::WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage)
+	void  VCmdBatch::WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage, uint64_t value)
 	{
 		EXLOCK( _drCheck );
 		ASSERT( GetState() < EState::Submitted );
 		CHECK_ERR( _batch.waitSemaphores.size() < _batch.waitSemaphores.capacity(), void());
 
 		_batch.waitSemaphores.push_back( sem, stage );
+		_batch.waitValues.push_back( value );
 	}
 	
 /*
@@ -136,6 +142,20 @@ namespace FG
 		_batch.commands.push_back( cmd, pool );
 	}
 	
+/*
+=================================================
+	PushSecondaryCommandBuffer
+=================================================
+*/
+	void  VCmdBatch::PushSecondaryCommandBuffer (VkCommandBuffer cmd, const VCommandPool *pool)
+	{
+		EXLOCK( _drCheck );
+		ASSERT( GetState() < EState::Submitted );
+		CHECK_ERR( _batch.secondaries.size() < _batch.secondaries.capacity(), void());
+
+		_batch.secondaries.push_back( cmd, pool );
+	}
+	
 /*
 =================================================
 	AddDependency
@@ -173,7 +193,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		ASSERT( uint(newState) > uint(GetState()) );
 
-		_state.store( newState, memory_order_relaxed );
+		// other threads read state without lock
+		_state.store( newState, memory_order_release );
 	}
 	
 /*
@@ -236,12 +257,17 @@ namespace FG
 	OnBaked
 =================================================
 */
-	bool  VCmdBatch::OnBaked (INOUT ResourceMap_t &resources)
+	bool  VCmdBatch::OnBaked (const ResourceMap_t &resources)
 	{
 		EXLOCK( _drCheck );
 		_SetState( EState::Backed );
 
-		std::swap( _resourcesToRelease, resources );
+		// map memory will be discarded by command buffer, so copy resources to the batch
+		_resourcesToRelease.reserve( resources.size() );
+
+		for (auto& res : resources) {
+			_resourcesToRelease.push_back( res );
+		}
 		return true;
 	}
 	
@@ -285,10 +311,9 @@ namespace FG
 	AfterSubmit
 =================================================
 */
-	bool  VCmdBatch::AfterSubmit (OUT Appendable<VSwapchain const*> swapchains, VSubmitted *ptr)
+	bool  VCmdBatch::AfterSubmit (OUT Appendable<VSwapchain const*> swapchains, VSubmitted *ptr, uint64_t timelineValue)
 	{
 		EXLOCK( _drCheck );
-		_SetState( EState::Submitted );
 
 		for (auto& sw : _swapchains) {
 			swapchains.push_back( sw );
@@ -296,8 +321,11 @@ namespace FG
 
 		_swapchains.clear();
 		_dependencies.clear();
-		_submitted = ptr;
+		_submitted.store( ptr, memory_order_relaxed );
+		_timelineValue = timelineValue;
 
+		// '_submitted' and '_timelineValue' must be visible when state is changed
+		_SetState( EState::Submitted );
 		return true;
 	}
 
@@ -309,7 +337,7 @@ namespace FG
 	bool  VCmdBatch::OnComplete (VDebugger &debugger, const ShaderDebugCallback_t &shaderDbgCallback, INOUT Statistic_t &outStatistic)
 	{
 		EXLOCK( _drCheck );
-		ASSERT( _submitted );
+		ASSERT( _submitted.load( memory_order_relaxed ));
 
 		_SetState( EState::Complete );
 
@@ -339,7 +367,7 @@ namespace FG
 		}
 		outStatistic.Merge( _statistic );
 
-		_submitted = null;
+		_submitted.store( null, memory_order_relaxed );
 		return true;
 	}
 	
@@ -355,21 +383,32 @@ namespace FG
 			if ( auto*  pool = _batch.commands.get<1>()[i] )
 				pool->RecyclePrimary( _batch.commands.get<0>()[i] );
 		}
+		
+		for (size_t i = 0; i < _batch.secondaries.size(); ++i)
+		{
+			if ( auto*  pool = _batch.secondaries.get<1>()[i] )
+				pool->RecycleSecondary( _batch.secondaries.get<0>()[i] );
+		}
 
 		_batch.commands.clear();
+		_batch.secondaries.clear();
 		_batch.signalSemaphores.clear();
 		_batch.waitSemaphores.clear();
+		_batch.signalValues.clear();
+		_batch.waitValues.clear();
 	}
 
 /*
 =================================================
 	_FinalizeStagingBuffers
+----
+	asynchronous callbacks are called on the completion thread,
+	in this case device-to-host staging memory is released
+	when all callbacks are complete.
 =================================================
 */
 	void  VCmdBatch::_FinalizeStagingBuffers ()
 	{
-		using T = BufferView::value_type;
-		
 		// map device-to-host staging buffers
 		for (auto& buf : _staging.deviceToHost)
 		{
@@ -377,23 +416,16 @@ namespace FG
 			CHECK( _MapMemory( INOUT buf ));
 		}
 
+		Array< OnBufferDataLoadedEvent >	async_buffer_events;
+		Array< OnImageDataLoadedEvent >		async_image_events;
+
 		// trigger buffer events
 		for (auto& ev : _staging.onBufferLoadedEvents)
 		{
-			FixedArray< ArrayView<T>, MaxBufferParts >	data_parts;
-			BytesU										total_size;
-
-			for (auto& part : ev.parts)
-			{
-				ArrayView<T>	view{ Cast<T>(part.buffer->mappedPtr + part.offset), size_t(part.size) };
-
-				data_parts.push_back( view );
-				total_size += part.size;
-			}
-
-			ASSERT( total_size == ev.totalSize );
-
-			ev.callback( BufferView{data_parts} );
+			if ( ev.isAsync )
+				async_buffer_events.push_back( std::move(ev) );
+			else
+				_TriggerDataLoadedEvent( _staging.deviceToHost, ev );
 		}
 		_staging.onBufferLoadedEvents.clear();
 		
@@ -401,38 +433,103 @@ namespace FG
 		// trigger image events
 		for (auto& ev : _staging.onImageLoadedEvents)
 		{
-			FixedArray< ArrayView<T>, MaxImageParts >	data_parts;
-			BytesU										total_size;
+			if ( ev.isAsync )
+				async_image_events.push_back( std::move(ev) );
+			else
+				_TriggerDataLoadedEvent( _staging.deviceToHost, ev );
+		}
+		_staging.onImageLoadedEvents.clear();
 
-			for (auto& part : ev.parts)
-			{
-				ArrayView<T>	view{ Cast<T>(part.buffer->mappedPtr + part.offset), size_t(part.size) };
 
-				data_parts.push_back( view );
-				total_size += part.size;
-			}
+		// release resources, GPU doesn't use staging memory anymore
+		_ReleaseStagingBuffers( _frameGraph, _frameGraph.GetUploadRing(), INOUT _staging.hostToDevice );
 
-			ASSERT( total_size == ev.totalSize );
+		if ( async_buffer_events.empty() and async_image_events.empty() )
+		{
+			_ReleaseStagingBuffers( _frameGraph, _frameGraph.GetReadbackRing(), INOUT _staging.deviceToHost );
+		}
+		else
+		{
+			_frameGraph.RunOnCompletionThread(
+				[fg = &_frameGraph, buffers = std::move(_staging.deviceToHost),
+				 buffer_events = std::move(async_buffer_events), image_events = std::move(async_image_events)] () mutable
+				{
+					for (auto& ev : buffer_events) {
+						_TriggerDataLoadedEvent( buffers, ev );
+					}
+					for (auto& ev : image_events) {
+						_TriggerDataLoadedEvent( buffers, ev );
+					}
+					_ReleaseStagingBuffers( *fg, fg->GetReadbackRing(), INOUT buffers );
+				});
+			_staging.deviceToHost.clear();
+		}
+	}
+
+/*
+=================================================
+	_TriggerDataLoadedEvent
+=================================================
+*/
+	void  VCmdBatch::_TriggerDataLoadedEvent (const StagingBuffers_t &deviceToHost, const OnBufferDataLoadedEvent &ev)
+	{
+		using T = BufferView::value_type;
+
+		FixedArray< ArrayView<T>, MaxBufferParts >	data_parts;
+		BytesU										total_size;
 
-			ev.callback( ImageView{ data_parts, ev.imageSize, ev.rowPitch, ev.slicePitch, ev.format, ev.aspect });
+		for (auto& part : ev.parts)
+		{
+			auto&			buf = deviceToHost[ part.bufferIndex ];
+			ArrayView<T>	view{ Cast<T>(buf.mappedPtr + part.offset), size_t(part.size) };
+
+			data_parts.push_back( view );
+			total_size += part.size;
 		}
-		_staging.onImageLoadedEvents.clear();
 
+		ASSERT( total_size == ev.totalSize );
 
-		// release resources
+		ev.callback( BufferView{data_parts} );
+	}
+	
+	void  VCmdBatch::_TriggerDataLoadedEvent (const StagingBuffers_t &deviceToHost, const OnImageDataLoadedEvent &ev)
+	{
+		using T = BufferView::value_type;
+
+		FixedArray< ArrayView<T>, MaxImageParts >	data_parts;
+		BytesU										total_size;
+
+		for (auto& part : ev.parts)
 		{
-			auto&	rm = _frameGraph.GetResourceManager();
+			auto&			buf = deviceToHost[ part.bufferIndex ];
+			ArrayView<T>	view{ Cast<T>(buf.mappedPtr + part.offset), size_t(part.size) };
 
-			for (auto& sb : _staging.hostToDevice) {
-				rm.ReleaseResource( sb.bufferId.Release() );
-			}
-			_staging.hostToDevice.clear();
+			data_parts.push_back( view );
+			total_size += part.size;
+		}
 
-			for (auto& sb : _staging.deviceToHost) {
-				rm.ReleaseResource( sb.bufferId.Release() );
-			}
-			_staging.deviceToHost.clear();
+		ASSERT( total_size == ev.totalSize );
+
+		ev.callback( ImageView{ data_parts, ev.imageSize, ev.rowPitch, ev.slicePitch, ev.format, ev.aspect });
+	}
+	
+/*
+=================================================
+	_ReleaseStagingBuffers
+=================================================
+*/
+	void  VCmdBatch::_ReleaseStagingBuffers (VFrameGraph &fg, VStagingRing &ring, INOUT StagingBuffers_t &buffers)
+	{
+		auto&	rm = fg.GetResourceManager();
+
+		for (auto& sb : buffers)
+		{
+			if ( sb.ringIndex != UMax )
+				ring.Release( sb.ringIndex );
+			else
+				rm.ReleaseResource( sb.bufferId );
 		}
+		buffers.clear();
 	}
 
 /*
@@ -668,7 +765,64 @@ namespace FG
 
 /*
 =================================================
-	_GetWritable
+	_AddStagingBuffer
+----
+	staging memory is allocated from the frame graph ring buffer,
+	dedicated buffer is created only if ring is full.
+=================================================
+*/
+	bool  VCmdBatch::_AddStagingBuffer (INOUT StagingBuffers_t &stagingBuffers, VStagingRing &ring, const BytesU srcRequiredSize, const BytesU offsetAlign,
+										const BytesU dstMinSize, const BufferDesc &desc, EMemoryType memType, StringView dbgName)
+	{
+		// block must be large enough to be reused by the next allocations
+		// and small enough to not exhaust the ring by a single batch
+		const BytesU	min_block	= ring.Capacity() / 64;
+		const BytesU	max_block	= Max( ring.Capacity() / 4, dstMinSize );
+		const BytesU	block_size	= Min( Max( srcRequiredSize, min_block ), max_block ) + offsetAlign;
+
+		VStagingRing::Block		block;
+
+		if ( EnumEq( ring.Usage(), desc.usage ) and ring.Alloc( _frameGraph, block_size, offsetAlign, OUT block ))
+		{
+			stagingBuffers.push_back( StagingBuffer{ block });
+			return true;
+		}
+
+		ASSERT( dstMinSize < desc.size );
+
+		RawBufferID	buf_id = _frameGraph.CreateBuffer( desc, MemoryDesc{ memType }, dbgName ).Release();
+		CHECK_ERR( buf_id );
+		
+		RawMemoryID	mem_id = _frameGraph.GetResourceManager().GetResource( buf_id )->GetMemoryID();
+		CHECK_ERR( mem_id );
+
+		stagingBuffers.push_back({ buf_id, mem_id, desc.size });
+		CHECK( _MapMemory( stagingBuffers.back() ));
+		return true;
+	}
+
+/*
+=================================================
+	GetMaxMappableSize
+----
+	returns max size that is always allocated as a single block
+	in the staging ring or in the dedicated staging buffer.
+=================================================
+*/
+	BytesU  VCmdBatch::GetMaxMappableSize () const
+	{
+		SHAREDLOCK( _drCheck );
+
+		const BytesU	align	= 16_b;		// max offset alignment that is used for mapped memory
+		const BytesU	ring	= _frameGraph.GetUploadRing().Capacity();
+		const BytesU	buf		= _staging.hostWritableBufferSize;
+
+		return Min( ring > align ? ring - align : 0_b, buf > align ? buf - align : 0_b );
+	}
+
+/*
+=================================================
+	GetWritable
 =================================================
 */
 	bool VCmdBatch::GetWritable (const BytesU srcRequiredSize, const BytesU blockAlign, const BytesU offsetAlign, const BytesU dstMinSize,
@@ -678,61 +832,33 @@ namespace FG
 		ASSERT( blockAlign > 0_b and offsetAlign > 0_b );
 		ASSERT( dstMinSize == AlignToSmaller( dstMinSize, blockAlign ));
 
-		auto&	staging_buffers = _staging.hostToDevice;
-
-
-		// search in existing
+		auto&			staging_buffers = _staging.hostToDevice;
 		StagingBuffer*	suitable		= null;
-		StagingBuffer*	max_available	= null;
-		BytesU			max_size;
 
-		for (auto& buf : staging_buffers)
+		// only the last buffer may have free space
+		if ( staging_buffers.size() )
 		{
+			auto&			buf	= staging_buffers.back();
 			const BytesU	off	= AlignToLarger( buf.size, offsetAlign );
-			const BytesU	av	= AlignToSmaller( buf.capacity - off, blockAlign );
+			const BytesU	av	= off < buf.capacity ? AlignToSmaller( buf.capacity - off, blockAlign ) : 0_b;
 
-			if ( av >= srcRequiredSize )
-			{
+			if ( av >= srcRequiredSize or av >= dstMinSize )
 				suitable = &buf;
-				break;
-			}
-
-			if ( not max_available or av > max_size )
-			{
-				max_available	= &buf;
-				max_size		= av;
-			}
-		}
-
-		// no suitable space, try to use max available block
-		if ( not suitable and max_available and max_size >= dstMinSize )
-		{
-			suitable = max_available;
 		}
 
-		// allocate new buffer
+		// allocate new block
 		if ( not suitable )
 		{
-			ASSERT( dstMinSize < _staging.hostWritableBufferSize );
-			CHECK_ERR( staging_buffers.size() < staging_buffers.capacity() );
-
-			BufferID	buf_id = _frameGraph.CreateBuffer( BufferDesc{ _staging.hostWritableBufferSize, _staging.hostWritebleBufferUsage }, 
-															MemoryDesc{ EMemoryType::HostWrite }, "HostWriteBuffer" );
-			CHECK_ERR( buf_id );
-
-			RawMemoryID	mem_id = _frameGraph.GetResourceManager().GetResource( buf_id.Get() )->GetMemoryID();
-			CHECK_ERR( mem_id );
-
-			staging_buffers.push_back({ std::move(buf_id), mem_id, _staging.hostWritableBufferSize });
-
+			CHECK_ERR( _AddStagingBuffer( INOUT staging_buffers, _frameGraph.GetUploadRing(), srcRequiredSize, offsetAlign, dstMinSize,
+										  BufferDesc{ _staging.hostWritableBufferSize, _staging.hostWritebleBufferUsage },
+										  EMemoryType::HostWrite, "HostWriteBuffer" ));
 			suitable = &staging_buffers.back();
-			CHECK( _MapMemory( *suitable ));
 		}
 
 		// write data to buffer
 		dstOffset	= AlignToLarger( suitable->size, offsetAlign );
 		outSize		= Min( AlignToSmaller( suitable->capacity - dstOffset, blockAlign ), srcRequiredSize );
-		dstBuffer	= suitable->bufferId.Get();
+		dstBuffer	= suitable->bufferId;
 		mappedPtr	= suitable->mappedPtr + dstOffset;
 
 		suitable->size = dstOffset + outSize;
@@ -750,64 +876,36 @@ namespace FG
 		ASSERT( blockAlign > 0_b and offsetAlign > 0_b );
 		ASSERT( dstMinSize == AlignToSmaller( dstMinSize, blockAlign ));
 
-		auto&	staging_buffers = _staging.deviceToHost;
-		
-
-		// search in existing
+		auto&			staging_buffers = _staging.deviceToHost;
 		StagingBuffer*	suitable		= null;
-		StagingBuffer*	max_available	= null;
-		BytesU			max_size;
-
-		for (auto& buf : staging_buffers)
+		
+		// only the last buffer may have free space
+		if ( staging_buffers.size() )
 		{
+			auto&			buf	= staging_buffers.back();
 			const BytesU	off	= AlignToLarger( buf.size, offsetAlign );
-			const BytesU	av	= AlignToSmaller( buf.capacity - off, blockAlign );
+			const BytesU	av	= off < buf.capacity ? AlignToSmaller( buf.capacity - off, blockAlign ) : 0_b;
 
-			if ( av >= srcRequiredSize )
-			{
+			if ( av >= srcRequiredSize or av >= dstMinSize )
 				suitable = &buf;
-				break;
-			}
-			
-			if ( not max_available or av > max_size )
-			{
-				max_available	= &buf;
-				max_size		= av;
-			}
 		}
 
-		// no suitable space, try to use max available block
-		if ( not suitable and max_available and max_size >= dstMinSize )
-		{
-			suitable = max_available;
-		}
-
-		// allocate new buffer
+		// allocate new block
 		if ( not suitable )
 		{
-			ASSERT( dstMinSize < _staging.hostReadableBufferSize );
-			CHECK_ERR( staging_buffers.size() < staging_buffers.capacity() );
-
-			BufferID	buf_id = _frameGraph.CreateBuffer( BufferDesc{ _staging.hostReadableBufferSize, EBufferUsage::TransferDst },
-															MemoryDesc{ EMemoryType::HostRead }, "HostReadBuffer" );
-			CHECK_ERR( buf_id );
-			
-			RawMemoryID	mem_id = _frameGraph.GetResourceManager().GetResource( buf_id.Get() )->GetMemoryID();
-			CHECK_ERR( mem_id );
-
 			// TODO: make immutable because read after write happens after waiting for fences and it implicitly make changes visible to the host
 
-			staging_buffers.push_back({ std::move(buf_id), mem_id, _staging.hostReadableBufferSize });
-
+			CHECK_ERR( _AddStagingBuffer( INOUT staging_buffers, _frameGraph.GetReadbackRing(), srcRequiredSize, offsetAlign, dstMinSize,
+										  BufferDesc{ _staging.hostReadableBufferSize, EBufferUsage::TransferDst },
+										  EMemoryType::HostRead, "HostReadBuffer" ));
 			suitable = &staging_buffers.back();
-			CHECK( _MapMemory( *suitable ));
 		}
 		
 		// write data to buffer
-		range.buffer	= suitable;
-		range.offset	= AlignToLarger( suitable->size, offsetAlign );
-		range.size		= Min( AlignToSmaller( suitable->capacity - range.offset, blockAlign ), srcRequiredSize );
-		dstBuffer		= suitable->bufferId.Get();
+		range.bufferIndex	= uint(std::distance( staging_buffers.data(), suitable ));
+		range.offset		= AlignToLarger( suitable->size, offsetAlign );
+		range.size			= Min( AlignToSmaller( suitable->capacity - range.offset, blockAlign ), srcRequiredSize );
+		dstBuffer			= suitable->bufferId;
 
 		suitable->size = range.offset + range.size;
 		return true;
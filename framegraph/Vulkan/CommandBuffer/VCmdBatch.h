@@ -7,7 +7,10 @@
 #include "VDescriptorSetLayout.h"
 #include "VLocalDebugger.h"
 #include "VCommandPool.h"
+#include "VStagingRing.h"
 #include "stl/Containers/FixedTupleArray.h"
+#include "stl/Containers/FlatHashMap.h"
+#include "stl/Memory/LinearAllocator.h"
 
 namespace FG
 {
@@ -101,7 +104,11 @@ namespace FG
 			}
 		};
 		
-		using ResourceMap_t		= std::unordered_map< Resource, uint, ResourceHash >;		// TODO: custom allocator
+		// used while recording, memory is allocated by command buffer
+		using ResourceMap_t		= FlatHashMap< Resource, uint, ResourceHash, UntypedLinearAllocator<> >;
+
+		// resources will be released when batch complete execution
+		using ResourceArray_t	= Array< Pair< Resource, uint >>;
 
 
 		//---------------------------------------------------------------------------
@@ -114,33 +121,39 @@ namespace FG
 		struct StagingBuffer
 		{
 		// variables
-			BufferID		bufferId;
+			RawBufferID		bufferId;
 			RawMemoryID		memoryId;
-			BytesU			capacity;
-			BytesU			size;
+			BytesU			capacity;					// end of the available range in the buffer
+			BytesU			size;						// end of the used range in the buffer
 			
-			void *			mappedPtr	= null;
+			void *			mappedPtr	= null;			// pointer to the beginning of the buffer
 			BytesU			memOffset;					// can be used to flush memory ranges
 			VkDeviceMemory	mem			= VK_NULL_HANDLE;
 			bool			isCoherent	= false;
+			uint64_t		ringIndex	= UMax;			// block in the staging ring, 'UMax' if buffer is owned by the batch
 
 		// methods
 			StagingBuffer () {}
 
-			StagingBuffer (BufferID &&buf, RawMemoryID mem, BytesU capacity) :
-				bufferId{std::move(buf)}, memoryId{mem}, capacity{capacity} {}
+			StagingBuffer (RawBufferID buf, RawMemoryID mem, BytesU capacity) :
+				bufferId{buf}, memoryId{mem}, capacity{capacity} {}
+
+			explicit StagingBuffer (const VStagingRing::Block &block) :
+				bufferId{block.bufferId}, memoryId{block.memoryId}, capacity{block.offset + block.size}, size{block.offset},
+				mappedPtr{block.mappedPtr}, memOffset{block.memOffset}, mem{block.mem}, isCoherent{block.isCoherent}, ringIndex{block.index} {}
 
 			ND_ bool	IsFull ()	const	{ return size >= capacity; }
-			ND_ bool	Empty ()	const	{ return size == 0_b; }
 		};
 
+		using StagingBuffers_t	= Array< StagingBuffer >;
+
 
 		struct OnBufferDataLoadedEvent
 		{
 		// types
 			struct Range
 			{
-				StagingBuffer const*	buffer;
+				uint					bufferIndex;	// index in device-to-host staging buffers
 				BytesU					offset;
 				BytesU					size;
 			};
@@ -152,6 +165,7 @@ namespace FG
 			Callback_t		callback;
 			DataParts_t		parts;
 			BytesU			totalSize;
+			bool			isAsync		= false;	// callback is called on the completion thread
 
 		// methods
 			OnBufferDataLoadedEvent () {}
@@ -175,6 +189,7 @@ namespace FG
 			BytesU			slicePitch;
 			EPixelFormat	format		= Default;
 			EImageAspect	aspect		= EImageAspect::Color;
+			bool			isAsync		= false;	// callback is called on the completion thread
 
 		// methods
 			OnImageDataLoadedEvent () {}
@@ -233,8 +248,10 @@ namespace FG
 
 		static constexpr uint		MaxBatchItems = 8;
 		using CmdBuffers_t			= FixedTupleArray< MaxBatchItems, VkCommandBuffer, VCommandPool const* >;
+		using SecondaryCmdBuffers_t	= FixedTupleArray< FG_MaxSecondaryCmdBuffers, VkCommandBuffer, VCommandPool const* >;
 		using SignalSemaphores_t	= FixedArray< VkSemaphore, MaxBatchItems >;
 		using WaitSemaphores_t		= FixedTupleArray< MaxBatchItems, VkSemaphore, VkPipelineStageFlags >;
+		using SemaphoreValues_t		= FixedArray< uint64_t, MaxBatchItems >;
 		
 		using VkResourceArray_t		= Array<Pair< VkObjectType, uint64_t >>;
 
@@ -267,8 +284,11 @@ namespace FG
 		// command batch data
 		struct {
 			CmdBuffers_t						commands;
+			SecondaryCmdBuffers_t				secondaries;	// executed by primary command buffers, only recycled
 			SignalSemaphores_t					signalSemaphores;
 			WaitSemaphores_t					waitSemaphores;
+			SemaphoreValues_t					signalValues;	// for timeline semaphores, ignored for binary semaphores
+			SemaphoreValues_t					waitValues;
 		}									_batch;
 
 		// staging buffers
@@ -276,14 +296,14 @@ namespace FG
 			BytesU								hostWritableBufferSize;
 			BytesU								hostReadableBufferSize;
 			EBufferUsage						hostWritebleBufferUsage	= Default;
-			FixedArray< StagingBuffer, 8 >		hostToDevice;	// CPU write, GPU read
-			FixedArray< StagingBuffer, 8 >		deviceToHost;	// CPU read, GPU write
+			StagingBuffers_t					hostToDevice;	// CPU write, GPU read, only the last buffer is used for allocation
+			StagingBuffers_t					deviceToHost;	// CPU read, GPU write
 			Array< OnBufferDataLoadedEvent >	onBufferLoadedEvents;
 			Array< OnImageDataLoadedEvent >		onImageLoadedEvents;
 		}									_staging;
 
 		// resources
-		ResourceMap_t						_resourcesToRelease;
+		ResourceArray_t						_resourcesToRelease;
 		Swapchains_t						_swapchains;
 		VkResourceArray_t					_readyToDelete;
 
@@ -302,7 +322,8 @@ namespace FG
 		
 		Statistic_t							_statistic;
 
-		VSubmitted *						_submitted	= null;	// TODO: should be atomic
+		std::atomic<VSubmitted *>			_submitted	{null};
+		uint64_t							_timelineValue	= 0;	// value of the queue timeline semaphore that will be signaled when batch complete
 		
 		RWDataRaceCheck						_drCheck;
 
@@ -318,16 +339,17 @@ namespace FG
 		bool  OnBegin (const CommandBufferDesc &);
 		void  OnBeginRecording (VkCommandBuffer cmd);
 		void  OnEndRecording (VkCommandBuffer cmd);
-		bool  OnBaked (INOUT ResourceMap_t &);
+		bool  OnBaked (const ResourceMap_t &);
 		bool  OnReadyToSubmit ();
 		bool  BeforeSubmit (OUT VkSubmitInfo &);
-		bool  AfterSubmit (OUT Appendable<VSwapchain const*>, VSubmitted *);
+		bool  AfterSubmit (OUT Appendable<VSwapchain const*>, VSubmitted *, uint64_t timelineValue);
 		bool  OnComplete (VDebugger &, const ShaderDebugCallback_t &, INOUT Statistic_t &);
 
-		void  SignalSemaphore (VkSemaphore sem);
-		void  WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage);
+		void  SignalSemaphore (VkSemaphore sem, uint64_t value = 0);
+		void  WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage, uint64_t value = 0);
 		void  PushFrontCommandBuffer (VkCommandBuffer, const VCommandPool *);
 		void  PushBackCommandBuffer (VkCommandBuffer, const VCommandPool *);
+		void  PushSecondaryCommandBuffer (VkCommandBuffer, const VCommandPool *);
 		void  AddDependency (VCmdBatch *);
 		void  DestroyPostponed (VkObjectType type, uint64_t handle);
 	
@@ -352,12 +374,16 @@ namespace FG
 
 		ND_ BytesU					GetMaxWritableStoregeSize ()	const	{ SHAREDLOCK( _drCheck );  return _staging.hostWritableBufferSize / 4; }
 		ND_ BytesU					GetMaxReadableStorageSize ()	const	{ SHAREDLOCK( _drCheck );  return _staging.hostReadableBufferSize / 4; }
+		ND_ BytesU					GetMaxMappableSize ()			const;
 
 
-		ND_ EQueueType				GetQueueType ()					const	{ SHAREDLOCK( _drCheck );  return _queueType; }
-		ND_ EState					GetState ()								{ return _state.load( memory_order_relaxed ); }
+		ND_ EQueueType				GetQueueType ()					const	{ return _queueType; }		// immutable after 'Initialize'
+		ND_ EState					GetState ()								{ return _state.load( memory_order_acquire ); }
 		ND_ ArrayView<VCmdBatchPtr>	GetDependencies ()				const	{ SHAREDLOCK( _drCheck );  return _dependencies; }
-		ND_ VSubmitted *			GetSubmitted ()					const	{ SHAREDLOCK( _drCheck );  return _submitted; }		// TODO: rename
+		ND_ VSubmitted *			GetSubmitted ()					const	{ return _submitted.load( memory_order_acquire ); }		// TODO: rename
+		ND_ uint64_t				GetTimelineValue ()				const	{ ASSERT( _state.load( memory_order_acquire ) >= EState::Submitted );  return _timelineValue; }
+		ND_ ArrayView<uint64_t>		GetSignalSemaphoreValues ()		const	{ SHAREDLOCK( _drCheck );  return _batch.signalValues; }
+		ND_ ArrayView<uint64_t>		GetWaitSemaphoreValues ()		const	{ SHAREDLOCK( _drCheck );  return _batch.waitValues; }
 		ND_ uint					GetIndexInPool ()				const	{ return _indexInPool; }
 
 
@@ -381,8 +407,13 @@ namespace FG
 		// staging buffer //
 		bool  _AddPendingLoad (const BytesU srcRequiredSize, const BytesU blockAlign, const BytesU offsetAlign, const BytesU dstMinSize,
 							   OUT RawBufferID &dstBuffer, OUT OnBufferDataLoadedEvent::Range &range);
+		bool  _AddStagingBuffer (INOUT StagingBuffers_t &, VStagingRing &ring, BytesU srcRequiredSize, BytesU offsetAlign, BytesU dstMinSize,
+								 const BufferDesc &desc, EMemoryType memType, StringView dbgName);
 		bool  _MapMemory (INOUT StagingBuffer &) const;
 		void  _FinalizeStagingBuffers ();
+		static void  _TriggerDataLoadedEvent (const StagingBuffers_t &deviceToHost, const OnBufferDataLoadedEvent &ev);
+		static void  _TriggerDataLoadedEvent (const StagingBuffers_t &deviceToHost, const OnImageDataLoadedEvent &ev);
+		static void  _ReleaseStagingBuffers (VFrameGraph &fg, VStagingRing &ring, INOUT StagingBuffers_t &buffers);
 	};
 
 
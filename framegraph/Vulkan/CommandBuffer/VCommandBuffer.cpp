@@ -2,6 +2,7 @@
 
 #include "VCommandBuffer.h"
 #include "VTaskGraph.hpp"
+#include "Shared/PipelineResourcesHelper.h"
 
 namespace FG
 {
@@ -10,6 +11,8 @@ namespace {
 	static constexpr auto	ComputeBit		= EQueueUsage::Graphics | EQueueUsage::AsyncCompute;
 	static constexpr auto	RayTracingBit	= EQueueUsage::Graphics | EQueueUsage::AsyncCompute;
 	static constexpr auto	TransferBit		= EQueueUsage::Graphics | EQueueUsage::AsyncCompute | EQueueUsage::AsyncTransfer;
+
+	static constexpr uint	FirstVisitorID	= 1;
 }
 	
 /*
@@ -25,6 +28,10 @@ namespace {
 	{
 		_mainAllocator.SetBlockSize( 16_Mb );
 
+		for (auto& worker : _workers) {
+			worker.allocator.SetBlockSize( 1_Mb );
+		}
+
 		_ResetLocalRemaping();
 	}
 	
@@ -42,6 +49,22 @@ namespace {
 			q.Destroy( GetDevice() );
 		}
 		_perQueue.clear();
+
+		for (auto& worker : _workers)
+		{
+			for (auto& q : worker.perQueue) {
+				q.Destroy( GetDevice() );
+			}
+			worker.perQueue.clear();
+		}
+
+		for (auto& per_queue : _drawCmdPools)
+		{
+			for (auto& q : per_queue) {
+				q.Destroy( GetDevice() );
+			}
+			per_queue.clear();
+		}
 	}
 
 /*
@@ -59,6 +82,10 @@ namespace {
 		_dbgName	= desc.name;
 		_state		= EState::Recording;
 		_queueIndex	= queue->familyIndex;
+		_queue		= queue;
+
+		// local debugger is not thread safe, so parallel recording is disabled
+		_workerCount = (desc.debugFlags != Default ? 0 : Min( desc.recordingThreads, FG_MaxRecordingThreads ));
 		
 		// create command pool
 		{
@@ -72,6 +99,19 @@ namespace {
 			{
 				CHECK_ERR( pool.Create( GetDevice(), queue ));
 			}
+
+			// each worker thread records commands into its own command pool
+			for (uint i = 0; _workerCount > 1 and i < _workerCount; ++i)
+			{
+				auto&	per_queue = _workers[i].perQueue;
+
+				per_queue.resize( Max( per_queue.size(), index+1 ));
+
+				if ( not per_queue[index].IsCreated() )
+				{
+					CHECK_ERR( per_queue[index].Create( GetDevice(), queue ));
+				}
+			}
 		}
 		
 		_batch->OnBegin( desc );
@@ -88,6 +128,11 @@ namespace {
 			_debugger.reset();
 
 		_taskGraph.OnStart( GetAllocator() );
+		_taskChains.OnStart( GetAllocator(), _workerCount > 1 );
+		_transients.OnStart( GetAllocator() );
+
+		_rm.resourceMap.Create( _mainAllocator );
+		_rm.resourceMap->reserve( 128 );
 		return true;
 	}
 	
@@ -112,10 +157,20 @@ namespace {
 		if ( _debugger )
 			_debugger->End( GetName(), _indexInPool, OUT &_batch->_debugDump, OUT &_batch->_debugGraph );
 
-		CHECK_ERR( _batch->OnBaked( INOUT _rm.resourceMap ));
+		CHECK_ERR( _batch->OnBaked( *_rm.resourceMap ));
 		
 		_taskGraph.OnDiscardMemory();
+		_taskChains.OnDiscardMemory();
+		_transients.OnDiscardMemory();
+		_rm.resourceMap.Destroy();
 		_AfterCompilation();
+
+		// all temporary data was destroyed, memory can be reused
+		_mainAllocator.Discard();
+
+		for (uint i = 0; i < _workerCount; ++i) {
+			_workers[i].allocator.Discard();
+		}
 		
 		EditStatistic().renderer.cpuTime += TimePoint_t::clock::now() - start_time;
 		_batch = null;
@@ -142,7 +197,8 @@ namespace {
 				_rm.logicalRenderPasses.Unassign( Index_t(i) );
 			}
 		}
-		_rm.logicalRenderPassCount = 0;
+		_rm.logicalRenderPassCount	= 0;
+		_rm.secondaryCount			= 0;
 	}
 
 /*
@@ -182,8 +238,22 @@ namespace {
 		//	return true;
 
 		VkCommandBuffer		cmd;
-		VDevice const&		dev	= GetDevice();
+		VDevice const&		dev			= GetDevice();
+		ExeOrderIndex		exe_order	= ExeOrderIndex::First;
+		WorkerPool::ParallelJobs	recording;
+
+		const uint	worker_count = _StartParallelRecording( INOUT exe_order, OUT recording );
 		
+		// execution order must be known before memory binding for transient resources
+		TempTaskArray_t		ordered{ GetAllocator() };
+		_SortTasks( exe_order, OUT ordered );
+
+		if ( not _transients.Allocate( GetResourceManager(), INOUT *_rm.resourceMap, INOUT EditStatistic().resources ))
+		{
+			recording.Wait();
+			RETURN_ERR( "failed to allocate memory for transient resources" );
+		}
+
 		// create command buffer
 		{
 			auto&	pool = _perQueue[ uint(_queueIndex) ];
@@ -203,15 +273,36 @@ namespace {
 		}
 
 		// commit image layout transition and other
-		_barrierMngr.Commit( dev, cmd );
+		_barrierMngr.Commit( dev, cmd, INOUT EditStatistic().renderer );
 
-		CHECK( _ProcessTasks( cmd ));
+		CHECK( _ProcessTasks( cmd, ordered ));
+
+		// independent chains don't use resources of other tasks, so they can be executed after all other tasks
+		if ( worker_count )
+		{
+			StaticArray< VkCommandBuffer, FG_MaxRecordingThreads >	secondaries;
+
+			recording.Wait();
+
+			for (uint i = 0; i < worker_count; ++i)
+			{
+				auto&	worker = _workers[i];
+
+				secondaries[i]	= worker.cmd;
+				worker.cmd		= VK_NULL_HANDLE;
+				worker.tasks.Destroy();
+
+				EditStatistic().Merge( worker.stat );
+			}
+
+			dev.vkCmdExecuteCommands( cmd, worker_count, secondaries.data() );
+		}
 
 		// transit image layout to default state
 		// add memory dependency to flush caches
 		{
 			_FlushLocalResourceStates( ExeOrderIndex::Final, _barrierMngr, GetDebugger() );
-			_barrierMngr.ForceCommit( dev, cmd, dev.GetAllWritableStages(), dev.GetAllReadableStages() );
+			_barrierMngr.ForceCommit( dev, cmd, dev.GetAllWritableStages(), dev.GetAllReadableStages(), INOUT EditStatistic().renderer );
 		}
 
 		// end
@@ -232,27 +323,35 @@ namespace {
 		// reset states
 		_currTask = node;
 		
-		if ( _fgThread.GetDebugger() )
-			_fgThread.GetDebugger()->AddTask( _currTask );
+		if ( _debugger )
+			_debugger->AddTask( _currTask );
 
 		node->Process( this );
 	}
 
 /*
 =================================================
-	_ProcessTasks
+	_SortTasks
+----
+	tasks are sorted in topological order,
+	execution order index is assigned to each task.
 =================================================
 */
-	bool VCommandBuffer::_ProcessTasks (VkCommandBuffer cmd)
+	void VCommandBuffer::_SortTasks (ExeOrderIndex exeOrderIndex, OUT TempTaskArray_t &ordered)
 	{
-		VTaskProcessor	processor{ *this, cmd };
-
-		uint			visitor_id		= 1;
-		ExeOrderIndex	exe_order_index	= ExeOrderIndex::First;
+		uint			visitor_id		= FirstVisitorID;
+		ExeOrderIndex	exe_order_index	= exeOrderIndex;
 
 		TempTaskArray_t		pending{ GetAllocator() };
 		pending.reserve( 128 );
-		pending.assign( _taskGraph.Entries().begin(), _taskGraph.Entries().end() );
+		ordered.reserve( 128 );
+
+		for (auto task : _taskGraph.Entries())
+		{
+			// skip tasks that are recorded on the worker threads
+			if ( task->VisitorID() != visitor_id )
+				pending.push_back( task );
+		}
 
 		for (uint k = 0; k < 10 and not pending.empty(); ++k)
 		{
@@ -284,7 +383,7 @@ namespace {
 				node->SetVisitorID( visitor_id );
 				node->SetExecutionOrder( ++exe_order_index );
 				
-				processor.Run( node );
+				ordered.push_back( node );
 
 				for (auto out_node : node->Outputs())
 				{
@@ -294,8 +393,152 @@ namespace {
 				pending.erase( pending.begin()+i );
 			}
 		}
+	}
+
+/*
+=================================================
+	_ProcessTasks
+=================================================
+*/
+	bool VCommandBuffer::_ProcessTasks (VkCommandBuffer cmd, ArrayView<VTask> ordered)
+	{
+		VTaskProcessor	processor{ *this, cmd };
+
+		for (auto node : ordered)
+		{
+			// transient resource reuses memory that was used by another resource
+			if ( _transients.IsAliasingBarrierRequired( node->ExecutionOrder() ))
+			{
+				VkMemoryBarrier	barrier = {};
+				barrier.sType			= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+				barrier.srcAccessMask	= VK_ACCESS_MEMORY_WRITE_BIT;
+				barrier.dstAccessMask	= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+				_barrierMngr.AddMemoryBarrier( VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, barrier );
+			}
+
+			processor.Run( node );
+		}
 		return true;
 	}
+	
+/*
+=================================================
+	_StartParallelRecording
+----
+	independent chains of transfer tasks are recorded into secondary command buffers
+	on the frame graph worker threads, returns number of started workers.
+=================================================
+*/
+	uint  VCommandBuffer::_StartParallelRecording (INOUT ExeOrderIndex &exeOrderIndex, OUT WorkerPool::ParallelJobs &jobs)
+	{
+		if ( not _taskChains.IsEnabled() )
+			return 0;
+
+		StaticArray< TempTaskArray_t*, FG_MaxRecordingThreads >	worker_tasks;
+
+		for (uint i = 0; i < _workerCount; ++i)
+		{
+			_workers[i].tasks.Create( _workers[i].allocator );
+			worker_tasks[i] = &(*_workers[i].tasks);
+		}
+
+		const uint	count = _taskChains.Distribute( ArrayView<TempTaskArray_t*>{ worker_tasks.data(), _workerCount });
+
+		for (uint i = count; i < _workerCount; ++i) {
+			_workers[i].tasks.Destroy();
+		}
+
+		if ( count == 0 )
+			return 0;
+
+		// tasks are recorded in submission order that is valid execution order,
+		// visitor id is used to skip these tasks in '_ProcessTasks'
+		for (uint i = 0; i < count; ++i)
+		{
+			for (auto task : *_workers[i].tasks)
+			{
+				task->SetVisitorID( FirstVisitorID );
+				task->SetExecutionOrder( ++exeOrderIndex );
+			}
+		}
+
+		// access records of resources will grow in the worker allocator
+		for (uint id = 0; id < _rm.images.maxGlobalIndex; ++id)
+		{
+			const Index_t	local = _rm.images.toLocal[id];
+
+			if ( local == UMax )
+				continue;
+
+			const uint	worker = _taskChains.WorkerOf( VTaskChains::EResource::Image, id );
+
+			if ( worker < count )
+				_rm.images.pool[ local ].Data().SetAllocator( _workers[worker].allocator );
+		}
+
+		for (uint id = 0; id < _rm.buffers.maxGlobalIndex; ++id)
+		{
+			const Index_t	local = _rm.buffers.toLocal[id];
+
+			if ( local == UMax )
+				continue;
+
+			const uint	worker = _taskChains.WorkerOf( VTaskChains::EResource::Buffer, id );
+
+			if ( worker < count )
+				_rm.buffers.pool[ local ].Data().SetAllocator( _workers[worker].allocator );
+		}
+
+		for (uint i = 0; i < count; ++i)
+		{
+			auto&	worker	= _workers[i];
+			auto&	pool	= worker.perQueue[ uint(_queueIndex) ];
+
+			worker.cmd	= pool.AllocSecondary( GetDevice() );
+			worker.stat	= Statistic_t{};
+			_batch->PushSecondaryCommandBuffer( worker.cmd, &pool );
+		}
+
+		jobs = _instance.GetRecordingWorkers().RunParallel( count, [this] (uint i) { _RecordSecondary( _workers[i] ); });
+		return count;
+	}
+	
+/*
+=================================================
+	_RecordSecondary
+----
+	called from the worker thread, must not use anything that is protected by '_drCheck'.
+=================================================
+*/
+	void  VCommandBuffer::_RecordSecondary (RecordingWorker &worker)
+	{
+		VDevice const&	dev	= GetDevice();
+
+		// begin
+		{
+			VkCommandBufferInheritanceInfo	inheritance = {};
+			inheritance.sType	= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+			VkCommandBufferBeginInfo	info = {};
+			info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			info.pInheritanceInfo	= &inheritance;
+
+			VK_CALL( dev.vkBeginCommandBuffer( worker.cmd, &info ));
+		}
+
+		// record tasks
+		{
+			VTaskProcessor	processor{ *this, worker.cmd, worker.allocator, worker.barrierMngr, null, worker.stat.renderer };
+
+			for (auto task : *worker.tasks) {
+				processor.Run( task );
+			}
+		}
+
+		VK_CALL( dev.vkEndCommandBuffer( worker.cmd ));
+	}
 //-----------------------------------------------------------------------------
 
 	
@@ -317,6 +560,9 @@ namespace {
 
 		_batch->_swapchains.push_back( swapchain );
 
+		// swapchain image is presented on the calling thread
+		_taskChains.AddResource( VTaskChains::EResource::Image, uint(id.Index()) );
+
 		return id;
 	}
 
@@ -378,6 +624,114 @@ namespace {
 		return _batch->GetWritable( size, 1_b, align, size, OUT buffer, OUT offset, OUT buf_size, OUT mapped );
 	}
 
+/*
+=================================================
+	MapBufferUpdate
+----
+	staging memory is allocated as a single block,
+	so data can be written directly without intermediate copy.
+=================================================
+*/
+	Task  VCommandBuffer::MapBufferUpdate (RawBufferID dstBuffer, BytesU offset, BytesU size, OUT void* &mapped, ArrayView<Task> dependsOn)
+	{
+		EXLOCK( _drCheck );
+		mapped = null;
+
+		CHECK_ERR( _IsRecording() );
+		ASSERT( EnumEq( TransferBit, _GetQueueUsage() ));
+		CHECK_ERR( dstBuffer and size > 0 );
+		CHECK_ERR( size <= _batch->GetMaxMappableSize() );
+
+		RawBufferID		src_buffer;
+		BytesU			src_offset, src_size;
+		void *			src_ptr		= null;
+		CHECK_ERR( _batch->GetWritable( size, 1_b, 16_b, size, OUT src_buffer, OUT src_offset, OUT src_size, OUT src_ptr ));
+		CHECK_ERR( src_size == size );
+
+		CopyBuffer	copy;
+		copy.taskName	= "MapBufferUpdate";
+		copy.debugColor	= ColorScheme::HostToDeviceTransfer;
+		copy.srcBuffer	= src_buffer;
+		copy.dstBuffer	= dstBuffer;
+		copy.AddRegion( src_offset, offset, size );
+
+		for (auto& dep : dependsOn) {
+			copy.DependsOn( dep );
+		}
+
+		Task	task = AddTask( copy );
+		CHECK_ERR( task );
+
+		mapped = src_ptr;
+		return task;
+	}
+	
+/*
+=================================================
+	MapImageUpdate
+----
+	rows and slices are tightly packed.
+=================================================
+*/
+	Task  VCommandBuffer::MapImageUpdate (RawImageID dstImage, const int3 &offset, const uint3 &size, MipmapLevel mipmap, ImageLayer layer, EImageAspect aspect,
+										  OUT void* &mapped, OUT BytesU &rowPitch, OUT BytesU &slicePitch, ArrayView<Task> dependsOn)
+	{
+		EXLOCK( _drCheck );
+		mapped		= null;
+		rowPitch	= 0_b;
+		slicePitch	= 0_b;
+
+		CHECK_ERR( _IsRecording() );
+		ASSERT( EnumEq( TransferBit, _GetQueueUsage() ));
+		CHECK_ERR( dstImage and Any( size > uint3(0) ));
+		
+		ImageDesc const&	img_desc = AcquireTemporary( dstImage )->Description();
+
+		ASSERT( mipmap < img_desc.maxLevel );
+		ASSERT( layer < img_desc.arrayLayers );
+
+		const uint3		image_size	= Max( size, 1u );
+		const auto&		fmt_info	= EPixelFormat_GetInfo( img_desc.format );
+		const auto&		block_dim	= fmt_info.blockSize;
+		const uint		block_size	= aspect != EImageAspect::Stencil ? fmt_info.bitsPerBlock : fmt_info.bitsPerBlock2;
+		
+		ASSERT( offset.x % block_dim.x == 0 );
+		ASSERT( offset.y % block_dim.y == 0 );
+
+		const BytesU	row_pitch	= BytesU(image_size.x * block_size + block_dim.x-1) / (block_dim.x * 8);
+		const BytesU	slice_pitch	= (image_size.y * row_pitch + block_dim.y-1) / block_dim.y;
+		const BytesU	total_size	= slice_pitch * image_size.z;
+		const uint		row_length	= uint((row_pitch * block_dim.x * 8) / block_size);
+		const uint		img_height	= uint((slice_pitch * block_dim.y) / row_pitch);
+
+		CHECK_ERR( total_size <= _batch->GetMaxMappableSize() );
+
+		RawBufferID		src_buffer;
+		BytesU			src_offset, src_size;
+		void *			src_ptr		= null;
+		CHECK_ERR( _batch->GetWritable( total_size, 1_b, 16_b, total_size, OUT src_buffer, OUT src_offset, OUT src_size, OUT src_ptr ));
+		CHECK_ERR( src_size == total_size );
+
+		CopyBufferToImage	copy;
+		copy.taskName	= "MapImageUpdate";
+		copy.debugColor	= ColorScheme::HostToDeviceTransfer;
+		copy.srcBuffer	= src_buffer;
+		copy.dstImage	= dstImage;
+		copy.AddRegion( src_offset, row_length, img_height, ImageSubresourceRange{ mipmap, layer, 1, aspect }, offset, image_size );
+		
+		for (auto& dep : dependsOn) {
+			copy.DependsOn( dep );
+		}
+
+		Task	task = AddTask( copy );
+		CHECK_ERR( task );
+
+		mapped		= src_ptr;
+		rowPitch	= row_pitch;
+		slicePitch	= slice_pitch;
+		return task;
+	}
+
 /*
 =================================================
 	AcquireImage
@@ -410,6 +764,48 @@ namespace {
 		}
 	}
 
+/*
+=================================================
+	CreateTransientImage
+=================================================
+*/
+	RawImageID  VCommandBuffer::CreateTransientImage (const ImageDesc &desc, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+
+		auto&		res_mngr	= GetResourceManager();
+		RawImageID	id			= res_mngr.CreateTransientImage( desc, Default, dbgName );
+		CHECK_ERR( id );
+
+		// image will be destroyed when command batch complete execution
+		ReleaseResource( id );
+
+		_transients.Add( id, res_mngr.GetResource( id )->GetMemoryRequirements( GetDevice() ));
+		return id;
+	}
+	
+/*
+=================================================
+	CreateTransientBuffer
+=================================================
+*/
+	RawBufferID  VCommandBuffer::CreateTransientBuffer (const BufferDesc &desc, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+
+		auto&		res_mngr	= GetResourceManager();
+		RawBufferID	id			= res_mngr.CreateTransientBuffer( desc, Default, dbgName );
+		CHECK_ERR( id );
+		
+		// buffer will be destroyed when command batch complete execution
+		ReleaseResource( id );
+
+		_transients.Add( id, res_mngr.GetResource( id )->GetMemoryRequirements( GetDevice() ));
+		return id;
+	}
+
 /*
 =================================================
 	AddTask (SubmitRenderPass)
@@ -423,6 +819,10 @@ namespace {
 
 		auto*	rp_task = _taskGraph.Add( *this, task );
 
+		// draw tasks and attachments of the render pass are used by this task
+		if ( rp_task )
+			_transients.SubmitPass( rp_task->GetLogicalPass(), rp_task );
+
 		// TODO
 		//_renderPassGraph.Add( rp_task );
 
@@ -832,6 +1232,8 @@ namespace {
 		OnDataLoadedEvent	load_event{ task.callback, task.size };
 		CopyBuffer			copy;
 
+		load_event.isAsync = task.asyncCallback;
+
 		copy.taskName	= task.taskName;
 		copy.debugColor	= task.debugColor;
 		copy.depends	= task.depends;
@@ -911,6 +1313,8 @@ namespace {
 		OnDataLoadedEvent	load_event{ task.callback, total_size, image_size, row_pitch, slice_pitch, img_desc.format, task.aspectMask };
 		CopyImageToBuffer	copy;
 
+		load_event.isAsync = task.asyncCallback;
+
 		copy.taskName	= task.taskName;
 		copy.debugColor	= task.debugColor;
 		copy.depends	= task.depends;
@@ -1343,6 +1747,60 @@ namespace {
 		return _taskGraph.Add( *this, task );
 	}
 
+/*
+=================================================
+	BeginSecondary
+----
+	can be called while draw tasks are added to other secondary command buffers.
+=================================================
+*/
+	IDrawCommandBuffer*  VCommandBuffer::BeginSecondary (LogicalPassID renderPass)
+	{
+		std::unique_lock	lock{ _secondaryGuard };
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+		ASSERT( EnumEq( GraphicsBit, _GetQueueUsage() ));
+
+		// some secondary command buffers are reserved for transfer workers
+		CHECK_ERR( _rm.secondaryCount + FG_MaxRecordingThreads < FG_MaxSecondaryCmdBuffers );
+
+		auto *	rp = ToLocal( renderPass );
+		CHECK_ERR( rp );
+
+		const uint	pool_index	= uint(rp->GetSecondaries().size()) % FG_MaxRecordingThreads;
+		const uint	queue_index	= uint(_queueIndex);
+		auto&		per_queue	= _drawCmdPools[ pool_index ];
+
+		per_queue.resize( Max( per_queue.size(), queue_index+1 ));
+
+		if ( not per_queue[queue_index].IsCreated() )
+		{
+			CHECK_ERR( per_queue[queue_index].Create( GetDevice(), _queue ));
+		}
+
+		auto*	result = rp->CreateSecondary( *this, _secondaryGuard );
+		CHECK_ERR( result );
+
+		++_rm.secondaryCount;
+		return result;
+	}
+
+/*
+=================================================
+	_IsPipelineReady
+----
+	pipeline may be created asynchronously, draw task is skipped until pipeline is ready.
+=================================================
+*/
+	bool  VCommandBuffer::_IsPipelineReady (RawGPipelineID id)
+	{
+		if ( not id or GetResourceManager().IsPipelineReady( id ))
+			return true;
+
+		++EditStatistic().renderer.drawCallsSkipped;
+		return false;
+	}
+
 /*
 =================================================
 	AddTask (DrawVertices)
@@ -1357,10 +1815,15 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		if ( not _IsPipelineReady( task.pipeline ))
+			return;
+
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<DrawVertices> >( 
 						*this, task,
 						VTaskProcessor::Visit1_DrawVertices,
 						VTaskProcessor::Visit2_DrawVertices );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1377,10 +1840,15 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		if ( not _IsPipelineReady( task.pipeline ))
+			return;
+
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<DrawIndexed> >(
 						*this, task,
 						VTaskProcessor::Visit1_DrawIndexed,
 						VTaskProcessor::Visit2_DrawIndexed );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1397,10 +1865,12 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<DrawMeshes> >(
 						*this, task,
 						VTaskProcessor::Visit1_DrawMeshes,
 						VTaskProcessor::Visit2_DrawMeshes );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1417,10 +1887,15 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		if ( not _IsPipelineReady( task.pipeline ))
+			return;
+
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<DrawVerticesIndirect> >(
 						*this, task,
 						VTaskProcessor::Visit1_DrawVerticesIndirect,
 						VTaskProcessor::Visit2_DrawVerticesIndirect );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1437,10 +1912,15 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		if ( not _IsPipelineReady( task.pipeline ))
+			return;
+
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<DrawIndexedIndirect> >(
 						*this, task,
 						VTaskProcessor::Visit1_DrawIndexedIndirect,
 						VTaskProcessor::Visit2_DrawIndexedIndirect );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1457,10 +1937,12 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<DrawMeshesIndirect> >(
 						*this, task,
 						VTaskProcessor::Visit1_DrawMeshesIndirect,
 						VTaskProcessor::Visit2_DrawMeshesIndirect );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1477,10 +1959,12 @@ namespace {
 		auto *	rp  = ToLocal( renderPass );
 		CHECK_ERR( rp, void());
 
+		_transients.BeginPass( rp );
 		rp->AddTask< VFgDrawTask<CustomDraw> >(
 						*this, task,
 						VTaskProcessor::Visit1_CustomDraw,
 						VTaskProcessor::Visit2_CustomDraw );
+		_transients.EndPass();
 	}
 	
 /*
@@ -1514,7 +1998,12 @@ namespace {
 		auto&		data = _rm.logicalRenderPasses[ index ];
 		Replace( data );
 
-		if ( not data.Create( *this, desc ) )
+		// render targets are used when render pass is submitted
+		_transients.BeginPass( &data.Data() );
+		const bool	created = data.Create( *this, desc );
+		_transients.EndPass();
+
+		if ( not created )
 		{
 			_rm.logicalRenderPasses.Unassign( index );
 			RETURN_ERR( "failed when creating logical render pass" );
@@ -1606,6 +2095,22 @@ namespace {
 
 		if ( id.Index() >= localRes.toLocal.size() )
 			return null;
+		
+		// tasks that use the same image or buffer must be recorded on the same thread
+		if ( _state == EState::Recording )
+		{
+			if constexpr( IsSameTypes<Res, VLocalImage> )
+				_taskChains.AddResource( VTaskChains::EResource::Image, uint(id.Index()) );
+
+			if constexpr( IsSameTypes<Res, VLocalBuffer> )
+				_taskChains.AddResource( VTaskChains::EResource::Buffer, uint(id.Index()) );
+
+			if constexpr( IsSameTypes<Res, VLocalImage> or IsSameTypes<Res, VLocalBuffer> )
+			{
+				if ( _transients.AddUsage( id ))
+					_taskChains.AddSerialResource();
+			}
+		}
 
 		Index_t&	local = localRes.toLocal[ id.Index() ];
 
@@ -1624,8 +2129,16 @@ namespace {
 
 		auto&	data = localRes.pool[ local ];
 		Replace( data );
-		
-		if ( not data.Create( res ) )
+
+		bool	created;
+
+		// access records of local images and buffers are allocated in the command buffer allocator
+		if constexpr( IsSameTypes<Res, VLocalImage> or IsSameTypes<Res, VLocalBuffer> )
+			created = data.Create( res, uint(local), _mainAllocator );
+		else
+			created = data.Create( res, uint(local) );
+
+		if ( not created )
 		{
 			localRes.pool.Unassign( local );
 			RETURN_ERR( msg );
@@ -1673,6 +2186,104 @@ namespace {
 		return &data.Data();
 	}
 
+/*
+=================================================
+	_AddChainResources
+----
+	descriptor set resources are converted to local resources only when task is processed,
+	so they are attached to the current task chain here.
+=================================================
+*/
+	void  VCommandBuffer::_AddChainResources (const VPipelineResources &res)
+	{
+		struct Visitor
+		{
+			VTaskChains &	chains;
+
+			void operator () (const UniformID &, const PipelineResources::Buffer &buf)
+			{
+				for (uint i = 0; i < buf.elementCount; ++i) {
+					if ( buf.elements[i].bufferId )
+						chains.AddResource( VTaskChains::EResource::Buffer, uint(buf.elements[i].bufferId.Index()) );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Image &img)
+			{
+				for (uint i = 0; i < img.elementCount; ++i) {
+					if ( img.elements[i].imageId )
+						chains.AddResource( VTaskChains::EResource::Image, uint(img.elements[i].imageId.Index()) );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Texture &tex)
+			{
+				for (uint i = 0; i < tex.elementCount; ++i) {
+					if ( tex.elements[i].imageId )
+						chains.AddResource( VTaskChains::EResource::Image, uint(tex.elements[i].imageId.Index()) );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Sampler &) {}
+			void operator () (const UniformID &, const PipelineResources::RayTracingScene &) {}
+		};
+
+		Visitor	visitor{ _taskChains };
+		res.ForEachUniform( visitor );
+	}
+
+/*
+=================================================
+	_AddTransientResources
+----
+	descriptor set that references transient resources
+	is updated when memory is bound.
+=================================================
+*/
+	void  VCommandBuffer::_AddTransientResources (const PipelineResources &desc, const VPipelineResources &res)
+	{
+		struct Visitor
+		{
+			VTransientResources &	transients;
+			bool					found	= false;
+
+			void operator () (const UniformID &, const PipelineResources::Buffer &buf)
+			{
+				for (uint i = 0; i < buf.elementCount; ++i) {
+					found |= transients.AddUsage( buf.elements[i].bufferId );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Image &img)
+			{
+				for (uint i = 0; i < img.elementCount; ++i) {
+					found |= transients.AddUsage( img.elements[i].imageId );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Texture &tex)
+			{
+				for (uint i = 0; i < tex.elementCount; ++i) {
+					found |= transients.AddUsage( tex.elements[i].imageId );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Sampler &) {}
+			void operator () (const UniformID &, const PipelineResources::RayTracingScene &) {}
+		};
+
+		Visitor	visitor{ _transients };
+		res.ForEachUniform( visitor );
+
+		if ( not visitor.found )
+			return;
+
+		_taskChains.AddSerialResource();
+
+		if ( res.IsDeferred() )
+			_transients.AddDeferred( PipelineResourcesHelper::GetCached( desc ));
+	}
+
 /*
 =================================================
 	_ResetLocalRemaping
@@ -4,6 +4,8 @@
 
 #include "framegraph/Public/FrameGraph.h"
 #include "VTaskGraph.h"
+#include "VTaskChains.h"
+#include "VTransientResources.h"
 #include "VBarrierManager.h"
 #include "VTaskProcessor.h"
 #include "VPipelineCache.h"
@@ -65,6 +67,21 @@ namespace FG
 		using LocalRTGeometries_t	= LocalResPool< VLocalRTGeometry,	VResourceManager::RTGeometryPool_t,	16 >;
 		using LogicalRenderPasses_t	= PoolTmpl< VLogicalRenderPass,		1u<<10,								16 >;
 		
+		// records independent task chains into secondary command buffer
+		struct RecordingWorker
+		{
+			Allocator_t					allocator;
+			VBarrierManager				barrierMngr;
+			PerQueueArray_t				perQueue;
+			Statistic_t					stat;
+			InPlace<TempTaskArray_t>	tasks;
+			VkCommandBuffer				cmd		= VK_NULL_HANDLE;
+		};
+		using RecordingWorkers_t	= StaticArray< RecordingWorker, FG_MaxRecordingThreads >;
+
+		// secondary command buffers of the render pass are recorded on different threads, each thread uses its own command pool
+		using DrawCmdPools_t		= StaticArray< PerQueueArray_t, FG_MaxRecordingThreads >;
+
 
 
 	// variables
@@ -74,6 +91,7 @@ namespace FG
 		EState					_state;
 		VCmdBatchPtr			_batch;
 		EQueueFamily			_queueIndex;
+		VDeviceQueueInfoPtr		_queue;
 
 		VFrameGraph &			_instance;
 		const uint				_indexInPool;
@@ -81,14 +99,23 @@ namespace FG
 		VPipelineCache			_pipelineCache;
 		Debugger_t				_debugger;
 
+		VTaskChains				_taskChains;
+		VTransientResources		_transients;
+		RecordingWorkers_t		_workers;
+		uint					_workerCount		= 0;		// number of workers that can be used, 0 or 1 if parallel recording is disabled
+
+		DrawCmdPools_t			_drawCmdPools;
+		std::mutex				_secondaryGuard;				// protects resource manager while draw tasks are added to the secondary command buffers
+
 		struct {
-			ResourceMap_t			resourceMap;
+			InPlace<ResourceMap_t>	resourceMap;
 			LocalImages_t			images;
 			LocalBuffers_t			buffers;
 			LocalRTScenes_t			rtScenes;
 			LocalRTGeometries_t		rtGeometries;
 			LogicalRenderPasses_t	logicalRenderPasses;
 			uint					logicalRenderPassCount	= 0;
+			uint					secondaryCount			= 0;
 		}						_rm;
 		
 		PerQueueArray_t			_perQueue;
@@ -118,6 +145,13 @@ namespace FG
 		void		AcquireImage (RawImageID id, bool makeMutable, bool invalidate);
 		void		AcquireBuffer (RawBufferID id, bool makeMutable);
 
+		Task		MapBufferUpdate (RawBufferID dstBuffer, BytesU offset, BytesU size, OUT void* &mapped, ArrayView<Task> dependsOn) override;
+		Task		MapImageUpdate (RawImageID dstImage, const int3 &offset, const uint3 &size, MipmapLevel mipmap, ImageLayer layer, EImageAspect aspect,
+									OUT void* &mapped, OUT BytesU &rowPitch, OUT BytesU &slicePitch, ArrayView<Task> dependsOn) override;
+
+		RawImageID	CreateTransientImage (const ImageDesc &desc, StringView dbgName) override;
+		RawBufferID	CreateTransientBuffer (const BufferDesc &desc, StringView dbgName) override;
+
 
 		// tasks //
 		Task		AddTask (const SubmitRenderPass &) override;
@@ -147,6 +181,7 @@ namespace FG
 
 		// draw tasks //
 		LogicalPassID  CreateRenderPass (const RenderPassDesc &desc) override;
+		IDrawCommandBuffer*  BeginSecondary (LogicalPassID) override;
 
 		void		AddTask (LogicalPassID, const DrawVertices &) override;
 		void		AddTask (LogicalPassID, const DrawIndexed &) override;
@@ -180,6 +215,9 @@ namespace FG
 		ND_ VPipelineCache &		GetPipelineCache ()					{ EXLOCK( _drCheck );  return _pipelineCache; }
 		ND_ VBarrierManager &		GetBarrierManager ()				{ EXLOCK( _drCheck );  return _barrierMngr; }
 		ND_ Ptr<VLocalDebugger>		GetDebugger ()						{ EXLOCK( _drCheck );  return _debugger.get(); }
+		ND_ VTaskChains &			GetTaskChains ()					{ EXLOCK( _drCheck );  return _taskChains; }
+		ND_ VTransientResources &	GetTransients ()					{ EXLOCK( _drCheck );  return _transients; }
+		ND_ VCommandPool &			GetDrawCommandPool (uint index)		{ EXLOCK( _drCheck );  return _drawCmdPools[index][ uint(_queueIndex) ]; }
 		ND_ VDevice const&			GetDevice ()				const	{ return _instance.GetDevice(); }
 		ND_ VFrameGraph &			GetInstance ()				const	{ return _instance; }
 		ND_ VResourceManager &		GetResourceManager ()		const	{ return _instance.GetResourceManager(); }
@@ -204,7 +242,12 @@ namespace FG
 
 	// task processor //
 		bool  _BuildCommandBuffers ();
-		bool  _ProcessTasks (VkCommandBuffer cmd);
+		void  _SortTasks (ExeOrderIndex exeOrderIndex, OUT TempTaskArray_t &ordered);
+		bool  _ProcessTasks (VkCommandBuffer cmd, ArrayView<VTask> ordered);
+		uint  _StartParallelRecording (INOUT ExeOrderIndex &exeOrderIndex, OUT WorkerPool::ParallelJobs &jobs);
+		void  _RecordSecondary (RecordingWorker &worker);
+		void  _AddChainResources (const VPipelineResources &);
+		void  _AddTransientResources (const PipelineResources &, const VPipelineResources &);
 		void  _AfterCompilation ();
 		
 
@@ -219,6 +262,9 @@ namespace FG
 	// queue //
 		ND_ EQueueUsage	_GetQueueUsage ()	const	{ return EQueueUsage(0) | _batch->GetQueueType(); }
 		ND_ bool		_IsRecording ()		const	{ return _state == EState::Recording; }
+
+	// draw //
+		ND_ bool		_IsPipelineReady (RawGPipelineID id);
 	};
 
 	
@@ -230,7 +276,7 @@ namespace FG
 	template <uint UID>
 	inline auto const*  VCommandBuffer::AcquireTemporary (_fg_hidden_::ResourceID<UID> id)
 	{
-		auto[iter, inserted] = _rm.resourceMap.insert({ Resource_t{ id }, 1 });
+		auto[iter, inserted] = _rm.resourceMap->insert({ Resource_t{ id }, 1 });
 
 		return _instance.GetResourceManager().GetResource( id, inserted );
 	}
@@ -243,7 +289,7 @@ namespace FG
 	template <uint UID>
 	inline void  VCommandBuffer::ReleaseResource (_fg_hidden_::ResourceID<UID> id)
 	{
-		_rm.resourceMap.insert({ Resource_t{ id }, 0 }).first->second++;
+		_rm.resourceMap->insert({ Resource_t{ id }, 0 }).first->second++;
 	}
 	
 /*
@@ -253,7 +299,15 @@ namespace FG
 */
 	inline VPipelineResources const*  VCommandBuffer::CreateDescriptorSet (const PipelineResources &desc)
 	{
-		return GetResourceManager().CreateDescriptorSet( desc, INOUT _rm.resourceMap );
+		auto*	result = GetResourceManager().CreateDescriptorSet( desc, INOUT *_rm.resourceMap );
+
+		if ( result and _taskChains.IsEnabled() )
+			_AddChainResources( *result );
+
+		if ( result and _IsRecording() and not _transients.Empty() )
+			_AddTransientResources( desc, *result );
+
+		return result;
 	}
 
 
@@ -0,0 +1,190 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VDrawCommandBuffer.h"
+#include "VCommandBuffer.h"
+#include "VTaskGraph.hpp"
+
+namespace FG
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VDrawCommandBuffer::VDrawCommandBuffer (VCommandBuffer &fgThread, VLogicalRenderPass &logicalPass, std::mutex &guard) :
+		_fgThread{ fgThread },	_logicalPass{ logicalPass },
+		_guard{ guard },		_drawTasks{ _allocator }
+	{
+		_allocator.SetBlockSize( 64_Kb );
+		_drawTasks.reserve( 64 );
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VDrawCommandBuffer::~VDrawCommandBuffer ()
+	{
+		EXLOCK( _drCheck );
+		ASSERT( _cmdBuffer == VK_NULL_HANDLE );
+	}
+
+/*
+=================================================
+	_AddTask
+=================================================
+*/
+	template <typename DrawTaskType, typename TaskType>
+	inline void  VDrawCommandBuffer::_AddTask (const TaskType &task, ProcessFunc_t pass1, ProcessFunc_t pass2)
+	{
+		EXLOCK( _drCheck );
+
+		auto*	ptr = _allocator.Alloc< DrawTaskType >();
+
+		// draw task acquires resources and creates descriptor sets in the command buffer
+		std::unique_lock	lock{ _guard };
+		auto&				transients = _fgThread.GetTransients();
+
+		transients.BeginPass( &_logicalPass );
+		_drawTasks.push_back( PlacementNew<DrawTaskType>( ptr, _logicalPass, _fgThread, task, pass1, pass2 ));
+		transients.EndPass();
+	}
+
+/*
+=================================================
+	_IsPipelineReady
+----
+	pipeline may be created asynchronously, draw task is skipped until pipeline is ready.
+=================================================
+*/
+	bool  VDrawCommandBuffer::_IsPipelineReady (RawGPipelineID id)
+	{
+		EXLOCK( _drCheck );
+
+		if ( not id or _fgThread.GetResourceManager().IsPipelineReady( id ))
+			return true;
+
+		++_stat.renderer.drawCallsSkipped;
+		return false;
+	}
+
+/*
+=================================================
+	AddTask
+=================================================
+*/
+	void  VDrawCommandBuffer::AddTask (const DrawVertices &task)
+	{
+		ASSERT( task.commands.size() );
+
+		if ( _IsPipelineReady( task.pipeline ))
+			_AddTask< VFgDrawTask<DrawVertices> >( task, VTaskProcessor::Visit1_DrawVertices, VTaskProcessor::Visit2_DrawVertices );
+	}
+
+	void  VDrawCommandBuffer::AddTask (const DrawIndexed &task)
+	{
+		ASSERT( task.commands.size() );
+
+		if ( _IsPipelineReady( task.pipeline ))
+			_AddTask< VFgDrawTask<DrawIndexed> >( task, VTaskProcessor::Visit1_DrawIndexed, VTaskProcessor::Visit2_DrawIndexed );
+	}
+
+	void  VDrawCommandBuffer::AddTask (const DrawVerticesIndirect &task)
+	{
+		ASSERT( task.commands.size() );
+
+		if ( _IsPipelineReady( task.pipeline ))
+			_AddTask< VFgDrawTask<DrawVerticesIndirect> >( task, VTaskProcessor::Visit1_DrawVerticesIndirect, VTaskProcessor::Visit2_DrawVerticesIndirect );
+	}
+
+	void  VDrawCommandBuffer::AddTask (const DrawIndexedIndirect &task)
+	{
+		ASSERT( task.commands.size() );
+
+		if ( _IsPipelineReady( task.pipeline ))
+			_AddTask< VFgDrawTask<DrawIndexedIndirect> >( task, VTaskProcessor::Visit1_DrawIndexedIndirect, VTaskProcessor::Visit2_DrawIndexedIndirect );
+	}
+
+	void  VDrawCommandBuffer::AddTask (const DrawMeshes &task)
+	{
+		ASSERT( task.commands.size() );
+		_AddTask< VFgDrawTask<DrawMeshes> >( task, VTaskProcessor::Visit1_DrawMeshes, VTaskProcessor::Visit2_DrawMeshes );
+	}
+
+	void  VDrawCommandBuffer::AddTask (const DrawMeshesIndirect &task)
+	{
+		ASSERT( task.commands.size() );
+		_AddTask< VFgDrawTask<DrawMeshesIndirect> >( task, VTaskProcessor::Visit1_DrawMeshesIndirect, VTaskProcessor::Visit2_DrawMeshesIndirect );
+	}
+
+	void  VDrawCommandBuffer::AddTask (const CustomDraw &task)
+	{
+		ASSERT( task.callback );
+		_AddTask< VFgDrawTask<CustomDraw> >( task, VTaskProcessor::Visit1_CustomDraw, VTaskProcessor::Visit2_CustomDraw );
+	}
+
+/*
+=================================================
+	BeginRecording
+----
+	called on the thread that processes render pass,
+	'pool' must not be used by other threads until recording is finished.
+=================================================
+*/
+	VkCommandBuffer  VDrawCommandBuffer::BeginRecording (VCmdBatch &batch, VCommandPool &pool, const VkCommandBufferInheritanceInfo &inheritance)
+	{
+		EXLOCK( _drCheck );
+		ASSERT( _cmdBuffer == VK_NULL_HANDLE );
+
+		VDevice const&	dev = _fgThread.GetDevice();
+
+		_cmdBuffer = pool.AllocSecondary( dev );
+		CHECK_ERR( _cmdBuffer );
+
+		batch.PushSecondaryCommandBuffer( _cmdBuffer, &pool );
+
+		VkCommandBufferBeginInfo	info = {};
+		info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		info.pInheritanceInfo	= &inheritance;
+
+		VK_CALL( dev.vkBeginCommandBuffer( _cmdBuffer, &info ));
+		return _cmdBuffer;
+	}
+
+/*
+=================================================
+	Record
+----
+	called from the worker thread, must not use anything that is protected by command buffer,
+	except when 'sharedGuard' is locked.
+=================================================
+*/
+	void  VDrawCommandBuffer::Record (const VFgTask<SubmitRenderPass> &task, std::mutex &sharedGuard)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _cmdBuffer, void());
+
+		// sort keys are calculated on the render pass thread
+		if ( _logicalPass.GetDrawOrder() == EDrawOrder::MinimizeStateChanges and _drawTasks.size() > 1 )
+		{
+			auto*	temp = _allocator.Alloc< IDrawTask* >( _drawTasks.size() );
+			CHECK_ERR( temp, void());
+
+			SortDrawTasks( _drawTasks.data(), _drawTasks.size(), temp );
+		}
+
+		{
+			VTaskProcessor	processor{ _fgThread, _cmdBuffer, _allocator, _barrierMngr, null, _stat.renderer };
+
+			processor.RecordDrawTasks( task, _drawTasks, sharedGuard );
+		}
+
+		VK_CALL( _fgThread.GetDevice().vkEndCommandBuffer( _cmdBuffer ));
+		_cmdBuffer = VK_NULL_HANDLE;
+	}
+
+
+}	// FG
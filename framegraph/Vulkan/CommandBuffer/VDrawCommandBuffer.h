@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#pragma once
+
+#include "VTaskGraph.h"
+#include "VBarrierManager.h"
+#include "VCmdBatch.h"
+
+namespace FG
+{
+
+	//
+	// Vulkan Draw Command Buffer
+	//
+	// Draw tasks of the logical render pass that are recorded into secondary command buffer.
+	// Tasks are added on the user thread, secondary command buffer is recorded on the worker thread
+	// when render pass is processed.
+	//
+
+	class VDrawCommandBuffer final : public IDrawCommandBuffer
+	{
+	// types
+	private:
+		using Allocator_t		= LinearAllocator<>;
+		using DrawTasks_t		= std::vector< IDrawTask*, StdLinearAllocator<IDrawTask*> >;
+		using Statistic_t		= IFrameGraph::Statistics;
+		using ProcessFunc_t		= IDrawTask::ProcessFunc_t;
+
+
+	// variables
+	private:
+		VCommandBuffer &		_fgThread;
+		VLogicalRenderPass &	_logicalPass;
+		std::mutex &			_guard;			// protects resource manager of the command buffer while task is created
+
+		Allocator_t				_allocator;
+		DrawTasks_t				_drawTasks;
+
+		VBarrierManager			_barrierMngr;	// barriers for draw tasks are added before render pass
+		Statistic_t				_stat;
+		VkCommandBuffer			_cmdBuffer		= VK_NULL_HANDLE;
+
+		DataRaceCheck			_drCheck;
+
+
+	// methods
+	public:
+		VDrawCommandBuffer (VCommandBuffer &, VLogicalRenderPass &, std::mutex &guard);
+		~VDrawCommandBuffer ();
+
+		void  AddTask (const DrawVertices &) override;
+		void  AddTask (const DrawIndexed &) override;
+		void  AddTask (const DrawVerticesIndirect &) override;
+		void  AddTask (const DrawIndexedIndirect &) override;
+		void  AddTask (const DrawMeshes &) override;
+		void  AddTask (const DrawMeshesIndirect &) override;
+		void  AddTask (const CustomDraw &) override;
+
+		ND_ VkCommandBuffer  BeginRecording (VCmdBatch &, VCommandPool &, const VkCommandBufferInheritanceInfo &);
+			void			 Record (const VFgTask<SubmitRenderPass> &, std::mutex &sharedGuard);
+
+		ND_ ArrayView< IDrawTask *>		GetDrawTasks ()		const	{ EXLOCK( _drCheck );  return _drawTasks; }
+		ND_ Statistic_t const&			GetStatistic ()		const	{ EXLOCK( _drCheck );  return _stat; }
+
+	private:
+		template <typename DrawTaskType, typename TaskType>
+		void  _AddTask (const TaskType &, ProcessFunc_t pass1, ProcessFunc_t pass2);
+
+		ND_ bool  _IsPipelineReady (RawGPipelineID id);
+	};
+
+
+}	// FG
@@ -4,6 +4,7 @@
 
 #include "framegraph/Public/FrameGraphDrawTask.h"
 #include "VCommon.h"
+#include "stl/Algorithms/RadixSort.h"
 
 namespace FG
 {
@@ -22,14 +23,18 @@ namespace FG
 	public:
 		using Name_t			= _fg_hidden_::TaskName_t;
 		using ProcessFunc_t		= void (*) (void *visitor, void *taskData);
+		using SortKey_t			= uint64_t;
+
+		static constexpr SortKey_t	UnsortedKey	= ~SortKey_t(0);	// task must not be reordered
 		
 
 	// variables
 	private:
-		ProcessFunc_t	_pass1	= null;
-		ProcessFunc_t	_pass2	= null;
-		Name_t			_taskName;
-		RGBA8u			_debugColor;
+		ProcessFunc_t		_pass1		= null;
+		ProcessFunc_t		_pass2		= null;
+		Name_t				_taskName;
+		RGBA8u				_debugColor;
+		mutable SortKey_t	_sortKey	= UnsortedKey;		// calculated in first pass
 
 
 	// interface
@@ -41,10 +46,39 @@ namespace FG
 	public:
 		ND_ StringView	GetName ()			const	{ return _taskName; }
 		ND_ RGBA8u		GetDebugColor ()	const	{ return _debugColor; }
+		ND_ SortKey_t	GetSortKey ()		const	{ return _sortKey; }
+
+		void SetSortKey (SortKey_t key)		const	{ _sortKey = key; }
 		
 		void Process1 (void *visitor)				{ ASSERT( _pass1 );  _pass1( visitor, this ); }
 		void Process2 (void *visitor)				{ ASSERT( _pass2 );  _pass2( visitor, this ); }
 	};
+	
+
+/*
+=================================================
+	SortDrawTasks
+----
+	tasks with 'UnsortedKey' keep their position and split the list
+	into ranges, each range is sorted separately.
+	'temp' must have space for 'count' elements.
+=================================================
+*/
+	inline void  SortDrawTasks (IDrawTask** tasks, size_t count, IDrawTask** temp)
+	{
+		size_t	first = 0;
+
+		for (size_t i = 0; i <= count; ++i)
+		{
+			if ( i < count and tasks[i]->GetSortKey() != IDrawTask::UnsortedKey )
+				continue;
+
+			if ( i > first + 1 )
+				RadixSort( tasks + first, temp, i - first, [] (const IDrawTask* task) { return task->GetSortKey(); });
+
+			first = i + 1;
+		}
+	}
 
 
 
@@ -15,6 +15,7 @@ namespace FG
 	VSubmitted::VSubmitted (uint indexInPool) :
 		_indexInPool{ indexInPool },
 		_fence{ VK_NULL_HANDLE },
+		_timelineValue{ 0 },
 		_queueType{ Default }
 	{
 	}
@@ -36,10 +37,15 @@ namespace FG
 	_Initialize
 =================================================
 */
-	void VSubmitted::_Initialize (const VDevice &dev, EQueueType queue, ArrayView<VCmdBatchPtr> batches, ArrayView<VkSemaphore> semaphores)
+	void VSubmitted::_Initialize (const VDevice &dev, EQueueType queue, ArrayView<VCmdBatchPtr> batches, ArrayView<VkSemaphore> semaphores, uint64_t timelineValue)
 	{
 		EXLOCK( _drCheck );
 
+		_timelineValue = timelineValue;
+
+		if ( _timelineValue )
+		{}	// completion is tracked by the queue timeline semaphore
+		else
 		if ( not _fence )
 		{
 			VkFenceCreateInfo	info = {};
@@ -31,6 +31,7 @@ namespace FG
 		Batches_t			_batches;
 		Semaphores_t		_semaphores;
 		VkFence				_fence;
+		uint64_t			_timelineValue;		// if not zero then timeline semaphore is used instead of fence
 		EQueueType			_queueType;
 
 		DataRaceCheck		_drCheck;
@@ -42,12 +43,13 @@ namespace FG
 		~VSubmitted ();
 
 		ND_ VkFence		GetFence ()			const	{ EXLOCK( _drCheck );  return _fence; }
+		ND_ uint64_t	GetTimelineValue ()	const	{ EXLOCK( _drCheck );  return _timelineValue; }
 		ND_ EQueueType	GetQueueType ()		const	{ EXLOCK( _drCheck );  return _queueType; }
 		ND_ uint		GetIndexInPool ()	const	{ return _indexInPool; }
 
 
 	private:
-		void _Initialize (const VDevice &, EQueueType queue, ArrayView<VCmdBatchPtr>, ArrayView<VkSemaphore>);
+		void _Initialize (const VDevice &, EQueueType queue, ArrayView<VCmdBatchPtr>, ArrayView<VkSemaphore>, uint64_t timelineValue);
 		void _Release (const VDevice &, VDebugger &, const IFrameGraph::ShaderDebugCallback_t &, INOUT Statistic_t &);
 		void _Destroy (const VDevice &);
 	};
@@ -0,0 +1,274 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VTaskChains.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	OnStart
+=================================================
+*/
+	void  VTaskChains::OnStart (LinearAllocator<> &alloc, bool enabled)
+	{
+		_enabled	= enabled;
+		_current	= SerialChain;
+
+		if ( not _enabled )
+			return;
+
+		_allocator = &alloc;
+		_parents.Create( alloc );
+		_workers.Create( alloc );
+		_tasks.Create( alloc );
+
+		for (auto& owners : _owners) {
+			owners.Create( alloc );
+		}
+
+		_parents->reserve( 128 );
+		_parents->push_back( SerialChain );
+		_tasks->reserve( 128 );
+	}
+
+/*
+=================================================
+	OnDiscardMemory
+=================================================
+*/
+	void  VTaskChains::OnDiscardMemory ()
+	{
+		if ( not _enabled )
+			return;
+
+		_parents.Destroy();
+		_workers.Destroy();
+		_tasks.Destroy();
+
+		for (auto& owners : _owners) {
+			owners.Destroy();
+		}
+
+		_allocator	= null;
+		_enabled	= false;
+	}
+
+/*
+=================================================
+	BeginTask
+----
+	resources that are used while task is created
+	will be attached to the chain of this task.
+=================================================
+*/
+	void  VTaskChains::BeginTask ()
+	{
+		if ( not _enabled )
+			return;
+
+		ASSERT( _current == SerialChain );
+
+		_current = uint(_parents->size());
+		_parents->push_back( _current );
+	}
+
+/*
+=================================================
+	EndTask
+----
+	'task' may be null if task creation failed.
+=================================================
+*/
+	void  VTaskChains::EndTask (VTask task, bool isParallel)
+	{
+		if ( not _enabled )
+			return;
+
+		if ( task )
+		{
+			for (auto in_node : task->Inputs()) {
+				_Union( _current, in_node->ChainIndex() );
+			}
+
+			if ( not isParallel )
+				_Union( _current, SerialChain );
+
+			task->SetChainIndex( _current );
+			_tasks->push_back( task );
+		}
+
+		_current = SerialChain;
+	}
+
+/*
+=================================================
+	AddResource
+----
+	resource that is used outside of task creation
+	will be processed on the calling thread.
+=================================================
+*/
+	void  VTaskChains::AddResource (EResource type, uint index)
+	{
+		if ( not _enabled )
+			return;
+
+		auto&	owners = *_owners[ uint(type) ];
+
+		if ( index >= owners.size() )
+			owners.resize( index+1, UMax );
+
+		uint&	owner = owners[ index ];
+
+		if ( owner == UMax )
+			owner = _current;
+		else
+			_Union( owner, _current );
+	}
+
+/*
+=================================================
+	AddSerialResource
+----
+	lifetime of transient resource is calculated from execution order
+	of the tasks on the calling thread, so task that uses it must not
+	be moved into secondary command buffer.
+=================================================
+*/
+	void  VTaskChains::AddSerialResource ()
+	{
+		if ( not _enabled )
+			return;
+
+		_Union( _current, SerialChain );
+	}
+
+/*
+=================================================
+	Distribute
+----
+	returns number of workers that have tasks to record,
+	chains are assigned to the least loaded worker starting from the longest chain.
+=================================================
+*/
+	uint  VTaskChains::Distribute (ArrayView<Tasks_t*> workerTasks)
+	{
+		if ( not _enabled or workerTasks.size() < 2 )
+			return 0;
+
+		ASSERT( workerTasks.size() <= FG_MaxRecordingThreads );
+
+		const uint	node_count	= uint(_parents->size());
+		uint		chain_count	= 0;
+		Indices_t	task_count{ *_allocator };
+		Indices_t	chains{ *_allocator };
+
+		task_count.resize( node_count, 0 );
+
+		for (auto& task : *_tasks)
+		{
+			const uint	root = _Find( task->ChainIndex() );
+
+			if ( root != SerialChain and task_count[root]++ == 0 )
+				++chain_count;
+		}
+
+		if ( chain_count < 2 )
+			return 0;
+
+		chains.reserve( chain_count );
+
+		for (uint i = 0; i < node_count; ++i)
+		{
+			if ( task_count[i] )
+				chains.push_back( i );
+		}
+
+		std::sort( chains.begin(), chains.end(), [&task_count] (uint lhs, uint rhs) { return task_count[lhs] > task_count[rhs]; });
+
+		const uint									worker_count = Min( chain_count, uint(workerTasks.size()) );
+		StaticArray< uint, FG_MaxRecordingThreads >	load;
+
+		load.fill( 0 );
+		_workers->assign( node_count, UMax );
+
+		for (uint root : chains)
+		{
+			const uint	worker = uint(std::distance( load.begin(), std::min_element( load.begin(), load.begin() + worker_count )));
+
+			(*_workers)[root]	 = worker;
+			load[worker]		+= task_count[root];
+		}
+
+		for (auto& task : *_tasks)
+		{
+			const uint	worker = (*_workers)[ _Find( task->ChainIndex() )];
+
+			if ( worker != UMax )
+				workerTasks[worker]->push_back( task );
+		}
+		return worker_count;
+	}
+
+/*
+=================================================
+	WorkerOf
+----
+	returns 'UMax' if resource is used on the calling thread.
+=================================================
+*/
+	uint  VTaskChains::WorkerOf (EResource type, uint index)
+	{
+		if ( not _enabled or _workers->empty() )
+			return UMax;
+
+		auto&	owners = *_owners[ uint(type) ];
+
+		if ( index >= owners.size() or owners[index] == UMax )
+			return UMax;
+
+		return (*_workers)[ _Find( owners[index] )];
+	}
+
+/*
+=================================================
+	_Find
+----
+	uses path halving, root of the serial chain is always 0.
+=================================================
+*/
+	uint  VTaskChains::_Find (uint node)
+	{
+		auto&	parents = *_parents;
+
+		while ( parents[node] != node )
+		{
+			parents[node]	= parents[ parents[node] ];
+			node			= parents[node];
+		}
+		return node;
+	}
+
+/*
+=================================================
+	_Union
+=================================================
+*/
+	void  VTaskChains::_Union (uint lhs, uint rhs)
+	{
+		lhs = _Find( lhs );
+		rhs = _Find( rhs );
+
+		if ( lhs == rhs )
+			return;
+
+		// the lowest index becomes root, so serial chain stays at 0
+		if ( lhs < rhs )
+			std::swap( lhs, rhs );
+
+		(*_parents)[lhs] = rhs;
+	}
+
+
+}	// FG
@@ -0,0 +1,80 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#pragma once
+
+#include "VTaskGraph.h"
+
+namespace FG
+{
+
+	//
+	// Task Chains
+	//
+	// Splits task graph into chains that have no common dependencies and resources,
+	// independent chains can be recorded into secondary command buffers in parallel.
+	//
+
+	class VTaskChains final
+	{
+	// types
+	public:
+		using Tasks_t	= std::vector< VTask, StdLinearAllocator<VTask> >;
+
+		// ray tracing resources are used only by the tasks that are recorded on the calling thread
+		enum class EResource : uint
+		{
+			Image,
+			Buffer,
+			_Count
+		};
+
+		// tasks that record only transfer commands and don't use per command buffer caches
+		template <typename T>
+		static constexpr bool	IsParallel	= IsSameTypes< T, CopyBuffer > or IsSameTypes< T, CopyImage > or IsSameTypes< T, CopyBufferToImage > or
+											  IsSameTypes< T, CopyImageToBuffer > or IsSameTypes< T, BlitImage > or IsSameTypes< T, ResolveImage > or
+											  IsSameTypes< T, GenerateMipmaps > or IsSameTypes< T, FillBuffer > or IsSameTypes< T, ClearColorImage > or
+											  IsSameTypes< T, ClearDepthStencilImage > or IsSameTypes< T, UpdateBuffer >;
+
+	private:
+		using Indices_t	= std::vector< uint, StdLinearAllocator<uint> >;
+		using Owners_t	= StaticArray< InPlace<Indices_t>, uint(EResource::_Count) >;
+
+		static constexpr uint	SerialChain	= 0;
+
+
+	// variables
+	private:
+		Ptr<LinearAllocator<>>	_allocator;
+		InPlace<Indices_t>		_parents;		// union-find forest, one node per task, chain 0 is recorded on the calling thread
+		InPlace<Indices_t>		_workers;		// worker index for each root node, 'UMax' for serial chain
+		Owners_t				_owners;		// node which uses resource, indexed by resource index
+		InPlace<Tasks_t>		_tasks;			// in submission order
+		uint					_current	= SerialChain;
+		bool					_enabled	= false;
+
+
+	// methods
+	public:
+		VTaskChains () {}
+
+		void OnStart (LinearAllocator<> &, bool enabled);
+		void OnDiscardMemory ();
+
+		void BeginTask ();
+		void EndTask (VTask task, bool isParallel);
+		void AddResource (EResource type, uint index);
+		void AddSerialResource ();
+
+		ND_ uint  Distribute (ArrayView<Tasks_t*> workerTasks);
+		ND_ uint  WorkerOf (EResource type, uint index);
+
+		ND_ bool  IsEnabled ()	const	{ return _enabled; }
+
+
+	private:
+		ND_ uint  _Find (uint node);
+			void  _Union (uint lhs, uint rhs);
+	};
+
+
+}	// FG
@@ -35,6 +35,7 @@ namespace FG
 		Name_t				_taskName;
 		RGBA8u				_debugColor;
 		uint				_visitorID		= 0;
+		uint				_chainIndex		= 0;
 		ExeOrderIndex		_exeOrderIdx	= ExeOrderIndex::Initial;
 
 
@@ -68,6 +69,7 @@ namespace FG
 		ND_ StringView			Name ()				const	{ return _taskName; }
 		ND_ RGBA8u				DebugColor ()		const	{ return _debugColor; }
 		ND_ uint				VisitorID ()		const	{ return _visitorID; }
+		ND_ uint				ChainIndex ()		const	{ return _chainIndex; }
 		ND_ ExeOrderIndex		ExecutionOrder ()	const	{ return _exeOrderIdx; }
 
 		ND_ ArrayView< VTask >	Inputs ()			const	{ return _inputs; }
@@ -75,6 +77,7 @@ namespace FG
 
 			void Attach (VTask output)						{ _outputs.push_back( output ); }
 			void SetVisitorID (uint id)						{ _visitorID = id; }
+			void SetChainIndex (uint idx)					{ _chainIndex = idx; }
 			void SetExecutionOrder (ExeOrderIndex idx)		{ _exeOrderIdx = idx; }
 
 			void Process (void *visitor)			const	{ ASSERT( _processFunc );  _processFunc( visitor, this ); }
@@ -17,10 +17,19 @@ namespace FG
 	template <typename T>
 	inline VFgTask<T>*  VTaskGraph<VisitorT>::Add (VCommandBuffer &cb, const T &task)
 	{
-		auto*	ptr  = cb.GetAllocator().Alloc< VFgTask<T> >();
+		auto*	ptr		= cb.GetAllocator().Alloc< VFgTask<T> >();
+		auto&	chains		= cb.GetTaskChains();
+		auto&	transients	= cb.GetTransients();
 
+		chains.BeginTask();
+		transients.BeginTask();
 		PlacementNew< VFgTask<T> >( OUT ptr, cb, task, &_Visitor<T> );
-		CHECK_ERR( ptr->IsValid() );
+
+		const bool	is_valid = ptr->IsValid();
+
+		transients.EndTask( is_valid ? ptr : null );
+		chains.EndTask( is_valid ? ptr : null, VTaskChains::IsParallel<T> );
+		CHECK_ERR( is_valid );
 
 		_nodes->insert( ptr );
 
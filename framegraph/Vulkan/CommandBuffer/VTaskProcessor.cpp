@@ -4,6 +4,7 @@
 #include "VCommandBuffer.h"
 #include "VPipelineCache.h"
 #include "VDrawTask.h"
+#include "VDrawCommandBuffer.h"
 #include "VEnumCast.h"
 #include "FGEnumCast.h"
 #include "Shared/EnumUtils.h"
@@ -24,15 +25,14 @@ namespace FG
 		return _fgThread.AcquireTemporary( id );
 	}
 	
-	template <typename ResType>
-	static void CommitResourceBarrier (const void *res, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger)
+	inline VTaskProcessor::Statistic_t&  VTaskProcessor::Stat () const
 	{
-		return static_cast<ResType const*>(res)->CommitBarrier( barrierMngr, debugger );
+		return _stat;
 	}
-
-	inline VTaskProcessor::Statistic_t&  VTaskProcessor::Stat () const
+	
+	inline std::unique_lock<std::mutex>  VTaskProcessor::_LockSharedState () const
 	{
-		return _fgThread.EditStatistic().renderer;
+		return _sharedGuard ? std::unique_lock<std::mutex>{ *_sharedGuard } : std::unique_lock<std::mutex>{};
 	}
 //-----------------------------------------------------------------------------
 
@@ -43,6 +43,11 @@ namespace FG
 	//
 	class VTaskProcessor::PipelineResourceBarriers
 	{
+	// types
+	private:
+		using ResourceRefs	= VPipelineResources::ResourceRefs;
+		using ImageRef		= VPipelineResources::ImageRef;
+
 	// variables
 	private:
 		VTaskProcessor &	_tp;
@@ -52,13 +57,12 @@ namespace FG
 	public:
 		PipelineResourceBarriers (VTaskProcessor &tp, ArrayView<uint> offsets) : _tp{tp}, _dynamicOffsets{offsets} {}
 
-		// ResourceGraph //
-		void operator () (const UniformID &, const PipelineResources::Buffer &buf);
-		void operator () (const UniformID &, const PipelineResources::Image &img);
-		void operator () (const UniformID &, const PipelineResources::Texture &tex);
-		//void operator () (const UniformID &, const PipelineResources::SubpassInput &sp);
-		void operator () (const UniformID &, const PipelineResources::Sampler &) {}
-		void operator () (const UniformID &, const PipelineResources::RayTracingScene &);
+		void operator () (const VPipelineResources &);
+
+	private:
+		void _AddBuffer (const PipelineResources::Buffer &buf, uint index);
+		void _AddImage (const ImageRef &ref);
+		void _AddRTScene (RawRTSceneID id);
 	};
 
 	
@@ -107,6 +111,11 @@ namespace FG
 		
 		template <typename DrawTask>
 		void _ExtractDescriptorSets (RawPipelineLayoutID layoutId, const DrawTask &task);
+		
+		template <typename DrawTask>
+		void _SetSortKey (const DrawTask &task, EPrimitive topology, HashVal buffersHash) const;
+
+		ND_ static HashVal  _HashOfVertexBuffers (const VBaseDrawVerticesTask &task);
 
 		ND_ bool						IsEarlyFragmentTests ()			const	{ return _earlyFragmentTests; }
 		ND_ bool						IsLateFragmentTests ()			const	{ return _lateFragmentTests; }
@@ -226,98 +235,107 @@ namespace FG
 	
 /*
 =================================================
-	operator (Buffer)
+	operator (VPipelineResources)
+----
+	walks only through the precomputed list of resources,
+	immutable descriptor set contains only read-only buffers that don't need barriers.
 =================================================
 */
-	void VTaskProcessor::PipelineResourceBarriers::operator () (const UniformID &, const PipelineResources::Buffer &buf)
+	void VTaskProcessor::PipelineResourceBarriers::operator () (const VPipelineResources &res)
 	{
-		for (uint i = 0; i < buf.elementCount; ++i)
-		{
-			auto&				elem	= buf.elements[i];
-			VLocalBuffer const*	buffer	= _tp._ToLocal( elem.bufferId );
-			if ( not buffer )
-				continue;
-
-			const VkDeviceSize	offset	= VkDeviceSize(elem.offset) + (buf.dynamicOffsetIndex < _dynamicOffsets.size() ? _dynamicOffsets[buf.dynamicOffsetIndex] : 0);		
-			const VkDeviceSize	size	= VkDeviceSize(elem.size == ~0_b ? buffer->Size() - offset : elem.size);
-
-			// validation
-			{
-				ASSERT( (size >= buf.staticSize) and (buf.arrayStride == 0 or (size - buf.staticSize) % buf.arrayStride == 0) );
-				ASSERT( offset < buffer->Size() );
-				ASSERT( offset + size <= buffer->Size() );
+		ResourceRefs const&	refs = res.GetResourceRefs();
 
-				auto&	limits	= _tp._fgThread.GetDevice().GetDeviceProperties().limits;
-				FG_UNUSED( limits );
+		// read-only buffers must be kept alive until the command buffer is complete
+		for (auto& id : refs.readOnlyBuffers) {
+			FG_UNUSED( _tp._ToLocal( id ));
+		}
 
-				if ( (buf.state & EResourceState::_StateMask) == EResourceState::UniformRead )
-				{
-					ASSERT( (offset % limits.minUniformBufferOffsetAlignment) == 0 );
-					ASSERT( size <= limits.maxUniformBufferRange );
-				}else{
-					ASSERT( (offset % limits.minStorageBufferOffsetAlignment) == 0 );
-					ASSERT( size <= limits.maxStorageBufferRange );
-				}
-			}
+		if ( res.IsImmutable() )
+			return;
 
-			_tp._AddBuffer( buffer, buf.state, offset, size );
+		for (auto& buf : refs.buffers) {
+			_AddBuffer( *buf.uniform, buf.index );
+		}
+		for (auto& img : refs.images) {
+			_AddImage( img );
+		}
+		for (auto& id : refs.rtScenes) {
+			_AddRTScene( id );
 		}
 	}
-		
+
 /*
 =================================================
-	operator (Image / Texture / SubpassInput)
+	_AddBuffer
 =================================================
 */
-	void VTaskProcessor::PipelineResourceBarriers::operator () (const UniformID &, const PipelineResources::Image &img)
+	void VTaskProcessor::PipelineResourceBarriers::_AddBuffer (const PipelineResources::Buffer &buf, uint index)
 	{
-		for (uint i = 0; i < img.elementCount; ++i)
+		auto&				elem	= buf.elements[index];
+		VLocalBuffer const*	buffer	= _tp._ToLocal( elem.bufferId );
+		if ( not buffer )
+			return;
+
+		const VkDeviceSize	offset	= VkDeviceSize(elem.offset) + (buf.dynamicOffsetIndex < _dynamicOffsets.size() ? _dynamicOffsets[buf.dynamicOffsetIndex] : 0);		
+		const VkDeviceSize	size	= VkDeviceSize(elem.size == ~0_b ? buffer->Size() - offset : elem.size);
+
+		// validation
 		{
-			auto&				elem	= img.elements[i];
-			VLocalImage const*  image	= _tp._ToLocal( elem.imageId );
+			ASSERT( (size >= buf.staticSize) and (buf.arrayStride == 0 or (size - buf.staticSize) % buf.arrayStride == 0) );
+			ASSERT( offset < buffer->Size() );
+			ASSERT( offset + size <= buffer->Size() );
 
-			if ( image )
-				_tp._AddImage( image, img.state, EResourceState_ToImageLayout( img.state, image->AspectMask() ), elem.desc );
+			auto&	limits	= _tp._fgThread.GetDevice().GetDeviceProperties().limits;
+			FG_UNUSED( limits );
+
+			if ( (buf.state & EResourceState::_StateMask) == EResourceState::UniformRead )
+			{
+				ASSERT( (offset % limits.minUniformBufferOffsetAlignment) == 0 );
+				ASSERT( size <= limits.maxUniformBufferRange );
+			}else{
+				ASSERT( (offset % limits.minStorageBufferOffsetAlignment) == 0 );
+				ASSERT( size <= limits.maxStorageBufferRange );
+			}
 		}
+
+		_tp._AddBuffer( buffer, buf.state, offset, size );
 	}
-	
-	void VTaskProcessor::PipelineResourceBarriers::operator () (const UniformID &, const PipelineResources::Texture &tex)
+		
+/*
+=================================================
+	_AddImage
+=================================================
+*/
+	void VTaskProcessor::PipelineResourceBarriers::_AddImage (const ImageRef &ref)
 	{
-		for (uint i = 0; i < tex.elementCount; ++i)
-		{
-			auto&				elem	= tex.elements[i];
-			VLocalImage const*  image	= _tp._ToLocal( elem.imageId );
+		VLocalImage const*  image = _tp._ToLocal( ref.imageId );
 
-			if ( image )
-				_tp._AddImage( image, tex.state, EResourceState_ToImageLayout( tex.state, image->AspectMask() ), elem.desc );
-		}
+		if ( image )
+			_tp._AddImage( image, ref.state, EResourceState_ToImageLayout( ref.state, image->AspectMask() ), *ref.desc );
 	}
 
 /*
 =================================================
-	operator (RayTracingScene)
+	_AddRTScene
 =================================================
 */
-	void VTaskProcessor::PipelineResourceBarriers::operator () (const UniformID &, const PipelineResources::RayTracingScene &rts)
+	void VTaskProcessor::PipelineResourceBarriers::_AddRTScene (RawRTSceneID id)
 	{
-		for (uint i = 0; i < rts.elementCount; ++i)
-		{
-			VLocalRTScene const*  scene = _tp._ToLocal( rts.elements[i].sceneId );
-			if ( not scene )
-				return;
+		VLocalRTScene const*  scene = _tp._ToLocal( id );
+		if ( not scene )
+			return;
 
-			_tp._AddRTScene( scene, EResourceState::RayTracingShaderRead );
+		_tp._AddRTScene( scene, EResourceState::RayTracingShaderRead );
 
-			auto&	data = scene->ToGlobal()->CurrentData();
-			SHAREDLOCK( data.guard );
-			ASSERT( data.geometryInstances.size() );
+		auto&	data = scene->ToGlobal()->CurrentData();
+		SHAREDLOCK( data.guard );
+		ASSERT( data.geometryInstances.size() );
 
-			for (auto& inst : data.geometryInstances)
+		for (auto& inst : data.geometryInstances)
+		{
+			if ( auto* geom = _tp._ToLocal( inst.geometry.Get() ))
 			{
-				if ( auto* geom = _tp._ToLocal( inst.geometry.Get() ))
-				{
-					_tp._AddRTGeometry( geom, EResourceState::RayTracingShaderRead );
-				}
+				_tp._AddRTGeometry( geom, EResourceState::RayTracingShaderRead );
 			}
 		}
 	}
@@ -381,6 +399,7 @@ namespace FG
 			}
 		}
 		
+		_SetSortKey( task, task.topology, _HashOfVertexBuffers( task ));
 		_MergePipeline( task.dynamicStates, task.pipeline );
 	}
 
@@ -412,6 +431,7 @@ namespace FG
 			}
 		}
 		
+		_SetSortKey( task, task.topology, _HashOfVertexBuffers( task ) + HashOf( task.indexBuffer ) + HashOf( size_t(task.indexBufferOffset) ));
 		_MergePipeline( task.dynamicStates, task.pipeline );
 	}
 	
@@ -431,6 +451,7 @@ namespace FG
 			_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
 		}
 		
+		_SetSortKey( task, task.topology, _HashOfVertexBuffers( task ));
 		_MergePipeline( task.dynamicStates, task.pipeline );
 	}
 	
@@ -459,6 +480,7 @@ namespace FG
 			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 		
+		_SetSortKey( task, task.topology, _HashOfVertexBuffers( task ) + HashOf( task.indexBuffer ) + HashOf( size_t(task.indexBufferOffset) ));
 		_MergePipeline( task.dynamicStates, task.pipeline );
 	}
 	
@@ -472,6 +494,7 @@ namespace FG
 		// update descriptor sets and add pipeline barriers
 		_ExtractDescriptorSets( task.pipeline->GetLayoutID(), task );
 		
+		_SetSortKey( task, EPrimitive::Unknown, HashVal{} );
 		_MergePipeline( task.dynamicStates, task.pipeline );
 	}
 	
@@ -491,6 +514,7 @@ namespace FG
 			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 
+		_SetSortKey( task, EPrimitive::Unknown, HashVal{} );
 		_MergePipeline( task.dynamicStates, task.pipeline );
 	}
 	
@@ -526,6 +550,57 @@ namespace FG
 		_tp._ExtractDescriptorSets( *_tp._GetResource( layoutId ), task.GetResources(), OUT task.descriptorSets );
 	}
 
+/*
+=================================================
+	_SetSortKey
+----
+	key is used to minimize state changes when draw tasks are reordered,
+	pipeline, descriptor sets and buffers are hashed and packed into 20, 20 and 24 bits.
+=================================================
+*/
+	template <typename DrawTask>
+	inline void VTaskProcessor::DrawTaskBarriers::_SetSortKey (const DrawTask &task, EPrimitive topology, HashVal buffersHash) const
+	{
+		using SortKey_t = IDrawTask::SortKey_t;
+
+		const auto	Fold = [] (HashVal hash, uint bits) -> SortKey_t
+		{
+			return (SortKey_t(size_t(hash)) * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+		};
+
+		const auto&	dyn_offsets	= task.GetResources().dynamicOffsets;
+		HashVal		ppln_hash	= HashOf( task.pipeline ) + HashOf( topology );
+		HashVal		ds_hash;
+
+		if ( task.descriptorSets.size() )
+			ds_hash << HashOf( task.descriptorSets.data(), size_t(ArraySizeOf( task.descriptorSets )) );
+
+		if ( dyn_offsets.size() )
+			ds_hash << HashOf( dyn_offsets.data(), size_t(ArraySizeOf( dyn_offsets )) );
+
+		const SortKey_t	key = (Fold( ppln_hash, 20 ) << 44) | (Fold( ds_hash, 20 ) << 24) | Fold( buffersHash, 24 );
+
+		// 'UnsortedKey' is reserved for tasks that must not be reordered
+		task.SetSortKey( key == IDrawTask::UnsortedKey ? key-1 : key );
+	}
+	
+/*
+=================================================
+	_HashOfVertexBuffers
+=================================================
+*/
+	HashVal  VTaskProcessor::DrawTaskBarriers::_HashOfVertexBuffers (const VBaseDrawVerticesTask &task)
+	{
+		HashVal	result;
+
+		if ( task.GetVertexBuffers().size() )
+		{
+			result << HashOf( task.GetVertexBuffers().data(), task.GetVertexBuffers().size() * sizeof(VLocalBuffer const*) );
+			result << HashOf( task.GetVBOffsets().data(), task.GetVBOffsets().size() * sizeof(VkDeviceSize) );
+		}
+		return result;
+	}
+
 /*
 =================================================
 	_MergePipeline
@@ -579,8 +654,7 @@ namespace FG
 			buffers[i] = vertexBuffers[i]->Handle();
 		}
 
-		_tp.vkCmdBindVertexBuffers( _cmdBuffer, 0, uint(buffers.size()), buffers.data(), vertexOffsets.data() );
-		_tp.Stat().vertexBufferBindings++;
+		_tp._BindVertexBuffers( 0, buffers, vertexOffsets );
 	}
 
 /*
@@ -591,27 +665,18 @@ namespace FG
 	template <typename DrawTask>
 	void VTaskProcessor::DrawTaskCommands::_BindPipelineResources (const VPipelineLayout &layout, const DrawTask &task) const
 	{
-		if ( task.descriptorSets.size() )
-		{
-			_tp.vkCmdBindDescriptorSets( _cmdBuffer,
-										  VK_PIPELINE_BIND_POINT_GRAPHICS,
-										  layout.Handle(),
-										  layout.GetFirstDescriptorSet(),
-										  uint(task.descriptorSets.size()),
-										  task.descriptorSets.data(),
-										  uint(task.GetResources().dynamicOffsets.size()),
-										  task.GetResources().dynamicOffsets.data() );
-			_tp.Stat().descriptorBinds++;
-		}
+		_tp._BindGraphicsDescriptorSets( layout, task.descriptorSets, task.GetResources() );
 		
 		if ( task.GetDebugModeIndex() != Default )
 		{
 			VkDescriptorSet		desc_set;
 			uint				offset, binding;
-			_tp._fgThread.GetBatch().GetDescriptotSet( task.GetDebugModeIndex(), OUT binding, OUT desc_set, OUT offset );
+			{
+				auto	lock = _tp._LockSharedState();
+				_tp._fgThread.GetBatch().GetDescriptotSet( task.GetDebugModeIndex(), OUT binding, OUT desc_set, OUT offset );
+			}
 			
-			_tp.vkCmdBindDescriptorSets( _cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout.Handle(), binding, 1, &desc_set, 1, &offset );
-			_tp.Stat().descriptorBinds++;
+			_tp._BindGraphicsDescriptorSet( layout.Handle(), binding, desc_set, {offset} );
 		}
 	}
 
@@ -791,9 +856,14 @@ namespace FG
 */
 	inline void VTaskProcessor::DrawTaskCommands::Visit (const VFgDrawTask<FG::CustomDraw> &task)
 	{
+		// draw context uses resource manager of the command buffer
+		auto		lock = _tp._LockSharedState();
 		DrawContext	ctx{ _tp, *_currTask->GetLogicalPass() };
 
 		task.callback( ctx );
+
+		// custom draw may change any state by using native command buffer
+		_tp._ResetDrawContext();
 	}
 //-----------------------------------------------------------------------------
 	
@@ -852,10 +922,7 @@ namespace FG
 		_renderState.multisample	= _logicalRP.GetMultisampleState();
 		_renderState.inputAssembly	= Default;
 
-		_tp._indexBuffer			= VK_NULL_HANDLE;
-		_tp._graphicsPipeline		= Default;
-		_tp._isDefaultScissor		= false;
-		_tp._perPassStatesUpdated	= false;
+		_tp._ResetDrawContext();
 	}
 
 /*
@@ -949,8 +1016,7 @@ namespace FG
 		uint						binding;
 		_pplnLayout->GetDescriptorSetLayout( id, OUT ds_layout, OUT binding );
 
-		_tp.vkCmdBindDescriptorSets( _tp._cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pplnLayout->Handle(), binding, 1, &ds, uint(dyn_offs.size()), dyn_offs.data() );
-		_tp.Stat().descriptorBinds++;
+		_tp._BindGraphicsDescriptorSet( _pplnLayout->Handle(), binding, ds, dyn_offs );
 	}
 	
 /*
@@ -999,8 +1065,7 @@ namespace FG
 			VkBuffer		vk_buf	= buf->Handle();
 			VkDeviceSize	off		{ offset };
 
-			_tp.vkCmdBindVertexBuffers( _tp._cmdBuffer, iter->second.index, 1, &vk_buf, &off );
-			_tp.Stat().vertexBufferBindings++;
+			_tp._BindVertexBuffers( iter->second.index, {vk_buf}, {off} );
 		}
 	}
 	
@@ -1279,10 +1344,26 @@ namespace FG
 =================================================
 */
 	VTaskProcessor::VTaskProcessor (VCommandBuffer &fgThread, VkCommandBuffer cmd) :
+		VTaskProcessor{ fgThread, cmd, fgThread.GetAllocator(), fgThread.GetBarrierManager(), fgThread.GetDebugger(), fgThread.EditStatistic().renderer }
+	{}
+	
+/*
+=================================================
+	constructor
+----
+	used to record tasks into secondary command buffer on the worker thread,
+	all temporary data is allocated in 'allocator' and barriers are added to 'barrierMngr'.
+=================================================
+*/
+	VTaskProcessor::VTaskProcessor (VCommandBuffer &fgThread, VkCommandBuffer cmd, LinearAllocator<> &allocator,
+									VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger, Statistic_t &stat) :
 		_fgThread{ fgThread },
-		_cmdBuffer{ cmd },						_enableDebugUtils{ _fgThread.GetDevice().IsDebugUtilsEnabled() },
+		_cmdBuffer{ cmd },						_barrierMngr{ barrierMngr },
+		_debugger{ debugger },					_stat{ stat },
+		_enableDebugUtils{ _fgThread.GetDevice().IsDebugUtilsEnabled() },
 		_isDefaultScissor{ false },				_perPassStatesUpdated{ false },
-		_pendingResourceBarriers{ fgThread.GetAllocator() }
+		_pendingImages{ allocator },			_pendingBuffers{ allocator },
+		_pendingRTGeometries{ allocator },		_pendingRTScenes{ allocator }
 	{
 		ASSERT( _cmdBuffer );
 		
@@ -1644,7 +1725,7 @@ namespace FG
 	_BeginRenderPass
 =================================================
 */
-	void VTaskProcessor::_BeginRenderPass (const VFgTask<SubmitRenderPass> &task)
+	void VTaskProcessor::_BeginRenderPass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents)
 	{
 		ASSERT( not task.IsSubpass() );
 
@@ -1667,6 +1748,18 @@ namespace FG
 				draw->Process1( &barrier_visitor );
 			}
 
+			// sort keys are calculated in the first pass
+			pass->SortDrawTasks();
+
+			// barriers for secondary command buffers are merged and committed before render pass
+			for (auto& secondary : pass->GetSecondaries())
+			{
+				for (auto& draw : secondary->GetDrawTasks())
+				{
+					draw->Process1( &barrier_visitor );
+				}
+			}
+
 			for (auto& item : pass->GetMutableImages())
 			{
 				ImageViewDesc	desc{ item.first->Description() };
@@ -1706,7 +1799,7 @@ namespace FG
 		pass_info.pClearValues				= task.GetLogicalPass()->GetClearValues().data();
 		pass_info.framebuffer				= framebuffer->Handle();
 		
-		vkCmdBeginRenderPass( _cmdBuffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE );
+		vkCmdBeginRenderPass( _cmdBuffer, &pass_info, contents );
 
 		_BindShadingRateImage( sri_view );
 	}
@@ -1716,13 +1809,13 @@ namespace FG
 	_BeginSubpass
 =================================================
 */
-	void VTaskProcessor::_BeginSubpass (const VFgTask<SubmitRenderPass> &task)
+	void VTaskProcessor::_BeginSubpass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents)
 	{
 		ASSERT( task.IsSubpass() );
 
 		// TODO: barriers for attachments
 
-		vkCmdNextSubpass( _cmdBuffer, VK_SUBPASS_CONTENTS_INLINE );
+		vkCmdNextSubpass( _cmdBuffer, contents );
 		/*
 		// TODO
 		vkCmdClearAttachments( _cmdBuffer,
@@ -1739,9 +1832,13 @@ namespace FG
 */
 	void VTaskProcessor::Visit (const VFgTask<SubmitRenderPass> &task)
 	{
-		if ( task.GetLogicalPass()->GetDrawTasks().empty() )
+		auto const&		logical_pass	= *task.GetLogicalPass();
+
+		if ( logical_pass.GetDrawTasks().empty() and logical_pass.GetSecondaries().empty() )
 			return;
 
+		const VkSubpassContents	contents = (logical_pass.GetSecondaries().empty() ? VK_SUBPASS_CONTENTS_INLINE : VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
 		// invalidate some states
 		_isDefaultScissor		= false;
 		_perPassStatesUpdated	= false;
@@ -1749,23 +1846,28 @@ namespace FG
 		if ( not task.IsSubpass() )
 		{
 			_CmdPushDebugGroup( task.Name() );
-			_BeginRenderPass( task );
+			_BeginRenderPass( task, contents );
 		}
 		else
 		{
 			_CmdPopDebugGroup();
 			_CmdPushDebugGroup( task.Name() );
-			_BeginSubpass( task );
+			_BeginSubpass( task, contents );
 		}
 
 
 		// draw
-		DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
-		
-		for (auto& draw : task.GetLogicalPass()->GetDrawTasks())
+		if ( contents == VK_SUBPASS_CONTENTS_INLINE )
 		{
-			draw->Process2( &command_builder );
+			DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
+		
+			for (auto& draw : logical_pass.GetDrawTasks())
+			{
+				draw->Process2( &command_builder );
+			}
 		}
+		else
+			_ExecuteSecondaries( task );
 
 		// end render pass
 		if ( task.IsLastPass() )
@@ -1775,6 +1877,93 @@ namespace FG
 		}
 	}
 	
+/*
+=================================================
+	_ExecuteSecondaries
+----
+	secondary command buffers of the render pass are recorded in parallel,
+	draw tasks access shared state of the command buffer only when 'shared_guard' is locked.
+=================================================
+*/
+	void VTaskProcessor::_ExecuteSecondaries (const VFgTask<SubmitRenderPass> &task)
+	{
+		using CmdBuffers_t	= FixedArray< VkCommandBuffer, FG_MaxSecondaryCmdBuffers >;
+
+		auto const&			logical_pass	= *task.GetLogicalPass();
+		auto				secondaries		= logical_pass.GetSecondaries();
+		VFramebuffer const*	framebuffer		= _GetResource( logical_pass.GetFramebufferID() );
+		VRenderPass const*	render_pass		= _GetResource( logical_pass.GetRenderPassID() );
+		const uint			thread_count	= Min( uint(secondaries.size()), FG_MaxRecordingThreads );
+		VCmdBatch &			batch			= _fgThread.GetBatch();
+		CmdBuffers_t		cmd_buffers;
+		std::mutex			shared_guard;
+
+		VkCommandBufferInheritanceInfo	inheritance = {};
+		inheritance.sType		= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass	= render_pass->Handle();
+		inheritance.subpass		= logical_pass.GetSubpassIndex();
+		inheritance.framebuffer	= framebuffer->Handle();
+
+		// secondaries that are recorded on the same thread use the same command pool
+		for (size_t i = 0; i < secondaries.size(); ++i)
+		{
+			VkCommandBuffer	cmd = secondaries[i]->BeginRecording( batch, _fgThread.GetDrawCommandPool( uint(i % thread_count) ), inheritance );
+
+			if ( cmd )
+				cmd_buffers.push_back( cmd );
+		}
+
+		// each index uses its own command pool, current thread records secondaries too
+		_fgThread.GetInstance().GetRecordingWorkers().ParallelFor( thread_count, [&task, &shared_guard, secondaries, thread_count] (uint first)
+			{
+				for (size_t i = first; i < secondaries.size(); i += thread_count) {
+					secondaries[i]->Record( task, shared_guard );
+				}
+			});
+
+		for (auto* secondary : secondaries) {
+			_fgThread.EditStatistic().Merge( secondary->GetStatistic() );
+		}
+
+		if ( cmd_buffers.size() )
+			vkCmdExecuteCommands( _cmdBuffer, uint(cmd_buffers.size()), cmd_buffers.data() );
+
+		// state of the primary command buffer is undefined after executing secondary command buffers
+		_ResetDrawContext();
+	}
+	
+/*
+=================================================
+	RecordDrawTasks
+----
+	called from the worker thread, dynamic states and shading rate image
+	are not inherited from the primary command buffer, so they are set again.
+=================================================
+*/
+	void VTaskProcessor::RecordDrawTasks (const VFgTask<SubmitRenderPass> &task, ArrayView<IDrawTask *> drawTasks, std::mutex &sharedGuard)
+	{
+		_sharedGuard			= &sharedGuard;
+		_isDefaultScissor		= false;
+		_perPassStatesUpdated	= false;
+
+		VLocalImage const*	sri_image;
+		ImageViewDesc		sri_desc;
+
+		if ( task.GetLogicalPass()->GetShadingRateImage( OUT sri_image, OUT sri_desc ))
+		{
+			_BindShadingRateImage( sri_image->GetView( _fgThread.GetDevice(), false, sri_desc ));
+		}
+
+		DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
+
+		for (auto& draw : drawTasks)
+		{
+			draw->Process2( &command_builder );
+		}
+
+		_sharedGuard = null;
+	}
+	
 /*
 =================================================
 	_ExtractDescriptorSets
@@ -1798,8 +1987,8 @@ namespace FG
 			if ( not layout.GetDescriptorSetLayout( res.descSetId, OUT ds_layout, OUT binding ))
 				continue;
 
-			PipelineResourceBarriers	visitor{ *this, resourceSet.dynamicOffsets };
-			res.pplnRes->ForEachUniform( visitor );
+			PipelineResourceBarriers	barriers{ *this, resourceSet.dynamicOffsets };
+			barriers( *res.pplnRes );
 
 			ASSERT( ds_layout == res.pplnRes->GetLayoutID() );
 			ASSERT( binding >= first_ds );
@@ -1811,12 +2000,17 @@ namespace FG
 
 		// sort dynamic offsets by binding index
 		uint	dst = 0;
-		for (auto& item : new_offsets)
+		resourceSet.dynamicOffsetCounts.resize( descriptorSets.size() );
+
+		for (size_t b = 0; b < descriptorSets.size(); ++b)
 		{
-			for (uint i = item.first; i < item.second; ++i, ++dst)
+			auto&	item = new_offsets[b];
+
+			for (uint i = item.first, end = item.first + item.second; i < end; ++i, ++dst)
 			{
 				resourceSet.dynamicOffsets[dst] = old_offsets[i];
 			}
+			resourceSet.dynamicOffsetCounts[b] = item.second;
 		}
 	}
 	
@@ -1998,15 +2192,18 @@ namespace FG
 		SetupExtensions( logicalRP, INOUT dynamic_states );
 
 		VkPipeline	ppln_id;
-		_fgThread.GetPipelineCache().CreatePipelineInstance(
-										_fgThread,
-										logicalRP,
-										*task.pipeline,
-										task.vertexInput,
-										render_state,
-										dynamic_states,
-										task.GetDebugModeIndex(),
-										OUT ppln_id, OUT pplnLayout );
+		{
+			auto	lock = _LockSharedState();
+			_fgThread.GetPipelineCache().CreatePipelineInstance(
+											_fgThread,
+											logicalRP,
+											*task.pipeline,
+											task.vertexInput,
+											render_state,
+											dynamic_states,
+											task.GetDebugModeIndex(),
+											OUT ppln_id, OUT pplnLayout );
+		}
 
 		_BindPipeline2( logicalRP, ppln_id );
 	}
@@ -2033,14 +2230,17 @@ namespace FG
 		SetupExtensions( logicalRP, INOUT dynamic_states );
 
 		VkPipeline	ppln_id;
-		_fgThread.GetPipelineCache().CreatePipelineInstance(
-										_fgThread,
-										logicalRP,
-										*task.pipeline,
-										render_state,
-										dynamic_states,
-										task.GetDebugModeIndex(),
-										OUT ppln_id, OUT pplnLayout );
+		{
+			auto	lock = _LockSharedState();
+			_fgThread.GetPipelineCache().CreatePipelineInstance(
+											_fgThread,
+											logicalRP,
+											*task.pipeline,
+											render_state,
+											dynamic_states,
+											task.GetDebugModeIndex(),
+											OUT ppln_id, OUT pplnLayout );
+		}
 		
 		_BindPipeline2( logicalRP, ppln_id );
 	}
@@ -2863,12 +3063,12 @@ namespace FG
 		ASSERT( img );
 		ASSERT( not state.range.IsEmpty() );
 
-		_pendingResourceBarriers.insert({ img, &CommitResourceBarrier<VLocalImage> });
+		_AddPendingBarrier( INOUT _pendingImages, img );
 
 		img->AddPendingState( state );
 
-		if ( _fgThread.GetDebugger() )
-			_fgThread.GetDebugger()->AddImageUsage( img->ToGlobal(), state );
+		if ( _debugger )
+			_debugger->AddImageUsage( img->ToGlobal(), state );
 	}
 	
 /*
@@ -2930,12 +3130,12 @@ namespace FG
 	inline void VTaskProcessor::_AddBufferState (const VLocalBuffer *buf, const BufferState &state)
 	{
 		ASSERT( buf );
-		_pendingResourceBarriers.insert({ buf, &CommitResourceBarrier<VLocalBuffer> });
+		_AddPendingBarrier( INOUT _pendingBuffers, buf );
 
 		buf->AddPendingState( state );
 		
-		if ( _fgThread.GetDebugger() )
-			_fgThread.GetDebugger()->AddBufferUsage( buf->ToGlobal(), state );
+		if ( _debugger )
+			_debugger->AddBufferUsage( buf->ToGlobal(), state );
 	}
 
 /*
@@ -3000,12 +3200,12 @@ namespace FG
 	void VTaskProcessor::_AddRTGeometry (const VLocalRTGeometry *geom, EResourceState state)
 	{
 		ASSERT( geom );
-		_pendingResourceBarriers.insert({ geom, &CommitResourceBarrier<VLocalRTGeometry> });
+		_AddPendingBarrier( INOUT _pendingRTGeometries, geom );
 
 		geom->AddPendingState(RTGeometryState{ state, _currTask });
 
-		if ( _fgThread.GetDebugger() )
-			_fgThread.GetDebugger()->AddRTGeometryUsage( geom->ToGlobal(), RTGeometryState{ state, _currTask });
+		if ( _debugger )
+			_debugger->AddRTGeometryUsage( geom->ToGlobal(), RTGeometryState{ state, _currTask });
 	}
 	
 /*
@@ -3016,12 +3216,66 @@ namespace FG
 	void VTaskProcessor::_AddRTScene (const VLocalRTScene *scene, EResourceState state)
 	{
 		ASSERT( scene );
-		_pendingResourceBarriers.insert({ scene, &CommitResourceBarrier<VLocalRTScene> });
+		_AddPendingBarrier( INOUT _pendingRTScenes, scene );
 
 		scene->AddPendingState(RTSceneState{ state, _currTask });
 
-		if ( _fgThread.GetDebugger() )
-			_fgThread.GetDebugger()->AddRTSceneUsage( scene->ToGlobal(), RTSceneState{ state, _currTask });
+		if ( _debugger )
+			_debugger->AddRTSceneUsage( scene->ToGlobal(), RTSceneState{ state, _currTask });
+	}
+
+/*
+=================================================
+	_AddPendingBarrier
+=================================================
+*/
+	template <typename Res>
+	inline void VTaskProcessor::_AddPendingBarrier (INOUT PendingBarriers<Res> &pending, const Res *res)
+	{
+		const uint	index	= res->LocalIndex();
+		const uint	word	= index / 64;
+		ASSERT( index != UMax );
+
+		if ( index >= pending.resources.size() )
+		{
+			pending.resources.resize( index+1 );
+			pending.bits.resize( word+1 );
+		}
+
+		ASSERT( pending.resources[index] == null or pending.resources[index] == res );
+
+		pending.resources[index] = res;
+		pending.bits[word]		|= (uint64_t(1) << (index % 64));
+		pending.firstWord		 = Min( pending.firstWord, word );
+		pending.lastWord		 = Max( pending.lastWord, word );
+	}
+	
+/*
+=================================================
+	_CommitPendingBarriers
+----
+	sweep over set bits in ascending local index order.
+=================================================
+*/
+	template <typename Res>
+	inline void VTaskProcessor::_CommitPendingBarriers (INOUT PendingBarriers<Res> &pending)
+	{
+		if ( pending.firstWord > pending.lastWord )
+			return;
+
+		for (uint w = pending.firstWord; w <= pending.lastWord; ++w)
+		{
+			for (uint64_t bits = pending.bits[w]; bits; bits &= (bits - 1))
+			{
+				const uint	index = w * 64 + uint(BitScanForward( bits ));
+
+				pending.resources[index]->CommitBarrier( _barrierMngr, _debugger );
+			}
+			pending.bits[w] = 0;
+		}
+
+		pending.firstWord	= UMax;
+		pending.lastWord	= 0;
 	}
 
 /*
@@ -3031,16 +3285,191 @@ namespace FG
 */
 	inline void VTaskProcessor::_CommitBarriers ()
 	{
-		for (auto& res : _pendingResourceBarriers)
+		_CommitPendingBarriers( INOUT _pendingImages );
+		_CommitPendingBarriers( INOUT _pendingBuffers );
+		_CommitPendingBarriers( INOUT _pendingRTGeometries );
+		_CommitPendingBarriers( INOUT _pendingRTScenes );
+
+		_barrierMngr.Commit( _fgThread.GetDevice(), _cmdBuffer, INOUT Stat() );
+	}
+	
+/*
+=================================================
+	_BindGraphicsDescriptorSets
+----
+	binds only minimal range of descriptor sets that differ from currently bound sets.
+	all sets are invalidated when pipeline layout is changed, it is
+	more strict than layout compatibility rules but doesn't require to compare set layouts.
+=================================================
+*/
+	void VTaskProcessor::_BindGraphicsDescriptorSets (const VPipelineLayout &layout, ArrayView<VkDescriptorSet> descSets, const VPipelineResourceSet &resourceSet)
+	{
+		if ( descSets.empty() )
+			return;
+
+		const VkPipelineLayout	layout_handle	= layout.Handle();
+		const uint				first_ds		= layout.GetFirstDescriptorSet();
+		auto const&				dyn_offsets		= resourceSet.dynamicOffsets;
+		auto const&				offset_counts	= resourceSet.dynamicOffsetCounts;
+
+		ASSERT( offset_counts.size() == descSets.size() );
+		CHECK_ERR( first_ds + descSets.size() <= _descSets.size(), void());
+
+		if ( _descSetsLayout != layout_handle )
 		{
-			res.second( res.first, _fgThread.GetBarrierManager(), _fgThread.GetDebugger() );
+			_descSetsLayout = layout_handle;
+
+			for (auto& ds : _descSets) {
+				ds.descSet = VK_NULL_HANDLE;
+			}
 		}
 
-		_pendingResourceBarriers.clear();
+		uint	first_changed	= UMax;
+		uint	last_changed	= 0;
+		uint	first_offset	= 0;
+		uint	last_offset		= 0;
+
+		for (uint i = 0, offset = 0; i < descSets.size(); ++i)
+		{
+			auto&			state	= _descSets[ first_ds + i ];
+			ArrayView<uint>	offsets	{ dyn_offsets.data() + offset, offset_counts[i] };
 
-		_fgThread.GetBarrierManager().Commit( _fgThread.GetDevice(), _cmdBuffer );
+			if ( state.descSet != descSets[i] or state.dynamicOffsets != offsets )
+			{
+				state.descSet = descSets[i];
+				state.dynamicOffsets.assign( offsets.begin(), offsets.end() );
+
+				if ( first_changed == UMax ) {
+					first_changed	= i;
+					first_offset	= offset;
+				}
+				last_changed	= i;
+				last_offset		= offset + offset_counts[i];
+			}
+			offset += offset_counts[i];
+		}
+
+		if ( first_changed == UMax )
+		{
+			Stat().descriptorBindsSkipped += uint(descSets.size());
+			return;
+		}
+
+		const uint	count = last_changed - first_changed + 1;
+
+		vkCmdBindDescriptorSets( _cmdBuffer,
+								 VK_PIPELINE_BIND_POINT_GRAPHICS,
+								 layout_handle,
+								 first_ds + first_changed,
+								 count,
+								 descSets.data() + first_changed,
+								 last_offset - first_offset,
+								 dyn_offsets.data() + first_offset );
+
+		Stat().descriptorBinds++;
+		Stat().descriptorBindsSkipped += uint(descSets.size()) - count;
+	}
+	
+/*
+=================================================
+	_BindGraphicsDescriptorSet
+=================================================
+*/
+	void VTaskProcessor::_BindGraphicsDescriptorSet (VkPipelineLayout layout, uint index, VkDescriptorSet descSet, ArrayView<uint> dynamicOffsets)
+	{
+		CHECK_ERR( index < _descSets.size(), void());
+
+		if ( _descSetsLayout != layout )
+		{
+			_descSetsLayout = layout;
+
+			for (auto& ds : _descSets) {
+				ds.descSet = VK_NULL_HANDLE;
+			}
+		}
+
+		auto&	state = _descSets[ index ];
+
+		if ( state.descSet == descSet and state.dynamicOffsets == dynamicOffsets )
+		{
+			Stat().descriptorBindsSkipped++;
+			return;
+		}
+
+		state.descSet = descSet;
+		state.dynamicOffsets.assign( dynamicOffsets.begin(), dynamicOffsets.end() );
+
+		vkCmdBindDescriptorSets( _cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, index, 1, &descSet, uint(dynamicOffsets.size()), dynamicOffsets.data() );
+		Stat().descriptorBinds++;
+	}
+	
+/*
+=================================================
+	_BindVertexBuffers
+----
+	binds only minimal range of vertex buffers that differ from currently bound buffers.
+=================================================
+*/
+	void VTaskProcessor::_BindVertexBuffers (uint firstBinding, ArrayView<VkBuffer> buffers, ArrayView<VkDeviceSize> offsets)
+	{
+		ASSERT( buffers.size() == offsets.size() );
+		CHECK_ERR( firstBinding + buffers.size() <= _vertexBuffers.size(), void());
+
+		uint	first_changed	= UMax;
+		uint	last_changed	= 0;
+
+		for (uint i = 0; i < buffers.size(); ++i)
+		{
+			const uint	binding = firstBinding + i;
+
+			if ( _vertexBuffers[binding] != buffers[i] or _vertexOffsets[binding] != offsets[i] )
+			{
+				_vertexBuffers[binding] = buffers[i];
+				_vertexOffsets[binding] = offsets[i];
+
+				first_changed	= Min( first_changed, i );
+				last_changed	= i;
+			}
+		}
+
+		if ( first_changed == UMax )
+		{
+			Stat().vertexBufferBindingsSkipped += uint(buffers.size());
+			return;
+		}
+
+		const uint	count = last_changed - first_changed + 1;
+
+		vkCmdBindVertexBuffers( _cmdBuffer, firstBinding + first_changed, count, buffers.data() + first_changed, offsets.data() + first_changed );
+
+		Stat().vertexBufferBindings++;
+		Stat().vertexBufferBindingsSkipped += uint(buffers.size()) - count;
 	}
 	
+/*
+=================================================
+	_ResetDrawContext
+----
+	invalidates cached graphics states, next draw call will bind all states again.
+=================================================
+*/
+	void VTaskProcessor::_ResetDrawContext ()
+	{
+		_graphicsPipeline		= Default;
+		_indexBuffer			= VK_NULL_HANDLE;
+		_descSetsLayout			= VK_NULL_HANDLE;
+		_isDefaultScissor		= false;
+		_perPassStatesUpdated	= false;
+
+		for (auto& ds : _descSets) {
+			ds.descSet = VK_NULL_HANDLE;
+		}
+
+		for (auto& vb : _vertexBuffers) {
+			vb = VK_NULL_HANDLE;
+		}
+	}
+
 /*
 =================================================
 	_BindIndexBuffer
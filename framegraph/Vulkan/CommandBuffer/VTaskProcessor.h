@@ -8,6 +8,7 @@
 #include "VLocalRTGeometry.h"
 #include "VLocalRTScene.h"
 #include "VBarrierManager.h"
+#include "stl/Math/BitMath.h"
 
 namespace FG
 {
@@ -32,9 +33,20 @@ namespace FG
 		using RTGeometryState			= VLocalRTGeometry::GeometryState;
 		using RTSceneState				= VLocalRTScene::SceneState;
 
-		using CommitBarrierFn_t			= void (*) (const void *, VBarrierManager &, Ptr<VLocalDebugger>);
-		using PendingResourceBarriers_t	= std::unordered_map< void const*, CommitBarrierFn_t, std::hash<void const*>, std::equal_to<void const*>,
-															  StdLinearAllocator<Pair<void const* const, CommitBarrierFn_t>> >;	// TODO: use temp allocator
+		// resources with uncommitted barriers, indexed by local resource index
+		template <typename Res>
+		struct PendingBarriers
+		{
+			using Bits_t		= std::vector< uint64_t, StdLinearAllocator<uint64_t> >;
+			using Resources_t	= std::vector< Res const*, StdLinearAllocator<Res const*> >;
+
+			Bits_t			bits;					// one bit per local resource
+			Resources_t		resources;
+			uint			firstWord	= UMax;		// range of non-zero words in 'bits'
+			uint			lastWord	= 0;
+
+			explicit PendingBarriers (LinearAllocator<> &alloc) : bits{alloc}, resources{alloc} {}
+		};
 		
 		using BufferCopyRegions_t		= FixedArray< VkBufferCopy, FG_MaxCopyRegions >;
 		using ImageCopyRegions_t		= FixedArray< VkImageCopy, FG_MaxCopyRegions >;
@@ -51,18 +63,35 @@ namespace FG
 			VkPipeline		pipeline	= VK_NULL_HANDLE;
 		};
 
+		struct DescriptorSetState
+		{
+			VkDescriptorSet									descSet		= VK_NULL_HANDLE;
+			FixedArray< uint, FG_MaxBufferDynamicOffsets >	dynamicOffsets;
+		};
+
+		using DescriptorSetStates_t		= StaticArray< DescriptorSetState, FG_MaxDescriptorSets >;
+		using VertexBufferHandles_t		= StaticArray< VkBuffer, FG_MaxVertexBuffers >;
+		using VertexBufferOffsets_t		= StaticArray< VkDeviceSize, FG_MaxVertexBuffers >;
+
 
 	// variables
 	private:
 		VCommandBuffer &			_fgThread;
 		const VkCommandBuffer		_cmdBuffer;
+		VBarrierManager &			_barrierMngr;
+		const Ptr<VLocalDebugger>	_debugger;
+		Statistic_t &				_stat;
+		Ptr<std::mutex>				_sharedGuard;		// not null if draw tasks are recorded on the worker thread
 		
 		VTask						_currTask;
 		bool						_enableDebugUtils		: 1;
 		bool						_isDefaultScissor		: 1;
 		bool						_perPassStatesUpdated	: 1;
 
-		PendingResourceBarriers_t	_pendingResourceBarriers;
+		PendingBarriers< VLocalImage >		_pendingImages;
+		PendingBarriers< VLocalBuffer >		_pendingBuffers;
+		PendingBarriers< VLocalRTGeometry >	_pendingRTGeometries;
+		PendingBarriers< VLocalRTScene >	_pendingRTScenes;
 
 		PipelineState				_graphicsPipeline;
 		PipelineState				_computePipeline;
@@ -73,6 +102,14 @@ namespace FG
 		VkDeviceSize				_indexBufferOffset	= UMax;
 		VkIndexType					_indexType			= VK_INDEX_TYPE_MAX_ENUM;
 
+		// graphics descriptor sets state, indexed by set number
+		VkPipelineLayout			_descSetsLayout		= VK_NULL_HANDLE;
+		DescriptorSetStates_t		_descSets;
+
+		// vertex buffers state, indexed by binding
+		VertexBufferHandles_t		_vertexBuffers		= {};
+		VertexBufferOffsets_t		_vertexOffsets		= {};
+
 		VkImageView					_shadingRateImage	= VK_NULL_HANDLE;
 
 		static constexpr float		_dbgColor[4]		= { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -81,6 +118,7 @@ namespace FG
 	// methods
 	public:
 		explicit VTaskProcessor (VCommandBuffer &, VkCommandBuffer);
+		VTaskProcessor (VCommandBuffer &, VkCommandBuffer, LinearAllocator<> &, VBarrierManager &, Ptr<VLocalDebugger>, Statistic_t &);
 		~VTaskProcessor ();
 
 		void Visit (const VFgTask<SubmitRenderPass> &);
@@ -120,6 +158,7 @@ namespace FG
 		static void Visit2_CustomDraw (void *, void *);
 
 		void Run (VTask);
+		void RecordDrawTasks (const VFgTask<SubmitRenderPass> &, ArrayView<IDrawTask *>, std::mutex &sharedGuard);
 
 
 	private:
@@ -131,15 +170,22 @@ namespace FG
 		template <typename ID>	ND_ auto const*  _GetResource (ID id) const;
 		
 		void _CommitBarriers ();
+
+		template <typename Res>	void _AddPendingBarrier (INOUT PendingBarriers<Res> &pending, const Res *res);
+		template <typename Res>	void _CommitPendingBarriers (INOUT PendingBarriers<Res> &pending);
 		
 		void _AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const DrawTaskBarriers &info);
 		void _SetShadingRateImage (const VLogicalRenderPass &logicalRP, OUT VkImageView &view);
-		void _BeginRenderPass (const VFgTask<SubmitRenderPass> &task);
-		void _BeginSubpass (const VFgTask<SubmitRenderPass> &task);
+		void _BeginRenderPass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents);
+		void _BeginSubpass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents);
+		void _ExecuteSecondaries (const VFgTask<SubmitRenderPass> &task);
 		bool _CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses);
 
 		void _ExtractDescriptorSets (const VPipelineLayout &, const VPipelineResourceSet &, OUT VkDescriptorSets_t &);
 		void _BindPipelineResources (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet, VkPipelineBindPoint bindPoint, ShaderDbgIndex debugModeIndex);
+		void _BindGraphicsDescriptorSets (const VPipelineLayout &layout, ArrayView<VkDescriptorSet> descSets, const VPipelineResourceSet &resourceSet);
+		void _BindGraphicsDescriptorSet (VkPipelineLayout layout, uint index, VkDescriptorSet descSet, ArrayView<uint> dynamicOffsets);
+		void _BindVertexBuffers (uint firstBinding, ArrayView<VkBuffer> buffers, ArrayView<VkDeviceSize> offsets);
 		void _BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, OUT VPipelineLayout const* &pplnLayout);
 		void _BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, OUT VPipelineLayout const* &pplnLayout);
 		void _BindPipeline2 (const VLogicalRenderPass &logicalRP, VkPipeline pipelineId);
@@ -166,6 +212,7 @@ namespace FG
 		void _BindIndexBuffer (VkBuffer indexBuffer, VkDeviceSize indexOffset, VkIndexType indexType);
 
 		ND_ Statistic_t&  Stat () const;
+		ND_ std::unique_lock<std::mutex>  _LockSharedState () const;
 	};
 
 
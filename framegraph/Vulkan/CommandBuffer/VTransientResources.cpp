@@ -0,0 +1,413 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VTransientResources.h"
+#include "VResourceManager.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	OnStart
+=================================================
+*/
+	void  VTransientResources::OnStart (LinearAllocator<> &alloc)
+	{
+		_allocator	= &alloc;
+		_current	= NoScope;
+		_barrierPos	= 0;
+
+		_resources.Create( alloc );
+		_usages.Create( alloc );
+		_scopes.Create( alloc );
+		_passScopes.Create( alloc );
+		_deferredSets.Create( alloc );
+		_aliasingBarriers.Create( alloc );
+	}
+
+/*
+=================================================
+	OnDiscardMemory
+=================================================
+*/
+	void  VTransientResources::OnDiscardMemory ()
+	{
+		_resources.Destroy();
+		_usages.Destroy();
+		_scopes.Destroy();
+		_passScopes.Destroy();
+		_deferredSets.Destroy();
+		_aliasingBarriers.Destroy();
+
+		_allocator = null;
+	}
+
+/*
+=================================================
+	Add
+=================================================
+*/
+	void  VTransientResources::Add (RawImageID id, const VkMemoryRequirements &memReq)
+	{
+		Resource	res;
+		res.image	= id;
+		res.memReq	= memReq;
+
+		_resources->push_back( res );
+	}
+
+	void  VTransientResources::Add (RawBufferID id, const VkMemoryRequirements &memReq)
+	{
+		Resource	res;
+		res.buffer	= id;
+		res.memReq	= memReq;
+
+		_resources->push_back( res );
+	}
+
+/*
+=================================================
+	AddDeferred
+=================================================
+*/
+	void  VTransientResources::AddDeferred (RawPipelineResourcesID id)
+	{
+		_deferredSets->push_back( id );
+	}
+
+/*
+=================================================
+	BeginTask
+----
+	resources that are used while task is created
+	will be alive when this task is executed.
+=================================================
+*/
+	void  VTransientResources::BeginTask ()
+	{
+		if ( Empty() )
+			return;
+
+		ASSERT( _current == NoScope );
+
+		_current = uint(_scopes->size());
+		_scopes->push_back( null );
+	}
+
+/*
+=================================================
+	EndTask
+----
+	'task' may be null if task creation failed.
+=================================================
+*/
+	void  VTransientResources::EndTask (VTask task)
+	{
+		if ( _current == NoScope )
+			return;
+
+		(*_scopes)[_current] = task;
+		_current = NoScope;
+	}
+
+/*
+=================================================
+	BeginPass
+----
+	draw tasks and render targets are used
+	when render pass is submitted.
+=================================================
+*/
+	void  VTransientResources::BeginPass (VLogicalRenderPass const* rp)
+	{
+		if ( Empty() )
+			return;
+
+		ASSERT( _current == NoScope );
+
+		for (auto& pass : *_passScopes)
+		{
+			if ( pass.first == rp ) {
+				_current = pass.second;
+				return;
+			}
+		}
+
+		_current = uint(_scopes->size());
+		_scopes->push_back( null );
+		_passScopes->push_back({ rp, _current });
+	}
+
+/*
+=================================================
+	EndPass
+=================================================
+*/
+	void  VTransientResources::EndPass ()
+	{
+		_current = NoScope;
+	}
+
+/*
+=================================================
+	SubmitPass
+=================================================
+*/
+	void  VTransientResources::SubmitPass (VLogicalRenderPass const* rp, VTask task)
+	{
+		for (auto& pass : *_passScopes)
+		{
+			if ( pass.first == rp ) {
+				(*_scopes)[pass.second] = task;
+				return;
+			}
+		}
+	}
+
+/*
+=================================================
+	AddUsage
+----
+	returns 'true' if resource is transient.
+=================================================
+*/
+	bool  VTransientResources::AddUsage (RawImageID id)
+	{
+		for (size_t i = 0; i < _resources->size(); ++i)
+		{
+			if ( (*_resources)[i].image == id ) {
+				_AddUsage( uint(i) );
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool  VTransientResources::AddUsage (RawBufferID id)
+	{
+		for (size_t i = 0; i < _resources->size(); ++i)
+		{
+			if ( (*_resources)[i].buffer == id ) {
+				_AddUsage( uint(i) );
+				return true;
+			}
+		}
+		return false;
+	}
+
+/*
+=================================================
+	_AddUsage
+=================================================
+*/
+	void  VTransientResources::_AddUsage (uint resource)
+	{
+		// resource is used outside of any task, so it must be alive during command buffer execution
+		if ( _current == NoScope )
+		{
+			auto&	res = (*_resources)[resource];
+			res.firstUse = uint(ExeOrderIndex::First);
+			res.lastUse  = uint(ExeOrderIndex::Final);
+			return;
+		}
+
+		_usages->push_back({ _current, resource });
+	}
+
+/*
+=================================================
+	_CalcLifetimes
+=================================================
+*/
+	void  VTransientResources::_CalcLifetimes ()
+	{
+		for (auto& usage : *_usages)
+		{
+			auto&	res		= (*_resources)[usage.resource];
+			VTask	task	= (*_scopes)[usage.scope];
+			uint	index	= task ? uint(task->ExecutionOrder()) : uint(ExeOrderIndex::Initial);
+
+			// task was not submitted or not processed
+			if ( index == uint(ExeOrderIndex::Initial) )
+			{
+				res.firstUse = uint(ExeOrderIndex::First);
+				res.lastUse  = uint(ExeOrderIndex::Final);
+				continue;
+			}
+
+			res.firstUse = Min( res.firstUse, index );
+			res.lastUse  = Max( res.lastUse, index );
+		}
+
+		// unused resources don't overlap with any other resources
+		for (auto& res : *_resources)
+		{
+			if ( res.firstUse > res.lastUse )
+				res.firstUse = res.lastUse = uint(ExeOrderIndex::Initial);
+		}
+	}
+
+/*
+=================================================
+	_PlaceResources
+----
+	resources are placed from the largest to the smallest,
+	each resource takes the lowest offset that doesn't overlap
+	with resources that are alive at the same time.
+	Images and buffers are placed into separate heaps to avoid 'bufferImageGranularity' restrictions.
+=================================================
+*/
+	bool  VTransientResources::_PlaceResources (OUT Heaps_t &heaps)
+	{
+		auto&	resources = *_resources;
+
+		Indices_t	order{ *_allocator };
+		order.resize( resources.size() );
+
+		for (size_t i = 0; i < order.size(); ++i) {
+			order[i] = uint(i);
+		}
+
+		std::sort( order.begin(), order.end(), [&resources] (uint lhs, uint rhs) {
+						return resources[lhs].memReq.size > resources[rhs].memReq.size;
+					});
+
+		const auto	IsAliveTogether	= [] (const Resource &lhs, const Resource &rhs) {
+										return lhs.firstUse <= rhs.lastUse and rhs.firstUse <= lhs.lastUse;
+									};
+		const auto	IsIntersects	= [] (const Resource &lhs, const Resource &rhs) {
+										return lhs.offset < rhs.offset + rhs.memReq.size and rhs.offset < lhs.offset + lhs.memReq.size;
+									};
+
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			auto&		res			= resources[ order[i] ];
+			const bool	is_image	= bool(res.image);
+
+			// find heap
+			for (res.heap = 0; res.heap < heaps.size(); ++res.heap)
+			{
+				auto&	heap = heaps[res.heap];
+
+				if ( heap.isImage == is_image and heap.memReq.memoryTypeBits == res.memReq.memoryTypeBits )
+					break;
+			}
+
+			if ( res.heap == heaps.size() )
+				heaps.push_back({ is_image, VkMemoryRequirements{ 0, 1, res.memReq.memoryTypeBits }});
+
+			// find lowest offset
+			res.offset = 0;
+
+			for (bool changed = true; changed;)
+			{
+				changed = false;
+
+				for (size_t j = 0; j < i; ++j)
+				{
+					auto&	other = resources[ order[j] ];
+
+					if ( other.heap == res.heap and IsAliveTogether( res, other ) and IsIntersects( res, other ))
+					{
+						res.offset	= AlignToLarger( other.offset + other.memReq.size, res.memReq.alignment );
+						changed		= true;
+					}
+				}
+			}
+
+			auto&	heap = heaps[res.heap];
+			heap.memReq.size		= Max( heap.memReq.size, res.offset + res.memReq.size );
+			heap.memReq.alignment	= Max( heap.memReq.alignment, res.memReq.alignment );
+
+			// resource reuses memory of the resource that was used before,
+			// so memory must be available for the new resource when it is used first time
+			for (size_t j = 0; j < i; ++j)
+			{
+				auto&	other = resources[ order[j] ];
+
+				if ( other.heap == res.heap and IsIntersects( res, other ))
+				{
+					_aliasingBarriers->push_back( Max( res.firstUse, other.firstUse ));
+				}
+			}
+		}
+
+		std::sort( _aliasingBarriers->begin(), _aliasingBarriers->end() );
+		_aliasingBarriers->erase( std::unique( _aliasingBarriers->begin(), _aliasingBarriers->end() ), _aliasingBarriers->end() );
+		return true;
+	}
+
+/*
+=================================================
+	Allocate
+----
+	must be called when execution order of all tasks is known.
+=================================================
+*/
+	bool  VTransientResources::Allocate (VResourceManager &resMngr, INOUT ResourceMap_t &resourceMap, INOUT Statistic_t &stat)
+	{
+		if ( Empty() )
+			return true;
+
+		_CalcLifetimes();
+
+		Heaps_t		heaps{ *_allocator };
+		CHECK_ERR( _PlaceResources( OUT heaps ));
+
+		// create memory blocks and bind resources
+		for (size_t i = 0; i < heaps.size(); ++i)
+		{
+			auto&		heap	= heaps[i];
+			RawMemoryID	mem_id	= resMngr.CreateTransientMemory( heap.memReq, "TransientMemory" );
+			CHECK_ERR( mem_id );
+
+			// memory will be released when command batch complete execution
+			resourceMap.insert({ VCmdBatch::Resource{ mem_id }, 1 });
+
+			for (auto& res : *_resources)
+			{
+				if ( res.heap != i )
+					continue;
+
+				if ( res.image )
+					CHECK_ERR( resMngr.BindTransientMemory( res.image, mem_id, BytesU(res.offset) ));
+				else
+					CHECK_ERR( resMngr.BindTransientMemory( res.buffer, mem_id, BytesU(res.offset) ));
+			}
+
+			stat.transientMemoryAllocated += BytesU(heap.memReq.size);
+		}
+
+		for (auto& res : *_resources)
+		{
+			stat.transientMemoryRequired += BytesU(res.memReq.size);
+		}
+		stat.transientResources += uint(_resources->size());
+
+		// image views can be created only when memory is bound
+		for (auto& id : *_deferredSets)
+		{
+			CHECK_ERR( resMngr.UpdateDescriptorSet( id ));
+		}
+		return true;
+	}
+
+/*
+=================================================
+	IsAliasingBarrierRequired
+----
+	tasks must be processed in execution order.
+=================================================
+*/
+	bool  VTransientResources::IsAliasingBarrierRequired (ExeOrderIndex index)
+	{
+		auto&	barriers = *_aliasingBarriers;
+
+		for (; _barrierPos < barriers.size() and barriers[_barrierPos] < uint(index); ++_barrierPos)
+		{}
+
+		return _barrierPos < barriers.size() and barriers[_barrierPos] == uint(index);
+	}
+
+
+}	// FG
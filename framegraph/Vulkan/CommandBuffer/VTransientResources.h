@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#pragma once
+
+#include "VTaskGraph.h"
+#include "VCmdBatch.h"
+
+namespace FG
+{
+
+	//
+	// Transient Resources
+	//
+	// Images and buffers that exist only inside a single command buffer.
+	// Lifetime of each resource is calculated from execution order of the tasks that use it,
+	// resources with non-overlapping lifetimes are placed into the same memory.
+	//
+
+	class VTransientResources final
+	{
+	// types
+	public:
+		using ResourceMap_t	= VCmdBatch::ResourceMap_t;
+		using Statistic_t	= IFrameGraph::ResourceStatistics;
+
+	private:
+		struct Resource
+		{
+			RawImageID				image;
+			RawBufferID				buffer;
+			VkMemoryRequirements	memReq		= {};
+			uint					firstUse	= UMax;		// execution order index
+			uint					lastUse		= 0;
+			VkDeviceSize			offset		= 0;
+			uint					heap		= UMax;
+		};
+
+		struct Usage
+		{
+			uint		scope;
+			uint		resource;
+		};
+
+		struct Heap
+		{
+			bool					isImage;
+			VkMemoryRequirements	memReq;
+		};
+
+		using PassScope_t		= Pair< VLogicalRenderPass const*, uint >;
+
+		using Resources_t		= std::vector< Resource, StdLinearAllocator<Resource> >;
+		using Usages_t			= std::vector< Usage, StdLinearAllocator<Usage> >;
+		using Scopes_t			= std::vector< VTask, StdLinearAllocator<VTask> >;
+		using PassScopes_t		= std::vector< PassScope_t, StdLinearAllocator<PassScope_t> >;
+		using Heaps_t			= std::vector< Heap, StdLinearAllocator<Heap> >;
+		using DescriptorSets_t	= std::vector< RawPipelineResourcesID, StdLinearAllocator<RawPipelineResourcesID> >;
+		using Indices_t			= std::vector< uint, StdLinearAllocator<uint> >;
+
+		static constexpr uint	NoScope	= UMax;
+
+
+	// variables
+	private:
+		Ptr<LinearAllocator<>>	_allocator;
+		InPlace<Resources_t>	_resources;
+		InPlace<Usages_t>		_usages;
+		InPlace<Scopes_t>		_scopes;			// task that owns the scope, resolved after task creation or render pass submission
+		InPlace<PassScopes_t>	_passScopes;		// draw tasks and attachments are used when render pass is submitted
+		InPlace<DescriptorSets_t>	_deferredSets;	// descriptor sets that are written after memory binding
+		InPlace<Indices_t>		_aliasingBarriers;	// sorted execution order indices
+		size_t					_barrierPos	= 0;
+		uint					_current	= NoScope;
+
+
+	// methods
+	public:
+		VTransientResources () {}
+
+		void OnStart (LinearAllocator<> &);
+		void OnDiscardMemory ();
+
+		void Add (RawImageID id, const VkMemoryRequirements &memReq);
+		void Add (RawBufferID id, const VkMemoryRequirements &memReq);
+		void AddDeferred (RawPipelineResourcesID id);
+
+		void BeginTask ();
+		void EndTask (VTask task);
+
+		void BeginPass (VLogicalRenderPass const* rp);
+		void EndPass ();
+		void SubmitPass (VLogicalRenderPass const* rp, VTask task);
+
+		ND_ bool  AddUsage (RawImageID id);
+		ND_ bool  AddUsage (RawBufferID id);
+
+		ND_ bool  Allocate (VResourceManager &, INOUT ResourceMap_t &, INOUT Statistic_t &);
+		ND_ bool  IsAliasingBarrierRequired (ExeOrderIndex index);
+
+		ND_ bool  Empty ()	const	{ return _resources->empty(); }
+
+
+	private:
+			void  _AddUsage (uint resource);
+			void  _CalcLifetimes ();
+		ND_ bool  _PlaceResources (OUT Heaps_t &heaps);
+	};
+
+
+}	// FG
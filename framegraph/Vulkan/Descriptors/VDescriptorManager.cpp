@@ -2,6 +2,7 @@
 
 #include "VDescriptorManager.h"
 #include "VDevice.h"
+#include <thread>
 
 namespace FG
 {
@@ -23,7 +24,7 @@ namespace FG
 */
 	VDescriptorManager::~VDescriptorManager ()
 	{
-		CHECK( _descriptorPools.empty() );
+		CHECK( _poolCount.load( memory_order_relaxed ) == 0 );
 	}
 	
 /*
@@ -35,6 +36,10 @@ namespace FG
 	{
 		EXLOCK( _guard );
 
+		for (auto& arena : _arenas) {
+			arena.store( 0, memory_order_relaxed );
+		}
+
 		CHECK_ERR( _CreateDescriptorPool() );
 		return true;
 	}
@@ -48,54 +53,141 @@ namespace FG
 	{
 		EXLOCK( _guard );
 
-		for (auto& item : _descriptorPools)
+		const uint	count = _poolCount.exchange( 0, memory_order_relaxed );
+
+		for (uint i = 0; i < count; ++i)
 		{
-			//EXLOCK( item.guard );
+			auto&	item = _descriptorPools[i];
+			EXLOCK( item.guard );
 
 			if ( item.pool )
 			{
 				_device.vkDestroyDescriptorPool( _device.GetVkDevice(), item.pool, null );
 				item.pool = VK_NULL_HANDLE;
 			}
+			item.allocated.store( 0, memory_order_relaxed );
 		}
-		_descriptorPools.clear();
 	}
 	
+/*
+=================================================
+	_ArenaIndex
+----
+	threads are mapped to arenas by hash,
+	so arena may be shared between threads, it is safe because pools have their own locks.
+=================================================
+*/
+	inline uint  VDescriptorManager::_ArenaIndex ()
+	{
+		return uint(size_t(HashOf( std::this_thread::get_id() )) % MaxThreadArenas);
+	}
+
 /*
 =================================================
 	AllocDescriptorSet
+----
+	allocate from the pool that is attached to the current thread arena,
+	global lock is used only when pool is exhausted and arena must acquire another pool.
 =================================================
 */
 	bool  VDescriptorManager::AllocDescriptorSet (VkDescriptorSetLayout layout, OUT DescriptorSet &ds)
 	{
-		EXLOCK( _guard );
-
 		VkDescriptorSetAllocateInfo		info = {};
 		info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 		info.descriptorSetCount	= 1;
 		info.pSetLayouts		= &layout;
 
-		for (auto& item : _descriptorPools)
+		auto&		arena		= _arenas[ _ArenaIndex() ];
+		const uint	pool_idx	= arena.load( memory_order_relaxed );
+
+		if ( _AllocInPool( pool_idx, info, OUT ds ))
+			return true;
+
+		EXLOCK( _guard );
+
+		// another thread may have already switched arena to the new pool
+		const uint	new_idx = arena.load( memory_order_relaxed );
+
+		if ( new_idx != pool_idx and _AllocInPool( new_idx, info, OUT ds ))
+			return true;
+
+		// acquire pool with the least number of allocated sets, pools are recycled when descriptor sets are released
+		const uint	count		= _poolCount.load( memory_order_relaxed );
+		uint		best_idx	= UMax;
+		uint		best_count	= MaxDescriptorSets;
+
+		for (uint i = 0; i < count; ++i)
 		{
-			//EXLOCK( item.guard );
-			info.descriptorPool = item.pool;
-			
-			if ( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &info, OUT &ds.first ) == VK_SUCCESS )
+			const uint	allocated = _descriptorPools[i].allocated.load( memory_order_relaxed );
+
+			if ( i != pool_idx and i != new_idx and allocated < best_count )
 			{
-				ds.second = uint8_t(Distance( _descriptorPools.data(), &item ));
-				return true;
+				best_idx	= i;
+				best_count	= allocated;
 			}
 		}
 
+		if ( best_idx != UMax and _AllocInPool( best_idx, info, OUT ds ))
+		{
+			arena.store( best_idx, memory_order_relaxed );
+			return true;
+		}
+
+		// all pools are full or fragmented
+		if ( _poolCount.load( memory_order_relaxed ) >= MaxDescriptorPools )
+		{
+			FG_LOGI( "all descriptor pools are exhausted" );
+			return false;
+		}
 		CHECK_ERR( _CreateDescriptorPool() );
 		
-		info.descriptorPool = _descriptorPools.back().pool;
-		VK_CHECK( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &info, OUT &ds.first ));
-		ds.second = uint8_t(_descriptorPools.size() - 1);
+		best_idx = _poolCount.load( memory_order_relaxed ) - 1;
+		CHECK_ERR( _AllocInPool( best_idx, info, OUT ds ));
 
+		arena.store( best_idx, memory_order_relaxed );
 		return true;
 	}
 	
+/*
+=================================================
+	_AllocInPool
+=================================================
+*/
+	bool  VDescriptorManager::_AllocInPool (uint poolIndex, const VkDescriptorSetAllocateInfo &inInfo, OUT DescriptorSet &ds)
+	{
+		if ( poolIndex >= _poolCount.load( memory_order_acquire ))
+			return false;
+
+		auto&	item = _descriptorPools[poolIndex];
+		EXLOCK( item.guard );
+
+		VkDescriptorSetAllocateInfo		info = inInfo;
+		info.descriptorPool = item.pool;
+
+		if ( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &info, OUT &ds.first ) != VK_SUCCESS )
+			return false;
+
+		ds.second = uint8_t(poolIndex);
+		item.allocated.fetch_add( 1, memory_order_relaxed );
+		return true;
+	}
+	
+/*
+=================================================
+	_FreeInPool
+=================================================
+*/
+	void  VDescriptorManager::_FreeInPool (uint poolIndex, ArrayView<VkDescriptorSet> descSets)
+	{
+		auto&	item = _descriptorPools[poolIndex];
+		EXLOCK( item.guard );
+
+		VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), item.pool, uint(descSets.size()), descSets.data() ));
+
+		ASSERT( item.allocated.load( memory_order_relaxed ) >= descSets.size() );
+		item.allocated.fetch_sub( uint(descSets.size()), memory_order_relaxed );
+	}
+
 /*
 =================================================
 	DeallocDescriptorSet
@@ -103,10 +195,9 @@ namespace FG
 */
 	bool  VDescriptorManager::DeallocDescriptorSet (const DescriptorSet &ds)
 	{
-		EXLOCK( _guard );
-		CHECK_ERR( ds.second < _descriptorPools.size() );
+		CHECK_ERR( ds.second < _poolCount.load( memory_order_acquire ));
 
-		VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), _descriptorPools[ds.second].pool, 1, &ds.first ));
+		_FreeInPool( ds.second, {ds.first} );
 		return true;
 	}
 	
@@ -117,16 +208,20 @@ namespace FG
 */
 	bool  VDescriptorManager::DeallocDescriptorSets (ArrayView<DescriptorSet> descSets)
 	{
-		EXLOCK( _guard );
-
+		const uint							count		= _poolCount.load( memory_order_acquire );
 		FixedArray< VkDescriptorSet, 32 >	temp;
-		uint8_t								last_idx = UMax;
+		uint8_t								last_idx	= UMax;
+
+		// validate before freeing, otherwise already batched sets will leak
+		for (auto& ds : descSets) {
+			CHECK_ERR( ds.second < count );
+		}
 
 		for (auto& ds : descSets)
 		{
-			if ( last_idx != ds.second and temp.size() )
+			if ( (last_idx != ds.second or temp.size() == temp.capacity()) and temp.size() )
 			{
-				VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), _descriptorPools[last_idx].pool, uint(temp.size()), temp.data() ));
+				_FreeInPool( last_idx, temp );
 				temp.clear();
 			}
 
@@ -134,9 +229,8 @@ namespace FG
 			temp.push_back( ds.first );
 		}
 
-		if ( temp.size() )
-		{
-			VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), _descriptorPools[last_idx].pool, uint(temp.size()), temp.data() ));
+		if ( temp.size() ) {
+			_FreeInPool( last_idx, temp );
 		}
 		return true;
 	}
@@ -148,7 +242,8 @@ namespace FG
 */
 	bool  VDescriptorManager::_CreateDescriptorPool ()
 	{
-		CHECK_ERR( _descriptorPools.size() < _descriptorPools.capacity() );
+		const uint	index = _poolCount.load( memory_order_relaxed );
+		CHECK_ERR( index < _descriptorPools.size() );
 
 		FixedArray< VkDescriptorPoolSize, 32 >	pool_sizes;
 
@@ -177,7 +272,15 @@ namespace FG
 		VkDescriptorPool	ds_pool;
 		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &info, null, OUT &ds_pool ));
 
-		_descriptorPools.push_back({ ds_pool });
+		auto&	item = _descriptorPools[index];
+		{
+			EXLOCK( item.guard );
+			item.pool = ds_pool;
+			item.allocated.store( 0, memory_order_relaxed );
+		}
+
+		// pool become visible for lock-free readers
+		_poolCount.store( index + 1, memory_order_release );
 		return true;
 	}
 
@@ -14,26 +14,36 @@ namespace FG
 	class VDescriptorManager final
 	{
 	// types
-	private:
+	public:
 		static constexpr uint	MaxDescriptorPoolSize	= 1u << 11;
-		static constexpr uint	MaxDescriptorSets		= 1u << 10;
+		static constexpr uint	MaxDescriptorSets		= 1u << 10;		// per pool
+		static constexpr uint	MaxDescriptorPools		= 64;
+		static constexpr uint	MaxThreadArenas			= 16;
+
+	private:
 
 		struct DSPool
 		{
-			//SpinLock			guard;
-			VkDescriptorPool	pool	= VK_NULL_HANDLE;
+			SpinLock			guard;						// protects 'pool', locked only for allocation/deallocation
+			VkDescriptorPool	pool		= VK_NULL_HANDLE;
+			std::atomic<uint>	allocated	{0};			// number of descriptor sets that are currently in use
 		};
 
-		using DescriptorPoolArray_t		= FixedArray< DSPool, 8 >;
+		using DescriptorPoolArray_t		= StaticArray< DSPool, MaxDescriptorPools >;
+		using ThreadArenas_t			= StaticArray< std::atomic<uint>, MaxThreadArenas >;	// index of the pool that is used by thread
 		using DescriptorSet				= VDescriptorSetLayout::DescriptorSet;
+		
+		STATIC_ASSERT( MaxDescriptorPools <= std::numeric_limits< decltype(DescriptorSet::second) >::max() );
 
 
 	// variables
 	private:
 		VDevice const&				_device;
 
-		std::mutex					_guard;
+		std::mutex					_guard;				// used only to create new pool or to acquire another pool for arena
 		DescriptorPoolArray_t		_descriptorPools;
+		std::atomic<uint>			_poolCount			{0};
+		ThreadArenas_t				_arenas;
 
 
 	// methods
@@ -50,6 +60,10 @@ namespace FG
 
 	private:
 		bool _CreateDescriptorPool ();
+		bool _AllocInPool (uint poolIndex, const VkDescriptorSetAllocateInfo &info, OUT DescriptorSet &ds);
+		void _FreeInPool (uint poolIndex, ArrayView<VkDescriptorSet> descSets);
+
+		ND_ static uint  _ArenaIndex ();
 	};
 
 
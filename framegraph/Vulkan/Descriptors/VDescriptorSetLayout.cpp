@@ -61,10 +61,88 @@ namespace FG
 
 		VK_CHECK( dev.vkCreateDescriptorSetLayout( dev.GetVkDevice(), &descriptor_info, null, OUT &_layout ) );
 
+		if ( dev.IsDescUpdateTemplateEnabled() )
+			CHECK( _CreateUpdateTemplate( dev, binding ));
+
 		_resourcesTemplate = PipelineResourcesHelper::CreateDynamicData( _uniforms, _maxIndex+1, _elementCount, _dynamicOffsetCount );
 		return true;
 	}
 	
+/*
+=================================================
+	_CreateUpdateTemplate
+----
+	template data contains one array of descriptor infos per binding,
+	see 'VPipelineResources::Create'.
+=================================================
+*/
+	bool VDescriptorSetLayout::_CreateUpdateTemplate (const VDevice &dev, const DescriptorBinding_t &binding)
+	{
+		Array< VkDescriptorUpdateTemplateEntry >	entries;
+		size_t										offset	= 0;
+
+		entries.reserve( binding.size() );
+		_templateEntries.resize( _maxIndex+1 );		// zero 'descriptorCount' means unused binding
+
+		for (auto& bind : binding)
+		{
+			size_t	stride = 0;
+
+			switch ( bind.descriptorType )
+			{
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC :
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC :
+					stride = sizeof(VkDescriptorBufferInfo);
+					break;
+
+				case VK_DESCRIPTOR_TYPE_SAMPLER :
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER :
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE :
+				case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT :
+					stride = sizeof(VkDescriptorImageInfo);
+					break;
+
+				default :
+					// acceleration structures are written with 'VkWriteDescriptorSet'
+					_templateEntries.clear();
+					return true;
+			}
+
+			VkDescriptorUpdateTemplateEntry	entry = {};
+			entry.dstBinding		= bind.binding;
+			entry.dstArrayElement	= 0;
+			entry.descriptorCount	= bind.descriptorCount;
+			entry.descriptorType	= bind.descriptorType;
+			entry.offset			= offset;
+			entry.stride			= stride;
+
+			offset += stride * bind.descriptorCount;
+
+			entries.push_back( entry );
+			_templateEntries[ bind.binding ] = entry;
+		}
+
+		if ( entries.empty() )
+		{
+			_templateEntries.clear();
+			return true;
+		}
+
+		VkDescriptorUpdateTemplateCreateInfo	info = {};
+		info.sType						= VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		info.descriptorUpdateEntryCount	= uint(entries.size());
+		info.pDescriptorUpdateEntries	= entries.data();
+		info.templateType				= VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		info.descriptorSetLayout		= _layout;
+
+		VK_CHECK( dev.vkCreateDescriptorUpdateTemplate( dev.GetVkDevice(), &info, null, OUT &_updateTemplate ));
+
+		_templateDataSize = BytesU{offset};
+		return true;
+	}
+	
 /*
 =================================================
 	Destroy
@@ -78,17 +156,25 @@ namespace FG
 			resMngr.GetDescriptorManager().DeallocDescriptorSets( _descSetCache );
 		}
 
+		if ( _updateTemplate ) {
+			auto&	dev = resMngr.GetDevice();
+			dev.vkDestroyDescriptorUpdateTemplate( dev.GetVkDevice(), _updateTemplate, null );
+		}
+
 		if ( _layout ) {
 			auto&	dev = resMngr.GetDevice();
 			dev.vkDestroyDescriptorSetLayout( dev.GetVkDevice(), _layout, null );
 		}
 
 		_descSetCache.clear();
+		_templateEntries.clear();
 		_resourcesTemplate.reset();
 		_poolSize.clear();
 
 		_uniforms			= null;
 		_layout				= VK_NULL_HANDLE;
+		_updateTemplate		= VK_NULL_HANDLE;
+		_templateDataSize	= 0_b;
 		_hash				= Default;
 		_maxIndex			= 0;
 		_elementCount		= 0;
@@ -19,6 +19,7 @@ namespace FG
 	public:
 		using DescriptorBinding_t	= Array< VkDescriptorSetLayoutBinding >;
 		using DescriptorSet			= Pair< VkDescriptorSet, /*pool index*/uint8_t >;
+		using TemplateEntries_t		= Array< VkDescriptorUpdateTemplateEntry >;
 
 	private:
 		using UniformMapPtr			= PipelineDescription::UniformMapPtr;
@@ -41,8 +42,11 @@ namespace FG
 		mutable SpinLock		_descSetCacheGuard;
 		mutable DescSetCache_t	_descSetCache;
 
+		VkDescriptorUpdateTemplate	_updateTemplate		= VK_NULL_HANDLE;
+		TemplateEntries_t		_templateEntries;		// indexed by binding
+		BytesU					_templateDataSize;
+
 		DebugName_t				_debugName;
-		// TODO: desc set update template
 
 		RWDataRaceCheck			_drCheck;
 
@@ -69,6 +73,10 @@ namespace FG
 		ND_ uint					GetMaxIndex ()		const	{ SHAREDLOCK( _drCheck );  return _maxIndex; }
 		ND_ StringView				GetDebugName ()		const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 
+		ND_ VkDescriptorUpdateTemplate						GetUpdateTemplate ()			const	{ SHAREDLOCK( _drCheck );  return _updateTemplate; }
+		ND_ ArrayView< VkDescriptorUpdateTemplateEntry >	GetUpdateTemplateEntries ()		const	{ SHAREDLOCK( _drCheck );  return _templateEntries; }
+		ND_ BytesU											GetUpdateTemplateDataSize ()	const	{ SHAREDLOCK( _drCheck );  return _templateDataSize; }
+
 
 	private:
 		void _AddUniform (const PipelineDescription::Uniform &un, INOUT DescriptorBinding_t &binding);
@@ -80,6 +88,7 @@ namespace FG
 		void _AddStorageBuffer (const PipelineDescription::StorageBuffer &sb, uint bindingIndex, uint arraySize, EShaderStages stageFlags, INOUT DescriptorBinding_t &binding);
 		void _AddRayTracingScene (const PipelineDescription::RayTracingScene &rts, uint bindingIndex, uint arraySize, EShaderStages stageFlags, INOUT DescriptorBinding_t &binding);
 		void _IncDescriptorCount (VkDescriptorType type);
+		bool _CreateUpdateTemplate (const VDevice &dev, const DescriptorBinding_t &binding);
 	};
 
 }	// FG
@@ -60,22 +60,165 @@ namespace FG
 		CHECK_ERR( not _descriptorSet.first );
 		CHECK_ERR( _dataPtr );
 
-		VDevice const&	dev			= resMngr.GetDevice();
 		auto const*		ds_layout	= resMngr.GetResource( _layoutId );
 		
 		CHECK_ERR( ds_layout );
 		CHECK_ERR( ds_layout->AllocDescriptorSet( resMngr, OUT _descriptorSet ));
+
+		// image views can not be created before memory is bound to the transient resources,
+		// so descriptors will be written when command buffer is executed
+		if ( _HasUnboundResources( resMngr ))
+		{
+			_isDeferred = true;
+			return true;
+		}
+
+		return _UpdateDescriptors( resMngr, *ds_layout );
+	}
+	
+/*
+=================================================
+	UpdateDeferred
+=================================================
+*/
+	bool VPipelineResources::UpdateDeferred (VResourceManager &resMngr)
+	{
+		EXLOCK( _drCheck );
+
+		if ( not _isDeferred )
+			return true;
 		
+		auto const*		ds_layout	= resMngr.GetResource( _layoutId );
+		CHECK_ERR( ds_layout );
+		CHECK_ERR( not _HasUnboundResources( resMngr ));
+
+		_isDeferred = false;
+		return _UpdateDescriptors( resMngr, *ds_layout );
+	}
+
+/*
+=================================================
+	_HasUnboundResources
+=================================================
+*/
+	bool VPipelineResources::_HasUnboundResources (const VResourceManager &resMngr) const
+	{
+		struct Visitor
+		{
+			VResourceManager const&	resMngr;
+			bool					unbound	= false;
+			
+			Visitor (const VResourceManager &resMngr) : resMngr{resMngr}
+			{}
+
+			void operator () (const UniformID &, const PipelineResources::Buffer &buf)
+			{
+				for (uint i = 0; i < buf.elementCount; ++i)
+				{
+					VBuffer const*	buffer = resMngr.GetResource( buf.elements[i].bufferId, false, true );
+					unbound |= (buffer and buffer->IsTransient() and not buffer->GetMemoryID());
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Image &img)
+			{
+				for (uint i = 0; i < img.elementCount; ++i)
+				{
+					VImage const*	image = resMngr.GetResource( img.elements[i].imageId, false, true );
+					unbound |= (image and image->IsTransient() and not image->GetMemoryID());
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Texture &tex)
+			{
+				for (uint i = 0; i < tex.elementCount; ++i)
+				{
+					VImage const*	image = resMngr.GetResource( tex.elements[i].imageId, false, true );
+					unbound |= (image and image->IsTransient() and not image->GetMemoryID());
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Sampler &) {}
+			void operator () (const UniformID &, const PipelineResources::RayTracingScene &) {}
+		};
+
+		Visitor	vis{ resMngr };
+		_dataPtr->ForEachUniform( vis );
+
+		return vis.unbound;
+	}
+
+/*
+=================================================
+	_UpdateDescriptors
+=================================================
+*/
+	bool VPipelineResources::_UpdateDescriptors (VResourceManager &resMngr, const VDescriptorSetLayout &dsLayout)
+	{
+		VDevice const&		dev		= resMngr.GetDevice();
 		UpdateDescriptors	update;
-		update.descriptors		= update.allocator.Alloc< VkWriteDescriptorSet >( ds_layout->GetMaxIndex() + 1 );
+		update.descriptors		= update.allocator.Alloc< VkWriteDescriptorSet >( dsLayout.GetMaxIndex() + 1 );
 		update.descriptorIndex	= 0;
 
+		if ( dsLayout.GetUpdateTemplate() )
+		{
+			update.templateEntries	= dsLayout.GetUpdateTemplateEntries();
+			update.templateData		= update.allocator.Alloc( dsLayout.GetUpdateTemplateDataSize(), AlignOf<VkDescriptorBufferInfo> );
+			update.useTemplate		= true;
+		}
+
 		_dataPtr->ForEachUniform( [&](auto&, auto& data) { _AddResource( resMngr, data, INOUT update ); });
+
+		_isImmutable = (_resourceRefs.buffers.empty() and _resourceRefs.images.empty() and _resourceRefs.rtScenes.empty());
+
+		// template can be used only if all bindings are written with the same descriptor count
+		if ( update.useTemplate )
+		{
+			uint	entry_count = 0;
+			for (auto& entry : update.templateEntries) {
+				entry_count += (entry.descriptorCount > 0);
+			}
+			update.useTemplate = (update.descriptorIndex == entry_count);
+		}
+
+		if ( update.useTemplate )
+		{
+			dev.vkUpdateDescriptorSetWithTemplate( dev.GetVkDevice(), _descriptorSet.first, dsLayout.GetUpdateTemplate(), update.templateData );
+			return true;
+		}
 		
 		dev.vkUpdateDescriptorSets( dev.GetVkDevice(), update.descriptorIndex, update.descriptors, 0, null );
 		return true;
 	}
 
+/*
+=================================================
+	_AllocInfo
+----
+	returns pointer to the template data if descriptor count is equal to the template entry,
+	otherwise descriptors will be updated without template.
+=================================================
+*/
+	template <typename T>
+	inline T*  VPipelineResources::_AllocInfo (INOUT UpdateDescriptors &list, const BindingIndex &index, uint count)
+	{
+		if ( list.templateData )
+		{
+			const uint	binding = index.VKBinding();
+
+			if ( binding < list.templateEntries.size() )
+			{
+				auto&	entry = list.templateEntries[ binding ];
+
+				if ( entry.descriptorCount == count and entry.stride == sizeof(T) )
+					return BitCast<T *>( static_cast<uint8_t *>(list.templateData) + entry.offset );
+			}
+
+			list.useTemplate = false;
+		}
+		return list.allocator.Alloc<T>( count );
+	}
+
 /*
 =================================================
 	Destroy
@@ -97,6 +240,9 @@ namespace FG
 		}
 
 		_dataPtr.reset();
+		_resourceRefs	= {};
+		_isImmutable	= false;
+		_isDeferred		= false;
 		_descriptorSet	= { VK_NULL_HANDLE, UMax };
 		_layoutId		= Default;
 		_hash			= Default;
@@ -195,7 +341,7 @@ namespace FG
 */
 	bool VPipelineResources::_AddResource (VResourceManager &resMngr, INOUT PipelineResources::Buffer &buf, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorBufferInfo >( buf.elementCount );
+		auto*	info = _AllocInfo< VkDescriptorBufferInfo >( INOUT list, buf.index, buf.elementCount );
 
 		for (uint i = 0; i < buf.elementCount; ++i)
 		{
@@ -209,6 +355,11 @@ namespace FG
 			info[i].buffer	= buffer->Handle();
 			info[i].offset	= VkDeviceSize(elem.offset);
 			info[i].range	= VkDeviceSize(elem.size);
+
+			if ( buffer->IsReadOnly() )
+				_resourceRefs.readOnlyBuffers.push_back( elem.bufferId );
+			else
+				_resourceRefs.buffers.push_back({ &buf, i });
 		}
 
 		const bool	is_uniform	= ((buf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
@@ -235,7 +386,7 @@ namespace FG
 */
 	bool VPipelineResources::_AddResource (VResourceManager &resMngr, INOUT PipelineResources::Image &img, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( img.elementCount );
+		auto*	info = _AllocInfo< VkDescriptorImageInfo >( INOUT list, img.index, img.elementCount );
 
 		for (uint i = 0; i < img.elementCount; ++i)
 		{
@@ -249,6 +400,9 @@ namespace FG
 			info[i].imageLayout	= EResourceState_ToImageLayout( img.state, img_res->AspectMask() );
 			info[i].imageView	= img_res->GetView( resMngr.GetDevice(), not elem.hasDesc, INOUT elem.desc );
 			info[i].sampler		= VK_NULL_HANDLE;
+
+			// images are always mutable because of layout transitions
+			_resourceRefs.images.push_back({ elem.imageId, img.state, &elem.desc });
 		}		
 		
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
@@ -271,7 +425,7 @@ namespace FG
 */
 	bool VPipelineResources::_AddResource (VResourceManager &resMngr, INOUT PipelineResources::Texture &tex, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( tex.elementCount );
+		auto*	info = _AllocInfo< VkDescriptorImageInfo >( INOUT list, tex.index, tex.elementCount );
 
 		for (uint i = 0; i < tex.elementCount; ++i)
 		{
@@ -286,6 +440,8 @@ namespace FG
 			info[i].imageLayout	= EResourceState_ToImageLayout( tex.state, img_res->AspectMask() );
 			info[i].imageView	= img_res->GetView( resMngr.GetDevice(), not elem.hasDesc, INOUT elem.desc );
 			info[i].sampler		= sampler->Handle();
+
+			_resourceRefs.images.push_back({ elem.imageId, tex.state, &elem.desc });
 		}
 		
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
@@ -307,7 +463,7 @@ namespace FG
 */
 	bool VPipelineResources::_AddResource (VResourceManager &resMngr, const PipelineResources::Sampler &samp, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( samp.elementCount );
+		auto*	info = _AllocInfo< VkDescriptorImageInfo >( INOUT list, samp.index, samp.elementCount );
 
 		for (uint i = 0; i < samp.elementCount; ++i)
 		{
@@ -351,6 +507,9 @@ namespace FG
 			CHECK( scene or _allowEmptyResources );
 
 			tlas[i] = scene ? scene->Handle() : VK_NULL_HANDLE;
+
+			if ( scene )
+				_resourceRefs.rtScenes.push_back( elem.sceneId );
 		}
 
 		auto& 	top_as = *list.allocator.Alloc<VkWriteDescriptorSetAccelerationStructureNV>( 1 );
@@ -16,12 +16,40 @@ namespace FG
 	class VPipelineResources final
 	{
 	// types
+	public:
+		struct BufferRef
+		{
+			PipelineResources::Buffer const*	uniform	= null;
+			uint								index	= 0;		// element index
+		};
+
+		struct ImageRef
+		{
+			RawImageID				imageId;
+			EResourceState			state	= Default;
+			ImageViewDesc const*	desc	= null;
+		};
+
+		// precomputed list of resources that are used in barrier placement
+		struct ResourceRefs
+		{
+			Array< BufferRef >		buffers;
+			Array< ImageRef >		images;
+			Array< RawRTSceneID >	rtScenes;
+			Array< RawBufferID >	readOnlyBuffers;	// barriers are not needed, but resources must be kept alive until execution is complete
+		};
+
 	private:
 		struct UpdateDescriptors
 		{
 			LinearAllocator<>			allocator;
 			VkWriteDescriptorSet *		descriptors;
 			uint						descriptorIndex;
+
+			// descriptor update template, descriptor infos are allocated in 'templateData'
+			ArrayView< VkDescriptorUpdateTemplateEntry >	templateEntries;
+			void *						templateData	= null;
+			bool						useTemplate		= false;
 		};
 
 		using Element_t			= Union< VkDescriptorBufferInfo, VkDescriptorImageInfo, VkAccelerationStructureNV >;
@@ -35,7 +63,10 @@ namespace FG
 		RawDescriptorSetLayoutID	_layoutId;
 		HashVal						_hash;
 		DynamicDataPtr				_dataPtr;
+		ResourceRefs				_resourceRefs;
 		const bool					_allowEmptyResources;
+		bool						_isImmutable	= false;	// all resources are read-only, barriers are not needed
+		bool						_isDeferred		= false;	// descriptors are not written until memory is bound to the transient resources
 		
 		DebugName_t					_debugName;
 		
@@ -51,6 +82,7 @@ namespace FG
 		~VPipelineResources ();
 
 			bool Create (VResourceManager &);
+			bool UpdateDeferred (VResourceManager &);
 			void Destroy (VResourceManager &);
 
 		ND_ bool IsAllResourcesAlive (const VResourceManager &) const;
@@ -63,17 +95,26 @@ namespace FG
 		ND_ VkDescriptorSet				Handle ()		const	{ SHAREDLOCK( _drCheck );  return _descriptorSet.first; }
 		ND_ RawDescriptorSetLayoutID	GetLayoutID ()	const	{ SHAREDLOCK( _drCheck );  return _layoutId; }
 		ND_ HashVal						GetHash ()		const	{ SHAREDLOCK( _drCheck );  return _hash; }
+		ND_ bool						IsImmutable ()	const	{ SHAREDLOCK( _drCheck );  return _isImmutable; }
+		ND_ bool						IsDeferred ()	const	{ SHAREDLOCK( _drCheck );  return _isDeferred; }
+		ND_ ResourceRefs const&			GetResourceRefs () const { SHAREDLOCK( _drCheck );  return _resourceRefs; }
 
 		ND_ StringView					GetDebugName ()	const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 
 
 	private:
+		bool _UpdateDescriptors (VResourceManager &, const VDescriptorSetLayout &);
+		ND_ bool _HasUnboundResources (const VResourceManager &) const;
+
 		bool _AddResource (VResourceManager &, INOUT PipelineResources::Buffer &, INOUT UpdateDescriptors &);
 		bool _AddResource (VResourceManager &, INOUT PipelineResources::Image &, INOUT UpdateDescriptors &);
 		bool _AddResource (VResourceManager &, INOUT PipelineResources::Texture &, INOUT UpdateDescriptors &);
 		bool _AddResource (VResourceManager &, const PipelineResources::Sampler &, INOUT UpdateDescriptors &);
 		bool _AddResource (VResourceManager &, const PipelineResources::RayTracingScene &, INOUT UpdateDescriptors &);
 		bool _AddResource (VResourceManager &, const NullUnion &, INOUT UpdateDescriptors &);
+
+		template <typename T>
+		ND_ static T*  _AllocInfo (INOUT UpdateDescriptors &, const BindingIndex &index, uint count);
 	};
 	
 
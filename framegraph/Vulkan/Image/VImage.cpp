@@ -73,7 +73,6 @@ namespace FG
 		// TODO: VK_IMAGE_CREATE_EXTENDED_USAGE_BIT
 		// TODO: VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT for 3D image
 		// TODO: VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT 
-		// TODO: VK_IMAGE_CREATE_ALIAS_BIT 
 		// TODO: VK_IMAGE_CREATE_BLOCK_TEXEL_VIEW_COMPATIBLE_BIT 
 
 		return flags;
@@ -178,14 +177,53 @@ namespace FG
 		
 		const bool	opt_tiling	= not uint(memObj.MemoryType() & EMemoryTypeExt::HostVisible);
 
-		_desc		= desc;		_desc.Validate();
-		_memoryId	= MemoryID{ memId };
+		_memoryId = MemoryID{ memId };
+
+		CHECK_ERR( _CreateImage( resMngr.GetDevice(), desc, GetImageFlags( desc.imageType ), opt_tiling, queueFamilyMask, defaultLayout, dbgName ));
+		CHECK_ERR( memObj.AllocateForImage( resMngr.GetMemoryManager(), _image ));
+
+		return true;
+	}
+	
+/*
+=================================================
+	CreateTransient
+----
+	memory will be bound later, image may share memory
+	with other transient resources.
+=================================================
+*/
+	bool VImage::CreateTransient (VResourceManager &resMngr, const ImageDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _image == VK_NULL_HANDLE );
+		CHECK_ERR( not _memoryId );
+		CHECK_ERR( not desc.isExternal );
+
+		const VkImageCreateFlags	flags = GetImageFlags( desc.imageType ) | VK_IMAGE_CREATE_ALIAS_BIT;
+
+		CHECK_ERR( _CreateImage( resMngr.GetDevice(), desc, flags, true, queueFamilyMask, VK_IMAGE_LAYOUT_MAX_ENUM, dbgName ));
+
+		_isTransient = true;
+		return true;
+	}
+	
+/*
+=================================================
+	_CreateImage
+=================================================
+*/
+	bool VImage::_CreateImage (const VDevice &dev, const ImageDesc &desc, VkImageCreateFlags flags, bool optTiling,
+							   EQueueFamilyMask queueFamilyMask, VkImageLayout defaultLayout, StringView dbgName)
+	{
+		_desc = desc;
+		_desc.Validate();
 		
 		// create image
 		VkImageCreateInfo	info = {};
 		info.sType			= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		info.pNext			= null;
-		info.flags			= GetImageFlags( _desc.imageType );
+		info.flags			= flags;
 		info.imageType		= GetImageType( _desc.imageType );
 		info.format			= VEnumCast( _desc.format );
 		info.extent.width	= _desc.dimension.x;
@@ -194,9 +232,9 @@ namespace FG
 		info.mipLevels		= _desc.maxLevel.Get();
 		info.arrayLayers	= _desc.arrayLayers.Get();
 		info.samples		= VEnumCast( _desc.samples );
-		info.tiling			= (opt_tiling ? VK_IMAGE_TILING_OPTIMAL : VK_IMAGE_TILING_LINEAR);
+		info.tiling			= (optTiling ? VK_IMAGE_TILING_OPTIMAL : VK_IMAGE_TILING_LINEAR);
 		info.usage			= VEnumCast( _desc.usage );
-		info.initialLayout	= (opt_tiling ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_PREINITIALIZED);
+		info.initialLayout	= (optTiling ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_PREINITIALIZED);
 		
 		StaticArray<uint32_t, 8>	queue_family_indices = {};
 
@@ -223,11 +261,7 @@ namespace FG
 			info.queueFamilyIndexCount	= 0;
 		}
 
-		auto&	dev = resMngr.GetDevice();
-
 		VK_CHECK( dev.vkCreateImage( dev.GetVkDevice(), &info, null, OUT &_image ));
-
-		CHECK_ERR( memObj.AllocateForImage( resMngr.GetMemoryManager(), _image ));
 		
 		if ( not dbgName.empty() )
 		{
@@ -242,6 +276,43 @@ namespace FG
 
 		return true;
 	}
+	
+/*
+=================================================
+	GetMemoryRequirements
+=================================================
+*/
+	VkMemoryRequirements  VImage::GetMemoryRequirements (const VDevice &dev) const
+	{
+		SHAREDLOCK( _drCheck );
+
+		VkMemoryRequirements	mem_req = {};
+		dev.vkGetImageMemoryRequirements( dev.GetVkDevice(), _image, OUT &mem_req );
+		return mem_req;
+	}
+	
+/*
+=================================================
+	BindMemory
+----
+	'offset' is relative to the memory object.
+=================================================
+*/
+	bool VImage::BindMemory (VResourceManager &resMngr, RawMemoryID memId, const VMemoryObj &memObj, BytesU offset)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _image and _isTransient );
+		CHECK_ERR( not _memoryId );
+
+		VMemoryObj::MemoryInfo	info;
+		CHECK_ERR( memObj.GetInfo( resMngr.GetMemoryManager(), OUT info ));
+
+		auto&	dev = resMngr.GetDevice();
+		VK_CHECK( dev.vkBindImageMemory( dev.GetVkDevice(), _image, info.mem, VkDeviceSize(info.offset + offset) ));
+
+		_memoryId = MemoryID{ memId };
+		return true;
+	}
 
 /*
 =================================================
@@ -322,6 +393,7 @@ namespace FG
 		_defaultLayout		= VK_IMAGE_LAYOUT_MAX_ENUM;
 		_queueFamilyMask	= Default;
 		_onRelease			= {};
+		_isTransient		= false;
 	}
 	
 /*
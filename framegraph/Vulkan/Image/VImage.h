@@ -38,6 +38,7 @@ namespace FG
 		VkImageLayout				_defaultLayout		= VK_IMAGE_LAYOUT_MAX_ENUM;
 		VkAccessFlags				_readAccessMask		= 0;
 		EQueueFamilyMask			_queueFamilyMask	= Default;
+		bool						_isTransient		= false;
 
 		DebugName_t					_debugName;
 		OnRelease_t					_onRelease;
@@ -56,14 +57,19 @@ namespace FG
 
 		bool Create (const VDevice &dev, const VulkanImageDesc &desc, StringView dbgName, OnRelease_t &&onRelease);
 
+		bool CreateTransient (VResourceManager &, const ImageDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName);
+		bool BindMemory (VResourceManager &, RawMemoryID memId, const VMemoryObj &memObj, BytesU offset);
+
 		void Destroy (VResourceManager &);
 
 		ND_ VulkanImageDesc		GetApiSpecificDescription () const;
+		ND_ VkMemoryRequirements	GetMemoryRequirements (const VDevice &) const;
 
 		ND_ VkImageView			GetView (const VDevice &, const HashedImageViewDesc &) const;
 		ND_ VkImageView			GetView (const VDevice &, bool isDefault, INOUT ImageViewDesc &) const;
 		
 		ND_ bool				IsReadOnly ()			const;
+		ND_ bool				IsTransient ()			const	{ SHAREDLOCK( _drCheck );  return _isTransient; }
 
 		ND_ VkImage				Handle ()				const	{ SHAREDLOCK( _drCheck );  return _image; }
 		ND_ RawMemoryID			GetMemoryID ()			const	{ SHAREDLOCK( _drCheck );  return _memoryId.Get(); }
@@ -90,6 +96,8 @@ namespace FG
 
 
 	private:
+		bool _CreateImage (const VDevice &, const ImageDesc &, VkImageCreateFlags flags, bool optTiling,
+						   EQueueFamilyMask queueFamilyMask, VkImageLayout defaultLayout, StringView dbgName);
 		bool _CreateView (const VDevice &, const HashedImageViewDesc &, OUT VkImageView &) const;
 	};
 	
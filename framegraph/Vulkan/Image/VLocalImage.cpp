@@ -24,12 +24,16 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalImage::Create (const VImage *imageData)
+	bool VLocalImage::Create (const VImage *imageData, uint localIndex, LinearAllocator<> &allocator)
 	{
 		CHECK_ERR( _imageData == null );
 		CHECK_ERR( imageData );
 
+		_pendingAccesses.SetAllocator( allocator );
+		_accessForReadWrite.SetAllocator( allocator );
+
 		_imageData		= imageData;
+		_localIndex		= localIndex;
 		_finalLayout	= _imageData->DefaultLayout();
 		_isImmutable	= false; //_imageData->IsReadOnly();
 		
@@ -40,7 +44,7 @@ namespace FG
 			pending.isWritable	= false;
 			pending.stages		= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
 			pending.access		= 0;
-			pending.layout		= _imageData->DefaultLayout();
+			pending.layout		= _imageData->IsTransient() ? VK_IMAGE_LAYOUT_UNDEFINED : _imageData->DefaultLayout();
 			pending.index		= ExeOrderIndex::Initial;
 			pending.range		= SubRange{ 0, ArrayLayers() * MipmapLevels() };
 
@@ -58,6 +62,7 @@ namespace FG
 	void VLocalImage::Destroy ()
 	{
 		_imageData	= null;
+		_localIndex	= UMax;
 		
 		// check for uncommited barriers
 		ASSERT( _pendingAccesses.empty() );
@@ -69,118 +74,18 @@ namespace FG
 
 /*
 =================================================
-	_FindFirstAccess
+	SetAllocator
+----
+	access records will grow in 'allocator',
+	used when resource is recorded on the worker thread.
 =================================================
 */
-	inline VLocalImage::AccessIter_t
-		VLocalImage::_FindFirstAccess (AccessRecords_t &arr, const SubRange &otherRange)
+	void VLocalImage::SetAllocator (LinearAllocator<> &allocator) const
 	{
-		size_t	left	= 0;
-		size_t	right	= arr.size();
-
-		for (; left < right; )
-		{
-			size_t	mid = (left + right) >> 1;
-
-			if ( arr[mid].range.end < otherRange.begin )
-				left = mid + 1;
-			else
-				right = mid;
-		}
-
-		if ( left < arr.size() and arr[left].range.end >= otherRange.begin )
-			return arr.begin() + left;
-		
-		return arr.end();
+		_pendingAccesses.SetAllocator( allocator );
+		_accessForReadWrite.SetAllocator( allocator );
 	}
-	
-/*
-=================================================
-	_ReplaceAccessRecords
-=================================================
-*/
-	void VLocalImage::_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const ImageAccess &barrier)
-	{
-		ASSERT( iter >= arr.begin() and iter <= arr.end() );
-
-		bool replaced = false;
-
-		for (; iter != arr.end();)
-		{
-			if ( iter->range.begin <  barrier.range.begin and
-				 iter->range.end   <= barrier.range.end )
-			{
-				//	|1111111|22222|
-				//     |bbbbb|			+
-				//  |11|....			=
-				iter->range.end = barrier.range.begin;
-				++iter;
-				continue;
-			}
 
-			if ( iter->range.begin < barrier.range.begin and
-				 iter->range.end   > barrier.range.end )
-			{
-				//  |111111111111111|
-				//      |bbbbb|			+
-				//  |111|bbbbb|11111|	=
-
-				const auto	src = *iter;
-
-				iter->range.end = barrier.range.begin;
-
-				iter = arr.insert( iter+1, barrier );
-				replaced = true;
-
-				iter = arr.insert( iter+1, src );
-
-				iter->range.begin = barrier.range.end;
-				break;
-			}
-
-			if ( iter->range.begin >= barrier.range.begin and
-				 iter->range.begin <  barrier.range.end )
-			{
-				if ( iter->range.end > barrier.range.end )
-				{
-					//  ...|22222222222|
-					//   |bbbbbbb|			+
-					//  ...bbbbbb|22222|	=
-					iter->range.begin = barrier.range.end;
-
-					if ( not replaced )
-					{
-						arr.insert( iter, barrier );
-						replaced = true;
-					}
-					break;
-				}
-
-				if ( replaced )
-				{
-					//  ...|22222|33333|
-					//   |bbbbbbbbbbb|		+
-					//  ...|bbbbbbbbb|...	=
-					iter = arr.erase( iter );
-				}
-				else
-				{
-					*iter = barrier;
-					++iter;
-					replaced = true;
-				}
-				continue;
-			}
-
-			break;
-		}
-			
-		if ( not replaced )
-		{
-			arr.insert( iter, barrier );
-		}
-	}
-	
 /*
 =================================================
 	SetInitialState
@@ -227,16 +132,15 @@ namespace FG
 		pending.index			= is.task->ExecutionOrder();
 		
 
-		// extract sub ranges
+		// merge sub ranges with pending
 		const uint		arr_layers	= ArrayLayers();
 		const uint		mip_levels	= MipmapLevels();
-		Array<SubRange>	sub_ranges;
 		SubRange		layer_range	 { is.range.Layers().begin,  Min( is.range.Layers().end,  arr_layers )};
 		SubRange		mipmap_range { is.range.Mipmaps().begin, Min( is.range.Mipmaps().end, mip_levels )};
 
 		if ( is.range.IsWholeLayers() and is.range.IsWholeMipmaps() )
 		{
-			sub_ranges.push_back(SubRange{ 0, arr_layers * mip_levels });
+			_AddPendingRange( SubRange{ 0, arr_layers * mip_levels }, INOUT pending );
 		}
 		else
 		if ( is.range.IsWholeLayers() )
@@ -244,7 +148,7 @@ namespace FG
 			uint	begin = mipmap_range.begin   * arr_layers + layer_range.begin;
 			uint	end   = (mipmap_range.end-1) * arr_layers + layer_range.end;
 				
-			sub_ranges.push_back(SubRange{ begin, end });
+			_AddPendingRange( SubRange{ begin, end }, INOUT pending );
 		}
 		else
 		for (uint mip = mipmap_range.begin; mip < mipmap_range.end; ++mip)
@@ -252,45 +156,48 @@ namespace FG
 			uint	begin = mip * arr_layers + layer_range.begin;
 			uint	end   = mip * arr_layers + layer_range.end;
 
-			sub_ranges.push_back(SubRange{ begin, end });
+			_AddPendingRange( SubRange{ begin, end }, INOUT pending );
 		}
+	}
+	
+/*
+=================================================
+	_AddPendingRange
+=================================================
+*/
+	void VLocalImage::_AddPendingRange (SubRange range, INOUT ImageAccess &pending) const
+	{
+		auto	iter = _pendingAccesses.FindFirst( range );
 
-
-		// merge with pending
-		for (auto& range : sub_ranges)
+		if ( iter != _pendingAccesses.end() and iter->range.begin > range.begin )
 		{
-			auto	iter = _FindFirstAccess( _pendingAccesses, range );
+			pending.range = { range.begin, iter->range.begin };
 
-			if ( iter != _pendingAccesses.end() and iter->range.begin > range.begin )
-			{
-				pending.range = { range.begin, iter->range.begin };
+			iter = _pendingAccesses.insert( iter, pending );
+			++iter;
 
-				iter = _pendingAccesses.insert( iter, pending );
-				++iter;
-
-				range.begin = iter->range.begin;
-			}
+			range.begin = iter->range.begin;
+		}
 
-			for (; iter != _pendingAccesses.end() and iter->range.IsIntersects( range ); ++iter)
-			{
-				ASSERT( iter->index == pending.index );
-				ASSERT( iter->layout == pending.layout );
-
-				iter->range.begin		= Min( iter->range.begin, range.begin );
-				range.begin				= iter->range.end;
-				iter->stages			|= pending.stages;
-				iter->access			|= pending.access;
-				iter->isReadable		|= pending.isReadable;
-				iter->isWritable		|= pending.isWritable;
-				iter->invalidateBefore	&= pending.invalidateBefore;
-				iter->invalidateAfter	&= pending.invalidateAfter;
-			}
+		for (; iter != _pendingAccesses.end() and iter->range.IsIntersects( range ); ++iter)
+		{
+			ASSERT( iter->index == pending.index );
+			ASSERT( iter->layout == pending.layout );
+
+			iter->range.begin		= Min( iter->range.begin, range.begin );
+			range.begin				= iter->range.end;
+			iter->stages			|= pending.stages;
+			iter->access			|= pending.access;
+			iter->isReadable		|= pending.isReadable;
+			iter->isWritable		|= pending.isWritable;
+			iter->invalidateBefore	&= pending.invalidateBefore;
+			iter->invalidateAfter	&= pending.invalidateAfter;
+		}
 
-			if ( not range.IsEmpty() )
-			{
-				pending.range = range;
-				_pendingAccesses.insert( iter, pending );
-			}
+		if ( not range.IsEmpty() )
+		{
+			pending.range = range;
+			_pendingAccesses.insert( iter, pending );
 		}
 	}
 	
@@ -303,6 +210,13 @@ namespace FG
 	{
 		ASSERT( _pendingAccesses.empty() );	// you must commit all pending states before reseting
 		
+		// memory may be already reused by other transient resource, so content and layout must not be changed
+		if ( _imageData->IsTransient() )
+		{
+			_accessForReadWrite.clear();
+			return;
+		}
+
 		// add full range barrier
 		{
 			ImageAccess		pending;
@@ -336,7 +250,7 @@ namespace FG
 
 		for (const auto& pending : _pendingAccesses)
 		{
-			const auto	first = _FindFirstAccess( _accessForReadWrite, pending.range );
+			const auto	first = _accessForReadWrite.FindFirst( pending.range );
 
 			for (auto iter = first; iter != _accessForReadWrite.end() and iter->range.begin < pending.range.end; ++iter)
 			{
@@ -361,24 +275,47 @@ namespace FG
 					barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 			
 					barrier.subresourceRange.aspectMask		= AspectMask();
-					barrier.subresourceRange.baseMipLevel	= (range.begin / arr_layers);
-					barrier.subresourceRange.levelCount		= Max( 1u, (range.end - range.begin) / arr_layers );	// TODO: use power of 2 values?
-					barrier.subresourceRange.baseArrayLayer	= (range.begin % arr_layers);
-					barrier.subresourceRange.layerCount		= Max( 1u, (range.end - range.begin) % arr_layers );
-
-					ASSERT( barrier.subresourceRange.levelCount > 0 );
-					ASSERT( barrier.subresourceRange.layerCount > 0 );
-
 					dst_stages |= pending.stages;
-					barrierMngr.AddImageBarrier( iter->stages, pending.stages, 0, barrier );
 
-					if ( debugger ) {
-						debugger->AddImageBarrier( _imageData.get(), iter->index, pending.index, iter->stages, pending.stages, 0, barrier );
+					// records may be merged across mipmap levels, so split range into
+					// partial layers of single mipmap level and whole layers of several levels
+					for (uint begin = range.begin; begin < range.end;)
+					{
+						const uint	mip		= begin / arr_layers;
+						const uint	layer	= begin % arr_layers;
+						uint		end;
+
+						if ( layer == 0 and range.end - begin >= arr_layers )
+						{
+							const uint	levels = (range.end - begin) / arr_layers;
+							end = begin + levels * arr_layers;
+
+							barrier.subresourceRange.baseMipLevel	= mip;
+							barrier.subresourceRange.levelCount		= levels;
+							barrier.subresourceRange.baseArrayLayer	= 0;
+							barrier.subresourceRange.layerCount		= arr_layers;
+						}
+						else
+						{
+							end = Min( range.end, (mip + 1) * arr_layers );
+
+							barrier.subresourceRange.baseMipLevel	= mip;
+							barrier.subresourceRange.levelCount		= 1;
+							barrier.subresourceRange.baseArrayLayer	= layer;
+							barrier.subresourceRange.layerCount		= end - begin;
+						}
+						begin = end;
+
+						barrierMngr.AddImageBarrier( iter->stages, pending.stages, 0, barrier );
+
+						if ( debugger ) {
+							debugger->AddImageBarrier( _imageData.get(), iter->index, pending.index, iter->stages, pending.stages, 0, barrier );
+						}
 					}
 				}
 			}
 
-			_ReplaceAccessRecords( _accessForReadWrite, first, pending );
+			_accessForReadWrite.Replace( first, pending );
 		}
 
 		_pendingAccesses.clear();
@@ -5,6 +5,7 @@
 #include "VImage.h"
 #include "framegraph/Public/EResourceState.h"
 #include "framegraph/Shared/ImageDataRange.h"
+#include "framegraph/Shared/ResourceRangeMap.h"
 
 namespace FG
 {
@@ -55,17 +56,29 @@ namespace FG
 
 		// methods
 			ImageAccess () : isReadable{false}, isWritable{false}, invalidateBefore{false}, invalidateAfter{false} {}
+
+			ND_ bool  HasEqualState (const ImageAccess &rhs) const
+			{
+				return	layout			 == rhs.layout			and
+						stages			 == rhs.stages			and
+						access			 == rhs.access			and
+						index			 == rhs.index			and
+						isReadable		 == rhs.isReadable		and
+						isWritable		 == rhs.isWritable		and
+						invalidateBefore == rhs.invalidateBefore	and
+						invalidateAfter	 == rhs.invalidateAfter;
+			}
 		};
 
 		using ImageViewMap_t	= VImage::ImageViewMap_t;
-		using AccessRecords_t	= Array< ImageAccess >;		// TODO: fixed size array or custom allocator
-		using AccessIter_t		= AccessRecords_t::iterator;
+		using AccessRecords_t	= ResourceRangeMap< ImageAccess, 4 >;	// spills into command buffer allocator
 
 		
 	// variables
 	private:
 		Ptr<VImage const>			_imageData;		// readonly access is thread safe
 		VkImageLayout				_finalLayout	= VK_IMAGE_LAYOUT_GENERAL;
+		uint						_localIndex		= UMax;
 
 		mutable AccessRecords_t		_pendingAccesses;
 		mutable AccessRecords_t		_accessForReadWrite;
@@ -78,19 +91,21 @@ namespace FG
 		VLocalImage (VLocalImage &&) = delete;
 		~VLocalImage ();
 
-		bool Create (const VImage *);
+		bool Create (const VImage *, uint localIndex, LinearAllocator<> &);
 		void Destroy ();
 
 		void SetInitialState (bool immutable, bool invalidate) const;
 		void AddPendingState (const ImageState &) const;
 		void ResetState (ExeOrderIndex index, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
 		void CommitBarrier (VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
+		void SetAllocator (LinearAllocator<> &allocator) const;
 		
 		ND_ VkImageView			GetView (const VDevice &dev, bool isDefault, INOUT ImageViewDesc &desc) const	{ return _imageData->GetView( dev, isDefault, INOUT desc ); }
 
 		ND_ bool				IsCreated ()		const	{ return _imageData != null; }
 		ND_ VkImage				Handle ()			const	{ return _imageData->Handle(); }
 		ND_ VImage const*		ToGlobal ()			const	{ return _imageData.get(); }
+		ND_ uint				LocalIndex ()		const	{ return _localIndex; }
 
 		ND_ ImageDesc const&	Description ()		const	{ return _imageData->Description(); }
 		ND_ VkImageAspectFlags	AspectMask ()		const	{ return _imageData->AspectMask(); }
@@ -109,10 +124,7 @@ namespace FG
 
 	private:
 		bool _CreateView (const VDevice &, const HashedImageViewDesc &, OUT VkImageView &) const;
-
-		ND_ static AccessIter_t	_FindFirstAccess (AccessRecords_t &arr, const SubRange &range);
-			static void			_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const ImageAccess &barrier);
-
+		void _AddPendingRange (SubRange range, INOUT ImageAccess &pending) const;
 	};
 
 
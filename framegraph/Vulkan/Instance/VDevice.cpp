@@ -77,6 +77,17 @@ namespace FG
 		_enableRayTracingNV			= HasDeviceExtension( VK_NV_RAY_TRACING_EXTENSION_NAME );
 		_enableShadingRateImageNV	= HasDeviceExtension( VK_NV_SHADING_RATE_IMAGE_EXTENSION_NAME );
 		_samplerMirrorClamp			= HasDeviceExtension( VK_KHR_SAMPLER_MIRROR_CLAMP_TO_EDGE_EXTENSION_NAME );
+		_enableDescUpdateTemplate	= (_vkVersion >= EShaderLangFormat::Vulkan_110);	// core in Vulkan 1.1
+#	ifdef VK_EXT_pipeline_creation_feedback
+		_enableCreationFeedback		= vdi.creationFeedback and HasDeviceExtension( VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME );
+#	else
+		_enableCreationFeedback		= false;
+#	endif
+#	ifdef VK_KHR_timeline_semaphore
+		_enableTimelineSemaphore	= FG_EnableTimelineSemaphore and vdi.timelineSemaphore and (_vkVersion >= EShaderLangFormat::Vulkan_110) and HasDeviceExtension( VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME );
+#	else
+		_enableTimelineSemaphore	= false;
+#	endif
 
 		// load extensions
 		if ( _vkVersion >= EShaderLangFormat::Vulkan_110 )
@@ -97,10 +108,21 @@ namespace FG
 				next_feat	= &_deviceInfo.shadingRateImageFeatures.pNext;
 				_deviceInfo.shadingRateImageFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADING_RATE_IMAGE_FEATURES_NV;
 			}
+		#ifdef VK_KHR_timeline_semaphore
+			if ( _enableTimelineSemaphore )
+			{
+				*next_feat	= &_deviceInfo.timelineSemaphoreFeatures;
+				next_feat	= &_deviceInfo.timelineSemaphoreFeatures.pNext;
+				_deviceInfo.timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+			}
+		#endif
 			vkGetPhysicalDeviceFeatures2( GetVkPhysicalDevice(), &feat2 );
 
 			_enableMeshShaderNV			= (_deviceInfo.meshShaderFeatures.meshShader or _deviceInfo.meshShaderFeatures.taskShader);
 			_enableShadingRateImageNV	= _deviceInfo.shadingRateImageFeatures.shadingRateImage;
+		#ifdef VK_KHR_timeline_semaphore
+			_enableTimelineSemaphore	= _deviceInfo.timelineSemaphoreFeatures.timelineSemaphore;
+		#endif
 
 
 			VkPhysicalDeviceProperties2	props2		= {};
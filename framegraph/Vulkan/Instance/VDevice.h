@@ -68,6 +68,9 @@ namespace FG
 		bool									_enableRayTracingNV			: 1;
 		bool									_samplerMirrorClamp			: 1;
 		bool									_enableShadingRateImageNV	: 1;
+		bool									_enableDescUpdateTemplate	: 1;
+		bool									_enableCreationFeedback		: 1;
+		bool									_enableTimelineSemaphore	: 1;
 
 		struct {
 			VkPhysicalDeviceProperties						properties;
@@ -78,6 +81,9 @@ namespace FG
 			VkPhysicalDeviceShadingRateImageFeaturesNV		shadingRateImageFeatures;
 			VkPhysicalDeviceShadingRateImagePropertiesNV	shadingRateImageProperties;
 			VkPhysicalDeviceRayTracingPropertiesNV			rayTracingProperties;
+		#ifdef VK_KHR_timeline_semaphore
+			VkPhysicalDeviceTimelineSemaphoreFeaturesKHR	timelineSemaphoreFeatures;
+		#endif
 		}										_deviceInfo;
 
 		mutable ExtensionSet_t					_instanceExtensions;
@@ -96,6 +102,9 @@ namespace FG
 		ND_ bool							IsRayTracingEnabled ()			const	{ return _enableRayTracingNV; }
 		ND_ bool							IsSamplerMirrorClampEnabled ()	const	{ return _samplerMirrorClamp; }
 		ND_ bool							IsShadingRateImageEnabled ()	const	{ return _enableShadingRateImageNV; }
+		ND_ bool							IsDescUpdateTemplateEnabled ()	const	{ return _enableDescUpdateTemplate; }
+		ND_ bool							IsCreationFeedbackEnabled ()	const	{ return _enableCreationFeedback; }
+		ND_ bool							IsTimelineSemaphoreEnabled ()	const	{ return _enableTimelineSemaphore; }
 		ND_ EResourceState					GetGraphicsShaderStages ()		const	{ return _graphicsShaderStages; }
 		ND_ VkPipelineStageFlags			GetAllWritableStages ()			const	{ return _allWritableStages; }
 		ND_ VkPipelineStageFlags			GetAllReadableStages ()			const	{ return _allReadableStages; }
@@ -13,6 +13,12 @@ namespace FG
 	using TempSemaphores_t		= VSubmitted::Semaphores_t;
 	using PendingSwapchains_t	= FixedArray< VSwapchain const*, 16 >;
 	using TempFences_t			= FixedArray< VkFence, 32 >;
+	using OutSemaphores_t		= StaticArray< VkSemaphore, uint(EQueueType::_Count) >;
+	using TimelineValues_t		= StaticArray< uint64_t, uint(EQueueType::_Count) >;
+	using BatchValues_t			= StaticArray< uint64_t, VSubmitted::MaxBatches >;
+#ifdef VK_KHR_timeline_semaphore
+	using TimelineInfos_t		= StaticArray< VkTimelineSemaphoreSubmitInfoKHR, VSubmitted::MaxBatches >;
+#endif
 
 /*
 =================================================
@@ -34,6 +40,9 @@ namespace FG
 	VFrameGraph::~VFrameGraph ()
 	{
 		CHECK( _GetState() == EState::Destroyed );
+
+		// library was loaded in 'IFrameGraph::CreateFrameGraph'
+		VulkanLoader::Unload();
 	}
 	
 /*
@@ -47,13 +56,24 @@ namespace FG
 
 		// setup queues
 		{
-			EXLOCK( _queueGuard );
-
 			_AddGraphicsQueue();
 			_AddAsyncComputeQueue();
 			_AddAsyncTransferQueue();
 			CHECK_ERR( not _queueMap.empty() );
 		}
+
+		// create timeline semaphores
+		if ( _device.IsTimelineSemaphoreEnabled() )
+		{
+			for (auto& q : _queueMap)
+			{
+				if ( not q.ptr )
+					continue;
+
+				q.timeline = _CreateTimelineSemaphore();
+				CHECK_ERR( q.timeline );
+			}
+		}
 		
 		// create query pool
 		{
@@ -66,6 +86,15 @@ namespace FG
 		}
 
 		CHECK_ERR( _resourceMngr.Initialize() );
+
+		_uploadRing.Initialize( BytesU::FromMb( FG_StagingRingSizeMb ),
+								EBufferUsage::TransferSrc | EBufferUsage::Uniform | EBufferUsage::Storage |
+								EBufferUsage::Index | EBufferUsage::Vertex | EBufferUsage::Indirect,
+								EMemoryType::HostWrite, "HostWriteRing" );
+		_readbackRing.Initialize( BytesU::FromMb( FG_StagingRingSizeMb ), EBufferUsage::TransferDst, EMemoryType::HostRead, "HostReadRing" );
+
+		CHECK_ERR( _completionThread.Start( 1 ));
+		CHECK_ERR( _recordingWorkers.Start( Clamp( std::thread::hardware_concurrency(), 2u, FG_MaxRecordingThreads+1 ) - 1 ));
 		
 		CHECK_ERR( _SetState( EState::Initialization, EState::Idle ));
 		return true;
@@ -81,6 +110,9 @@ namespace FG
 		CHECK_ERR( _SetState( EState::Idle, EState::Destroyed ), void());
 		CHECK_ERR( WaitIdle(), void());
 
+		_completionThread.Stop();
+		_recordingWorkers.Stop();
+
 		// delete command buffers
 		{
 			FG_LOGD( "Max command buffers "s << ToString(_cmdBufferPool.CreatedObjectsCount()) );
@@ -93,21 +125,24 @@ namespace FG
 		}
 
 		// delete per queue data
+		for (auto& q : _queueMap)
 		{
-			EXLOCK( _queueGuard );
+			EXLOCK( q.guard );
 
-			for (auto& q : _queueMap)
-			{
-				CHECK( q.pending.empty() );
-				CHECK( q.submitted.empty() );
+			VCmdBatchPtr	batch;
+			CHECK( not q.incoming.Pop( OUT batch ));
+			CHECK( q.pending.empty() );
+			CHECK( q.submitted.empty() );
 
-				q.cmdPool.Destroy( _device );
+			q.cmdPool.Destroy( _device );
 
-				for (auto& sem : q.semaphores) {
-					_device.vkDestroySemaphore( _device.GetVkDevice(), sem, null );
-					sem = VK_NULL_HANDLE;
-				}
+			for (auto& sem : q.semaphores) {
+				_device.vkDestroySemaphore( _device.GetVkDevice(), sem.exchange( VK_NULL_HANDLE, memory_order_relaxed ), null );
 			}
+
+			_device.vkDestroySemaphore( _device.GetVkDevice(), q.timeline, null );
+			q.timeline		= VK_NULL_HANDLE;
+			q.timelineValue	= 0;
 		}
 		
 		if ( _queryPool ) {
@@ -115,6 +150,9 @@ namespace FG
 			_queryPool = VK_NULL_HANDLE;
 		}
 
+		_uploadRing.Deinitialize( _resourceMngr );
+		_readbackRing.Deinitialize( _resourceMngr );
+
 		_shaderDebugCallback = {};
 		_resourceMngr.Deinitialize();
 	}
@@ -145,6 +183,44 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	SetPipelineCacheFile
+=================================================
+*/
+	bool  VFrameGraph::SetPipelineCacheFile (StringView filename)
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		return _resourceMngr.LoadPipelineCache( filename );
+	}
+	
+/*
+=================================================
+	SavePipelinePermutations
+=================================================
+*/
+	bool  VFrameGraph::SavePipelinePermutations (StringView filename)
+	{
+		CHECK_ERR( _IsInitialized() );
+		CHECK_ERR( not filename.empty() );
+
+		return _resourceMngr.SavePipelinePermutations( filename );
+	}
+	
+/*
+=================================================
+	PrewarmPipelines
+=================================================
+*/
+	bool  VFrameGraph::PrewarmPipelines (StringView filename)
+	{
+		CHECK_ERR( _IsInitialized() );
+		CHECK_ERR( not filename.empty() );
+
+		return _resourceMngr.PrewarmPipelines( filename );
+	}
+	
 /*
 =================================================
 	GetDeviceInfo
@@ -198,11 +274,11 @@ namespace FG
 		barrier.srcQueueFamilyIndex	= queueFamily;
 		barrier.dstQueueFamilyIndex	= queueFamily;
 
-		EXLOCK( _queueGuard );
 		for (auto& q : _queueMap)
 		{
 			if ( q.ptr and (uint(q.ptr->familyIndex) == queueFamily or queueFamily == VK_QUEUE_FAMILY_IGNORED) )
 			{
+				EXLOCK( q.guard );
 				q.imageBarriers.push_back( barrier );
 				return;
 			}
@@ -239,6 +315,28 @@ namespace FG
 		CHECK_ERR( _IsInitialized() );
 		return CPipelineID{ _resourceMngr.CreatePipeline( INOUT desc, dbgName )};
 	}
+
+/*
+=================================================
+	CreatePipelineAsync
+=================================================
+*/
+	GPipelineID  VFrameGraph::CreatePipelineAsync (const GraphicsPipelineDesc &desc, StringView dbgName)
+	{
+		CHECK_ERR( _IsInitialized() );
+		return GPipelineID{ _resourceMngr.CreatePipelineAsync( desc, dbgName )};
+	}
+	
+/*
+=================================================
+	IsPipelineReady
+=================================================
+*/
+	bool  VFrameGraph::IsPipelineReady (RawGPipelineID id) const
+	{
+		CHECK_ERR( _IsInitialized() );
+		return _resourceMngr.IsPipelineReady( id );
+	}
 	
 /*
 =================================================
@@ -631,8 +729,14 @@ namespace FG
 			uint	q_idx = uint(batch->GetQueueType());
 			CHECK_ERR( q_idx < _queueMap.size() );
 
-			EXLOCK( _queueGuard );
-			_queueMap[q_idx].pending.push_back( batch );
+			auto&	q = _queueMap[q_idx];
+
+			// if incoming queue is full then move batches to the pending list
+			for (; not q.incoming.Push( batch );)
+			{
+				EXLOCK( q.guard );
+				_MoveIncomingBatches( q );
+			}
 		}
 
 		//_FlushQueue( batch->GetQueueUsage(), 3u );
@@ -657,6 +761,78 @@ namespace FG
 
 		return result;
 	}
+	
+/*
+=================================================
+	_CreateTimelineSemaphore
+=================================================
+*/
+	VkSemaphore  VFrameGraph::_CreateTimelineSemaphore ()
+	{
+		VkSemaphore		result	= VK_NULL_HANDLE;
+
+	#ifdef VK_KHR_timeline_semaphore
+		VkSemaphoreTypeCreateInfoKHR	type_info	= {};
+		VkSemaphoreCreateInfo			info		= {};
+
+		type_info.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+		type_info.semaphoreType	= VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+		type_info.initialValue	= 0;
+
+		info.sType	= VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		info.pNext	= &type_info;
+		info.flags	= 0;
+
+		VK_CHECK( _device.vkCreateSemaphore( _device.GetVkDevice(), &info, null, OUT &result ));
+		_device.SetObjectName( uint64_t(result), "QueueTimeline", VK_OBJECT_TYPE_SEMAPHORE );
+	#endif
+
+		return result;
+	}
+	
+/*
+=================================================
+	_GetTimelineValue
+=================================================
+*/
+	uint64_t  VFrameGraph::_GetTimelineValue (VkSemaphore sem) const
+	{
+		uint64_t	value = 0;
+
+	#ifdef VK_KHR_timeline_semaphore
+		VK_CALL( _device.vkGetSemaphoreCounterValueKHR( _device.GetVkDevice(), sem, OUT &value ));
+	#else
+		FG_UNUSED( sem );
+	#endif
+
+		return value;
+	}
+	
+/*
+=================================================
+	_WaitTimelines
+----
+	wait until all semaphores reach the values.
+=================================================
+*/
+	VkResult  VFrameGraph::_WaitTimelines (ArrayView<VkSemaphore> semaphores, ArrayView<uint64_t> values, uint64_t timeout) const
+	{
+		ASSERT( semaphores.size() == values.size() );
+
+	#ifdef VK_KHR_timeline_semaphore
+		VkSemaphoreWaitInfoKHR	info = {};
+		info.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+		info.flags			= 0;
+		info.semaphoreCount	= uint(semaphores.size());
+		info.pSemaphores	= semaphores.data();
+		info.pValues		= values.data();
+
+		return _device.vkWaitSemaphoresKHR( _device.GetVkDevice(), &info, timeout );
+	#else
+		FG_UNUSED( semaphores, values, timeout );
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+	#endif
+	}
 
 /*
 =================================================
@@ -665,11 +841,7 @@ namespace FG
 */
 	bool  VFrameGraph::Flush (EQueueUsage queues)
 	{
-		bool	res;
-		{
-			EXLOCK( _queueGuard );
-			res = _FlushAll( queues, 10u );
-		}
+		bool	res = _FlushAll( queues );
 
 		_resourceMngr.RunValidation( 100 );
 		return res;
@@ -678,107 +850,317 @@ namespace FG
 /*
 =================================================
 	_FlushAll
+----
+	Batches from all selected queues are sorted in topological order,
+	each batch and each dependency is visited only once.
+	Dependency on the same queue requires that batch is ready to submit,
+	dependency on other queue requires that batch is submitted,
+	so all ready batches on the same queue are submitted together and
+	then dependent batches on other queues are unlocked.
+	Queue that waits for batches on other queue is submitted after them
+	to minimize number of 'vkQueueSubmit' calls.
 =================================================
 */
-	bool  VFrameGraph::_FlushAll (EQueueUsage queues, uint maxIter)
+	bool  VFrameGraph::_FlushAll (EQueueUsage queues)
 	{
-		for (size_t a = 0, a_max = Min( maxIter, _queueMap.size()), changed = 1;
-			 changed and (a < a_max);
-			 ++a)
+		struct Node
 		{
-			changed = 0;
+			VCmdBatchPtr	batch;
+			uint			queue;
+			uint			inDegree		= 0;	// number of dependencies that are not submitted yet
+			uint			firstDependent	= 0;	// index in 'dependents'
+			uint			dependentCount	= 0;
+			uint			visited			= 0;	// last round when batch was visited
+			bool			isSubmitted		= false;
+		};
+
+		using QueueLocks_t	= StaticArray< std::unique_lock<std::mutex>, uint(EQueueType::_Count) >;
+		using ReadyNodes_t	= StaticArray< Array<uint>, uint(EQueueType::_Count) >;
+
+		QueueLocks_t				locks;
+		Array<Node>					nodes;
+		Array<uint>					dependents;
+		HashMap< VCmdBatch*, uint >	node_map;
+		ReadyNodes_t				ready;
+
+		// lock queues in the same order to avoid deadlocks
+		for (size_t qi = 0; qi < _queueMap.size(); ++qi)
+		{
+			auto&	q = _queueMap[qi];
 
-			// for each queue type
-			for (size_t qi = 0; qi < _queueMap.size(); ++qi)
+			if ( not q.ptr or not EnumEq( queues, 1u<<qi ))
+				continue;
+
+			locks[qi] = std::unique_lock<std::mutex>{ q.guard };
+			_MoveIncomingBatches( q );
+
+			for (auto& batch : q.pending)
+			{
+				ASSERT( batch->GetState() == EBatchState::Backed );
+
+				node_map.insert({ batch.get(), uint(nodes.size()) });
+				nodes.push_back({ std::move(batch), uint(qi) });
+			}
+			q.pending.clear();
+		}
+
+		if ( nodes.empty() )
+			return true;
+
+		// count dependencies
+		for (auto& node : nodes)
+		{
+			for (auto& dep : node.batch->GetDependencies())
 			{
-				if ( _queueMap[qi].ptr and EnumEq( queues, 1u<<qi ) )
-					changed |= size_t(_FlushQueue( EQueueType(qi), 10u ));
+				auto	iter = node_map.find( dep.get() );
+
+				if ( iter != node_map.end() )
+				{
+					++node.inDegree;
+					++nodes[iter->second].dependentCount;
+				}
+				else
+				// batch is not pending on the selected queues, dependent batch will be skipped until next flush
+				if ( dep->GetState() < EBatchState::Submitted )
+					++node.inDegree;
 			}
 		}
+
+		// build list of dependents for each batch
+		{
+			uint	offset = 0;
+			for (auto& node : nodes)
+			{
+				node.firstDependent	= offset;
+				offset				+= node.dependentCount;
+				node.dependentCount	= 0;
+			}
+			dependents.resize( offset );
+
+			for (uint i = 0; i < nodes.size(); ++i)
+			{
+				for (auto& dep : nodes[i].batch->GetDependencies())
+				{
+					auto	iter = node_map.find( dep.get() );
+					if ( iter == node_map.end() )
+						continue;
+
+					auto&	src = nodes[iter->second];
+					dependents[ src.firstDependent + src.dependentCount++ ] = i;
+				}
+			}
+		}
+
+		for (uint i = 0; i < nodes.size(); ++i)
+		{
+			if ( nodes[i].inDegree == 0 )
+				ready[ nodes[i].queue ].push_back( i );
+		}
+
+		// submit batches
+		Array<uint>		stack;
+
+		for (uint round = 1;; ++round)
+		{
+			// queue is deferred while ready batches on other queue will unlock some of its batches,
+			// so more batches are coalesced into a single submission
+			StaticArray< uint, uint(EQueueType::_Count) >	unlocked_by	{};
+			uint											ready_mask	= 0;
+			uint											submit_mask	= 0;
+
+			for (uint qi = 0; qi < ready.size(); ++qi)
+			{
+				if ( ready[qi].empty() )
+					continue;
+
+				ready_mask |= (1u << qi);
+				stack.assign( ready[qi].begin(), ready[qi].end() );
+
+				for (; stack.size();)
+				{
+					auto&	node = nodes[ stack.back() ];
+					stack.pop_back();
+
+					if ( node.visited == round )
+						continue;
+
+					node.visited = round;
+
+					for (uint d = 0; d < node.dependentCount; ++d)
+					{
+						uint	idx = dependents[ node.firstDependent + d ];
+
+						if ( nodes[idx].queue == qi )
+							stack.push_back( idx );
+						else
+							unlocked_by[ nodes[idx].queue ] |= (1u << qi);
+					}
+				}
+			}
+
+			if ( ready_mask == 0 )
+				break;
+
+			for (uint qi = 0; qi < ready.size(); ++qi)
+			{
+				if ( EnumEq( ready_mask, 1u << qi ) and not (unlocked_by[qi] & ready_mask & ~(1u << qi)) )
+					submit_mask |= (1u << qi);
+			}
+
+			// queues depend on each other
+			if ( submit_mask == 0 )
+				submit_mask = ready_mask;
+
+			for (uint qi = 0; qi < ready.size(); ++qi)
+			{
+				auto&			ready_nodes	= ready[qi];
+				CmdBatches_t	pending;
+
+				if ( ready_nodes.empty() or not EnumEq( submit_mask, 1u << qi ))
+					continue;
+
+				// 'ready_nodes' grows while batches on the same queue are unlocked
+				for (size_t j = 0; j < ready_nodes.size(); ++j)
+				{
+					auto&	node = nodes[ ready_nodes[j] ];
+
+					if ( pending.size() == pending.capacity() )
+					{
+						_SubmitQueue( EQueueType(qi), pending );
+						pending.clear();
+					}
+
+					node.batch->OnReadyToSubmit();
+					node.isSubmitted = true;
+					pending.push_back( node.batch );
+
+					for (uint d = 0; d < node.dependentCount; ++d)
+					{
+						auto&	dst = nodes[ dependents[ node.firstDependent + d ]];
+
+						if ( dst.queue == qi and --dst.inDegree == 0 )
+							ready_nodes.push_back( dependents[ node.firstDependent + d ]);
+					}
+				}
+
+				_SubmitQueue( EQueueType(qi), pending );
+
+				// unlock batches on other queues
+				for (uint idx : ready_nodes)
+				{
+					auto&	node = nodes[idx];
+
+					for (uint d = 0; d < node.dependentCount; ++d)
+					{
+						auto&	dst = nodes[ dependents[ node.firstDependent + d ]];
+
+						if ( dst.queue != qi and --dst.inDegree == 0 )
+							ready[ dst.queue ].push_back( dependents[ node.firstDependent + d ]);
+					}
+				}
+
+				ready_nodes.clear();
+			}
+		}
+
+		// return skipped batches to the pending lists, order is preserved
+		for (auto& node : nodes)
+		{
+			if ( not node.isSubmitted )
+				_queueMap[ node.queue ].pending.push_back( std::move(node.batch) );
+		}
 		return true;
 	}
 	
 /*
 =================================================
-	_FlushQueue
+	_SubmitQueue
+----
+	queue guard must be locked.
 =================================================
 */
-	bool  VFrameGraph::_FlushQueue (EQueueType queueIndex, uint maxIter)
+	bool  VFrameGraph::_SubmitQueue (EQueueType queueIndex, ArrayView<VCmdBatchPtr> pending)
 	{
 		uint				qi		= uint(queueIndex);
 		auto&				q		= _queueMap[qi];
-		EQueueUsage			q_mask	= Default;
 
-		CmdBatches_t		pending;
 		SubmitInfos_t		submit_infos;
 		TempSemaphores_t	release_semaphores;
 		PendingSwapchains_t	swapchains;
+		OutSemaphores_t		out_semaphores	{};
+		BatchValues_t		batch_values	{};
 
-		// find batches that can be submitted
-		for (size_t b = 0, b_max = Min( maxIter, q.pending.size()), changed = 1;
-			 changed and (b < b_max);
-			 ++b)
-		{
-			changed = 0;
+		if ( pending.empty() )
+			return false;
 
-			for (auto iter = q.pending.begin(); iter != q.pending.end();)
+		const bool	use_timeline	= (q.timeline != VK_NULL_HANDLE);
+		uint64_t	timeline_value	= 0;
+
+		// add semaphores, each batch is a separate 'VkSubmitInfo' and waits only for its own dependencies
+		if ( use_timeline )
+		{
+			for (size_t i = 0; i < pending.size(); ++i)
 			{
-				auto&		batch	 = *iter;
-				bool		is_ready = true;
-				EQueueUsage	q_mask2	 = Default;
+				auto&				batch		= pending[i];
+				TimelineValues_t	wait_values	{};
 
-				ASSERT( batch->GetState() == EBatchState::Backed );
-				
+				// wait for the last dependency on each queue
 				for (auto& dep : batch->GetDependencies())
 				{
-					const auto	min_state = (dep->GetQueueType() == queueIndex ? EBatchState::Ready : EBatchState::Submitted);
+					uint	qj = uint(dep->GetQueueType());
 
-					q_mask2		|= dep->GetQueueType();
-					is_ready	&= (dep->GetState() >= min_state);
+					if ( qj != qi )
+						wait_values[qj] = Max( wait_values[qj], dep->GetTimelineValue() );
 				}
 
-				if ( is_ready )
+				for (size_t qj = 0; qj < wait_values.size(); ++qj)
 				{
-					batch->OnReadyToSubmit();
-					pending.push_back( std::move(batch) );
-							
-					changed	= 1;
-					iter	= q.pending.erase( iter );
-					q_mask	|= q_mask2;
+					if ( wait_values[qj] )
+						batch->WaitSemaphore( _queueMap[qj].timeline, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, wait_values[qj] );
 				}
-				else
-					++iter;
+
+				// dependent batches on other queues will wait only for this batch
+				batch_values[i] = ++q.timelineValue;
+				batch->SignalSemaphore( q.timeline, batch_values[i] );
 			}
-		}
-		
-		if ( pending.empty() )
-			return false;
 
-		// add semaphores
-		for (size_t qj = 0; qj < _queueMap.size(); ++qj)
+			timeline_value = q.timelineValue;
+		}
+		else
 		{
-			auto&	q2 = _queueMap[qj];
+			// input, semaphore is published by other queue after submission,
+			// binary semaphore can be waited only once, so it is added to the first batch that depends on that queue
+			uint	wait_mask = 0;
 
-			if ( not q2.ptr or qi == qj )
-				continue;
-			
-			// input
-			if ( EnumEq( q_mask, 1u<<qj ) and q2.semaphores[qi] )
+			for (auto& batch : pending)
 			{
-				pending.front()->WaitSemaphore( q2.semaphores[qi], VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
-				release_semaphores.push_back( q2.semaphores[qi] );
-				q2.semaphores[qi] = VK_NULL_HANDLE;
+				for (auto& dep : batch->GetDependencies())
+				{
+					uint	qj = uint(dep->GetQueueType());
+
+					if ( qj == qi or EnumEq( wait_mask, 1u << qj ))
+						continue;
+
+					wait_mask |= (1u << qj);
+
+					if ( VkSemaphore sem = _queueMap[qj].semaphores[qi].exchange( VK_NULL_HANDLE, memory_order_acquire ))
+					{
+						batch->WaitSemaphore( sem, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
+						release_semaphores.push_back( sem );
+					}
+				}
 			}
-						
-			// output
-			{
-				if ( q.semaphores[qj] )
-					release_semaphores.push_back( q.semaphores[qj] );
 
+			// output, semaphore will be published after submission
+			for (size_t qj = 0; qj < _queueMap.size(); ++qj)
+			{
+				if ( not _queueMap[qj].ptr or qi == qj )
+					continue;
+				
 				VkSemaphore	sem = _CreateSemaphore();
 
 				pending.back()->SignalSemaphore( sem );
-				q.semaphores[qj] = sem;
+				out_semaphores[qj] = sem;
 			}
 		}
 
@@ -790,7 +1172,7 @@ namespace FG
 			if ( _submittedPool.Assign( OUT index, [](VSubmitted* ptr, uint idx) { PlacementNew<VSubmitted>( ptr, idx ); }) )
 			{
 				submit = &_submittedPool[index];
-				submit->_Initialize( GetDevice(), EQueueType(qi), pending, release_semaphores );
+				submit->_Initialize( GetDevice(), EQueueType(qi), pending, release_semaphores, timeline_value );
 				break;
 			}
 			
@@ -824,6 +1206,32 @@ namespace FG
 			pending[i]->BeforeSubmit( OUT submit_infos[i] );
 		}
 
+	#ifdef VK_KHR_timeline_semaphore
+		TimelineInfos_t		timeline_infos;
+
+		if ( use_timeline )
+		{
+			for (uint i = 0; i < pending.size(); ++i)
+			{
+				auto	wait_values		= pending[i]->GetWaitSemaphoreValues();
+				auto	signal_values	= pending[i]->GetSignalSemaphoreValues();
+				auto&	info			= timeline_infos[i];
+
+				ASSERT( wait_values.size() == submit_infos[i].waitSemaphoreCount );
+				ASSERT( signal_values.size() == submit_infos[i].signalSemaphoreCount );
+
+				info = {};
+				info.sType						= VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+				info.waitSemaphoreValueCount	= uint(wait_values.size());
+				info.pWaitSemaphoreValues		= wait_values.data();
+				info.signalSemaphoreValueCount	= uint(signal_values.size());
+				info.pSignalSemaphoreValues		= signal_values.data();
+
+				submit_infos[i].pNext = &info;
+			}
+		}
+	#endif
+
 		// submit & present
 		{
 			// some logical queues may have access to the same physical queue
@@ -831,9 +1239,20 @@ namespace FG
 
 			VK_CALL( _device.vkQueueSubmit( q.ptr->handle, uint(pending.size()), submit_infos.data(), OUT submit->GetFence() ));
 			
+			// publish semaphores before batches become visible as submitted,
+			// semaphore that was not waited by other queue will be destroyed with current batches
+			for (size_t qj = 0; qj < out_semaphores.size(); ++qj)
+			{
+				if ( VkSemaphore sem = out_semaphores[qj] )
+				{
+					if ( VkSemaphore old = q.semaphores[qj].exchange( sem, memory_order_acq_rel ))
+						submit->_semaphores.push_back( old );
+				}
+			}
+
 			for (uint i = 0; i < pending.size(); ++i)
 			{
-				pending[i]->AfterSubmit( OUT swapchains, submit );
+				pending[i]->AfterSubmit( OUT swapchains, submit, batch_values[i] );
 			}
 
 			for (auto* sw : swapchains)
@@ -843,15 +1262,44 @@ namespace FG
 			}
 		}
 
-		// remove completed batches
+		// statistic
+		{
+			EXLOCK( _statisticGuard );
+			_lastStatistic.renderer.queueSubmits		+= 1;
+			_lastStatistic.renderer.submittedBatches	+= uint(pending.size());
+		}
+
+		_RemoveCompletedBatches( q );
+
+		q.submitted.push_back( submit );
+		
+		_resourceMngr.OnSubmit();
+		return true;
+	}
+
+/*
+=================================================
+	_RemoveCompletedBatches
+----
+	queue guard must be locked.
+=================================================
+*/
+	void  VFrameGraph::_RemoveCompletedBatches (QueueData &q)
+	{
+		// timeline semaphore counter is read once for all submitted batches
+		const uint64_t	completed = (q.timeline and q.submitted.size() ? _GetTimelineValue( q.timeline ) : 0);
+
 		for (auto iter = q.submitted.begin(); iter != q.submitted.end();)
 		{
 			VSubmitted*	submitted	= *iter;
 			VkFence		fence		= submitted->GetFence();
-			bool		is_complete	= not fence;
+			uint64_t	value		= submitted->GetTimelineValue();
+			bool		is_complete	= false;
 
-			if ( fence and _device.vkGetFenceStatus( _device.GetVkDevice(), fence ) == VK_SUCCESS )
-				is_complete = true;
+			if ( value )
+				is_complete = (value <= completed);
+			else
+				is_complete = (not fence or _device.vkGetFenceStatus( _device.GetVkDevice(), fence ) == VK_SUCCESS);
 
 			if ( is_complete )
 			{
@@ -863,56 +1311,81 @@ namespace FG
 			else
 				break;
 		}
+	}
 
-		q.submitted.push_back( submit );
-		
-		_resourceMngr.OnSubmit();
-		return true;
+/*
+=================================================
+	_MoveIncomingBatches
+----
+	queue guard must be locked.
+=================================================
+*/
+	void  VFrameGraph::_MoveIncomingBatches (QueueData &q)
+	{
+		VCmdBatchPtr	batch;
+
+		for (; q.incoming.Pop( OUT batch );)
+		{
+			q.pending.push_back( std::move(batch) );
+		}
 	}
 
 /*
 =================================================
 	Wait
+----
+	queues are locked one by one,
+	timeout is applied to each queue.
 =================================================
 */
 	bool  VFrameGraph::Wait (ArrayView<CommandBuffer> commands, Nanoseconds timeout)
 	{
-		EXLOCK( _queueGuard );
+		if ( _device.IsTimelineSemaphoreEnabled() )
+			return _WaitTimeline( commands, timeout );
 
-		TempFences_t	fences;
+		bool	result = true;
 
-		for (auto& cmd : commands)
+		for (size_t qi = 0; qi < _queueMap.size(); ++qi)
 		{
-			auto*	batch = Cast<VCmdBatch>(cmd.GetBatch());
-			if ( not batch )
+			auto&			q = _queueMap[qi];
+			TempFences_t	fences;
+
+			if ( not q.ptr )
 				continue;
 
-			auto	state		= batch->GetState();
-			auto*	submitted	= batch->GetSubmitted();
+			EXLOCK( q.guard );
 
-			if ( state == EBatchState::Complete )
-			{}
-			else
-			if ( state == EBatchState::Submitted )
+			for (auto& cmd : commands)
 			{
-				auto	fence = submitted->GetFence();
-				bool	found = false;
+				auto*	batch = Cast<VCmdBatch>(cmd.GetBatch());
+				if ( not batch or uint(batch->GetQueueType()) != qi )
+					continue;
 
-				ASSERT( fence );
+				auto	state		= batch->GetState();
+				auto*	submitted	= batch->GetSubmitted();
 
-				for (auto& f : fences) {
-					found |= (f == fence);
-				}
+				if ( state == EBatchState::Complete )
+				{}
+				else
+				if ( state == EBatchState::Submitted )
+				{
+					auto	fence = submitted->GetFence();
+					bool	found = false;
+
+					ASSERT( fence );
 
-				if ( not found )
-					fences.push_back( fence );
+					for (auto& f : fences) {
+						found |= (f == fence);
+					}
+
+					if ( not found )
+						fences.push_back( fence );
+				}
 			}
-		}
 
-		bool	result = true;
+			if ( fences.empty() )
+				continue;
 
-		if ( fences.size() )
-		{
 			EXLOCK( _statisticGuard );
 
 			auto  res = _device.vkWaitForFences( _device.GetVkDevice(), uint(fences.size()), fences.data(), VK_TRUE, timeout.count() );
@@ -922,7 +1395,11 @@ namespace FG
 				// release resources
 				for (auto& cmd : commands)
 				{
-					if ( auto*  submitted = Cast<VCmdBatch>(cmd.GetBatch())->GetSubmitted() )
+					auto*	batch = Cast<VCmdBatch>(cmd.GetBatch());
+					if ( not batch or uint(batch->GetQueueType()) != qi )
+						continue;
+
+					if ( auto*  submitted = batch->GetSubmitted() )
 						submitted->_Release( GetDevice(), _debugger, _shaderDebugCallback, INOUT _lastStatistic );
 				}
 			}
@@ -936,6 +1413,62 @@ namespace FG
 		return result;
 	}
 
+/*
+=================================================
+	_WaitTimeline
+----
+	single wait for all queues,
+	queues are not locked while waiting.
+=================================================
+*/
+	bool  VFrameGraph::_WaitTimeline (ArrayView<CommandBuffer> commands, Nanoseconds timeout)
+	{
+		TimelineValues_t								values {};
+		FixedArray< VkSemaphore, uint(EQueueType::_Count) >	wait_semaphores;
+		FixedArray< uint64_t, uint(EQueueType::_Count) >		wait_values;
+
+		for (auto& cmd : commands)
+		{
+			auto*	batch = Cast<VCmdBatch>(cmd.GetBatch());
+			if ( not batch or batch->GetState() != EBatchState::Submitted )
+				continue;
+
+			uint	qi = uint(batch->GetQueueType());
+			values[qi] = Max( values[qi], batch->GetTimelineValue() );
+		}
+
+		for (size_t qi = 0; qi < values.size(); ++qi)
+		{
+			if ( values[qi] ) {
+				wait_semaphores.push_back( _queueMap[qi].timeline );
+				wait_values.push_back( values[qi] );
+			}
+		}
+
+		if ( wait_semaphores.empty() )
+			return true;
+
+		auto  res = _WaitTimelines( wait_semaphores, wait_values, uint64_t(timeout.count()) );
+
+		if ( res != VK_SUCCESS )
+		{
+			CHECK( res == VK_TIMEOUT );
+			return false;
+		}
+
+		// release resources
+		for (size_t qi = 0; qi < values.size(); ++qi)
+		{
+			if ( values[qi] )
+			{
+				auto&	q = _queueMap[qi];
+				EXLOCK( q.guard );
+				_RemoveCompletedBatches( q );
+			}
+		}
+		return true;
+	}
+
 /*
 =================================================
 	WaitIdle
@@ -943,43 +1476,49 @@ namespace FG
 */
 	bool  VFrameGraph::WaitIdle ()
 	{
+		CHECK_ERR( _FlushAll( EQueueUsage::All ));
+		
+		for (auto& q : _queueMap)
 		{
-			EXLOCK( _queueGuard );
+			if ( not q.ptr )
+				continue;
 
-			TempFences_t	fences;
+			EXLOCK( q.guard );
+			CHECK( q.pending.empty() );	// circular dependency
 
-			CHECK_ERR( _FlushAll( EQueueUsage::All, 10u ));
-		
-			for (size_t i = 0; i < _queueMap.size(); ++i)
+			if ( q.timeline )
 			{
-				auto&	q = _queueMap[i];
-
-				CHECK( q.pending.empty() );	// circular dependency
+				if ( q.submitted.size() )
+					VK_CALL( _WaitTimelines( {q.timeline}, {q.timelineValue}, UMax ));
+			}
+			else
+			{
+				TempFences_t	fences;
 
 				for (auto& s : q.submitted)
 				{
 					if ( auto fence = s->GetFence() )
 						fences.push_back( fence );
 				}
-			}
 		
-			if ( fences.size() )
-			{
-				VK_CALL( _device.vkWaitForFences( _device.GetVkDevice(), uint(fences.size()), fences.data(), VK_TRUE, UMax ));
+				if ( fences.size() )
+				{
+					VK_CALL( _device.vkWaitForFences( _device.GetVkDevice(), uint(fences.size()), fences.data(), VK_TRUE, UMax ));
+				}
 			}
 		
 			EXLOCK( _statisticGuard );
 
-			for (auto& q : _queueMap)
-			{
-				for (auto* s : q.submitted) {
-					s->_Release( GetDevice(), _debugger, _shaderDebugCallback, INOUT _lastStatistic );
-					_submittedPool.Unassign( s->GetIndexInPool() );
-				}
-				q.submitted.clear();
+			for (auto* s : q.submitted) {
+				s->_Release( GetDevice(), _debugger, _shaderDebugCallback, INOUT _lastStatistic );
+				_submittedPool.Unassign( s->GetIndexInPool() );
 			}
+			q.submitted.clear();
 		}
 
+		// wait for asynchronous readback callbacks
+		_completionThread.WaitAll();
+
 		_resourceMngr.RunValidation( 100 );
 		return true;
 	}
@@ -1292,5 +1831,19 @@ namespace FG
 		_cmdBatchPool.Unassign( batch->GetIndexInPool() );
 	}
 
+/*
+=================================================
+	RunOnCompletionThread
+----
+	job is executed on the calling thread if completion thread is stopped.
+=================================================
+*/
+	void  VFrameGraph::RunOnCompletionThread (WorkerPool::Job_t &&job)
+	{
+		// 'job' is not moved if 'Run' failed
+		if ( not _completionThread.Run( std::move(job) ))
+			job();
+	}
+
 
 }	// FG
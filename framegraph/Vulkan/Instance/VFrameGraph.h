@@ -7,7 +7,10 @@
 #include "VDevice.h"
 #include "VCmdBatch.h"
 #include "VDebugger.h"
+#include "VStagingRing.h"
 #include "stl/ThreadSafe/LfIndexedPool.h"
+#include "stl/ThreadSafe/LfFixedQueue.h"
+#include "stl/ThreadSafe/WorkerPool.h"
 
 namespace FG
 {
@@ -29,18 +32,25 @@ namespace FG
 		};
 		
 		using EBatchState		= VCmdBatch::EState;
-		using PerQueueSem_t		= StaticArray< VkSemaphore, uint(EQueueType::_Count) >;
+		using PerQueueSem_t		= StaticArray< std::atomic<VkSemaphore>, uint(EQueueType::_Count) >;
+		using IncomingQueue_t	= LfFixedQueue< VCmdBatchPtr, 64 >;
 
 		struct QueueData
 		{
 		// immutable data
 			VDeviceQueueInfoPtr			ptr;			// pointer to the physical queue
 			EQueueType					type			= Default;
+			VkSemaphore					timeline		= VK_NULL_HANDLE;	// only if timeline semaphores are enabled
 
-		// mutable data
-			Array<VCmdBatchPtr>			pending;		// TODO: circular queue
+		// lock-free data
+			IncomingQueue_t				incoming;		// batches added by 'Execute' from any thread
+			PerQueueSem_t				semaphores		{};	// signaled by this queue, waited by other queues
+
+		// mutable data, protected by 'guard'
+			std::mutex					guard;
+			Array<VCmdBatchPtr>			pending;		// batches that wait for dependencies
 			Array<VSubmitted *>			submitted;
-			PerQueueSem_t				semaphores		{};
+			uint64_t					timelineValue	= 0;	// last value that will be signaled by the queue
 
 			VCommandPool				cmdPool;
 			Array<VkImageMemoryBarrier>	imageBarriers;
@@ -60,8 +70,7 @@ namespace FG
 
 		VDevice					_device;
 
-		std::mutex				_queueGuard;		// TODO: remove global lock
-		QueueMap_t				_queueMap;
+		QueueMap_t				_queueMap;			// each queue has its own lock
 		EQueueUsage				_queueUsage;
 
 		CmdBufferPool_t			_cmdBufferPool;
@@ -70,8 +79,14 @@ namespace FG
 
 		VResourceManager		_resourceMngr;
 		VDebugger				_debugger;
+
+		VStagingRing			_uploadRing;		// CPU write, GPU read
+		VStagingRing			_readbackRing;		// CPU read, GPU write
 		VkQueryPool				_queryPool;			// for time measurements
 
+		WorkerPool				_completionThread;	// runs asynchronous readback callbacks
+		WorkerPool				_recordingWorkers;	// records secondary command buffers, shared between all command buffers
+
 		ShaderDebugCallback_t	_shaderDebugCallback;
 
 		mutable std::mutex		_statisticGuard;
@@ -88,6 +103,9 @@ namespace FG
 		void			Deinitialize () override;
 		bool			AddPipelineCompiler (const PipelineCompiler &comp) override;
 		bool			SetShaderDebugCallback (ShaderDebugCallback_t &&) override;
+		bool			SetPipelineCacheFile (StringView filename) override;
+		bool			SavePipelinePermutations (StringView filename) override;
+		bool			PrewarmPipelines (StringView filename) override;
 		DeviceInfo_t	GetDeviceInfo () const override;
 		EQueueUsage		GetAvilableQueues () const override		{ return _queueUsage; }
 
@@ -97,6 +115,8 @@ namespace FG
 		RTPipelineID	CreatePipeline (INOUT RayTracingPipelineDesc &desc) override;
 		GPipelineID		CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName) override;
 		CPipelineID		CreatePipeline (INOUT ComputePipelineDesc &desc, StringView dbgName) override;
+		GPipelineID		CreatePipelineAsync (const GraphicsPipelineDesc &desc, StringView dbgName) override;
+		bool			IsPipelineReady (RawGPipelineID id) const override;
 		ImageID			CreateImage (const ImageDesc &desc, const MemoryDesc &mem, StringView dbgName) override;
 		BufferID		CreateBuffer (const BufferDesc &desc, const MemoryDesc &mem, StringView dbgName) override;
 		ImageID			CreateImage (const ExternalImageDesc_t &desc, OnExternalImageReleased_t &&, StringView dbgName) override;
@@ -149,12 +169,16 @@ namespace FG
 
 		// //
 		void			RecycleBatch (const VCmdBatch *);
+		void			RunOnCompletionThread (WorkerPool::Job_t &&job);
 
 		
 		ND_ VDeviceQueueInfoPtr	FindQueue (EQueueType type) const;
 		ND_ VDevice const&		GetDevice ()				const	{ return _device; }
 		ND_ VResourceManager &	GetResourceManager ()				{ return _resourceMngr; }
+		ND_ VStagingRing &		GetUploadRing ()					{ return _uploadRing; }
+		ND_ VStagingRing &		GetReadbackRing ()					{ return _readbackRing; }
 		ND_ VkQueryPool			GetQueryPool ()				const	{ return _queryPool; }
+		ND_ WorkerPool &		GetRecordingWorkers ()				{ return _recordingWorkers; }
 
 
 	private:
@@ -168,6 +192,9 @@ namespace FG
 		void _TransitImageLayoutToDefault (RawImageID imageId, VkImageLayout initialLayout, uint queueFamily);
 
 		ND_ VkSemaphore	_CreateSemaphore ();
+		ND_ VkSemaphore	_CreateTimelineSemaphore ();
+		ND_ uint64_t	_GetTimelineValue (VkSemaphore sem) const;
+		ND_ VkResult	_WaitTimelines (ArrayView<VkSemaphore> semaphores, ArrayView<uint64_t> values, uint64_t timeout) const;
 
 
 		// queues //
@@ -181,8 +208,11 @@ namespace FG
 			bool  _CreateQueue (EQueueType, VDeviceQueueInfoPtr);
 
 			bool  _TryFlush (const VCmdBatchPtr &batch);
-			bool  _FlushAll (EQueueUsage queues, uint maxIter);
-			bool  _FlushQueue (EQueueType queue, uint maxIter);
+			void  _MoveIncomingBatches (QueueData &q);
+			bool  _FlushAll (EQueueUsage queues);
+			bool  _SubmitQueue (EQueueType queue, ArrayView<VCmdBatchPtr> batches);
+			void  _RemoveCompletedBatches (QueueData &q);
+			bool  _WaitTimeline (ArrayView<CommandBuffer> commands, Nanoseconds timeout);
 			bool  _WaitQueue (EQueueType queue, Nanoseconds timeout);
 
 
@@ -5,6 +5,8 @@
 #include "VEnumCast.h"
 #include "stl/Algorithms/StringUtils.h"
 #include "Shared/PipelineResourcesHelper.h"
+#include "stl/Stream/FileStream.h"
+#include <cstdio>
 
 namespace FG
 {
@@ -83,6 +85,8 @@ namespace FG
 	{
 		CHECK_ERR( _memoryMngr.Initialize() );
 		CHECK_ERR( _descMngr.Initialize() );
+		CHECK_ERR( _CreatePipelineCache( {}, OUT _pipelineCache ));
+		CHECK_ERR( _compileWorkers.Start( Clamp( std::thread::hardware_concurrency() / 2, 1u, MaxCompileThreads )));
 
 		_CreateEmptyDescriptorSetLayout();
 		return true;
@@ -95,8 +99,29 @@ namespace FG
 */
 	void VResourceManager::Deinitialize ()
 	{
+		// complete asynchronous pipeline creation
+		_compileWorkers.Stop();
+		ASSERT( _pendingGPipelines.empty() );
+
+		SavePipelineCache();
+
+		if ( _pipelineCache )
+		{
+			_device.vkDestroyPipelineCache( _device.GetVkDevice(), _pipelineCache, null );
+			_pipelineCache = VK_NULL_HANDLE;
+		}
+
 		_debugDSLayoutsCache.clear();
 
+		// release render passes that was created by 'PrewarmPipelines'
+		{
+			EXLOCK( _prewarmGuard );
+			for (auto& rp : _prewarmRenderPasses) {
+				ReleaseResource( rp );
+			}
+			_prewarmRenderPasses.clear();
+		}
+
 		_DestroyResourceCache( INOUT _samplerCache );
 		_DestroyResourceCache( INOUT _pplnLayoutCache );
 		_DestroyResourceCache( INOUT _dsLayoutCache );
@@ -148,6 +173,303 @@ namespace FG
 		_submissionCounter.fetch_add( 1, memory_order_relaxed );
 	}
 	
+/*
+=================================================
+	_CreatePipelineCache
+=================================================
+*/
+	bool  VResourceManager::_CreatePipelineCache (ArrayView<uint8_t> initialData, OUT VkPipelineCache &cache) const
+	{
+		VkPipelineCacheCreateInfo	info = {};
+		info.sType				= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		info.flags				= 0;
+		info.initialDataSize	= initialData.size();
+		info.pInitialData		= initialData.data();
+
+		VK_CHECK( _device.vkCreatePipelineCache( _device.GetVkDevice(), &info, null, OUT &cache ));
+		return true;
+	}
+	
+/*
+=================================================
+	_IsCompatiblePipelineCache
+----
+	validate header (VkPipelineCacheHeaderVersionOne),
+	cache data from another device or driver version must be ignored.
+=================================================
+*/
+	bool  VResourceManager::_IsCompatiblePipelineCache (ArrayView<uint8_t> data) const
+	{
+		struct Header
+		{
+			uint		headerSize;
+			uint		headerVersion;
+			uint		vendorID;
+			uint		deviceID;
+			uint8_t		pipelineCacheUUID [VK_UUID_SIZE];
+		};
+		STATIC_ASSERT( sizeof(Header) == 16 + VK_UUID_SIZE );
+
+		if ( data.size() < sizeof(Header) )
+			return false;
+
+		Header	header;
+		std::memcpy( OUT &header, data.data(), sizeof(header) );
+
+		auto&	props = _device.GetDeviceProperties();
+
+		return	header.headerSize		>= sizeof(Header)						and
+				header.headerSize		<= data.size()							and
+				header.headerVersion	== VK_PIPELINE_CACHE_HEADER_VERSION_ONE	and
+				header.vendorID			== props.vendorID						and
+				header.deviceID			== props.deviceID						and
+				std::memcmp( header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE ) == 0;
+	}
+
+/*
+=================================================
+	LoadPipelineCache
+----
+	cache data is merged into the shared pipeline cache,
+	must not be called while pipelines are created.
+	Cache is saved to the previous file before switching,
+	empty filename disables saving in 'Deinitialize'.
+	Returns false if file is created for another device or driver version,
+	this file will be replaced.
+=================================================
+*/
+	bool  VResourceManager::LoadPipelineCache (StringView filename)
+	{
+		EXLOCK( _pipelineCacheGuard );
+		CHECK_ERR( _pipelineCache );
+
+		if ( not _pipelineCacheFile.empty() and _pipelineCacheFile != filename )
+			CHECK( _SavePipelineCache() );
+
+		_pipelineCacheFile = String{filename};
+
+		if ( _pipelineCacheFile.empty() )
+			return true;
+
+		FileRStream		file{ _pipelineCacheFile };
+		if ( not file.IsOpen() )
+		{
+			FG_LOGI( "pipeline cache file '"s << _pipelineCacheFile << "' doesn't exist, it will be created" );
+			return true;
+		}
+
+		Array<uint8_t>	data;
+		CHECK_ERR( file.Read( size_t(file.Size()), OUT data ));
+
+		if ( not _IsCompatiblePipelineCache( data ))
+		{
+			FG_LOGI( "pipeline cache in '"s << _pipelineCacheFile << "' is created for another device or driver version, it will be replaced" );
+			return false;
+		}
+
+		VkPipelineCache		src_cache;
+		CHECK_ERR( _CreatePipelineCache( data, OUT src_cache ));
+
+		VK_CALL( _device.vkMergePipelineCaches( _device.GetVkDevice(), _pipelineCache, 1, &src_cache ));
+		_device.vkDestroyPipelineCache( _device.GetVkDevice(), src_cache, null );
+		return true;
+	}
+	
+/*
+=================================================
+	SavePipelineCache
+----
+	data is written to the temporary file and then renamed,
+	so previous cache is never corrupted.
+=================================================
+*/
+	bool  VResourceManager::SavePipelineCache ()
+	{
+		EXLOCK( _pipelineCacheGuard );
+		return _SavePipelineCache();
+	}
+	
+/*
+=================================================
+	_SavePipelineCache
+=================================================
+*/
+	bool  VResourceManager::_SavePipelineCache ()
+	{
+		if ( _pipelineCacheFile.empty() or not _pipelineCache )
+			return false;
+
+		size_t			size = 0;
+		Array<uint8_t>	data;
+		VK_CHECK( _device.vkGetPipelineCacheData( _device.GetVkDevice(), _pipelineCache, OUT &size, null ));
+
+		data.resize( size );
+		VK_CHECK( _device.vkGetPipelineCacheData( _device.GetVkDevice(), _pipelineCache, INOUT &size, OUT data.data() ));
+		data.resize( size );
+
+		const String	temp_name = _pipelineCacheFile + ".tmp";
+		{
+			FileWStream		file{ temp_name };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Write( ArrayView<uint8_t>{ data }));
+		}
+
+		if ( std::rename( temp_name.c_str(), _pipelineCacheFile.c_str() ) != 0 )
+		{
+			// on some platforms destination file must be removed before renaming
+			std::remove( _pipelineCacheFile.c_str() );
+			CHECK_ERR( std::rename( temp_name.c_str(), _pipelineCacheFile.c_str() ) == 0 );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	SavePipelinePermutations
+----
+	records all pipeline instances of alive graphics pipelines,
+	instances with shader debugging are skipped.
+	Must not be called while pipelines are created or destroyed.
+=================================================
+*/
+	bool  VResourceManager::SavePipelinePermutations (StringView filename)
+	{
+		VPipelinePermutations					perms;
+		Array<VGraphicsPipeline::InstanceKey>	keys;
+
+		for (size_t i = 0, count = _graphicsPplnPool.size(); i < count; ++i)
+		{
+			auto&	res = _graphicsPplnPool[ Index_t(i) ];
+
+			if ( not res.IsCreated() )
+				continue;
+
+			auto&	ppln = res.Data();
+			
+			keys.clear();
+			ppln.GetInstanceKeys( OUT keys );
+
+			for (auto& key : keys)
+			{
+				// render pass may be already destroyed
+				if ( auto* render_pass = GetResource( key.renderPassId, false, true ))
+					perms.Add( ppln.GetSourceHash(), key, *render_pass );
+			}
+		}
+
+		FileWStream		file{ filename };
+		CHECK_ERR( file.IsOpen() );
+		CHECK_ERR( perms.Save( file ));
+		return true;
+	}
+	
+/*
+=================================================
+	PrewarmPipelines
+----
+	creates pipeline instances from recorded permutations on the worker threads
+	and blocks until all of them are created.
+	Graphics pipelines are matched by hash of shader sources,
+	so pipelines must be created before this call.
+	Render passes are added to the cache and are not released until 'Deinitialize',
+	because pipeline instances are keyed by render pass ID.
+=================================================
+*/
+	bool  VResourceManager::PrewarmPipelines (StringView filename)
+	{
+		VPipelinePermutations	perms;
+		{
+			FileRStream		file{ filename };
+			if ( not file.IsOpen() )
+			{
+				FG_LOGI( "pipeline permutations file '"s << filename << "' doesn't exist" );
+				return false;
+			}
+			CHECK_ERR( perms.Load( file ));
+		}
+
+		// complete asynchronous pipeline creation
+		_compileWorkers.WaitAll();
+
+		// find graphics pipelines by hash of shader sources
+		HashMap< size_t, RawGPipelineID >	pipelines;
+
+		for (size_t i = 0, count = _graphicsPplnPool.size(); i < count; ++i)
+		{
+			auto&	res = _graphicsPplnPool[ Index_t(i) ];
+
+			if ( not res.IsCreated() )
+				continue;
+
+			RawGPipelineID	id{ Index_t(i), res.GetInstanceID() };
+			
+			if ( pipelines.insert({ size_t(res.Data().GetSourceHash()), id }).second and not AcquireResource( id ))
+				pipelines.erase( size_t(res.Data().GetSourceHash()) );
+		}
+
+		Array< RawRenderPassID >	render_passes;
+		render_passes.resize( perms.RenderPassCount() );
+
+		for (uint i = 0; i < perms.RenderPassCount(); ++i)
+		{
+			render_passes[i] = CreateRenderPass( perms.GetRenderPassInfo( i ), "PrewarmRenderPass" );
+		}
+
+		// create pipeline instances
+		const auto			permutations	= perms.GetPermutations();
+		const uint			job_count		= Max( 1u, _compileWorkers.ThreadCount() );
+		std::atomic<uint>	created			{0};
+		std::atomic<uint>	skipped			{0};
+
+		const auto	Prewarm = [&] (uint first)
+		{
+			VPipelineCache					cache;
+			VertexInputState				vertex_input;
+			IFrameGraph::ResourceStatistics	stat;
+
+			for (size_t i = first; i < permutations.size(); i += job_count)
+			{
+				auto&					perm	= permutations[i];
+				auto					iter	= pipelines.find( size_t(perm.sourceHash) );
+				const RawRenderPassID	rp_id	= render_passes[ perm.renderPassIndex ];
+				VGraphicsPipeline const*	ppln	= iter != pipelines.end() ? GetResource( iter->second ) : null;
+
+				if ( not ppln or not rp_id or not perm.GetVertexInput( OUT vertex_input ) or
+					 not cache.PrewarmPipelineInstance( *this, *ppln, rp_id, perm.subpassIndex, perm.viewportCount,
+														vertex_input, perm.renderState, perm.dynamicState, INOUT stat ))
+				{
+					skipped.fetch_add( 1, memory_order_relaxed );
+				}
+			}
+			created.fetch_add( stat.newGraphicsPipelineCount, memory_order_relaxed );
+		};
+
+		for (uint j = 0; j < job_count; ++j)
+		{
+			if ( not _compileWorkers.Run( [&Prewarm, j] () { Prewarm( j ); }))
+				Prewarm( j );
+		}
+		_compileWorkers.WaitAll();
+
+		for (auto& ppln : pipelines) {
+			ReleaseResource( ppln.second );
+		}
+
+		// pipeline instances don't hold references to render passes,
+		// so render passes are released only in 'Deinitialize'
+		{
+			EXLOCK( _prewarmGuard );
+			for (auto& rp : render_passes)
+			{
+				if ( rp )
+					_prewarmRenderPasses.push_back( rp );
+			}
+		}
+
+		FG_LOGI( "pre-warmed "s << ToString( created.load() ) << " pipelines, skipped " << ToString( skipped.load() ) << " of " << ToString( permutations.size() ) << " permutations" );
+		return true;
+	}
+
 /*
 =================================================
 	_DestroyResourceCache
@@ -697,6 +1019,51 @@ namespace FG
 		return id;
 	}
 	
+/*
+=================================================
+	HashOfShaders
+----
+	hash of shader sources before compilation,
+	used to find same pipeline in the next application run.
+	Hash of external shader module depends on handle value
+	and is valid only in the current run.
+=================================================
+*/
+	ND_ static HashVal  HashOfShaders (const GraphicsPipelineDesc &desc)
+	{
+		HashVal		result;
+
+		for (auto& sh : desc._shaders)
+		{
+			for (auto& data : sh.second.data)
+			{
+				HashVal	h = HashOf( sh.first ) + HashOf( data.first );
+
+				Visit( data.second,
+					[&h] (const PipelineDescription::SharedShaderPtr<String> &src) {
+						h << HashOf( src->GetData().data(), src->GetData().size() ) << HashOf( src->GetEntry() );
+					},
+					[&h] (const PipelineDescription::SharedShaderPtr<Array<uint8_t>> &bin) {
+						h << HashOf( bin->GetData().data(), bin->GetData().size() ) << HashOf( bin->GetEntry() );
+					},
+					[&h] (const PipelineDescription::SharedShaderPtr<Array<uint>> &bin) {
+						h << HashOf( bin->GetData().data(), bin->GetData().size() * sizeof(uint) ) << HashOf( bin->GetEntry() );
+					},
+					[&h] (const PipelineDescription::VkShaderPtr &module) {
+						h << HashOf( module->GetData() ) << HashOf( module->GetEntry() );
+					},
+					[] (const NullUnion &) {}
+				);
+				result << h;
+			}
+
+			for (auto& spec : sh.second.specConstants) {
+				result << HashOf( sh.first ) << HashOf( spec.first ) << HashOf( spec.second );
+			}
+		}
+		return result;
+	}
+
 /*
 =================================================
 	CreatePipeline
@@ -704,6 +1071,8 @@ namespace FG
 */
 	RawGPipelineID  VResourceManager::CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName)
 	{
+		const HashVal	src_hash = HashOfShaders( desc );
+
 		if ( not _CompileShaders( INOUT desc, _device ))
 			return Default;
 		
@@ -717,7 +1086,7 @@ namespace FG
 		auto&	data = _GetResourcePool( id )[ id.Index() ];
 		Replace( data );
 		
-		if ( not data.Create( desc, layout_id, dbgName ))
+		if ( not data.Create( desc, layout_id, src_hash, dbgName ))
 		{
 			_Unassign( id );
 			RETURN_ERR( "failed when creating graphics pipeline" );
@@ -729,6 +1098,174 @@ namespace FG
 		return id;
 	}
 	
+/*
+=================================================
+	CreatePipelineAsync
+----
+	returns ID immediately, pipeline will be created on the worker thread.
+	Pipeline instances for render passes are still created on demand.
+=================================================
+*/
+	RawGPipelineID  VResourceManager::CreatePipelineAsync (const GraphicsPipelineDesc &desc, StringView dbgName)
+	{
+		RawGPipelineID		id;
+		CHECK_ERR( _Assign( OUT id ));
+
+		auto&	data = _GetResourcePool( id )[ id.Index() ];
+		Replace( data );
+		{
+			EXLOCK( _asyncPplnGuard );
+			_pendingGPipelines.insert( id.Index() );
+			_pendingGPipelineCount.fetch_add( 1, memory_order_relaxed );
+		}
+
+		const bool	queued = _compileWorkers.Run( [this, id, desc = GraphicsPipelineDesc{desc}, name = String(dbgName)] () mutable
+									{
+										_CreatePipelineAsync( id, INOUT desc, name );
+									});
+		if ( not queued )
+		{
+			{
+				EXLOCK( _asyncPplnGuard );
+				_pendingGPipelines.erase( id.Index() );
+				_pendingGPipelineCount.fetch_sub( 1, memory_order_release );
+			}
+			_Unassign( id );
+			RETURN_ERR( "failed to run asynchronous pipeline creation" );
+		}
+		return id;
+	}
+	
+/*
+=================================================
+	_CreatePipelineAsync
+----
+	called on the worker thread.
+=================================================
+*/
+	void  VResourceManager::_CreatePipelineAsync (RawGPipelineID id, INOUT GraphicsPipelineDesc &desc, StringView dbgName)
+	{
+		auto&			data		= _GetResourcePool( id )[ id.Index() ];
+		bool			created		= false;
+		const HashVal	src_hash	= HashOfShaders( desc );
+
+		if ( _CompileShaders( INOUT desc, _device ))
+		{
+			RawPipelineLayoutID						layout_id;
+			ResourceBase<VPipelineLayout> const*	layout	= null;
+
+			if ( _CreatePipelineLayout( OUT layout_id, OUT layout, std::move(desc._pipelineLayout) ) and
+				 data.Create( desc, layout_id, src_hash, dbgName ))
+			{
+				layout->AddRef();
+				data.AddRef();
+				created = true;
+			}
+		}
+
+		if ( not created )
+		{
+			FG_LOGE( "failed when creating graphics pipeline '"s << dbgName << "' asynchronously" );
+		}
+
+		// pipeline becomes ready only here, after references are added
+		{
+			EXLOCK( _asyncPplnGuard );
+			_pendingGPipelines.erase( id.Index() );
+			_pendingGPipelineCount.fetch_sub( 1, memory_order_release );
+		}
+		_asyncPplnCV.notify_all();
+	}
+	
+/*
+=================================================
+	IsPipelineReady
+=================================================
+*/
+	bool  VResourceManager::IsPipelineReady (RawGPipelineID id) const
+	{
+		auto&	pool = _GetResourceCPool( id );
+
+		if ( id.Index() >= pool.size() )
+			return false;
+
+		auto&	data = pool[ id.Index() ];
+
+		if ( not data.IsCreated() or data.GetInstanceID() != id.InstanceID() )
+			return false;
+
+		// state is published before references are added on the worker thread
+		if ( _IsPipelinePending( id ))
+			return false;
+
+		// synchronize with pipeline creation on the worker thread
+		std::atomic_thread_fence( memory_order_acquire );
+		return true;
+	}
+	
+/*
+=================================================
+	_IsPipelinePending
+=================================================
+*/
+	bool  VResourceManager::_IsPipelinePending (RawGPipelineID id) const
+	{
+		if ( _pendingGPipelineCount.load( memory_order_acquire ) == 0 )
+			return false;
+
+		EXLOCK( _asyncPplnGuard );
+		return _pendingGPipelines.count( id.Index() ) > 0;
+	}
+
+/*
+=================================================
+	_WaitPipeline
+=================================================
+*/
+	void  VResourceManager::_WaitPipeline (RawGPipelineID id)
+	{
+		if ( not _IsPipelinePending( id ))
+			return;
+
+		std::unique_lock	lock{ _asyncPplnGuard };
+
+		_asyncPplnCV.wait( lock, [this, id] () { return _pendingGPipelines.count( id.Index() ) == 0; });
+	}
+	
+/*
+=================================================
+	ReleaseResource
+----
+	graphics pipeline may be created asynchronously,
+	in this case wait until creation is complete and then release it.
+=================================================
+*/
+	void  VResourceManager::ReleaseResource (RawGPipelineID id, uint refCount)
+	{
+		ASSERT( id );
+		auto&	pool = _GetResourcePool( id );
+
+		if ( id.Index() >= pool.size() )
+			return;
+
+		auto&	data = pool[ id.Index() ];
+
+		if ( data.GetInstanceID() != id.InstanceID() )
+			return;	// this instance is already destroyed
+
+		// pipeline may be already published but references are not added yet
+		_WaitPipeline( id );
+
+		// creation failed, there are no references
+		if ( not data.IsCreated() )
+		{
+			_Unassign( id );
+			return;
+		}
+
+		_ReleaseResource( pool, data, id.Index(), refCount );
+	}
+
 /*
 =================================================
 	CreatePipeline
@@ -874,6 +1411,106 @@ namespace FG
 		return id;
 	}
 	
+/*
+=================================================
+	CreateTransientImage
+=================================================
+*/
+	RawImageID  VResourceManager::CreateTransientImage (const ImageDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName)
+	{
+		RawImageID		id;
+		CHECK_ERR( _Assign( OUT id ));
+
+		auto&	data = _GetResourcePool( id )[ id.Index() ];
+		Replace( data );
+
+		if ( not data.CreateTransient( *this, desc, queueFamilyMask, dbgName ))
+		{
+			_Unassign( id );
+			RETURN_ERR( "failed when creating transient image" );
+		}
+		
+		data.AddRef();
+		return id;
+	}
+	
+/*
+=================================================
+	CreateTransientBuffer
+=================================================
+*/
+	RawBufferID  VResourceManager::CreateTransientBuffer (const BufferDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName)
+	{
+		RawBufferID		id;
+		CHECK_ERR( _Assign( OUT id ));
+
+		auto&	data = _GetResourcePool( id )[ id.Index() ];
+		Replace( data );
+
+		if ( not data.CreateTransient( *this, desc, queueFamilyMask, dbgName ))
+		{
+			_Unassign( id );
+			RETURN_ERR( "failed when creating transient buffer" );
+		}
+		
+		data.AddRef();
+		return id;
+	}
+	
+/*
+=================================================
+	CreateTransientMemory
+----
+	memory block that is shared between transient resources.
+=================================================
+*/
+	RawMemoryID  VResourceManager::CreateTransientMemory (const VkMemoryRequirements &memReq, StringView dbgName)
+	{
+		RawMemoryID					mem_id;
+		ResourceBase<VMemoryObj>*	mem_obj	= null;
+		CHECK_ERR( _CreateMemory( OUT mem_id, OUT mem_obj, MemoryDesc{ EMemoryType::Default | EMemoryType::AllowAliasing }, dbgName ));
+
+		if ( not mem_obj->Data().AllocateMemory( GetMemoryManager(), memReq ))
+		{
+			_Unassign( mem_id );
+			RETURN_ERR( "failed when allocating transient memory" );
+		}
+
+		mem_obj->AddRef();
+		return mem_id;
+	}
+	
+/*
+=================================================
+	BindTransientMemory
+=================================================
+*/
+	bool  VResourceManager::BindTransientMemory (RawImageID id, RawMemoryID memId, BytesU offset)
+	{
+		auto&	image	= _GetResourcePool( id )[ id.Index() ];
+		auto&	mem_obj	= _GetResourcePool( memId )[ memId.Index() ];
+		CHECK_ERR( image.IsCreated() and id.InstanceID() == image.GetInstanceID() );
+		CHECK_ERR( mem_obj.IsCreated() and memId.InstanceID() == mem_obj.GetInstanceID() );
+
+		CHECK_ERR( image.Data().BindMemory( *this, memId, mem_obj.Data(), offset ));
+
+		mem_obj.AddRef();
+		return true;
+	}
+	
+	bool  VResourceManager::BindTransientMemory (RawBufferID id, RawMemoryID memId, BytesU offset)
+	{
+		auto&	buffer	= _GetResourcePool( id )[ id.Index() ];
+		auto&	mem_obj	= _GetResourcePool( memId )[ memId.Index() ];
+		CHECK_ERR( buffer.IsCreated() and id.InstanceID() == buffer.GetInstanceID() );
+		CHECK_ERR( mem_obj.IsCreated() and memId.InstanceID() == mem_obj.GetInstanceID() );
+
+		CHECK_ERR( buffer.Data().BindMemory( *this, memId, mem_obj.Data(), offset ));
+
+		mem_obj.AddRef();
+		return true;
+	}
+
 /*
 =================================================
 	CreateImage
@@ -989,6 +1626,26 @@ namespace FG
 										[&] (auto& data) { return data.Create( _device, dbgName ); });
 	}
 	
+/*
+=================================================
+	CreateRenderPass
+----
+	recreate render pass from recorded pipeline permutations,
+	if create info is same then render pass from cache will be returned.
+=================================================
+*/
+	RawRenderPassID  VResourceManager::CreateRenderPass (const VkRenderPassCreateInfo &ci, StringView dbgName)
+	{
+		return _CreateCachedResource<RawRenderPassID>( "failed when creating render pass",
+										[&] (auto& data) { return Replace( data, ci ); },
+										[&] (auto& data) { return data.Create( _device, dbgName ); });
+	}
+	
+/*
+=================================================
+	CreateFramebuffer
+=================================================
+*/
 	RawFramebufferID  VResourceManager::CreateFramebuffer (ArrayView<Pair<RawImageID, ImageViewDesc>> attachments,
 																 RawRenderPassID rp, uint2 dim, uint layers, StringView dbgName)
 	{
@@ -1062,6 +1719,21 @@ namespace FG
 		return null;
 	}
 	
+/*
+=================================================
+	UpdateDescriptorSet
+----
+	writes descriptors that was deferred until memory is bound to the transient resources.
+=================================================
+*/
+	bool  VResourceManager::UpdateDescriptorSet (RawPipelineResourcesID id)
+	{
+		auto&	res = _GetResourcePool( id )[ id.Index() ];
+		CHECK_ERR( res.IsCreated() and id.InstanceID() == res.GetInstanceID() );
+
+		return res.Data().UpdateDeferred( *this );
+	}
+
 /*
 =================================================
 	CacheDescriptorSet
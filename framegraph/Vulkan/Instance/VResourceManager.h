@@ -8,11 +8,13 @@
 #include "stl/Memory/LinearAllocator.h"
 #include "stl/Containers/ChunkedIndexedPool.h"
 #include "stl/Containers/CachedIndexedPool.h"
+#include "stl/ThreadSafe/WorkerPool.h"
 #include "VBuffer.h"
 #include "VImage.h"
 #include "VSampler.h"
 #include "VMemoryObj.h"
 #include "VPipelineCache.h"
+#include "VPipelinePermutations.h"
 #include "VRenderPass.h"
 #include "VFramebuffer.h"
 #include "VPipelineResources.h"
@@ -50,6 +52,7 @@ namespace FG
 		static constexpr uint	MaxMemoryObjs	= 1u << 10;
 		static constexpr uint	MaxCached		= 1u << 9;
 		static constexpr uint	MaxRTObjects	= 1u << 9;
+		static constexpr uint	MaxCompileThreads	= 4;
 
 		using ImagePool_t			= PoolTmpl<			ResourceBase<VImage>,					MaxImages,		32 >;
 		using BufferPool_t			= PoolTmpl<			ResourceBase<VBuffer>,					MaxBuffers,		32 >;
@@ -114,6 +117,19 @@ namespace FG
 
 		std::atomic<uint>			_submissionCounter;
 
+		std::mutex					_pipelineCacheGuard;		// protects file name, cache object is internally synchronized
+		VkPipelineCache				_pipelineCache		= VK_NULL_HANDLE;	// shared between all command buffers
+		String						_pipelineCacheFile;
+
+		WorkerPool					_compileWorkers;		// shader compilation and pipeline creation in background
+		mutable std::mutex			_asyncPplnGuard;
+		std::condition_variable		_asyncPplnCV;			// signaled when asynchronous pipeline creation is complete
+		HashSet< Index_t >			_pendingGPipelines;		// graphics pipelines that are created on the worker threads
+		std::atomic<uint>			_pendingGPipelineCount	{0};	// size of '_pendingGPipelines', used to skip locking
+
+		std::mutex					_prewarmGuard;
+		Array< RawRenderPassID >	_prewarmRenderPasses;	// keeps render passes alive, pre-warmed pipeline instances are keyed by render pass ID
+
 		DebugLayoutCache_t			_debugDSLayoutsCache;
 
 		// cached resources validation
@@ -147,10 +163,19 @@ namespace FG
 		void AddCompiler (const PipelineCompiler &comp);
 		void OnSubmit ();
 
+		bool LoadPipelineCache (StringView filename);
+		bool SavePipelineCache ();
+
+		bool SavePipelinePermutations (StringView filename);
+		bool PrewarmPipelines (StringView filename);
+
 		ND_ RawMPipelineID		CreatePipeline (INOUT MeshPipelineDesc &desc, StringView dbgName);
 		ND_ RawGPipelineID		CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName);
 		ND_ RawCPipelineID		CreatePipeline (INOUT ComputePipelineDesc &desc, StringView dbgName);
 		ND_ RawRTPipelineID		CreatePipeline (INOUT RayTracingPipelineDesc &desc);
+
+		ND_ RawGPipelineID		CreatePipelineAsync (const GraphicsPipelineDesc &desc, StringView dbgName);
+		ND_ bool				IsPipelineReady (RawGPipelineID id) const;
 		
 		ND_ RawImageID			CreateImage (const ImageDesc &desc, const MemoryDesc &mem, EQueueFamilyMask queueFamilyMask, VkImageLayout defaultLayout, StringView dbgName);
 		ND_ RawBufferID			CreateBuffer (const BufferDesc &desc, const MemoryDesc &mem, EQueueFamilyMask queueFamilyMask, StringView dbgName);
@@ -158,12 +183,20 @@ namespace FG
 		
 		ND_ RawImageID			CreateImage (const VulkanImageDesc &desc, IFrameGraph::OnExternalImageReleased_t &&onRelease, StringView dbgName);
 		ND_ RawBufferID			CreateBuffer (const VulkanBufferDesc &desc, IFrameGraph::OnExternalBufferReleased_t &&onRelease, StringView dbgName);
+		
+		ND_ RawImageID			CreateTransientImage (const ImageDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName);
+		ND_ RawBufferID			CreateTransientBuffer (const BufferDesc &desc, EQueueFamilyMask queueFamilyMask, StringView dbgName);
+		ND_ RawMemoryID			CreateTransientMemory (const VkMemoryRequirements &memReq, StringView dbgName);
+			bool				BindTransientMemory (RawImageID id, RawMemoryID memId, BytesU offset);
+			bool				BindTransientMemory (RawBufferID id, RawMemoryID memId, BytesU offset);
 
 		ND_ RawRenderPassID		CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses, StringView dbgName);
+		ND_ RawRenderPassID		CreateRenderPass (const VkRenderPassCreateInfo &ci, StringView dbgName);
 		ND_ RawFramebufferID	CreateFramebuffer (ArrayView<Pair<RawImageID, ImageViewDesc>> attachments, RawRenderPassID rp, uint2 dim, uint layers, StringView dbgName);
 
 		ND_ VPipelineResources const*	CreateDescriptorSet (const PipelineResources &desc, VCmdBatch::ResourceMap_t &);
 			bool						CacheDescriptorSet (INOUT PipelineResources &desc);
+			bool						UpdateDescriptorSet (RawPipelineResourcesID id);
 		
 		ND_ RawRTGeometryID		CreateRayTracingGeometry (const RayTracingGeometryDesc &desc, const MemoryDesc &mem, StringView dbgName);
 		ND_ RawRTSceneID		CreateRayTracingScene (const RayTracingSceneDesc &desc, const MemoryDesc &mem, StringView dbgName);
@@ -181,6 +214,7 @@ namespace FG
 		template <typename ID>
 		void ReleaseResource (ID id, uint refCount = 1);
 		void ReleaseResource (INOUT PipelineResources &desc);
+		void ReleaseResource (RawGPipelineID id, uint refCount = 1);
 		
 		template <typename ID>
 		bool AcquireResource (ID id);
@@ -197,6 +231,7 @@ namespace FG
 		ND_ VDevice const&		GetDevice ()				const	{ return _device; }
 		ND_ VMemoryManager&		GetMemoryManager ()					{ return _memoryMngr; }
 		ND_ VDescriptorManager&	GetDescriptorManager ()				{ return _descMngr; }
+		ND_ VkPipelineCache		GetVkPipelineCache ()		const	{ return _pipelineCache; }
 		
 		ND_ uint				GetSubmitIndex ()			const	{ return _submissionCounter.load( memory_order_relaxed ); }
 		
@@ -227,6 +262,14 @@ namespace FG
 		bool  _CompileShader (INOUT ComputePipelineDesc &desc, const VDevice &dev);
 		bool  _CompileSPIRVShader (const VDevice &dev, const PipelineDescription::ShaderDataUnion_t &shaderData, OUT VkShaderPtr &module);
 
+		void  _CreatePipelineAsync (RawGPipelineID id, INOUT GraphicsPipelineDesc &desc, StringView dbgName);
+		void  _WaitPipeline (RawGPipelineID id);
+		ND_ bool  _IsPipelinePending (RawGPipelineID id) const;
+
+		bool  _CreatePipelineCache (ArrayView<uint8_t> initialData, OUT VkPipelineCache &cache) const;
+		bool  _IsCompatiblePipelineCache (ArrayView<uint8_t> data) const;
+		bool  _SavePipelineCache ();
+
 		template <typename DataT, size_t CS, size_t MC>
 		void  _DestroyResourceCache (INOUT CachedPoolTmpl<DataT,CS,MC> &pool);
 		
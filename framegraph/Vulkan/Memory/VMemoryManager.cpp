@@ -137,6 +137,34 @@ namespace FG
 		RETURN_ERR( "unsupported memory type" );
 	}
 
+/*
+=================================================
+	AllocateMemory
+----
+	allocates memory without binding,
+	used for transient resources that share the same memory.
+=================================================
+*/
+	bool VMemoryManager::AllocateMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data)
+	{
+		SHAREDLOCK( _drCheck );
+		ASSERT( not _allocators.empty() );
+
+		for (size_t i = 0; i < _allocators.size(); ++i)
+		{
+			auto&	alloc = _allocators[i];
+
+			if ( alloc->IsSupported( desc.type ) )
+			{
+				CHECK_ERR( alloc->AllocForMemory( memReq, desc, OUT data ));
+				
+				*data.Cast<uint>() = uint(i);
+				return true;
+			}
+		}
+		RETURN_ERR( "unsupported memory type" );
+	}
+
 /*
 =================================================
 	Deallocate
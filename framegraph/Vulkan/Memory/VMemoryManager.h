@@ -36,6 +36,7 @@ namespace FG
 			virtual bool AllocForImage (VkImage image, const MemoryDesc &desc, OUT Storage_t &data) = 0;
 			virtual bool AllocForBuffer (VkBuffer buffer, const MemoryDesc &desc, OUT Storage_t &data) = 0;
 			virtual bool AllocateForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data) = 0;
+			virtual bool AllocForMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data) = 0;
 
 			virtual bool Dealloc (INOUT Storage_t &data) = 0;
 			
@@ -65,6 +66,7 @@ namespace FG
 		virtual bool AllocateForImage (VkImage image, const MemoryDesc &desc, OUT Storage_t &data);
 		virtual bool AllocateForBuffer (VkBuffer buffer, const MemoryDesc &desc, OUT Storage_t &data);
 		virtual bool AllocateForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data);
+		virtual bool AllocateMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data);
 		virtual bool Deallocate (INOUT Storage_t &data);
 
 		virtual bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const;
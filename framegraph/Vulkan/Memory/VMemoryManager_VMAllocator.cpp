@@ -67,6 +67,7 @@ namespace FG
 		bool AllocForImage (VkImage image, const MemoryDesc &mem, OUT Storage_t &data) override;
 		bool AllocForBuffer (VkBuffer buffer, const MemoryDesc &mem, OUT Storage_t &data) override;
 		bool AllocateForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data) override;
+		bool AllocForMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data) override;
 
 		bool Dealloc (INOUT Storage_t &data) override;
 		
@@ -235,6 +236,29 @@ namespace FG
 		return true;
 	}
 
+/*
+=================================================
+	AllocForMemory
+=================================================
+*/
+	bool VMemoryManager::VulkanMemoryAllocator::AllocForMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data)
+	{
+		VmaAllocationCreateInfo		info = {};
+		info.flags			= _ConvertToMemoryFlags( desc.type );
+		info.usage			= _ConvertToMemoryUsage( desc.type );
+		info.requiredFlags	= _ConvertToMemoryProperties( desc.type );
+		info.preferredFlags	= 0;
+		info.memoryTypeBits	= 0;
+		info.pool			= VK_NULL_HANDLE;
+		info.pUserData		= null;
+
+		VmaAllocation	mem = null;
+		VK_CHECK( vmaAllocateMemory( _allocator, &memReq, &info, OUT &mem, null ));
+		
+		_CastStorage( data )->allocation = mem;
+		return true;
+	}
+
 /*
 =================================================
 	Dealloc
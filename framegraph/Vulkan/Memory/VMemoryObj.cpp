@@ -70,6 +70,19 @@ namespace FG
 		return true;
 	}
 
+/*
+=================================================
+	AllocateMemory
+=================================================
+*/
+	bool VMemoryObj::AllocateMemory (VMemoryManager &memMngr, const VkMemoryRequirements &memReq)
+	{
+		EXLOCK( _drCheck );
+		
+		CHECK_ERR( memMngr.AllocateMemory( memReq, _desc, INOUT _storage ));
+		return true;
+	}
+
 /*
 =================================================
 	Destroy
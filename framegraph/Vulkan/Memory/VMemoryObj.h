@@ -50,6 +50,7 @@ namespace FG
 		bool AllocateForImage (VMemoryManager &, VkImage);
 		bool AllocateForBuffer (VMemoryManager &, VkBuffer);
 		bool AllocateForAccelStruct (VMemoryManager &, VkAccelerationStructureNV);
+		bool AllocateMemory (VMemoryManager &, const VkMemoryRequirements &);
 
 		bool GetInfo (VMemoryManager &, OUT MemoryInfo &) const;
 
@@ -73,7 +73,7 @@ namespace FG
 	Create
 =================================================
 */
-	bool VGraphicsPipeline::Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, StringView dbgName)
+	bool VGraphicsPipeline::Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, HashVal sourceHash, StringView dbgName)
 	{
 		EXLOCK( _drCheck );
 		
@@ -96,6 +96,7 @@ namespace FG
 		_vertexAttribs		= desc._vertexAttribs;
 		_patchControlPoints	= desc._patchControlPoints;
 		_earlyFragmentTests	= desc._earlyFragmentTests;
+		_sourceHash			= sourceHash;
 		_debugName			= dbgName;
 		
 		return true;
@@ -130,6 +131,34 @@ namespace FG
 		_supportedTopology	= Default;
 		_patchControlPoints	= 0;
 		_earlyFragmentTests	= false;
+		_sourceHash			= Default;
+	}
+
+/*
+=================================================
+	GetInstanceKeys
+=================================================
+*/
+	void VGraphicsPipeline::GetInstanceKeys (OUT Array<InstanceKey> &keys) const
+	{
+		SHAREDLOCK( _drCheck );
+		SHAREDLOCK( _instanceGuard );
+
+		keys.reserve( keys.size() + _instances.size() );
+
+		for (auto& inst : _instances)
+		{
+			if ( inst.first.debugMode != 0 )
+				continue;
+
+			auto&	key = keys.emplace_back();
+			key.renderPassId	= inst.first.renderPassId;
+			key.renderState		= inst.first.renderState;
+			key.vertexInput		= inst.first.vertexInput;
+			key.dynamicState	= inst.first.dynamicState;
+			key.subpassIndex	= inst.first.subpassIndex;
+			key.viewportCount	= inst.first.viewportCount;
+		}
 	}
 
 
@@ -24,6 +24,17 @@ namespace FG
 			EShaderDebugMode					debugMode	= Default;
 		};
 
+		// key of pipeline instance without shader debugging, used to record pipeline permutations
+		struct InstanceKey
+		{
+			RawRenderPassID				renderPassId;
+			RenderState					renderState;
+			VertexInputState			vertexInput;
+			EPipelineDynamicState		dynamicState	= Default;
+			uint						subpassIndex	= 0;
+			uint						viewportCount	= 0;
+		};
+
 
 	private:
 		struct PipelineInstance
@@ -71,6 +82,7 @@ namespace FG
 		VertexAttribs_t				_vertexAttribs;
 		uint						_patchControlPoints		= 0;
 		bool						_earlyFragmentTests		= true;
+		HashVal						_sourceHash;			// hash of shader sources, it is same between application launches
 		
 		DebugName_t					_debugName;
 		
@@ -83,13 +95,16 @@ namespace FG
 		VGraphicsPipeline (VGraphicsPipeline &&) = default;
 		~VGraphicsPipeline ();
 
-		bool Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, StringView dbgName);
+		bool Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, HashVal sourceHash, StringView dbgName);
 		void Destroy (VResourceManager &);
+
+		void GetInstanceKeys (OUT Array<InstanceKey> &keys) const;
 		
 		ND_ RawPipelineLayoutID		GetLayoutID ()			const	{ SHAREDLOCK( _drCheck );  return _baseLayoutId.Get(); }
 		ND_ ArrayView<VertexAttrib>	GetVertexAttribs ()		const	{ SHAREDLOCK( _drCheck );  return _vertexAttribs; }
 
 		ND_ bool					IsEarlyFragmentTests ()	const	{ SHAREDLOCK( _drCheck );  return _earlyFragmentTests; }
+		ND_ HashVal					GetSourceHash ()		const	{ SHAREDLOCK( _drCheck );  return _sourceHash; }
 		
 		ND_ StringView				GetDebugName ()			const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 	};
@@ -9,14 +9,58 @@
 
 namespace FG
 {
+namespace {
+	
+	//
+	// Pipeline Creation Feedback
+	//
+	struct PipelineCreationFeedback
+	{
+	#ifdef VK_EXT_pipeline_creation_feedback
+		static constexpr uint	MaxStages	= 8;
+
+		VkPipelineCreationFeedbackCreateInfoEXT					info		{};
+		VkPipelineCreationFeedbackEXT							feedback	{};
+		StaticArray< VkPipelineCreationFeedbackEXT, MaxStages >	stages		{};
+
+		template <typename PipelineInfo>
+		void  Attach (const VDevice &dev, INOUT PipelineInfo &pipelineInfo, uint stageCount)
+		{
+			if ( not dev.IsCreationFeedbackEnabled() or stageCount > MaxStages )
+				return;
+
+			info.sType								= VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+			info.pNext								= pipelineInfo.pNext;
+			info.pPipelineCreationFeedback			= &feedback;
+			info.pipelineStageCreationFeedbackCount	= stageCount;
+			info.pPipelineStageCreationFeedbacks	= stages.data();
+			pipelineInfo.pNext						= &info;
+		}
+
+		ND_ bool  IsCacheHit () const
+		{
+			const VkPipelineCreationFeedbackFlagsEXT	mask = VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT | VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT;
+			return (feedback.flags & mask) == mask;
+		}
+
+	#else
+		template <typename PipelineInfo>
+		void  Attach (const VDevice &, PipelineInfo &, uint)	{}
+
+		ND_ bool  IsCacheHit () const							{ return false; }
+	#endif
+	};
+
+}	// namespace
+//-----------------------------------------------------------------------------
+
 
 /*
 =================================================
 	constructor
 =================================================
 */
-	VPipelineCache::VPipelineCache () :
-		_pipelinesCache{ VK_NULL_HANDLE }
+	VPipelineCache::VPipelineCache ()
 	{
 		const uint	max_stages = 32;
 
@@ -34,63 +78,6 @@ namespace FG
 */
 	VPipelineCache::~VPipelineCache ()
 	{
-		CHECK( _pipelinesCache == VK_NULL_HANDLE );
-	}
-	
-/*
-=================================================
-	Initialize
-=================================================
-*/
-	bool VPipelineCache::Initialize (const VDevice &dev)
-	{
-		CHECK_ERR( _CreatePipelineCache( dev ));
-		return true;
-	}
-	
-/*
-=================================================
-	Deinitialize
-=================================================
-*/
-	void VPipelineCache::Deinitialize (const VDevice &dev)
-	{
-		if ( _pipelinesCache )
-		{
-			dev.vkDestroyPipelineCache( dev.GetVkDevice(), _pipelinesCache, null );
-			_pipelinesCache = VK_NULL_HANDLE;
-		}
-	}
-
-/*
-=================================================
-	MergeCache
-=================================================
-*/
-	bool VPipelineCache::MergeCache (VPipelineCache &)
-	{
-		// TODO
-		return false;
-	}
-	
-/*
-=================================================
-	_CreatePipelineCache
-=================================================
-*/
-	bool  VPipelineCache::_CreatePipelineCache (const VDevice &dev)
-	{
-		CHECK_ERR( not _pipelinesCache );
-
-		VkPipelineCacheCreateInfo	info = {};
-		info.sType				= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-		info.pNext				= null;
-		info.flags				= 0;
-		info.initialDataSize	= 0;
-		info.pInitialData		= null;
-
-		VK_CHECK( dev.vkCreatePipelineCache( dev.GetVkDevice(), &info, null, OUT &_pipelinesCache ));
-		return true;
 	}
 
 /*
@@ -210,6 +197,75 @@ namespace FG
 		
 		outLayout = fgThread.AcquireTemporary( layout_id );
 
+		return _FindOrCreateInstance( fgThread.GetResourceManager(), gppln, *render_pass, *outLayout, dbg_mode, dbg_stages,
+									  INOUT inst, OUT outPipeline, INOUT fgThread.EditStatistic().resources );
+	}
+	
+/*
+=================================================
+	PrewarmPipelineInstance
+----
+	creates pipeline instance without command buffer,
+	shader debugging is not supported.
+=================================================
+*/
+	bool  VPipelineCache::PrewarmPipelineInstance (VResourceManager				&resMngr,
+												   const VGraphicsPipeline		&gppln,
+												   RawRenderPassID				 renderPassId,
+												   uint							 subpassIndex,
+												   uint							 viewportCount,
+												   const VertexInputState		&vertexInput,
+												   const RenderState			&renderState,
+												   const EPipelineDynamicState	 dynamicStates,
+												   INOUT ResourceStatistic_t	&stat)
+	{
+		VDevice const&			dev			= resMngr.GetDevice();
+		VRenderPass const*		render_pass	= resMngr.GetResource( renderPassId, false, true );
+		RawPipelineLayoutID		layout_id	= gppln.GetLayoutID();
+		VPipelineLayout const*	layout		= resMngr.GetResource( layout_id, false, true );
+
+		CHECK_ERR( render_pass and layout );
+		CHECK_ERR( subpassIndex < render_pass->GetCreateInfo().subpassCount );
+		CHECK_ERR(	uint(renderState.inputAssembly.topology) < gppln._supportedTopology.size() and
+					gppln._supportedTopology[uint(renderState.inputAssembly.topology)] );
+
+		GPipelineInstance_t		inst;
+		inst.layoutId		= layout_id;
+		inst.dynamicState	= dynamicStates;
+		inst.renderPassId	= renderPassId;
+		inst.subpassIndex	= uint8_t(subpassIndex);
+		inst.vertexInput	= vertexInput;
+		inst.viewportCount	= uint8_t(viewportCount);
+		inst.debugMode		= GetDebugModeHash( Default, Default );
+		inst.renderState	= renderState;
+
+		inst.vertexInput.ApplyAttribs( gppln.GetVertexAttribs() );
+		_ValidateRenderState( dev, INOUT inst.renderState, INOUT inst.dynamicState );
+
+		inst.UpdateHash();
+
+		VkPipeline	ppln = VK_NULL_HANDLE;
+		return _FindOrCreateInstance( resMngr, gppln, *render_pass, *layout, Default, Default, INOUT inst, OUT ppln, INOUT stat );
+	}
+	
+/*
+=================================================
+	_FindOrCreateInstance
+=================================================
+*/
+	bool  VPipelineCache::_FindOrCreateInstance (VResourceManager				&resMngr,
+												 const VGraphicsPipeline		&gppln,
+												 const VRenderPass				&renderPass,
+												 const VPipelineLayout			&layout,
+												 EShaderDebugMode				 dbgMode,
+												 EShaderStages					 dbgStages,
+												 INOUT GPipelineInstance_t		&inst,
+												 OUT VkPipeline					&outPipeline,
+												 INOUT ResourceStatistic_t		&stat)
+	{
+		VDevice const&				dev			= resMngr.GetDevice();
+		const RawPipelineLayoutID	layout_id	= inst.layoutId;
+
 		// find existing instance
 		{
 			SHAREDLOCK( gppln._instanceGuard );
@@ -236,9 +292,9 @@ namespace FG
 		VkPipelineVertexInputStateCreateInfo	vertex_input_info	= {};
 		VkPipelineViewportStateCreateInfo		viewport_info		= {};
 
-		_SetShaderStages( OUT _tempStages, INOUT _tempSpecialization, INOUT _tempSpecEntries, gppln._shaders, dbg_mode, dbg_stages );
+		_SetShaderStages( OUT _tempStages, INOUT _tempSpecialization, INOUT _tempSpecEntries, gppln._shaders, dbgMode, dbgStages );
 		_SetDynamicState( OUT dynamic_state_info, OUT _tempDynamicStates, inst.dynamicState );
-		_SetColorBlendState( OUT blend_info, OUT _tempAttachments, inst.renderState.color, *render_pass, inst.subpassIndex );
+		_SetColorBlendState( OUT blend_info, OUT _tempAttachments, inst.renderState.color, renderPass, inst.subpassIndex );
 		_SetMultisampleState( OUT multisample_info, inst.renderState.multisample );
 		_SetTessellationState( OUT tessellation_info, gppln._patchControlPoints );
 		_SetDepthStencilState( OUT depth_stencil_info, inst.renderState.depth, inst.renderState.stencil );
@@ -261,10 +317,10 @@ namespace FG
 		pipeline_info.pDynamicState			= (_tempDynamicStates.empty() ? null : &dynamic_state_info);
 		pipeline_info.basePipelineIndex		= -1;
 		pipeline_info.basePipelineHandle	= VK_NULL_HANDLE;
-		pipeline_info.layout				= outLayout->Handle();
+		pipeline_info.layout				= layout.Handle();
 		pipeline_info.stageCount			= uint(_tempStages.size());
 		pipeline_info.pStages				= _tempStages.data();
-		pipeline_info.renderPass			= render_pass->Handle();
+		pipeline_info.renderPass			= renderPass.Handle();
 		pipeline_info.subpass				= inst.subpassIndex;
 		
 		if ( not rasterization_info.rasterizerDiscardEnable )
@@ -277,10 +333,14 @@ namespace FG
 			pipeline_info.pColorBlendState		= null;
 		}
 
+		PipelineCreationFeedback	feedback;
+		feedback.Attach( dev, INOUT pipeline_info, pipeline_info.stageCount );
+
 		outPipeline = {};
-		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
+		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), resMngr.GetVkPipelineCache(), 1, &pipeline_info, null, OUT &outPipeline ));
 
-		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
+		stat.newGraphicsPipelineCount++;
+		stat.pipelineCacheHits += uint(feedback.IsCacheHit());
 		
 		// try to insert new instance
 		{
@@ -297,7 +357,7 @@ namespace FG
 			}
 		}
 		
-		CHECK( fgThread.GetResourceManager().AcquireResource( layout_id ));
+		CHECK( resMngr.AcquireResource( layout_id ));
 		return true;
 	}
 /*
@@ -409,10 +469,14 @@ namespace FG
 			pipeline_info.pColorBlendState		= null;
 		}
 
+		PipelineCreationFeedback	feedback;
+		feedback.Attach( dev, INOUT pipeline_info, pipeline_info.stageCount );
+
 		outPipeline = {};
-		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
+		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), fgThread.GetResourceManager().GetVkPipelineCache(), 1, &pipeline_info, null, OUT &outPipeline ));
 		
 		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
+		fgThread.EditStatistic().resources.pipelineCacheHits += uint(feedback.IsCacheHit());
 		
 		// try to insert new instance
 		{
@@ -516,10 +580,14 @@ namespace FG
 			pipeline_info.stage.pSpecializationInfo	= &spec;
 		}
 
+		PipelineCreationFeedback	feedback;
+		feedback.Attach( dev, INOUT pipeline_info, 1 );
+
 		outPipeline = {};
-		VK_CHECK( dev.vkCreateComputePipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
+		VK_CHECK( dev.vkCreateComputePipelines( dev.GetVkDevice(), fgThread.GetResourceManager().GetVkPipelineCache(), 1, &pipeline_info, null, OUT &outPipeline ));
 		
 		fgThread.EditStatistic().resources.newComputePipelineCount++;
+		fgThread.EditStatistic().resources.pipelineCacheHits += uint(feedback.IsCacheHit());
 		
 		// try to insert new instance
 		{
@@ -704,7 +772,7 @@ namespace FG
 			pipeline_info.basePipelineIndex		= -1;
 			pipeline_info.basePipelineHandle	= VK_NULL_HANDLE;
 
-			VK_CHECK( dev.vkCreateRayTracingPipelinesNV( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &table.pipeline ));
+			VK_CHECK( dev.vkCreateRayTracingPipelinesNV( dev.GetVkDevice(), fgThread.GetResourceManager().GetVkPipelineCache(), 1, &pipeline_info, null, OUT &table.pipeline ));
 			fgThread.EditStatistic().resources.newRayTracingPipelineCount++;
 			
 			CHECK( res_mngr.AcquireResource( layout_id ));
@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "framegraph/Public/FrameGraphTask.h"
+#include "framegraph/Public/FrameGraph.h"
 #include "VDescriptorSetLayout.h"
 #include "VPipelineLayout.h"
 #include "VGraphicsPipeline.h"
@@ -58,6 +58,8 @@ namespace FG
 		using RTShaderSpecializations_t	= FixedArray< RTShaderSpec, 32 >;
 		
 		using ShaderModule_t			= VGraphicsPipeline::ShaderModule;
+		using GPipelineInstance_t		= VGraphicsPipeline::PipelineInstance;
+		using ResourceStatistic_t		= IFrameGraph::ResourceStatistics;
 
 	public:
 		struct BufferCopyRegion
@@ -71,8 +73,6 @@ namespace FG
 
 	// variables
 	private:
-		VkPipelineCache				_pipelinesCache;
-
 		// temporary arrays
 		ShaderStages_t				_tempStages;			// TODO: use custom allocator?
 		Specializations_t			_tempSpecialization;
@@ -93,11 +93,6 @@ namespace FG
 	public:
 		VPipelineCache ();
 		~VPipelineCache ();
-		
-		bool Initialize (const VDevice &dev);
-		void Deinitialize (const VDevice &dev);
-
-		bool MergeCache (VPipelineCache &);
 
 		bool CreatePipelineInstance (VCommandBuffer					&fgThread,
 									 const VLogicalRenderPass		&logicalRP,
@@ -109,6 +104,16 @@ namespace FG
 									 OUT VkPipeline					&outPipeline,
 									 OUT VPipelineLayout const*		&outLayout);
 		
+		bool PrewarmPipelineInstance (VResourceManager				&resMngr,
+									  const VGraphicsPipeline		&gpipeline,
+									  RawRenderPassID				 renderPassId,
+									  uint							 subpassIndex,
+									  uint							 viewportCount,
+									  const VertexInputState		&vertexInput,
+									  const RenderState				&renderState,
+									  const EPipelineDynamicState	 dynamicStates,
+									  INOUT ResourceStatistic_t		&stat);
+
 		bool CreatePipelineInstance (VCommandBuffer					&fgThread,
 									 const VLogicalRenderPass		&logicalRP,
 									 const VMeshPipeline			&mpipeline,
@@ -137,7 +142,15 @@ namespace FG
 
 
 	private:
-		bool _CreatePipelineCache (const VDevice &dev);
+		bool _FindOrCreateInstance (VResourceManager			&resMngr,
+									const VGraphicsPipeline		&gpipeline,
+									const VRenderPass			&renderPass,
+									const VPipelineLayout		&layout,
+									EShaderDebugMode			 dbgMode,
+									EShaderStages				 dbgStages,
+									INOUT GPipelineInstance_t	&inst,
+									OUT VkPipeline				&outPipeline,
+									INOUT ResourceStatistic_t	&stat);
 
 		template <typename Pipeline>
 		bool _SetupShaderDebugging (VCommandBuffer &fgThread, const Pipeline &ppln, ShaderDbgIndex debugModeIndex,
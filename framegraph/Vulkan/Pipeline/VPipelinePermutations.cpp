@@ -0,0 +1,341 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VPipelinePermutations.h"
+
+namespace FG
+{
+namespace
+{
+	static constexpr uint	PermutationsMagic	= 0x46475050;	// 'FGPP'
+	static constexpr uint	PermutationsVersion	= 1;
+	static constexpr uint	MaxRenderPasses		= 1u << 12;
+	static constexpr uint	MaxPermutations		= 1u << 20;
+
+	// minimal size of serialized data, used to detect truncated or corrupted file before allocation
+	static constexpr BytesU	MinRenderPassSize	= SizeOf<VkRenderPassCreateFlags> + SizeOf<uint> * 3 +							// flags, attachments, dependencies, subpass count
+												  SizeOf<VkSubpassDescriptionFlags> + SizeOf<VkPipelineBindPoint> + SizeOf<uint> * 5;	// single subpass
+	static constexpr BytesU	MinPermutationSize	= SizeOf<size_t> + SizeOf<uint> * 3 + SizeOf<EPipelineDynamicState> + SizeOf<RenderState> +
+												  SizeOf<uint> * 2;																// bindings and vertices count
+
+	struct FileHeader
+	{
+		uint	magic;
+		uint	version;
+		uint	renderStateSize;
+		uint	vertexIdSize;
+		uint	bufferIdSize;
+		uint	renderPassCount;
+		uint	permutationCount;
+	};
+
+	STATIC_ASSERT( std::is_trivially_copyable_v< RenderState >);
+	STATIC_ASSERT( std::is_trivially_copyable_v< VertexID >);
+	STATIC_ASSERT( std::is_trivially_copyable_v< VertexBufferID >);
+
+/*
+=================================================
+	WriteRaw / ReadRaw
+----
+	for trivially copyable types that are not POD
+=================================================
+*/
+	template <typename T>
+	ND_ inline bool  WriteRaw (WStream &stream, const T &value)
+	{
+		STATIC_ASSERT( std::is_trivially_copyable_v<T> );
+		return stream.Write( &value, BytesU::SizeOf(value) );
+	}
+
+	template <typename T>
+	ND_ inline bool  ReadRaw (RStream &stream, OUT T &value)
+	{
+		STATIC_ASSERT( std::is_trivially_copyable_v<T> );
+		return stream.Read( OUT &value, BytesU::SizeOf(value) );
+	}
+
+	template <typename T>
+	ND_ inline bool  WriteArray (WStream &stream, const T *ptr, uint count)
+	{
+		CHECK_ERR( stream.Write( count ));
+		return count == 0 or stream.Write( ptr, BytesU::SizeOf(*ptr) * count );
+	}
+
+	template <typename T>
+	ND_ inline bool  ReadArray (RStream &stream, uint maxCount, OUT Array<T> &arr)
+	{
+		uint	count = 0;
+		CHECK_ERR( stream.Read( OUT count ));
+		CHECK_ERR( count <= maxCount );
+
+		arr.clear();
+		return count == 0 or stream.Read( count, OUT arr );
+	}
+}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	GetVertexInput
+=================================================
+*/
+	bool  VPipelinePermutations::GraphicsPermutation::GetVertexInput (OUT VertexInputState &result) const
+	{
+		result.Clear();
+
+		for (auto& bind : bindings) {
+			result.Bind( bind.id, Bytes<uint>{bind.stride}, bind.index, bind.rate );
+		}
+
+		for (auto& attr : vertices)
+		{
+			auto	iter = std::find_if( bindings.begin(), bindings.end(), [&attr] (auto& b) { return b.index == attr.bufferBinding; });
+			CHECK_ERR( iter != bindings.end() );
+
+			result.Add( attr.id, attr.type, BytesU{attr.offset}, iter->id );
+		}
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	Add
+=================================================
+*/
+	void  VPipelinePermutations::Add (HashVal sourceHash, const VGraphicsPipeline::InstanceKey &key, const VRenderPass &renderPass)
+	{
+		auto	rp_iter = _renderPassMap.find( key.renderPassId );
+
+		if ( rp_iter == _renderPassMap.end() )
+		{
+			rp_iter = _renderPassMap.insert({ key.renderPassId, uint(_renderPasses.size()) }).first;
+			_renderPasses.push_back( UniquePtr<VRenderPass>{ new VRenderPass{ renderPass.GetCreateInfo() }});
+		}
+
+		auto&	perm = _permutations.emplace_back();
+		perm.sourceHash			= sourceHash;
+		perm.renderPassIndex	= rp_iter->second;
+		perm.subpassIndex		= key.subpassIndex;
+		perm.viewportCount		= key.viewportCount;
+		perm.dynamicState		= key.dynamicState;
+		perm.renderState		= key.renderState;
+
+		for (auto& bind : key.vertexInput.BufferBindings()) {
+			perm.bindings.push_back({ bind.first, bind.second.index, uint(bind.second.stride), bind.second.rate });
+		}
+
+		for (auto& attr : key.vertexInput.Vertices()) {
+			perm.vertices.push_back({ attr.first, attr.second.type, uint(attr.second.offset), attr.second.bufferBinding });
+		}
+	}
+
+/*
+=================================================
+	Save
+=================================================
+*/
+	bool  VPipelinePermutations::Save (WStream &stream) const
+	{
+		CHECK_ERR( stream.IsOpen() );
+
+		FileHeader	header;
+		header.magic			= PermutationsMagic;
+		header.version			= PermutationsVersion;
+		header.renderStateSize	= uint(sizeof(RenderState));
+		header.vertexIdSize		= uint(sizeof(VertexID));
+		header.bufferIdSize		= uint(sizeof(VertexBufferID));
+		header.renderPassCount	= uint(_renderPasses.size());
+		header.permutationCount	= uint(_permutations.size());
+
+		CHECK_ERR( stream.Write( header ));
+
+		for (auto& rp : _renderPasses) {
+			CHECK_ERR( _WriteRenderPass( stream, rp->GetCreateInfo() ));
+		}
+
+		for (auto& perm : _permutations)
+		{
+			CHECK_ERR( stream.Write( size_t(perm.sourceHash) ));
+			CHECK_ERR( stream.Write( perm.renderPassIndex ));
+			CHECK_ERR( stream.Write( perm.subpassIndex ));
+			CHECK_ERR( stream.Write( perm.viewportCount ));
+			CHECK_ERR( stream.Write( perm.dynamicState ));
+			CHECK_ERR( WriteRaw( stream, perm.renderState ));
+
+			CHECK_ERR( stream.Write( uint(perm.bindings.size()) ));
+			for (auto& bind : perm.bindings) {
+				CHECK_ERR( WriteRaw( stream, bind ));
+			}
+
+			CHECK_ERR( stream.Write( uint(perm.vertices.size()) ));
+			for (auto& attr : perm.vertices) {
+				CHECK_ERR( WriteRaw( stream, attr ));
+			}
+		}
+		return true;
+	}
+
+/*
+=================================================
+	Load
+----
+	returns false if file is corrupted or created by another build.
+=================================================
+*/
+	bool  VPipelinePermutations::Load (RStream &stream)
+	{
+		CHECK_ERR( stream.IsOpen() );
+
+		_renderPasses.clear();
+		_renderPassMap.clear();
+		_permutations.clear();
+
+		FileHeader	header;
+		CHECK_ERR( stream.Read( OUT header ));
+
+		if ( header.magic			!= PermutationsMagic		or
+			 header.version			!= PermutationsVersion		or
+			 header.renderStateSize	!= sizeof(RenderState)		or
+			 header.vertexIdSize	!= sizeof(VertexID)			or
+			 header.bufferIdSize	!= sizeof(VertexBufferID) )
+		{
+			RETURN_ERR( "pipeline permutations are created by another build" );
+		}
+
+		CHECK_ERR( header.renderPassCount <= MaxRenderPasses and header.permutationCount <= MaxPermutations );
+		CHECK_ERR( MinRenderPassSize * header.renderPassCount + MinPermutationSize * header.permutationCount <= stream.RemainingSize() );
+
+		_renderPasses.resize( header.renderPassCount );
+		for (auto& rp : _renderPasses) {
+			CHECK_ERR( _ReadRenderPass( stream, OUT rp ));
+		}
+
+		_permutations.resize( header.permutationCount );
+		for (auto& perm : _permutations)
+		{
+			size_t	hash = 0;
+			uint	count;
+			CHECK_ERR( stream.Read( OUT hash ));
+			CHECK_ERR( stream.Read( OUT perm.renderPassIndex ));
+			CHECK_ERR( stream.Read( OUT perm.subpassIndex ));
+			CHECK_ERR( stream.Read( OUT perm.viewportCount ));
+			CHECK_ERR( stream.Read( OUT perm.dynamicState ));
+			CHECK_ERR( ReadRaw( stream, OUT perm.renderState ));
+
+			perm.sourceHash = HashVal{hash};
+			CHECK_ERR( perm.renderPassIndex < _renderPasses.size() );
+			CHECK_ERR( perm.subpassIndex < _renderPasses[perm.renderPassIndex]->GetCreateInfo().subpassCount );
+
+			CHECK_ERR( stream.Read( OUT count ) and count <= FG_MaxVertexBuffers );
+			perm.bindings.resize( count );
+			for (auto& bind : perm.bindings) {
+				CHECK_ERR( ReadRaw( stream, OUT bind ));
+			}
+
+			CHECK_ERR( stream.Read( OUT count ) and count <= FG_MaxVertexAttribs );
+			perm.vertices.resize( count );
+			for (auto& attr : perm.vertices) {
+				CHECK_ERR( ReadRaw( stream, OUT attr ));
+			}
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_WriteRenderPass
+=================================================
+*/
+	bool  VPipelinePermutations::_WriteRenderPass (WStream &stream, const VkRenderPassCreateInfo &ci)
+	{
+		CHECK_ERR( stream.Write( ci.flags ));
+		CHECK_ERR( WriteArray( stream, ci.pAttachments, ci.attachmentCount ));
+		CHECK_ERR( WriteArray( stream, ci.pDependencies, ci.dependencyCount ));
+		CHECK_ERR( stream.Write( ci.subpassCount ));
+
+		for (uint i = 0; i < ci.subpassCount; ++i)
+		{
+			auto&	sp = ci.pSubpasses[i];
+
+			CHECK_ERR( stream.Write( sp.flags ));
+			CHECK_ERR( stream.Write( sp.pipelineBindPoint ));
+			CHECK_ERR( WriteArray( stream, sp.pInputAttachments, sp.inputAttachmentCount ));
+			CHECK_ERR( WriteArray( stream, sp.pColorAttachments, sp.colorAttachmentCount ));
+			CHECK_ERR( WriteArray( stream, sp.pResolveAttachments, sp.pResolveAttachments ? sp.colorAttachmentCount : 0 ));
+			CHECK_ERR( WriteArray( stream, sp.pDepthStencilAttachment, sp.pDepthStencilAttachment ? 1 : 0 ));
+			CHECK_ERR( WriteArray( stream, sp.pPreserveAttachments, sp.preserveAttachmentCount ));
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_ReadRenderPass
+=================================================
+*/
+	bool  VPipelinePermutations::_ReadRenderPass (RStream &stream, OUT UniquePtr<VRenderPass> &result)
+	{
+		struct SubpassData
+		{
+			Array<VkAttachmentReference>	input, color, resolve, depth;
+			Array<uint>						preserve;
+		};
+
+		const uint	max_attachments	= FG_MaxColorBuffers + 1;
+
+		VkRenderPassCreateInfo					ci		= {};
+		Array<VkAttachmentDescription>			attachments;
+		Array<VkSubpassDependency>				dependencies;
+		Array<VkSubpassDescription>				subpasses;
+		StaticArray<SubpassData, FG_MaxRenderPassSubpasses>	sp_data;
+
+		CHECK_ERR( stream.Read( OUT ci.flags ));
+		CHECK_ERR( ReadArray( stream, max_attachments, OUT attachments ));
+		CHECK_ERR( ReadArray( stream, FG_MaxRenderPassSubpasses * 2, OUT dependencies ));
+		CHECK_ERR( stream.Read( OUT ci.subpassCount ));
+		CHECK_ERR( ci.subpassCount > 0 and ci.subpassCount <= FG_MaxRenderPassSubpasses );
+
+		subpasses.resize( ci.subpassCount );
+		for (uint i = 0; i < ci.subpassCount; ++i)
+		{
+			auto&	sp		= subpasses[i];
+			auto&	data	= sp_data[i];
+			sp = {};
+
+			CHECK_ERR( stream.Read( OUT sp.flags ));
+			CHECK_ERR( stream.Read( OUT sp.pipelineBindPoint ));
+			CHECK_ERR( ReadArray( stream, max_attachments, OUT data.input ));
+			CHECK_ERR( ReadArray( stream, FG_MaxColorBuffers, OUT data.color ));
+			CHECK_ERR( ReadArray( stream, FG_MaxColorBuffers, OUT data.resolve ));
+			CHECK_ERR( ReadArray( stream, 1, OUT data.depth ));
+			CHECK_ERR( ReadArray( stream, max_attachments, OUT data.preserve ));
+			CHECK_ERR( data.resolve.empty() or data.resolve.size() == data.color.size() );
+
+			sp.inputAttachmentCount		= uint(data.input.size());
+			sp.pInputAttachments		= data.input.empty() ? null : data.input.data();
+			sp.colorAttachmentCount		= uint(data.color.size());
+			sp.pColorAttachments		= data.color.empty() ? null : data.color.data();
+			sp.pResolveAttachments		= data.resolve.empty() ? null : data.resolve.data();
+			sp.pDepthStencilAttachment	= data.depth.empty() ? null : data.depth.data();
+			sp.preserveAttachmentCount	= uint(data.preserve.size());
+			sp.pPreserveAttachments		= data.preserve.empty() ? null : data.preserve.data();
+		}
+
+		ci.sType			= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		ci.attachmentCount	= uint(attachments.size());
+		ci.pAttachments		= attachments.data();
+		ci.dependencyCount	= uint(dependencies.size());
+		ci.pDependencies	= dependencies.data();
+		ci.pSubpasses		= subpasses.data();
+
+		result.reset( new VRenderPass{ ci });
+		CHECK_ERR( result->GetCreateInfo().subpassCount == ci.subpassCount );
+		return true;
+	}
+
+
+}	// FG
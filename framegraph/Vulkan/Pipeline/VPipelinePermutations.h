@@ -0,0 +1,87 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Recorded graphics pipeline permutations (render pass, render state, vertex input, ...),
+	used to create pipeline instances before first draw call.
+	IDs and render states are stored as raw data, so file is valid only for the same build.
+*/
+
+#pragma once
+
+#include "stl/Stream/Stream.h"
+#include "VGraphicsPipeline.h"
+#include "VRenderPass.h"
+
+namespace FG
+{
+
+	//
+	// Pipeline Permutations
+	//
+
+	class VPipelinePermutations final
+	{
+	// types
+	public:
+		struct VertexBinding
+		{
+			VertexBufferID		id;
+			uint				index	= 0;
+			uint				stride	= 0;
+			EVertexInputRate	rate	= EVertexInputRate::Unknown;
+		};
+
+		struct VertexAttrib
+		{
+			VertexID			id;
+			EVertexType			type			= EVertexType::Unknown;
+			uint				offset			= 0;
+			uint				bufferBinding	= 0;
+		};
+
+		struct GraphicsPermutation
+		{
+			HashVal						sourceHash;
+			uint						renderPassIndex	= UMax;
+			uint						subpassIndex	= 0;
+			uint						viewportCount	= 0;
+			EPipelineDynamicState		dynamicState	= Default;
+			RenderState					renderState;
+			Array< VertexBinding >		bindings;
+			Array< VertexAttrib >		vertices;
+
+			bool  GetVertexInput (OUT VertexInputState &result) const;
+		};
+
+	private:
+		using RenderPasses_t	= Array< UniquePtr< VRenderPass >>;
+		using RenderPassMap_t	= HashMap< RawRenderPassID, uint >;
+		using Permutations_t	= Array< GraphicsPermutation >;
+
+
+	// variables
+	private:
+		RenderPasses_t		_renderPasses;		// copy of create info, vulkan objects are not created
+		RenderPassMap_t		_renderPassMap;
+		Permutations_t		_permutations;
+
+
+	// methods
+	public:
+		VPipelinePermutations () {}
+
+		void  Add (HashVal sourceHash, const VGraphicsPipeline::InstanceKey &key, const VRenderPass &renderPass);
+
+		bool  Save (WStream &stream) const;
+		bool  Load (RStream &stream);
+
+		ND_ uint								RenderPassCount ()					const	{ return uint(_renderPasses.size()); }
+		ND_ VkRenderPassCreateInfo const&		GetRenderPassInfo (uint index)		const	{ return _renderPasses[index]->GetCreateInfo(); }
+		ND_ ArrayView< GraphicsPermutation >	GetPermutations ()					const	{ return _permutations; }
+
+	private:
+		static bool  _WriteRenderPass (WStream &stream, const VkRenderPassCreateInfo &ci);
+		static bool  _ReadRenderPass (RStream &stream, OUT UniquePtr<VRenderPass> &result);
+	};
+
+
+}	// FG
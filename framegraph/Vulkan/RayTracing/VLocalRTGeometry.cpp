@@ -24,12 +24,13 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalRTGeometry::Create (const VRayTracingGeometry *geometryData)
+	bool VLocalRTGeometry::Create (const VRayTracingGeometry *geometryData, uint localIndex)
 	{
 		CHECK_ERR( _rtGeometryData == null );
 		CHECK_ERR( geometryData );
 
 		_rtGeometryData	= geometryData;
+		_localIndex		= localIndex;
 
 		return true;
 	}
@@ -42,6 +43,7 @@ namespace FG
 	void VLocalRTGeometry::Destroy ()
 	{
 		_rtGeometryData	= null;
+		_localIndex		= UMax;
 		
 		// check for uncommited barriers
 		ASSERT( _pendingAccesses.empty() );
@@ -43,6 +43,7 @@ namespace FG
 	// variables
 	private:
 		Ptr<VRayTracingGeometry const>	_rtGeometryData;		// readonly access is thread safe
+		uint							_localIndex		= UMax;
 		
 		mutable GeometryAccess			_pendingAccesses;
 		mutable GeometryAccess			_accessForReadWrite;
@@ -54,7 +55,7 @@ namespace FG
 		VLocalRTGeometry (VLocalRTGeometry &&) = delete;
 		~VLocalRTGeometry ();
 		
-		bool Create (const VRayTracingGeometry *);
+		bool Create (const VRayTracingGeometry *, uint localIndex);
 		void Destroy ();
 		
 		void AddPendingState (const GeometryState &state) const;
@@ -70,6 +71,7 @@ namespace FG
 		ND_ ERayTracingFlags			GetFlags ()			const	{ return _rtGeometryData->GetFlags(); }
 
 		ND_ VRayTracingGeometry const*	ToGlobal ()			const	{ return _rtGeometryData.get(); }
+		ND_ uint						LocalIndex ()		const	{ return _localIndex; }
 	};
 
 
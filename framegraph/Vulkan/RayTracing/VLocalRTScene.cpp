@@ -25,12 +25,13 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalRTScene::Create (const VRayTracingScene *sceneData)
+	bool VLocalRTScene::Create (const VRayTracingScene *sceneData, uint localIndex)
 	{
 		CHECK_ERR( _rtSceneData == null );
 		CHECK_ERR( sceneData );
 
 		_rtSceneData = sceneData;
+		_localIndex	 = localIndex;
 
 		return true;
 	}
@@ -43,6 +44,7 @@ namespace FG
 	void VLocalRTScene::Destroy ()
 	{
 		_rtSceneData = null;
+		_localIndex	 = UMax;
 		
 		// check for uncommited barriers
 		ASSERT( _pendingAccesses.empty() );
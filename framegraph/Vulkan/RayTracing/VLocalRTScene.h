@@ -43,6 +43,7 @@ namespace FG
 	// variables
 	private:
 		Ptr<VRayTracingScene const>	_rtSceneData;		// readonly access is thread safe
+		uint						_localIndex		= UMax;
 
 		mutable SceneAccess			_pendingAccesses;
 		mutable SceneAccess			_accessForReadWrite;
@@ -54,7 +55,7 @@ namespace FG
 		VLocalRTScene (VLocalRTScene &&) = delete;
 		~VLocalRTScene ();
 		
-		bool Create (const VRayTracingScene *);
+		bool Create (const VRayTracingScene *, uint localIndex);
 		void Destroy ();
 		
 		void AddPendingState (const SceneState &state) const;
@@ -65,6 +66,7 @@ namespace FG
 		ND_ ERayTracingFlags			GetFlags ()					const	{ return _rtSceneData->GetFlags(); }
 		ND_ uint						MaxInstanceCount ()			const	{ return _rtSceneData->MaxInstanceCount(); }
 		ND_ VRayTracingScene const*		ToGlobal ()					const	{ return _rtSceneData.get(); }
+		ND_ uint						LocalIndex ()				const	{ return _localIndex; }
 	};
 
 
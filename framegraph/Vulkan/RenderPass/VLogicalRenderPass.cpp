@@ -2,6 +2,7 @@
 
 #include "VLogicalRenderPass.h"
 #include "VCommandBuffer.h"
+#include "VDrawCommandBuffer.h"
 #include "VEnumCast.h"
 
 namespace FG
@@ -50,6 +51,7 @@ namespace {
 		_area				= desc.area;
 		//_parallelExecution= desc.parallelExecution;
 		_canBeMerged		= desc.canBeMerged;
+		_drawOrder			= desc.drawOrder;
 		
 
 		// copy descriptor sets
@@ -221,6 +223,24 @@ namespace {
 		return true;
 	}
 
+/*
+=================================================
+	SortDrawTasks
+----
+	sort keys are calculated when barriers for draw tasks are added.
+=================================================
+*/
+	void VLogicalRenderPass::SortDrawTasks ()
+	{
+		if ( _drawOrder != EDrawOrder::MinimizeStateChanges or _drawTasks.size() < 2 )
+			return;
+
+		auto*	temp = _allocator->Alloc< IDrawTask* >( _drawTasks.size() );
+		CHECK_ERR( temp, void());
+
+		FG::SortDrawTasks( _drawTasks.data(), _drawTasks.size(), temp );
+	}
+
 /*
 =================================================
 	Destroy
@@ -230,11 +250,32 @@ namespace {
 	{
 		_drawTasks.clear();
 
+		for (auto* secondary : _secondaries) {
+			secondary->~VDrawCommandBuffer();
+		}
+		_secondaries.clear();
+
 		_allocator.Destroy();
 
 		_shadingRateImage = null;
 	}
 	
+/*
+=================================================
+	CreateSecondary
+=================================================
+*/
+	VDrawCommandBuffer*  VLogicalRenderPass::CreateSecondary (VCommandBuffer &fgThread, std::mutex &guard)
+	{
+		CHECK_ERR( _drawTasks.empty() );	// draw tasks must be added only to the secondary command buffers
+		CHECK_ERR( not _isSubmited );
+
+		auto*	ptr = _allocator->Alloc< VDrawCommandBuffer >();
+		_secondaries.push_back( PlacementNew< VDrawCommandBuffer >( ptr, fgThread, *this, guard ));
+
+		return _secondaries.back();
+	}
+
 /*
 =================================================
 	Submit
@@ -294,6 +335,7 @@ namespace {
 	VLogicalRenderPass::~VLogicalRenderPass ()
 	{
 		ASSERT( _drawTasks.empty() );
+		ASSERT( _secondaries.empty() );
 	}
 
 
@@ -63,6 +63,7 @@ namespace FG
 		// TODO: DOD
 		Array< IDrawTask *>			_drawTasks;				// all draw tasks created with custom allocator in FrameGraph and
 															// will be released after frame execution.
+		Array< VDrawCommandBuffer *>	_secondaries;		// secondary command buffers, created in '_allocator'
 		
 		ColorTargets_t				_colorTargets;
 		DepthStencilTarget			_depthStencilTarget;
@@ -81,6 +82,7 @@ namespace FG
 		//bool						_parallelExecution		= true;
 		bool						_canBeMerged			= true;
 		bool						_isSubmited				= false;
+		EDrawOrder					_drawOrder				= Default;
 		
 		VPipelineResourceSet		_perPassResources;
 
@@ -106,22 +108,29 @@ namespace FG
 		template <typename DrawTaskType, typename ...Args>
 		bool AddTask (Args&& ...args)
 		{
+			CHECK_ERR( _secondaries.empty() );	// draw tasks must be added to the secondary command buffers
+
 			auto*	ptr = _allocator->Alloc<DrawTaskType>();
 			_drawTasks.push_back( PlacementNew<DrawTaskType>( ptr, *this, std::forward<Args&&>(args)... ));
 			return true;
 		}
 
 
+		ND_ VDrawCommandBuffer*  CreateSecondary (VCommandBuffer &, std::mutex &guard);
+
 		bool Submit (VCommandBuffer &, ArrayView<Pair<RawImageID, EResourceState>>, ArrayView<Pair<RawBufferID, EResourceState>>);
 
 		void _SetRenderPass (RawRenderPassID rp, uint subpass, RawFramebufferID fb, uint depthIndex);
 		
 		bool GetShadingRateImage (OUT VLocalImage const* &, OUT ImageViewDesc &) const;
 
+		void SortDrawTasks ();
+
 
 		ND_ bool								HasShadingRateImage ()		const	{ return _shadingRateImage != null; }
 
 		ND_ ArrayView< IDrawTask *>				GetDrawTasks ()				const	{ return _drawTasks; }
+		ND_ ArrayView< VDrawCommandBuffer *>	GetSecondaries ()			const	{ return _secondaries; }
 		
 		ND_ ColorTargets_t const&				GetColorTargets ()			const	{ return _colorTargets; }
 		ND_ DepthStencilTarget const&			GetDepthStencilTarget ()	const	{ return _depthStencilTarget; }
@@ -131,6 +140,7 @@ namespace FG
 
 		ND_ bool								IsSubmited ()				const	{ return _isSubmited; }
 		ND_ bool								IsMergingAvailable ()		const	{ return _canBeMerged; }
+		ND_ EDrawOrder							GetDrawOrder ()				const	{ return _drawOrder; }
 		
 		ND_ RawFramebufferID					GetFramebufferID ()			const	{ return _framebufferId; }
 		ND_ RawRenderPassID						GetRenderPassID ()			const	{ return _renderPassId; }
@@ -105,6 +105,80 @@ namespace FG
 		_createInfo.pSubpasses		= _subpasses.data();
 
 
+		_CalcHash( _createInfo, OUT _hash, OUT _attachmentHash, OUT _subpassesHash );
+		return true;
+	}
+
+/*
+=================================================
+	constructor
+----
+	copy render pass description,
+	used to recreate render pass from recorded pipeline permutations.
+=================================================
+*/
+	VRenderPass::VRenderPass (const VkRenderPassCreateInfo &ci)
+	{
+		_Initialize( ci );
+	}
+
+	bool VRenderPass::_Initialize (const VkRenderPassCreateInfo &ci)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( ci.pNext == null );
+		CHECK_ERR( ci.attachmentCount <= _attachments.capacity() );
+		CHECK_ERR( ci.subpassCount <= _subpasses.capacity() );
+		CHECK_ERR( ci.dependencyCount <= _dependencies.capacity() );
+
+		const auto	CopyRefs = [] (INOUT AttachmentsRef_t &dst, const VkAttachmentReference *src, uint count) -> const VkAttachmentReference*
+		{
+			if ( src == null or count == 0 )
+				return null;
+
+			auto*	result = dst.end();
+			for (uint i = 0; i < count; ++i) {
+				dst.push_back( src[i] );
+			}
+			return result;
+		};
+
+		_attachments.assign( ci.pAttachments, ci.pAttachments + ci.attachmentCount );
+		_dependencies.assign( ci.pDependencies, ci.pDependencies + ci.dependencyCount );
+
+		for (uint i = 0; i < ci.subpassCount; ++i)
+		{
+			const VkSubpassDescription&	src = ci.pSubpasses[i];
+			VkSubpassDescription&		dst = _subpasses.emplace_back( src );
+
+			CHECK_ERR( _attachmentRef.size() + src.colorAttachmentCount * 2 + 1 <= _attachmentRef.capacity() );
+			CHECK_ERR( _inputAttachRef.size() + src.inputAttachmentCount <= _inputAttachRef.capacity() );
+			CHECK_ERR( _preserves.size() + src.preserveAttachmentCount <= _preserves.capacity() );
+
+			dst.pInputAttachments		= CopyRefs( INOUT _inputAttachRef, src.pInputAttachments, src.inputAttachmentCount );
+			dst.pColorAttachments		= CopyRefs( INOUT _attachmentRef, src.pColorAttachments, src.colorAttachmentCount );
+			dst.pResolveAttachments		= CopyRefs( INOUT _attachmentRef, src.pResolveAttachments, src.colorAttachmentCount );
+			dst.pDepthStencilAttachment	= CopyRefs( INOUT _attachmentRef, src.pDepthStencilAttachment, 1 );
+			dst.pPreserveAttachments	= null;
+
+			if ( src.pPreserveAttachments and src.preserveAttachmentCount )
+			{
+				dst.pPreserveAttachments = _preserves.end();
+				for (uint j = 0; j < src.preserveAttachmentCount; ++j) {
+					_preserves.push_back( src.pPreserveAttachments[j] );
+				}
+			}
+		}
+
+		_createInfo					= {};
+		_createInfo.sType			= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		_createInfo.flags			= ci.flags;
+		_createInfo.attachmentCount	= uint(_attachments.size());
+		_createInfo.pAttachments	= _attachments.data();
+		_createInfo.subpassCount	= uint(_subpasses.size());
+		_createInfo.pSubpasses		= _subpasses.data();
+		_createInfo.dependencyCount	= uint(_dependencies.size());
+		_createInfo.pDependencies	= _dependencies.empty() ? null : _dependencies.data();
+
 		_CalcHash( _createInfo, OUT _hash, OUT _attachmentHash, OUT _subpassesHash );
 		return true;
 	}
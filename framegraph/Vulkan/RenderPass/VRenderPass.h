@@ -57,6 +57,7 @@ namespace FG
 		VRenderPass () {}
 		VRenderPass (VRenderPass &&) = default;
 		explicit VRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses);
+		explicit VRenderPass (const VkRenderPassCreateInfo &ci);
 		~VRenderPass ();
 
 		bool Create (const VDevice &dev, StringView dbgName);
@@ -71,6 +72,7 @@ namespace FG
 
 	private:
 		bool _Initialize (ArrayView<VLogicalRenderPass*> logicalPasses);
+		bool _Initialize (const VkRenderPassCreateInfo &ci);
 
 		static void  _CalcHash (const VkRenderPassCreateInfo &ci, OUT HashVal &hash, OUT HashVal &attachmentHash,
 								OUT SubpassesHash_t &subpassesHash);
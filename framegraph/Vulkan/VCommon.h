@@ -85,6 +85,7 @@ namespace FG
 	class VShaderDebugger;
 	class VPipelineResources;
 	class VCommandBuffer;
+	class VDrawCommandBuffer;
 	class VSwapchain;
 	class VSubmitted;
 	class VLocalDebugger;
@@ -105,6 +106,7 @@ namespace FG
 
 		FixedArray< Item, FG_MaxDescriptorSets >					resources;
 		mutable FixedArray< uint, FG_MaxBufferDynamicOffsets >		dynamicOffsets;
+		mutable FixedArray< uint, FG_MaxDescriptorSets >			dynamicOffsetCounts;	// per descriptor set in binding order, valid after 'dynamicOffsets' are sorted
 	};
 
 
@@ -0,0 +1,88 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Stable LSD radix sort with 8-bit digits for unsigned integer keys.
+	Histograms for all digits are built in a single pass over the data,
+	digits that are equal for all keys are skipped.
+*/
+
+#pragma once
+
+#include "stl/Common.h"
+
+namespace FGC
+{
+
+/*
+=================================================
+	RadixSort
+----
+	'temp' must have space for 'count' elements.
+	'getKey' must return unsigned integer, it is called (passes + 1) times for each element.
+=================================================
+*/
+	template <typename T, typename KeyFn>
+	inline void  RadixSort (T* data, T* temp, size_t count, KeyFn &&getKey)
+	{
+		using Key_t = std::decay_t< decltype(getKey( *data )) >;
+		STATIC_ASSERT( IsUnsignedInteger<Key_t> );
+
+		static constexpr uint	DigitBits	= 8;
+		static constexpr uint	NumBuckets	= 1u << DigitBits;
+		static constexpr uint	NumPasses	= uint(sizeof(Key_t) * 8) / DigitBits;
+
+		if ( count < 2 )
+			return;
+
+		ASSERT( data != null and temp != null );
+		ASSERT( count <= size_t(uint(UMax)) );
+
+		StaticArray< StaticArray< uint, NumBuckets >, NumPasses >	histograms = {};
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Key_t	key = getKey( data[i] );
+
+			for (uint p = 0; p < NumPasses; ++p) {
+				++histograms[p][ (key >> (p * DigitBits)) & (NumBuckets-1) ];
+			}
+		}
+
+		T*	src = data;
+		T*	dst = temp;
+
+		for (uint p = 0; p < NumPasses; ++p)
+		{
+			auto&		hist	= histograms[p];
+			const uint	shift	= p * DigitBits;
+
+			// all keys have same digit
+			if ( hist[ (getKey( src[0] ) >> shift) & (NumBuckets-1) ] == count )
+				continue;
+
+			uint	offset = 0;
+			for (auto& h : hist)
+			{
+				const uint	cnt = h;
+				h		= offset;
+				offset += cnt;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint	digit = uint(getKey( src[i] ) >> shift) & (NumBuckets-1);
+				dst[ hist[digit]++ ] = std::move( src[i] );
+			}
+
+			std::swap( src, dst );
+		}
+
+		if ( src != data )
+		{
+			for (size_t i = 0; i < count; ++i) {
+				data[i] = std::move( src[i] );
+			}
+		}
+	}
+
+
+}	// FGC
@@ -0,0 +1,346 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Hash map with open addressing and linear probing.
+	All elements are stored in single array, so insertion doesn't allocate memory for each node.
+
+	Designed for trivial keys like packed 64-bit IDs, default constructed key is reserved
+	to mark empty bucket and must not be inserted.
+	Erasing is not supported, use 'clear' to reuse map.
+
+	With 'UntypedLinearAllocator' memory of old buckets is released only when linear allocator is discarded.
+*/
+
+#pragma once
+
+#include "stl/Algorithms/Cast.h"
+#include "stl/Memory/UntypedAllocator.h"
+#include "stl/Math/BitMath.h"
+#include "stl/Math/Math.h"
+#include "stl/Math/Bytes.h"
+
+namespace FGC
+{
+
+	//
+	// Flat Hash Map
+	//
+
+	template <typename Key,
+			  typename Value,
+			  typename Hasher = std::hash<Key>,
+			  typename AllocatorType = UntypedAlignedAllocator
+			 >
+	struct FlatHashMap
+	{
+		STATIC_ASSERT( std::is_trivially_destructible_v<Key> and std::is_trivially_copyable_v<Key> );
+		STATIC_ASSERT( std::is_trivially_destructible_v<Value> );
+
+	// types
+	public:
+		using Self				= FlatHashMap< Key, Value, Hasher, AllocatorType >;
+		using pair_type			= Pair< Key, Value >;
+		using key_type			= Key;
+		using value_type		= Value;
+		using Allocator_t		= AllocatorType;
+
+		template <typename T>
+		struct TIterator
+		{
+			friend struct FlatHashMap;
+
+		private:
+			T *		_ptr	= null;
+			T *		_end	= null;
+
+			TIterator (T* ptr, T* end) : _ptr{ptr}, _end{end}	{ _SkipEmpty(); }
+
+			void _SkipEmpty ()	{ for (; _ptr != _end and _ptr->first == Key{}; ++_ptr) {} }
+
+		public:
+			TIterator () {}
+
+			TIterator&	operator ++ ()							{ ++_ptr;  _SkipEmpty();  return *this; }
+
+			ND_ T&		operator * ()					const	{ return *_ptr; }
+			ND_ T*		operator -> ()					const	{ return _ptr; }
+
+			ND_ bool	operator == (const TIterator &rhs) const	{ return _ptr == rhs._ptr; }
+			ND_ bool	operator != (const TIterator &rhs) const	{ return _ptr != rhs._ptr; }
+		};
+
+		using iterator			= TIterator< pair_type >;
+		using const_iterator	= TIterator< const pair_type >;
+
+	private:
+		static constexpr size_t		_MinCapacity	= 16;
+		static constexpr BytesU		_Align			= AlignOf< pair_type >;
+
+
+	// variables
+	private:
+		pair_type *		_buckets	= null;
+		size_t			_capacity	= 0;		// power of 2
+		size_t			_count		= 0;
+		uint			_shift		= 0;		// 64 - log2(capacity)
+		Allocator_t		_alloc;
+
+
+	// methods
+	public:
+		FlatHashMap () {}
+		explicit FlatHashMap (const Allocator_t &alloc) : _alloc{alloc} {}
+
+		FlatHashMap (Self &&);
+		FlatHashMap (const Self &) = delete;
+
+		~FlatHashMap ()		{ _Deallocate(); }
+
+			Self&	operator = (Self &&);
+			Self&	operator = (const Self &) = delete;
+
+		ND_ size_t			size ()			const	{ return _count; }
+		ND_ bool			empty ()		const	{ return _count == 0; }
+		ND_ size_t			capacity ()		const	{ return _capacity; }
+
+		ND_ iterator		begin ()				{ return iterator{ _buckets, _buckets + _capacity }; }
+		ND_ const_iterator	begin ()		const	{ return const_iterator{ _buckets, _buckets + _capacity }; }
+		ND_ iterator		end ()					{ return iterator{ _buckets + _capacity, _buckets + _capacity }; }
+		ND_ const_iterator	end ()			const	{ return const_iterator{ _buckets + _capacity, _buckets + _capacity }; }
+
+			Pair<iterator,bool>  insert (const pair_type &value);
+
+		ND_ iterator		find (const key_type &key);
+		ND_ const_iterator	find (const key_type &key) const;
+
+		ND_ size_t			count (const key_type &key) const	{ return find( key ) != end() ? 1 : 0; }
+
+			void			reserve (size_t count);
+			void			clear ();
+
+
+	private:
+		ND_ size_t	_BucketIndex (const key_type &key) const;
+		ND_ size_t	_FindBucket (const key_type &key) const;
+			void	_Rehash (size_t newCapacity);
+			void	_Deallocate ();
+	};
+
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline FlatHashMap<K,V,H,A>::FlatHashMap (Self &&other) :
+		_buckets{ other._buckets },		_capacity{ other._capacity },
+		_count{ other._count },			_shift{ other._shift },
+		_alloc{ std::move(other._alloc) }
+	{
+		other._buckets	= null;
+		other._capacity	= 0;
+		other._count	= 0;
+		other._shift	= 0;
+	}
+
+/*
+=================================================
+	operator =
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline FlatHashMap<K,V,H,A>&  FlatHashMap<K,V,H,A>::operator = (Self &&rhs)
+	{
+		ASSERT( this != &rhs );
+		ASSERT( _alloc == rhs._alloc );	// allocator may be a reference, so it can't be moved
+
+		std::swap( _buckets,  rhs._buckets );
+		std::swap( _capacity, rhs._capacity );
+		std::swap( _count,    rhs._count );
+		std::swap( _shift,    rhs._shift );
+
+		rhs._Deallocate();
+		return *this;
+	}
+
+/*
+=================================================
+	_BucketIndex
+----
+	fibonacci hashing, high bits of the product are
+	well mixed even if hash function is identity
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline size_t  FlatHashMap<K,V,H,A>::_BucketIndex (const key_type &key) const
+	{
+		return size_t( (uint64_t(H{}( key )) * 0x9E3779B97F4A7C15ull) >> _shift );
+	}
+
+/*
+=================================================
+	_FindBucket
+----
+	returns index of bucket with same key or empty bucket
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline size_t  FlatHashMap<K,V,H,A>::_FindBucket (const key_type &key) const
+	{
+		const size_t	mask = _capacity - 1;
+
+		for (size_t i = _BucketIndex( key );; i = (i + 1) & mask)
+		{
+			const K&	curr = _buckets[i].first;
+
+			if ( curr == key or curr == K{} )
+				return i;
+		}
+	}
+
+/*
+=================================================
+	insert
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline Pair< typename FlatHashMap<K,V,H,A>::iterator, bool >
+		FlatHashMap<K,V,H,A>::insert (const pair_type &value)
+	{
+		ASSERT( not (value.first == K{}) );
+
+		// keep load factor less than 0.75
+		if ( (_count + 1) * 4 > _capacity * 3 )
+			_Rehash( Max( _MinCapacity, _capacity * 2 ));
+
+		pair_type&	bucket		= _buckets[ _FindBucket( value.first )];
+		const bool	inserted	= not (bucket.first == value.first);
+
+		if ( inserted )
+		{
+			PlacementNew<pair_type>( &bucket, value );
+			++_count;
+		}
+		return { iterator{ &bucket, _buckets + _capacity }, inserted };
+	}
+
+/*
+=================================================
+	find
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline typename FlatHashMap<K,V,H,A>::iterator
+		FlatHashMap<K,V,H,A>::find (const key_type &key)
+	{
+		if ( _count == 0 or key == K{} )
+			return end();
+
+		pair_type&	bucket = _buckets[ _FindBucket( key )];
+
+		return bucket.first == key ? iterator{ &bucket, _buckets + _capacity } : end();
+	}
+
+	template <typename K, typename V, typename H, typename A>
+	inline typename FlatHashMap<K,V,H,A>::const_iterator
+		FlatHashMap<K,V,H,A>::find (const key_type &key) const
+	{
+		if ( _count == 0 or key == K{} )
+			return end();
+
+		pair_type const&	bucket = _buckets[ _FindBucket( key )];
+
+		return bucket.first == key ? const_iterator{ &bucket, _buckets + _capacity } : end();
+	}
+
+/*
+=================================================
+	reserve
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline void  FlatHashMap<K,V,H,A>::reserve (size_t count)
+	{
+		size_t	new_capacity = Max( _MinCapacity, _capacity );
+
+		while ( count * 4 > new_capacity * 3 ) {
+			new_capacity *= 2;
+		}
+
+		if ( new_capacity > _capacity )
+			_Rehash( new_capacity );
+	}
+
+/*
+=================================================
+	clear
+----
+	keeps allocated memory
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline void  FlatHashMap<K,V,H,A>::clear ()
+	{
+		if ( _count == 0 )
+			return;
+
+		for (size_t i = 0; i < _capacity; ++i) {
+			_buckets[i].first = K{};
+		}
+		_count = 0;
+	}
+
+/*
+=================================================
+	_Rehash
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline void  FlatHashMap<K,V,H,A>::_Rehash (size_t newCapacity)
+	{
+		ASSERT( IsPowerOfTwo( newCapacity ));
+		ASSERT( newCapacity > _count );
+
+		pair_type*		old_buckets		= _buckets;
+		const size_t	old_capacity	= _capacity;
+
+		_buckets	= Cast<pair_type>( _alloc.Allocate( SizeOf<pair_type> * newCapacity, _Align ));
+		_capacity	= newCapacity;
+		_shift		= uint(64 - IntLog2( newCapacity ));
+		CHECK( _buckets != null );
+
+		for (size_t i = 0; i < _capacity; ++i) {
+			PlacementNew<K>( &_buckets[i].first );
+		}
+
+		for (size_t i = 0; i < old_capacity; ++i)
+		{
+			pair_type&	src = old_buckets[i];
+
+			if ( not (src.first == K{}) )
+				PlacementNew<pair_type>( &_buckets[ _FindBucket( src.first )], std::move(src) );
+		}
+
+		if ( old_buckets )
+			_alloc.Deallocate( old_buckets, SizeOf<pair_type> * old_capacity, _Align );
+	}
+
+/*
+=================================================
+	_Deallocate
+=================================================
+*/
+	template <typename K, typename V, typename H, typename A>
+	inline void  FlatHashMap<K,V,H,A>::_Deallocate ()
+	{
+		if ( _buckets )
+			_alloc.Deallocate( _buckets, SizeOf<pair_type> * _capacity, _Align );
+
+		_buckets	= null;
+		_capacity	= 0;
+		_count		= 0;
+		_shift		= 0;
+	}
+
+}	// FGC
@@ -0,0 +1,204 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Array with inline storage for small number of elements,
+	when inline storage overflows elements are moved to memory from linear allocator.
+
+	Memory is never released by array, it is released when linear allocator is discarded,
+	so array must be cleared or destroyed before that.
+	Only trivial types are supported.
+*/
+
+#pragma once
+
+#include "stl/Containers/ArrayView.h"
+#include "stl/Containers/Ptr.h"
+#include "stl/Memory/LinearAllocator.h"
+#include "stl/Math/Math.h"
+
+namespace FGC
+{
+
+	//
+	// Small Array
+	//
+
+	template <typename T, size_t InlineSize>
+	struct SmallArray
+	{
+		STATIC_ASSERT( std::is_trivially_copyable_v<T> and std::is_trivially_destructible_v<T> );
+		STATIC_ASSERT( InlineSize > 0 );
+
+	// types
+	public:
+		using iterator			= T *;
+		using const_iterator	= const T *;
+		using value_type		= T;
+		using Allocator_t		= LinearAllocator<>;
+		using Self				= SmallArray< T, InlineSize >;
+
+
+	// variables
+	private:
+		T *						_external	= null;		// null if inline storage is used
+		uint					_count		= 0;
+		uint					_capacity	= uint(InlineSize);
+		Ptr<Allocator_t>		_allocator;
+		alignas(T) char			_inline [sizeof(T) * InlineSize];
+
+
+	// methods
+	public:
+		SmallArray () {}
+		explicit SmallArray (Allocator_t &alloc) : _allocator{&alloc} {}
+
+		SmallArray (const Self &) = delete;
+		SmallArray (Self &&) = delete;
+
+			Self&  operator = (const Self &) = delete;
+			Self&  operator = (Self &&) = delete;
+
+			// external storage stays in the previous allocator, only next reallocation will use new allocator
+			void  SetAllocator (Allocator_t &alloc)			{ _allocator = &alloc; }
+
+		ND_ operator ArrayView<T> ()					const	{ return ArrayView<T>{ data(), _count }; }
+
+		ND_ size_t				size ()					const	{ return _count; }
+		ND_ bool				empty ()				const	{ return _count == 0; }
+		ND_ size_t				capacity ()				const	{ return _capacity; }
+		ND_ bool				IsInline ()				const	{ return _external == null; }
+
+		ND_ T *					data ()							{ return _external ? _external : reinterpret_cast<T *>(_inline); }
+		ND_ T const *			data ()					const	{ return _external ? _external : reinterpret_cast<T const *>(_inline); }
+
+		ND_ T &					operator [] (size_t i)			{ ASSERT( i < _count );  return data()[i]; }
+		ND_ T const &			operator [] (size_t i)	const	{ ASSERT( i < _count );  return data()[i]; }
+
+		ND_ iterator			begin ()						{ return data(); }
+		ND_ const_iterator		begin ()				const	{ return data(); }
+		ND_ iterator			end ()							{ return data() + _count; }
+		ND_ const_iterator		end ()					const	{ return data() + _count; }
+
+		ND_ T &					front ()						{ ASSERT( _count > 0 );  return data()[0]; }
+		ND_ T const &			front ()				const	{ ASSERT( _count > 0 );  return data()[0]; }
+		ND_ T &					back ()							{ ASSERT( _count > 0 );  return data()[_count-1]; }
+		ND_ T const &			back ()					const	{ ASSERT( _count > 0 );  return data()[_count-1]; }
+
+
+		void  push_back (const T &value)
+		{
+			if ( _count == _capacity )
+			{
+				const T		temp = value;	// value may be a reference to element
+				_Grow( _count + 1 );
+				PlacementNew<T>( data() + (_count++), temp );
+			}
+			else
+				PlacementNew<T>( data() + (_count++), value );
+		}
+
+
+		iterator  insert (const_iterator pos, const T &value)
+		{
+			ASSERT( pos >= begin() and pos <= end() );
+
+			const size_t	index	= size_t(pos - begin());
+			const T			temp	= value;
+
+			if ( _count == _capacity )
+				_Grow( _count + 1 );
+
+			T*	ptr = data();
+			std::memmove( ptr + index + 1, ptr + index, sizeof(T) * (_count - index) );
+
+			PlacementNew<T>( ptr + index, temp );
+			++_count;
+
+			return ptr + index;
+		}
+
+
+		// 'first' and 'last' must not point into this array
+		iterator  insert (const_iterator pos, const T* first, const T* last)
+		{
+			ASSERT( pos >= begin() and pos <= end() );
+			ASSERT( first <= last );
+
+			const size_t	index	= size_t(pos - begin());
+			const size_t	count	= size_t(last - first);
+
+			if ( _count + count > _capacity )
+				_Grow( _count + count );
+
+			T*	ptr = data();
+			std::memmove( ptr + index + count, ptr + index, sizeof(T) * (_count - index) );
+			std::memcpy( ptr + index, first, sizeof(T) * count );
+			_count += uint(count);
+
+			return ptr + index;
+		}
+
+
+		iterator  erase (const_iterator pos)
+		{
+			ASSERT( pos >= begin() and pos < end() );
+
+			const size_t	index	= size_t(pos - begin());
+			T*				ptr		= data();
+
+			std::memmove( ptr + index, ptr + index + 1, sizeof(T) * (_count - index - 1) );
+			--_count;
+
+			return ptr + index;
+		}
+
+
+		iterator  erase (const_iterator first, const_iterator last)
+		{
+			ASSERT( first >= begin() and first <= last and last <= end() );
+
+			const size_t	index	= size_t(first - begin());
+			const size_t	count	= size_t(last - first);
+			T*				ptr		= data();
+
+			std::memmove( ptr + index, ptr + index + count, sizeof(T) * (_count - index - count) );
+			_count -= uint(count);
+
+			return ptr + index;
+		}
+
+
+		void  reserve (size_t count)
+		{
+			if ( count > _capacity )
+				_Grow( count );
+		}
+
+
+		// inline storage will be used again, external memory is not released
+		void  clear ()
+		{
+			_external	= null;
+			_count		= 0;
+			_capacity	= uint(InlineSize);
+		}
+
+
+	private:
+		// callers write to the new storage without checks, so allocation failure is fatal
+		void  _Grow (size_t minCapacity)
+		{
+			CHECK_FATAL( _allocator );
+
+			const size_t	new_cap	= Max( minCapacity, size_t(_capacity) * 2 );
+			T*				ptr		= _allocator->template Alloc<T>( new_cap );
+			CHECK_FATAL( ptr );
+
+			std::memcpy( ptr, data(), sizeof(T) * _count );
+
+			_external	= ptr;
+			_capacity	= uint(new_cap);
+		}
+	};
+
+
+}	// FGC
@@ -0,0 +1,122 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Bounded lock-free FIFO queue.
+	Multiple producers and multiple consumers are allowed,
+	each cell has a sequence number that tells whether it is ready for writing or reading.
+
+	'Push' returns 'false' if queue is full, 'Pop' returns 'false' if queue is empty.
+*/
+
+#pragma once
+
+#include "stl/Containers/ArrayView.h"
+#include "stl/Math/BitMath.h"
+#include <atomic>
+
+namespace FGC
+{
+
+	//
+	// Lock-free Fixed Size Queue
+	//
+
+	template <typename T, size_t Size>
+	struct LfFixedQueue final
+	{
+		STATIC_ASSERT( IsPowerOfTwo( Size ));
+
+	// types
+	private:
+		struct alignas(FG_CACHE_LINE) Cell
+		{
+			std::atomic<size_t>		seq;
+			T						value;
+		};
+
+		static constexpr size_t		Mask	= Size - 1;
+
+
+	// variables
+	private:
+		StaticArray< Cell, Size >				_cells;
+		alignas(FG_CACHE_LINE) std::atomic<size_t>	_pushPos {0};
+		alignas(FG_CACHE_LINE) std::atomic<size_t>	_popPos  {0};
+
+
+	// methods
+	public:
+		LfFixedQueue ()
+		{
+			for (size_t i = 0; i < Size; ++i) {
+				_cells[i].seq.store( i, memory_order_relaxed );
+			}
+			std::atomic_thread_fence( memory_order_release );
+		}
+
+		LfFixedQueue (const LfFixedQueue &) = delete;
+		LfFixedQueue& operator = (const LfFixedQueue &) = delete;
+
+
+		template <typename V>
+		ND_ bool  Push (V &&value)
+		{
+			size_t	pos = _pushPos.load( memory_order_relaxed );
+
+			for (;;)
+			{
+				Cell&			cell	= _cells[ pos & Mask ];
+				const size_t	seq		= cell.seq.load( memory_order_acquire );
+				const intptr_t	diff	= intptr_t(seq) - intptr_t(pos);
+
+				if ( diff == 0 )
+				{
+					if ( _pushPos.compare_exchange_weak( INOUT pos, pos + 1, memory_order_relaxed ))
+					{
+						cell.value = std::forward<V>( value );
+						cell.seq.store( pos + 1, memory_order_release );
+						return true;
+					}
+				}
+				else
+				if ( diff < 0 )
+					return false;	// queue is full
+				else
+					pos = _pushPos.load( memory_order_relaxed );
+			}
+		}
+
+
+		ND_ bool  Pop (OUT T &value)
+		{
+			size_t	pos = _popPos.load( memory_order_relaxed );
+
+			for (;;)
+			{
+				Cell&			cell	= _cells[ pos & Mask ];
+				const size_t	seq		= cell.seq.load( memory_order_acquire );
+				const intptr_t	diff	= intptr_t(seq) - intptr_t(pos + 1);
+
+				if ( diff == 0 )
+				{
+					if ( _popPos.compare_exchange_weak( INOUT pos, pos + 1, memory_order_relaxed ))
+					{
+						value = std::move( cell.value );
+						cell.value = T{};
+						cell.seq.store( pos + Size, memory_order_release );
+						return true;
+					}
+				}
+				else
+				if ( diff < 0 )
+					return false;	// queue is empty
+				else
+					pos = _popPos.load( memory_order_relaxed );
+			}
+		}
+
+
+		ND_ static constexpr size_t  Capacity ()	{ return Size; }
+	};
+
+
+}	// FGC
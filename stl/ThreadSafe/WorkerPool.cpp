@@ -0,0 +1,194 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/WorkerPool.h"
+#include "stl/Algorithms/Cast.h"
+#include "stl/Math/Math.h"
+
+namespace FGC
+{
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	WorkerPool::~WorkerPool ()
+	{
+		Stop();
+	}
+
+/*
+=================================================
+	Start
+=================================================
+*/
+	bool WorkerPool::Start (uint threadCount)
+	{
+		CHECK_ERR( threadCount > 0 );
+		{
+			std::unique_lock	lock{ _guard };
+			CHECK_ERR( not _looping and _threads.empty() );
+			_looping = true;
+		}
+
+		_threads.reserve( threadCount );
+
+		for (uint i = 0; i < threadCount; ++i) {
+			_threads.emplace_back( [this] () { _Loop(); });
+		}
+		return true;
+	}
+
+/*
+=================================================
+	Stop
+----
+	all queued jobs will be completed before threads exit.
+=================================================
+*/
+	void WorkerPool::Stop ()
+	{
+		{
+			std::unique_lock	lock{ _guard };
+			_looping = false;
+		}
+		_jobCV.notify_all();
+
+		for (auto& thread : _threads) {
+			thread.join();
+		}
+		_threads.clear();
+
+		ASSERT( _jobs.empty() );
+	}
+
+/*
+=================================================
+	Run
+=================================================
+*/
+	bool WorkerPool::Run (Job_t &&job)
+	{
+		ASSERT( job );
+		{
+			std::unique_lock	lock{ _guard };
+			CHECK_ERR( _looping );
+
+			_jobs.push_back( std::move(job) );
+		}
+		_jobCV.notify_one();
+		return true;
+	}
+
+/*
+=================================================
+	WaitAll
+=================================================
+*/
+	void WorkerPool::WaitAll ()
+	{
+		std::unique_lock	lock{ _guard };
+
+		_idleCV.wait( lock, [this] () { return _jobs.empty() and _activeJobs == 0; });
+	}
+
+/*
+=================================================
+	RunParallel
+----
+	worker threads that are started after all indices
+	are processed access only the shared state.
+=================================================
+*/
+	WorkerPool::ParallelJobs  WorkerPool::RunParallel (uint count, IndexedJob_t &&job)
+	{
+		ParallelJobs	result;
+
+		if ( count == 0 )
+			return result;
+
+		result._state			= MakeShared< ParallelJobs::State >();
+		result._state->count	= count;
+		result._state->job		= std::move(job);
+
+		// waiting thread will process the rest
+		const uint	job_count = Min( count, ThreadCount() );
+
+		for (uint i = 0; i < job_count; ++i)
+		{
+			if ( not Run( [state = result._state] () { ParallelJobs::_Process( *state ); }))
+				break;
+		}
+		return result;
+	}
+
+/*
+=================================================
+	ParallelJobs::Wait
+=================================================
+*/
+	void WorkerPool::ParallelJobs::Wait ()
+	{
+		if ( not _state )
+			return;
+
+		_Process( *_state );
+
+		std::unique_lock	lock{ _state->guard };
+		_state->cv.wait( lock, [this] () { return _state->completed.load( memory_order_acquire ) == _state->count; });
+		lock.unlock();
+
+		_state.reset();
+	}
+
+/*
+=================================================
+	ParallelJobs::_Process
+=================================================
+*/
+	void WorkerPool::ParallelJobs::_Process (State &state)
+	{
+		for (uint i; (i = state.next.fetch_add( 1, memory_order_relaxed )) < state.count;)
+		{
+			state.job( i );
+
+			if ( state.completed.fetch_add( 1, memory_order_acq_rel ) + 1 == state.count )
+			{
+				// lock to avoid lost wakeup
+				{ std::unique_lock	lock{ state.guard }; }
+				state.cv.notify_all();
+			}
+		}
+	}
+
+/*
+=================================================
+	_Loop
+=================================================
+*/
+	void WorkerPool::_Loop ()
+	{
+		std::unique_lock	lock{ _guard };
+
+		for (;;)
+		{
+			_jobCV.wait( lock, [this] () { return not _jobs.empty() or not _looping; });
+
+			if ( _jobs.empty() )
+				break;	// stopped and nothing to do
+
+			Job_t	job = std::move( _jobs.front() );
+			_jobs.pop_front();
+			++_activeJobs;
+
+			lock.unlock();
+			job();
+			lock.lock();
+
+			if ( --_activeJobs == 0 and _jobs.empty() )
+				_idleCV.notify_all();
+		}
+	}
+
+
+}	// FGC
@@ -0,0 +1,107 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Fixed set of background threads that execute jobs in FIFO order.
+	Used for long CPU-side work (shader compilation, pipeline creation)
+	that must not stall the render thread.
+
+	'RunParallel' splits indexed job between the worker threads and the thread that waits for it,
+	waiting thread processes indices that are not started yet, so it can be used inside other job.
+*/
+
+#pragma once
+
+#include "stl/Common.h"
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+namespace FGC
+{
+
+	//
+	// Worker Pool
+	//
+
+	class WorkerPool final
+	{
+	// types
+	public:
+		using Job_t			= std::function< void () >;
+		using IndexedJob_t	= std::function< void (uint index) >;
+
+		
+		//
+		// Parallel Jobs
+		//
+		class ParallelJobs final
+		{
+			friend class WorkerPool;
+
+		// types
+		private:
+			struct State
+			{
+				std::atomic<uint>			next		{0};	// next index to process
+				std::atomic<uint>			completed	{0};
+				uint						count		= 0;
+				IndexedJob_t				job;
+				std::mutex					guard;
+				std::condition_variable		cv;			// signaled when all indices are processed
+			};
+
+		// variables
+		private:
+			SharedPtr< State >		_state;
+
+		// methods
+		public:
+			ParallelJobs () {}
+			ParallelJobs (ParallelJobs &&) = default;
+			ParallelJobs& operator = (ParallelJobs &&rhs)	{ Wait();  _state = std::move(rhs._state);  return *this; }
+			~ParallelJobs ()	{ Wait(); }
+
+			void Wait ();
+
+		private:
+			static void _Process (State &);
+		};
+
+
+	// variables
+	private:
+		std::mutex					_guard;
+		std::condition_variable		_jobCV;		// signaled when new job added or pool stopped
+		std::condition_variable		_idleCV;	// signaled when all jobs complete
+		Deque< Job_t >				_jobs;
+		Array< std::thread >		_threads;
+		uint						_activeJobs	= 0;
+		bool						_looping	= false;
+
+
+	// methods
+	public:
+		WorkerPool () {}
+		~WorkerPool ();
+
+		WorkerPool (const WorkerPool &) = delete;
+		WorkerPool& operator = (const WorkerPool &) = delete;
+
+		bool Start (uint threadCount);
+		void Stop ();
+
+		bool Run (Job_t &&job);
+		void WaitAll ();
+
+		// job may be called until 'Wait' returns, so captured references must be valid.
+		ND_ ParallelJobs  RunParallel (uint count, IndexedJob_t &&job);
+			void		  ParallelFor (uint count, IndexedJob_t &&job)	{ RunParallel( count, std::move(job) ).Wait(); }
+
+		ND_ uint  ThreadCount ()	const	{ return uint(_threads.size()); }
+
+	private:
+		void _Loop ();
+	};
+
+
+}	// FGC
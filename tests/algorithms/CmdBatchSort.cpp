@@ -2,6 +2,7 @@
 
 #include "UnitTest_Common.h"
 #include <list>
+#include <unordered_map>
 
 
 extern void Test_CmdBatchSort ()
@@ -12,7 +13,6 @@ extern void Test_CmdBatchSort ()
 		const std::string		name;
 		const int				queueIdx;
 		bool					isReady		= false;
-		bool					isDepsReady	= false;
 		bool					isSubmitted	= false;
 
 		Batch (std::string_view name, int idx) : name{name}, queueIdx{idx} {}
@@ -25,78 +25,152 @@ extern void Test_CmdBatchSort ()
 
 	std::array<Queue, 3>	queues;
 
+	// topological sort with dependency counters, same as 'VFrameGraph::_FlushAll'
 	auto	Flush = [&queues] (std::string_view ref)
 	{
-		std::vector<Batch*>	submit;
-		std::string			str;
-		int					max_iii = 0;
-		int					max_ii	= 0;
-		int					count	= 0;
+		struct Node
+		{
+			Batch *				batch;
+			std::vector<int>	dependents	{};
+			int					inDegree	= 0;
+		};
+
+		std::vector<Node>					nodes;
+		std::unordered_map<Batch*, int>		node_map;
+		std::array<std::vector<int>, 3>		ready;
+		std::string							str;
+		int									count	= 0;
+
+		for (auto& q : queues)
+		{
+			for (auto* b : q.pending)
+			{
+				node_map.insert({ b, int(nodes.size()) });
+				nodes.push_back({ b });
+			}
+		}
 
-		for (int iii = 0, iii_changed = 1; iii_changed and (iii < 10); ++iii)
+		for (size_t i = 0; i < nodes.size(); ++i)
 		{
-			max_iii = std::max( max_iii, iii );
+			auto&	curr = nodes[i];
+
+			// batch that is not ready will be submitted in next flush
+			if ( not curr.batch->isReady )
+				++curr.inDegree;
+
+			for (auto* dep : curr.batch->dependsOn)
+			{
+				++count;
+				auto	iter = node_map.find( dep );
 
-			iii_changed = 0;
+				if ( iter != node_map.end() ) {
+					++curr.inDegree;
+					nodes[iter->second].dependents.push_back( int(i) );
+				}
+				else
+				if ( not dep->isSubmitted )
+					++curr.inDegree;
+			}
+
+			if ( curr.inDegree == 0 )
+				ready[ curr.batch->queueIdx ].push_back( int(i) );
+		}
 
-			for (auto& q : queues)
+		for (;;)
+		{
+			// queue is deferred while ready batches on other queue will unlock some of its batches
+			std::array<int, 3>	unlocked_by	= {};
+			int					ready_mask	= 0;
+			int					submit_mask	= 0;
+
+			for (int qi = 0; qi < int(ready.size()); ++qi)
 			{
-				for (int ii = 0, ii_max = std::max(10, int(q.pending.size())), ii_changed = 1;
-					 ii_changed and (ii < ii_max);
-					 ++ii)
+				if ( ready[qi].empty() )
+					continue;
+
+				ready_mask |= (1 << qi);
+
+				std::vector<int>	stack	{ ready[qi].begin(), ready[qi].end() };
+				std::vector<bool>	visited	( nodes.size(), false );
+
+				for (; stack.size();)
 				{
-					max_ii = std::max( max_ii, ii );
-					ii_changed = 0;
+					int		idx = stack.back();
+					stack.pop_back();
+
+					if ( visited[idx] )
+						continue;
 
-					for (auto iter = q.pending.begin(); iter != q.pending.end();)
+					visited[idx] = true;
+
+					for (int d : nodes[idx].dependents)
 					{
-						++count;
+						if ( nodes[d].batch->queueIdx == qi )
+							stack.push_back( d );
+						else
+							unlocked_by[ nodes[d].batch->queueIdx ] |= (1 << qi);
+					}
+				}
+			}
 
-						auto&	curr = **iter;
-						ASSERT( not curr.isSubmitted );
+			if ( ready_mask == 0 )
+				break;
 
-						if ( curr.isReady and not curr.isDepsReady )
-						{
-							curr.isDepsReady = true;
+			for (int qi = 0; qi < int(ready.size()); ++qi)
+			{
+				if ( (ready_mask & (1 << qi)) and not (unlocked_by[qi] & ready_mask & ~(1 << qi)) )
+					submit_mask |= (1 << qi);
+			}
 
-							for (auto& dep : curr.dependsOn)
-							{
-								curr.isDepsReady &= dep->isDepsReady;
-							}
-							
-							if ( curr.isDepsReady )
-							{
-								iii_changed = ii_changed = 1;
-								curr.isSubmitted = true;
+			// queues depend on each other
+			if ( submit_mask == 0 )
+				submit_mask = ready_mask;
 
-								submit.push_back( &curr );
-								iter = q.pending.erase( iter );
+			for (int qi = 0; qi < int(ready.size()); ++qi)
+			{
+				auto&	ready_nodes = ready[qi];
+				if ( ready_nodes.empty() or not (submit_mask & (1 << qi)) )
+					continue;
+
+				if ( str.size() ) str += " ";
+
+				// batches on the same queue are unlocked immediately
+				for (size_t j = 0; j < ready_nodes.size(); ++j)
+				{
+					auto&	curr = nodes[ ready_nodes[j] ];
+					ASSERT( not curr.batch->isSubmitted );
+					++count;
 
-								continue;
-							}
-						}
+					if ( j ) str += ", ";
+					str += curr.batch->name;
 
-						++iter;
+					for (int d : curr.dependents)
+					{
+						if ( nodes[d].batch->queueIdx == qi and --nodes[d].inDegree == 0 )
+							ready_nodes.push_back( d );
 					}
 				}
+				str += ";";
 
-				if ( submit.size() )
+				// batches on other queues are unlocked after submission
+				for (int idx : ready_nodes)
 				{
-					if ( str.size() ) str += " ";
+					auto&	curr = nodes[idx];
+					curr.batch->isSubmitted = true;
+					queues[qi].pending.remove( curr.batch );
 
-					for (auto& b : submit)
+					for (int d : curr.dependents)
 					{
-						if ( &b != submit.data() )	str += ", ";
-						str += b->name;
+						if ( nodes[d].batch->queueIdx != qi and --nodes[d].inDegree == 0 )
+							ready[ nodes[d].batch->queueIdx ].push_back( d );
 					}
-
-					submit.clear();
-					str += ";";
 				}
+
+				ready_nodes.clear();
 			}
 		}
 
-		FG_LOGI( "max: "s << ToString( max_ii ) << ", " << ToString( max_iii ) << ", total: " << ToString( count ) );
+		FG_LOGI( "total: "s << ToString( count ) );
 		TEST( str == ref );
 	};
 
@@ -227,4 +301,52 @@ extern void Test_CmdBatchSort ()
 
 		Flush( "b0, b2; b1, b3;" );
 	}
+	
+	// frame 7, long chain across all queues must be submitted in a single flush
+	{
+		std::vector<Batch*>	chain;
+		std::string			ref;
+
+		for (int i = 0; i < 30; ++i)
+		{
+			auto*	b = new Batch{ "c"s << ToString(i), i % 3 };
+
+			if ( chain.size() )
+				b->dependsOn.push_back( chain.back() );
+
+			b->isReady = true;
+			chain.push_back( b );
+			ref += (ref.size() ? " " : "") + b->name + ";";
+		}
+
+		// add in reverse order
+		for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter) {
+			queues[ (*iter)->queueIdx ].pending.push_back( *iter );
+		}
+
+		Flush( ref );
+	}
+
+	// frame 8, queue waits for other queue to submit all ready batches at once
+	{
+		auto*	b0 = new Batch{ "b0", 0 };
+		auto*	b1 = new Batch{ "b1", 0 };
+		auto*	b2 = new Batch{ "b2", 1 };
+		auto*	b3 = new Batch{ "b3", 1 };
+
+		b1->dependsOn.push_back( b3 );
+		b3->dependsOn.push_back( b2 );
+
+		queues[ b0->queueIdx ].pending.push_back( b0 );
+		queues[ b1->queueIdx ].pending.push_back( b1 );
+		queues[ b2->queueIdx ].pending.push_back( b2 );
+		queues[ b3->queueIdx ].pending.push_back( b3 );
+
+		b0->isReady = true;
+		b1->isReady = true;
+		b2->isReady = true;
+		b3->isReady = true;
+
+		Flush( "b2, b3; b0, b1;" );
+	}
 }
@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "FGBench.h"
+
+namespace FG
+{
+
+	bool FGBench::Bench_DispatchCompute ()
+	{
+		ComputePipelineDesc	ppln;
+
+		ppln.AddShader( EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(compute)
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+layout(rgba8) readonly  uniform image2D  un_InImage;
+layout(rgba8) writeonly uniform image2D  un_OutImage;
+
+void main ()
+{
+	ivec2	coord = ivec2(gl_GlobalInvocationID.xy);
+	imageStore( un_OutImage, coord, imageLoad( un_InImage, coord ) * 0.5 );
+}
+)#" );
+
+		const uint		chain_count		= 16;
+		const uint		chain_length	= 32;
+		const uint2		image_dim		= {256, 256};
+
+		CPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+		// each chain uses two images in ping-pong mode, so every dispatch depends on the previous one
+		ImageID			images [chain_count][2];
+		for (auto& chain : images)
+		for (auto& img : chain)
+		{
+			img = _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{image_dim.x, image_dim.y, 1}, EPixelFormat::RGBA8_UNorm,
+													   EImageUsage::Storage }, Default, "Image" );
+			CHECK_ERR( img );
+		}
+
+		PipelineResources	resources;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources ));
+
+		const auto	RecordFrame = [&] (const CommandBuffer &cmd) -> uint
+		{
+			for (uint c = 0; c < chain_count; ++c)
+			{
+				Task	t_prev = null;
+
+				for (uint i = 0; i < chain_length; ++i)
+				{
+					resources.BindImage( UniformID("un_InImage"),  images[c][i&1] );
+					resources.BindImage( UniformID("un_OutImage"), images[c][(i+1)&1] );
+
+					t_prev = cmd->AddTask( DispatchCompute{}.SetPipeline( pipeline ).AddResources( DescriptorSetID("0"), &resources )
+															.Dispatch( image_dim / 8 ).DependsOn( t_prev ));
+				}
+			}
+			return chain_count * chain_length;
+		};
+
+		CHECK_ERR( _RunFrames( "DispatchCompute: "s << ToString(chain_count) << " chains x " << ToString(chain_length) << " dispatches", RecordFrame ));
+
+		for (auto& chain : images)
+		for (auto& img : chain) {
+			DeleteResources( img );
+		}
+		DeleteResources( pipeline );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,121 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "FGBench.h"
+
+namespace FG
+{
+
+	bool FGBench::Bench_DrawIndexed ()
+	{
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(set=0, binding=0, std140) uniform PerObjectUB {
+	vec4	offset;
+	vec4	color;
+};
+
+in  vec2  at_Position;
+
+layout(location=0) out vec3  v_Color;
+
+void main() {
+	gl_Position	= vec4( at_Position + offset.xy, 0.0, 1.0 );
+	v_Color		= color.rgb;
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+layout(location=0) in  vec3  v_Color;
+
+void main() {
+	out_Color = vec4(v_Color, 1.0);
+}
+)#" );
+
+		struct Vertex
+		{
+			float2		position;
+		};
+
+		const uint		pass_count		= 8;
+		const uint		draws_per_pass	= 256;
+		const uint		index_count		= 6 * 64;
+		const uint2		view_size		= {800, 600};
+		const BytesU	ub_size			= 32_b;
+
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+		BufferID		vbuffer		= _frameGraph->CreateBuffer( BufferDesc{ SizeOf<Vertex> * 4 * 64, EBufferUsage::Vertex | EBufferUsage::TransferDst }, Default, "VertexBuffer" );
+		BufferID		ibuffer		= _frameGraph->CreateBuffer( BufferDesc{ SizeOf<uint16_t> * index_count, EBufferUsage::Index | EBufferUsage::TransferDst }, Default, "IndexBuffer" );
+		BufferID		ubuffer0	= _frameGraph->CreateBuffer( BufferDesc{ ub_size, EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "UniformBuffer0" );
+		BufferID		ubuffer1	= _frameGraph->CreateBuffer( BufferDesc{ ub_size, EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "UniformBuffer1" );
+		CHECK_ERR( vbuffer and ibuffer and ubuffer0 and ubuffer1 );
+
+		ImageID			images [pass_count];
+		for (auto& img : images)
+		{
+			img = _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+													   EImageUsage::ColorAttachment | EImageUsage::TransferSrc }, Default, "RenderTarget" );
+			CHECK_ERR( img );
+		}
+
+		PipelineResources	resources0;
+		PipelineResources	resources1;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources0 ));
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources1 ));
+		resources0.BindBuffer( UniformID("PerObjectUB"), ubuffer0 );
+		resources1.BindBuffer( UniformID("PerObjectUB"), ubuffer1 );
+
+		const VertexInputState	vertex_input = VertexInputState{}.Bind( VertexBufferID(), SizeOf<Vertex> )
+														.Add( VertexID("at_Position"), &Vertex::position );
+
+		const auto	RecordFrame = [&] (const CommandBuffer &cmd) -> uint
+		{
+			uint	task_count = 0;
+			Task	t_prev		= null;
+
+			for (uint p = 0; p < pass_count; ++p)
+			{
+				LogicalPassID	pass = cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID(0), images[p], RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ));
+
+				for (uint d = 0; d < draws_per_pass; ++d)
+				{
+					cmd->AddTask( pass, DrawIndexed{}.SetPipeline( pipeline )
+											.AddResources( DescriptorSetID("0"), (d & 1 ? &resources1 : &resources0) )
+											.AddBuffer( VertexBufferID(), vbuffer ).SetVertexInput( vertex_input )
+											.SetTopology( EPrimitive::TriangleList )
+											.SetIndexBuffer( ibuffer, 0_b, EIndex::UShort )
+											.Draw( index_count ));
+				}
+				task_count += draws_per_pass;
+
+				t_prev = cmd->AddTask( SubmitRenderPass{ pass }.DependsOn( t_prev ));
+				++task_count;
+			}
+			return task_count;
+		};
+
+		CHECK_ERR( _RunFrames( "DrawIndexed: "s << ToString(pass_count) << " passes x " << ToString(draws_per_pass) << " draws", RecordFrame ));
+
+		for (auto& img : images) {
+			DeleteResources( img );
+		}
+		DeleteResources( pipeline, vbuffer, ibuffer, ubuffer0, ubuffer1 );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,56 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "FGBench.h"
+
+namespace FG
+{
+
+	bool FGBench::Bench_Upload ()
+	{
+		const uint		buffer_count	= 64;
+		const uint		image_count		= 32;
+		const BytesU	buffer_size		= 16_Kb;
+		const uint2		image_dim		= {64, 64};
+
+		BufferID		buffers [buffer_count];
+		ImageID			images [image_count];
+
+		for (auto& buf : buffers)
+		{
+			buf = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "Buffer" );
+			CHECK_ERR( buf );
+		}
+		for (auto& img : images)
+		{
+			img = _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{image_dim.x, image_dim.y, 1}, EPixelFormat::RGBA8_UNorm,
+													   EImageUsage::Sampled | EImageUsage::TransferDst }, Default, "Image" );
+			CHECK_ERR( img );
+		}
+
+		Array<uint8_t>	buffer_data;	buffer_data.resize( size_t(buffer_size) );
+		Array<uint8_t>	image_data;		image_data.resize( size_t(image_dim.x * image_dim.y * 4) );
+
+		const auto	RecordFrame = [&] (const CommandBuffer &cmd) -> uint
+		{
+			for (auto& buf : buffers) {
+				cmd->AddTask( UpdateBuffer{}.SetBuffer( buf ).AddData( buffer_data ));
+			}
+			for (auto& img : images) {
+				cmd->AddTask( UpdateImage{}.SetImage( img ).SetData( image_data, image_dim ));
+			}
+			return buffer_count + image_count;
+		};
+
+		CHECK_ERR( _RunFrames( "Upload: "s << ToString(buffer_count) << " buffers x " << ToString(buffer_size) << ", "
+										  << ToString(image_count) << " images x " << ToString(image_dim), RecordFrame ));
+
+		for (auto& buf : buffers) {
+			DeleteResources( buf );
+		}
+		for (auto& img : images) {
+			DeleteResources( img );
+		}
+		return true;
+	}
+
+}	// FG
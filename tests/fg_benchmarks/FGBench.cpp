@@ -0,0 +1,257 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "FGBench.h"
+#include "pipeline_compiler/VPipelineCompiler.h"
+#include "vulkan_loader/VulkanNullDriver.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	static std::atomic<uint64_t>	s_AllocationCounter {0};
+}
+
+/*
+=================================================
+	operator new / delete
+----
+	count all heap allocations to detect
+	allocations per frame
+=================================================
+*/
+	void* operator new (size_t size)
+	{
+		s_AllocationCounter.fetch_add( 1, std::memory_order_relaxed );
+
+		if ( void* ptr = std::malloc( size ? size : 1 ))
+			return ptr;
+
+		throw std::bad_alloc{};
+	}
+
+	void operator delete (void* ptr) noexcept
+	{
+		std::free( ptr );
+	}
+
+	void operator delete (void* ptr, size_t) noexcept
+	{
+		std::free( ptr );
+	}
+//-----------------------------------------------------------------------------
+
+
+namespace FG
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	FGBench::FGBench ()
+	{
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	FGBench::~FGBench ()
+	{
+		_Destroy();
+	}
+
+/*
+=================================================
+	_GetAllocationCount
+=================================================
+*/
+	uint64_t  FGBench::_GetAllocationCount ()
+	{
+		return s_AllocationCounter.load( std::memory_order_relaxed );
+	}
+
+/*
+=================================================
+	_Initialize
+=================================================
+*/
+	bool FGBench::_Initialize ()
+	{
+		CHECK_ERR( VulkanLoader::InitializeNullDriver() );
+
+		// initialize vulkan device
+		CHECK_ERR( _vulkan.Create( "Benchmark", "FrameGraph", VK_API_VERSION_1_1,
+								   "",
+								   {{ VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_SPARSE_BINDING_BIT, 0.0f },
+									{ VK_QUEUE_COMPUTE_BIT,  0.0f },
+									{ VK_QUEUE_TRANSFER_BIT, 0.0f }}
+								));
+
+		// setup device info
+		VulkanDeviceInfo	vulkan_info;
+		{
+			vulkan_info.instance		= BitCast<InstanceVk_t>( _vulkan.GetVkInstance() );
+			vulkan_info.physicalDevice	= BitCast<PhysicalDeviceVk_t>( _vulkan.GetVkPhysicalDevice() );
+			vulkan_info.device			= BitCast<DeviceVk_t>( _vulkan.GetVkDevice() );
+
+			for (auto& q : _vulkan.GetVkQueues())
+			{
+				VulkanDeviceInfo::QueueInfo	qi;
+				qi.handle		= BitCast<QueueVk_t>( q.handle );
+				qi.familyFlags	= BitCast<QueueFlagsVk_t>( q.flags );
+				qi.familyIndex	= q.familyIndex;
+				qi.priority		= q.priority;
+				qi.debugName	= "";
+
+				vulkan_info.queues.push_back( qi );
+			}
+		}
+
+		// initialize framegraph
+		{
+			_frameGraph = IFrameGraph::CreateFrameGraph( vulkan_info );
+			CHECK_ERR( _frameGraph );
+		}
+
+		// add glsl pipeline compiler
+		{
+			_pplnCompiler = MakeShared<VPipelineCompiler>( vulkan_info.physicalDevice, vulkan_info.device );
+			_pplnCompiler->SetCompilationFlags( EShaderCompilationFlags::AutoMapLocations	|
+												EShaderCompilationFlags::Quiet				|
+												EShaderCompilationFlags::ParseAnnoations	|
+												EShaderCompilationFlags::UseCurrentDeviceLimits );
+
+			_frameGraph->AddPipelineCompiler( _pplnCompiler );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_Destroy
+=================================================
+*/
+	void FGBench::_Destroy ()
+	{
+		if ( _frameGraph )
+		{
+			_frameGraph->Deinitialize();
+			_frameGraph = null;
+		}
+
+		_pplnCompiler = null;
+
+		if ( _vulkan.GetVkDevice() )
+		{
+			_vulkan.Destroy();
+			VulkanLoader::Unload();
+		}
+	}
+
+/*
+=================================================
+	_RunFrames
+----
+	'AddTask' time includes all CPU work in 'record' function,
+	waiting is not included in any counter.
+=================================================
+*/
+	bool FGBench::_RunFrames (StringView name, const RecordFrame_t &record)
+	{
+		FrameStat	stat;
+
+		for (uint i = 0; i < _warmupFrames + _frameCount; ++i)
+		{
+			if ( i == _warmupFrames )
+			{
+				IFrameGraph::Statistics		temp;
+				CHECK_ERR( _frameGraph->GetStatistics( OUT temp ));	// reset statistics
+				VulkanNullDriver::ResetStatistics();
+			}
+
+			const uint64_t	alloc_start	= _GetAllocationCount();
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			const auto		t0		= Clock_t::now();
+			const uint		tasks	= record( cmd );
+			const auto		t1		= Clock_t::now();
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			const auto		t2		= Clock_t::now();
+
+			CHECK_ERR( _frameGraph->Flush() );
+			const auto		t3		= Clock_t::now();
+
+			const uint64_t	alloc_end	= _GetAllocationCount();
+
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			if ( i < _warmupFrames )
+				continue;
+
+			stat.frames			+= 1;
+			stat.tasks			+= tasks;
+			stat.allocations	+= (alloc_end - alloc_start);
+			stat.addTask		+= std::chrono::duration_cast<Nanoseconds>( t1 - t0 );
+			stat.execute		+= std::chrono::duration_cast<Nanoseconds>( t2 - t1 );
+			stat.flush			+= std::chrono::duration_cast<Nanoseconds>( t3 - t2 );
+		}
+
+		CHECK_ERR( stat.frames > 0 and stat.tasks > 0 );
+
+		IFrameGraph::Statistics	fg_stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT fg_stat ));
+
+		const auto		drv_stat	= VulkanNullDriver::GetStatistics();
+		const double	tasks		= double(stat.tasks);
+		const double	frames		= double(stat.frames);
+		String			str;
+
+		str << "\n--------------------------------------------------"
+			<< "\n" << name
+			<< "\n  tasks per frame:       " << ToString( tasks / frames, 1 )
+			<< "\n  AddTask, ns/task:      " << ToString( double(stat.addTask.count()) / tasks, 1 )
+			<< "\n  Execute, ns/task:      " << ToString( double(stat.execute.count()) / tasks, 1 )
+			<< "\n  Flush, ns/task:        " << ToString( double(stat.flush.count()) / tasks, 1 )
+			<< "\n  allocations per frame: " << ToString( double(stat.allocations) / frames, 1 )
+			<< "\n  vk commands per frame: " << ToString( double(drv_stat.commands) / frames, 1 )
+			<< "\n  barriers per frame:    " << ToString( double(drv_stat.pipelineBarriers) / frames, 1 )
+			<< "\n  barrier structs:       " << ToString( double(fg_stat.renderer.pipelineBarriersBeforeMerge) / frames, 1 )
+			<< " -> " << ToString( double(fg_stat.renderer.pipelineBarriers) / frames, 1 ) << " after merging"
+			<< "\n  submits per frame:     " << ToString( double(drv_stat.queueSubmits) / frames, 1 );
+
+		FG_LOGI( str );
+		return true;
+	}
+
+/*
+=================================================
+	Run
+=================================================
+*/
+	bool FGBench::Run ()
+	{
+		FGBench		bench;
+		CHECK_ERR( bench._Initialize() );
+
+		const BenchFunc_t	benchmarks[] = {
+			&FGBench::Bench_DrawIndexed,
+			&FGBench::Bench_DispatchCompute,
+			&FGBench::Bench_Upload
+		};
+
+		bool	result = true;
+
+		for (auto& func : benchmarks)
+		{
+			result &= (bench.*func)();
+		}
+		return result;
+	}
+
+}	// FG
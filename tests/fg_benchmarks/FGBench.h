@@ -0,0 +1,101 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Measures CPU overhead of the frame graph on synthetic frames.
+	Vulkan is replaced by the null driver, so results don't depend on GPU and driver.
+*/
+
+#pragma once
+
+#include "framework/Vulkan/VulkanDevice.h"
+#include "framegraph/FG.h"
+#include "stl/Algorithms/StringUtils.h"
+#include <chrono>
+#include <functional>
+
+namespace FG
+{
+
+	//
+	// Frame Graph Benchmark Application
+	//
+
+	class FGBench final
+	{
+	// types
+	private:
+		using BenchFunc_t			= bool (FGBench::*) ();
+		using VPipelineCompilerPtr	= SharedPtr< class VPipelineCompiler >;
+		using Clock_t				= std::chrono::high_resolution_clock;
+
+		struct FrameStat
+		{
+			uint64_t		frames		= 0;
+			uint64_t		tasks		= 0;
+			uint64_t		allocations	= 0;
+			Nanoseconds		addTask		{0};
+			Nanoseconds		execute		{0};
+			Nanoseconds		flush		{0};
+		};
+
+		// records tasks into the command buffer and returns number of added tasks
+		using RecordFrame_t	= std::function< uint (const CommandBuffer &) >;
+
+
+	// variables
+	private:
+		VulkanDevice			_vulkan;
+		FrameGraph				_frameGraph;
+		VPipelineCompilerPtr	_pplnCompiler;
+
+		static constexpr uint	_warmupFrames	= 8;
+		static constexpr uint	_frameCount		= 100;
+
+
+	// methods
+	public:
+		FGBench ();
+		~FGBench ();
+
+		static bool Run ();
+
+
+	// helpers
+	private:
+		bool _Initialize ();
+		void _Destroy ();
+
+		bool _RunFrames (StringView name, const RecordFrame_t &record);
+
+		template <typename ...Args>
+		void DeleteResources (Args& ...args);
+
+		template <typename Arg0, typename ...Args>
+		void _RecursiveDeleteResources (Arg0 &arg0, Args& ...args);
+
+		ND_ static uint64_t  _GetAllocationCount ();
+
+
+	// benchmarks
+	private:
+		bool Bench_DrawIndexed ();
+		bool Bench_DispatchCompute ();
+		bool Bench_Upload ();
+	};
+
+
+	template <typename ...Args>
+	inline void  FGBench::DeleteResources (Args& ...args)
+	{
+		_RecursiveDeleteResources( std::forward<Args&>( args )... );
+	}
+
+	template <typename Arg0, typename ...Args>
+	inline void  FGBench::_RecursiveDeleteResources (Arg0 &arg0, Args& ...args)
+	{
+		_frameGraph->ReleaseResource( INOUT arg0 );
+
+		if constexpr ( CountOf<Args...>() )
+			_RecursiveDeleteResources( std::forward<Args&>( args )... );
+	}
+
+}	// FG
@@ -0,0 +1,14 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "FGBench.h"
+
+using namespace FG;
+
+
+int main ()
+{
+	CHECK_FATAL( FGBench::Run() );
+
+	FG_LOGI( "fg_benchmarks finished" );
+	return 0;
+}
@@ -58,6 +58,18 @@ namespace {
 		_tests.push_back({ &FGApp::ImplTest_Multithreading2, 1 });
 		_tests.push_back({ &FGApp::ImplTest_Multithreading3, 1 });
 		_tests.push_back({ &FGApp::ImplTest_Multithreading4, 1 });
+		_tests.push_back({ &FGApp::ImplTest_Multithreading5, 1 });
+		_tests.push_back({ &FGApp::ImplTest_QueueSubmit1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_RedundantBinds1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_ParallelRecording1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_ParallelRecording2, 1 });
+		_tests.push_back({ &FGApp::ImplTest_AsyncPipeline1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_PipelinePrewarm1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_PipelineCache1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_TransientResources1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_StagingRing1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_ZeroCopyUpload1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_AsyncReadback1, 1 });
 		
 		// RTX only
 		_tests.push_back({ &FGApp::Test_DrawMeshes1,		1 });
@@ -141,6 +153,12 @@ namespace {
 			vulkan_info.instance		= BitCast<InstanceVk_t>( _vulkan.GetVkInstance() );
 			vulkan_info.physicalDevice	= BitCast<PhysicalDeviceVk_t>( _vulkan.GetVkPhysicalDevice() );
 			vulkan_info.device			= BitCast<DeviceVk_t>( _vulkan.GetVkDevice() );
+		#ifdef VK_KHR_timeline_semaphore
+			vulkan_info.timelineSemaphore	= _vulkan.GetDeviceTimelineSemaphoreFeatures().timelineSemaphore;
+		#endif
+		#ifdef VK_EXT_pipeline_creation_feedback
+			vulkan_info.creationFeedback	= _vulkan.HasDeviceExtension( VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME );
+		#endif
 			
 			VulkanSwapchainCreateInfo	swapchain_ci;
 			swapchain_ci.surface		= BitCast<SurfaceVk_t>( _vulkan.GetVkSurface() );
@@ -85,6 +85,18 @@ namespace FG
 		bool ImplTest_Multithreading2 ();
 		bool ImplTest_Multithreading3 ();
 		bool ImplTest_Multithreading4 ();
+		bool ImplTest_Multithreading5 ();
+		bool ImplTest_QueueSubmit1 ();
+		bool ImplTest_RedundantBinds1 ();
+		bool ImplTest_ParallelRecording1 ();
+		bool ImplTest_ParallelRecording2 ();
+		bool ImplTest_AsyncPipeline1 ();
+		bool ImplTest_PipelinePrewarm1 ();
+		bool ImplTest_PipelineCache1 ();
+		bool ImplTest_TransientResources1 ();
+		bool ImplTest_StagingRing1 ();
+		bool ImplTest_ZeroCopyUpload1 ();
+		bool ImplTest_AsyncReadback1 ();
 
 
 	// drawing tests
@@ -0,0 +1,91 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_AsyncPipeline1 ()
+	{
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2(-1.0,  3.0),
+	vec2( 3.0, -1.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4( 0.0, 1.0, 0.0, 1.0 );
+}
+)#" );
+
+		const uint2		view_size	= {256, 256};
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::ColorAttachment | EImageUsage::TransferSrc }, Default, "RenderTarget" );
+
+		GPipelineID		pipeline	= _frameGraph->CreatePipelineAsync( ppln, "AsyncPipeline" );
+		CHECK_ERR( pipeline );
+
+		// wait for shader compilation on the worker thread
+		for (uint i = 0; i < 10'000 and not _frameGraph->IsPipelineReady( pipeline ); ++i) {
+			std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+		}
+		CHECK_ERR( _frameGraph->IsPipelineReady( pipeline ));
+
+
+		bool		data_is_correct = false;
+
+		const auto	OnLoaded =	[OUT &data_is_correct] (const ImageView &imageData)
+		{
+			RGBA32f	col;
+			imageData.Load( uint3(imageData.Dimension().x / 2, imageData.Dimension().y / 2, 0), OUT col );
+
+			data_is_correct = All(Equals( col, RGBA32f{0.0f, 1.0f, 0.0f, 1.0f}, 0.1f ));
+			ASSERT( data_is_correct );
+		};
+
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID(0), image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ) );
+
+		cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ));
+
+		Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+		Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw ) );
+		FG_UNUSED( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( data_is_correct );
+
+		DeleteResources( image, pipeline );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_AsyncReadback1 ()
+	{
+		const BytesU	buf_size	= 64_Kb;
+		const uint2		img_dim		= {64, 32};
+		BufferID		buffer		= _frameGraph->CreateBuffer( BufferDesc{ buf_size, EBufferUsage::Transfer }, Default, "Buffer" );
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{img_dim.x, img_dim.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::Transfer }, Default, "Image" );
+		CHECK_ERR( buffer and image );
+
+		Array<uint>		buf_data;
+		Array<RGBA8u>	img_data;
+
+		buf_data.resize( size_t(buf_size / SizeOf<uint>) );
+		for (size_t i = 0; i < buf_data.size(); ++i) {
+			buf_data[i] = uint(i) * 7;
+		}
+
+		img_data.resize( img_dim.x * img_dim.y );
+		for (uint y = 0; y < img_dim.y; ++y)
+		for (uint x = 0; x < img_dim.x; ++x) {
+			img_data[x + y * img_dim.x] = RGBA8u{ uint8_t(x * 4), uint8_t(y * 8), 0, 255 };
+		}
+
+		const auto	render_thread	= std::this_thread::get_id();
+		bool		cb_is_async		= false;
+		bool		cb_is_called	= false;
+
+		const auto	OnLoaded = [render_thread, OUT &cb_is_async, OUT &cb_is_called] (BufferView)
+		{
+			cb_is_async		= (std::this_thread::get_id() != render_thread);
+			cb_is_called	= true;
+		};
+
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		BufferReadback	buf_result;
+		ImageReadback	img_result;
+		
+		Task	t_update0	= cmd->AddTask( UpdateBuffer{}.SetBuffer( buffer ).AddData( buf_data ));
+		Task	t_update1	= cmd->AddTask( UpdateImage{}.SetImage( image ).SetData( img_data.data(), img_data.size(), img_dim ));
+		Task	t_read0		= cmd->AddTask( ReadBuffer{}.SetBuffer( buffer, 0_b, buf_size ).SetFuture( OUT buf_result ).DependsOn( t_update0 ));
+		Task	t_read1		= cmd->AddTask( ReadImage{}.SetImage( image, int2(), img_dim ).SetFuture( OUT img_result ).DependsOn( t_update1 ));
+		Task	t_read2		= cmd->AddTask( ReadBuffer{}.SetBuffer( buffer, 0_b, 16_b ).SetAsyncCallback( OnLoaded ).DependsOn( t_update0 ));
+		FG_UNUSED( t_read0, t_read1, t_read2 );
+
+		CHECK_ERR( buf_result.IsValid() and img_result.IsValid() );
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->Wait({ cmd }));
+
+		// check buffer data
+		{
+			BufferView const&	view	= buf_result.Get();
+			CHECK_ERR( view.size() == size_t(buf_size) );
+			CHECK_ERR( view.Parts().size() == 1 );
+
+			const uint*		ptr		= Cast<uint>( view.Parts()[0].data() );
+			bool			is_eq	= true;
+
+			for (size_t i = 0; i < buf_data.size(); ++i) {
+				is_eq &= (ptr[i] == buf_data[i]);
+			}
+			CHECK_ERR( is_eq );
+		}
+
+		// check image data
+		{
+			ImageView const&	view	= img_result.Get();
+			CHECK_ERR( All( view.Dimension() == uint3{img_dim.x, img_dim.y, 1} ));
+			CHECK_ERR( view.Format() == EPixelFormat::RGBA8_UNorm );
+
+			bool	is_eq = true;
+
+			for (uint y = 0; y < img_dim.y; ++y)
+			for (uint x = 0; x < img_dim.x; ++x)
+			{
+				RGBA32f	col;
+				view.Load( uint3(x, y, 0), OUT col );
+
+				is_eq &= All(Equals( col, RGBA32f{img_data[x + y * img_dim.x]}, 0.01f ));
+			}
+			CHECK_ERR( is_eq );
+		}
+
+		// continuation is called immediately because data is ready
+		bool	continuation_called = false;
+		buf_result.Then( [&continuation_called] (const BufferView &) { continuation_called = true; });
+		CHECK_ERR( continuation_called );
+
+		// 'WaitIdle' waits for asynchronous callbacks
+		CHECK_ERR( _frameGraph->WaitIdle() );
+		CHECK_ERR( cb_is_called );
+		CHECK_ERR( cb_is_async );
+
+		DeleteResources( buffer, image );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
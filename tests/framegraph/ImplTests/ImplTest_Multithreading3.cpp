@@ -149,8 +149,11 @@ void main() {
 		
 		pipeline = _frameGraph->CreatePipeline( ppln );
 		
-		bool			thread1_result;
-		bool			thread2_result;
+		bool						thread1_result;
+		bool						thread2_result;
+		IFrameGraph::Statistics		stat;
+		
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));	// reset statistics
 
 		std::thread		thread1( [this, &thread1_result]() { thread1_result = RenderThread1( _frameGraph ); });
 		std::thread		thread2( [this, &thread2_result]() { thread2_result = RenderThread2( _frameGraph ); });
@@ -161,6 +164,12 @@ void main() {
 		CHECK_ERR( _frameGraph->WaitIdle() );
 		CHECK_ERR( thread1_result and thread2_result );
 		
+		// batches from both threads are flushed together, so they should be coalesced into a single 'vkQueueSubmit'
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.renderer.submittedBatches >= max_count * 2 );
+		CHECK_ERR( stat.renderer.queueSubmits < stat.renderer.submittedBatches );
+		FG_LOGI( TEST_NAME << ": " << ToString( stat.renderer.queueSubmits ) << " submits for " << ToString( stat.renderer.submittedBatches ) << " batches" );
+		
 		for (auto& cmd : cmdBuffers) { cmd = null; }
 		for (auto& cmd : perFrame) { cmd = null; }
 
@@ -0,0 +1,89 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_Multithreading5 ()
+	{
+		using TimePoint_t = std::chrono::high_resolution_clock::time_point;
+
+		const uint		batches_per_thread	= 1000;
+		const uint		max_threads			= Max( 4u, std::thread::hardware_concurrency() );
+		const uint		thread_counts[]		= { 1, 2, 4, max_threads };
+		FrameGraph &	fg					= _frameGraph;
+		uint			last_count			= 0;
+
+		// submission throughput, the same workload is recorded and submitted from 1, 2, 4 and N threads
+		for (uint thread_count : thread_counts)
+		{
+			if ( thread_count <= last_count )
+				continue;
+
+			last_count = thread_count;
+
+			Array<BufferID>		buffers;
+			Array<std::thread>	threads;
+			std::atomic<bool>	result	{true};
+
+			for (uint t = 0; t < thread_count; ++t) {
+				buffers.push_back( fg->CreateBuffer( BufferDesc{ 256_b, EBufferUsage::TransferDst }, Default, "Buffer" ));
+			}
+			CHECK_ERR( fg->WaitIdle() );
+
+			const auto	start_time = TimePoint_t::clock::now();
+
+			for (uint t = 0; t < thread_count; ++t)
+			{
+				threads.emplace_back( [&fg, &buffers, &result, t] ()
+				{
+					CommandBuffer	per_frame[2] = {};
+
+					for (uint i = 0; i < batches_per_thread; ++i)
+					{
+						fg->Wait({ per_frame[i&1] });
+
+						CommandBuffer	cmd = fg->Begin( CommandBufferDesc{ EQueueType::Graphics });
+						if ( not cmd )
+						{
+							result = false;
+							return;
+						}
+
+						per_frame[i&1] = cmd;
+						cmd->AddTask( FillBuffer().SetBuffer( buffers[t] ).SetPattern( i ));
+
+						if ( not fg->Execute( cmd ) or not fg->Flush() )
+						{
+							result = false;
+							return;
+						}
+					}
+				});
+			}
+
+			for (auto& t : threads) {
+				t.join();
+			}
+
+			CHECK_ERR( fg->WaitIdle() );
+			CHECK_ERR( result.load() );
+
+			const auto	dt		= TimePoint_t::clock::now() - start_time;
+			const uint	total	= batches_per_thread * thread_count;
+
+			FG_LOGI( TEST_NAME << ": " << ToString( thread_count ) << " threads, " << ToString( total ) << " batches in " << ToString( dt ) << ", "
+					 << ToString( double(total) / std::chrono::duration<double>(dt).count(), 1 ) << " batches/s" );
+
+			for (auto& buf : buffers) {
+				fg->ReleaseResource( buf );
+			}
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
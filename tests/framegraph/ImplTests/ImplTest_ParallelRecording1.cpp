@@ -0,0 +1,75 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_ParallelRecording1 ()
+	{
+		static constexpr uint	chain_count	= 6;
+		const BytesU			buffer_size	= 1_Kb;
+
+		StaticArray< BufferID, chain_count >	src_buffers;
+		StaticArray< BufferID, chain_count >	dst_buffers;
+		StaticArray< bool, chain_count >		data_is_correct	= {};
+		uint									cb_counter		= 0;
+
+		for (uint i = 0; i < chain_count; ++i)
+		{
+			src_buffers[i] = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "SrcBuffer-"s << ToString(i) );
+			dst_buffers[i] = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "DstBuffer-"s << ToString(i) );
+		}
+
+		// each chain doesn't share resources with other chains, so chains can be recorded in parallel
+		CommandBuffer	cmd1 = _frameGraph->Begin( CommandBufferDesc{}.SetRecordingThreads( 4 ));
+		CHECK_ERR( cmd1 );
+
+		for (uint i = 0; i < chain_count; ++i)
+		{
+			Task	t_fill	= cmd1->AddTask( FillBuffer().SetBuffer( src_buffers[i] ).SetPattern( 0x01010101u * (i+1) ));
+			Task	t_copy	= cmd1->AddTask( CopyBuffer().From( src_buffers[i] ).To( dst_buffers[i] ).AddRegion( 0_b, 0_b, buffer_size ).DependsOn( t_fill ));
+			FG_UNUSED( t_copy );
+		}
+
+		CHECK_ERR( _frameGraph->Execute( cmd1 ));
+
+		// staging buffer is shared between all 'ReadBuffer' tasks, so they are recorded on the calling thread
+		CommandBuffer	cmd2 = _frameGraph->Begin( CommandBufferDesc{}.SetRecordingThreads( 4 ), {cmd1} );
+		CHECK_ERR( cmd2 );
+
+		for (uint i = 0; i < chain_count; ++i)
+		{
+			const auto	OnLoaded = [i, buffer_size, OUT &cb_counter, OUT &data_is_correct] (BufferView data)
+			{
+				bool	is_correct = (data.size() == size_t(buffer_size));
+
+				for (size_t j = 0; is_correct and j < data.size(); ++j) {
+					is_correct = (data[j] == uint8_t(i+1));
+				}
+
+				ASSERT( is_correct );
+				data_is_correct[i] = is_correct;
+				++cb_counter;
+			};
+
+			Task	t_read = cmd2->AddTask( ReadBuffer().SetBuffer( dst_buffers[i], 0_b, buffer_size ).SetCallback( OnLoaded ));
+			FG_UNUSED( t_read );
+		}
+
+		CHECK_ERR( _frameGraph->Execute( cmd2 ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( cb_counter == chain_count );
+
+		for (uint i = 0; i < chain_count; ++i)
+		{
+			CHECK_ERR( data_is_correct[i] );
+			DeleteResources( src_buffers[i], dst_buffers[i] );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
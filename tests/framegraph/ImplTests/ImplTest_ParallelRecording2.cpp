@@ -0,0 +1,131 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_ParallelRecording2 ()
+	{
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2(-1.0,  3.0),
+	vec2( 3.0, -1.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (push_constant, std140) uniform PushConst {
+	vec4	color;
+} pc;
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = pc.color;
+}
+)#" );
+
+		static constexpr uint	thread_count	= 4;
+		const uint2				view_size		= {800, 600};
+		const uint2				half_size		= view_size / 2;
+		const RGBA32f			colors[]		= { RGBA32f{1.0f, 0.0f, 0.0f, 1.0f}, RGBA32f{0.0f, 1.0f, 0.0f, 1.0f},
+													RGBA32f{0.0f, 0.0f, 1.0f, 1.0f}, RGBA32f{1.0f, 1.0f, 0.0f, 1.0f} };
+		STATIC_ASSERT( CountOf(colors) == thread_count );
+
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::ColorAttachment | EImageUsage::TransferSrc }, Default, "RenderTarget" );
+
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+
+		bool		data_is_correct = false;
+
+		const auto	OnLoaded =	[&colors, OUT &data_is_correct] (const ImageView &imageData)
+		{
+			const auto	TestPixel = [&imageData] (float x, float y, const RGBA32f &color)
+			{
+				uint	ix	 = uint( (x + 1.0f) * 0.5f * float(imageData.Dimension().x) + 0.5f );
+				uint	iy	 = uint( (y + 1.0f) * 0.5f * float(imageData.Dimension().y) + 0.5f );
+
+				RGBA32f	col;
+				imageData.Load( uint3(ix, iy, 0), OUT col );
+
+				bool	is_equal = All(Equals( col, color, 0.1f ));
+				ASSERT( is_equal );
+				return is_equal;
+			};
+
+			data_is_correct  = true;
+			data_is_correct &= TestPixel(-0.5f, -0.5f, colors[0] );
+			data_is_correct &= TestPixel( 0.5f, -0.5f, colors[1] );
+			data_is_correct &= TestPixel(-0.5f,  0.5f, colors[2] );
+			data_is_correct &= TestPixel( 0.5f,  0.5f, colors[3] );
+		};
+
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID(0), image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ) );
+
+		StaticArray< IDrawCommandBuffer*, thread_count >	secondaries;
+		for (auto& secondary : secondaries)
+		{
+			secondary = cmd->BeginSecondary( render_pass );
+			CHECK_ERR( secondary );
+		}
+
+		// each thread draws one quarter of the render target
+		StaticArray< std::thread, thread_count >	threads;
+		for (uint i = 0; i < thread_count; ++i)
+		{
+			threads[i] = std::thread{ [&, i] ()
+				{
+					const int2	offset	= int2( int(i & 1), int(i >> 1) ) * int2(half_size);
+
+					secondaries[i]->AddTask( DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList )
+													.AddScissor( RectI{ offset, offset + int2(half_size) })
+													.AddPushConstant( PushConstantID("PushConst"), colors[i] ));
+				}};
+		}
+
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+		Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw ) );
+		FG_UNUSED( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( data_is_correct );
+
+		DeleteResources( image, pipeline );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
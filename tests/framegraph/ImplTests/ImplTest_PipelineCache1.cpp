@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include "stl/Stream/FileStream.h"
+#include <cstdio>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_PipelineCache1 ()
+	{
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2(-1.0,  3.0),
+	vec2( 3.0, -1.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4( 0.0, 0.0, 1.0, 1.0 );
+}
+)#" );
+
+		const char		file_name[]		= "ImplTest_PipelineCache1.bin";
+		const char		bad_file_name[]	= "ImplTest_PipelineCache1_bad.bin";
+		const size_t	header_size		= 16 + VK_UUID_SIZE;	// VkPipelineCacheHeaderVersionOne
+		const uint2		view_size		= {256, 256};
+		ImageID			image			= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			  EImageUsage::ColorAttachment | EImageUsage::TransferSrc }, Default, "RenderTarget" );
+		GPipelineID		pipeline		= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+		const auto	ReadFile = [] (StringView name, OUT Array<uint8_t> &data)
+		{
+			FileRStream		file{ name };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Read( size_t(file.Size()), OUT data ));
+			return true;
+		};
+
+		std::remove( file_name );
+		std::remove( bad_file_name );
+
+		// file doesn't exist, it will be created
+		CHECK_ERR( _frameGraph->SetPipelineCacheFile( file_name ));
+
+		// create pipeline instance
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID(0), image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ) );
+
+			cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ));
+			cmd->AddTask( SubmitRenderPass{ render_pass });
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+		}
+
+		// save cache to the file
+		CHECK_ERR( _frameGraph->SetPipelineCacheFile( "" ));
+
+		Array<uint8_t>	saved;
+		CHECK_ERR( ReadFile( file_name, OUT saved ));
+		CHECK_ERR( saved.size() >= header_size );
+
+		// cache is created for the same device and driver version
+		CHECK_ERR( _frameGraph->SetPipelineCacheFile( file_name ));
+		CHECK_ERR( _frameGraph->SetPipelineCacheFile( "" ));
+
+		// file with different pipeline cache UUID must be rejected and replaced
+		{
+			Array<uint8_t>	bad = saved;
+			bad[16] ^= 0xFF;
+
+			FileWStream		file{ bad_file_name };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Write( ArrayView<uint8_t>{ bad }));
+		}
+		CHECK_ERR( not _frameGraph->SetPipelineCacheFile( bad_file_name ));
+		CHECK_ERR( _frameGraph->SetPipelineCacheFile( "" ));
+
+		Array<uint8_t>	replaced;
+		CHECK_ERR( ReadFile( bad_file_name, OUT replaced ));
+		CHECK_ERR( replaced.size() >= header_size );
+		CHECK_ERR( std::memcmp( replaced.data(), saved.data(), header_size ) == 0 );
+
+		DeleteResources( image, pipeline );
+		std::remove( file_name );
+		std::remove( bad_file_name );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
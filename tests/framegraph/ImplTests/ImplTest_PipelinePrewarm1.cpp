@@ -0,0 +1,100 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include <cstdio>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_PipelinePrewarm1 ()
+	{
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2(-1.0,  3.0),
+	vec2( 3.0, -1.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4( 0.0, 1.0, 0.0, 1.0 );
+}
+)#" );
+
+		const char		file_name[]	= "ImplTest_PipelinePrewarm1.bin";
+		const uint2		view_size	= {256, 256};
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::ColorAttachment | EImageUsage::TransferSrc }, Default, "RenderTarget" );
+		
+		const auto	Draw = [&] (const GPipelineID &pipeline)
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID(0), image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ) );
+
+			cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ));
+			cmd->AddTask( SubmitRenderPass{ render_pass });
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+			return true;
+		};
+
+		IFrameGraph::Statistics		stat;
+
+		// record pipeline permutations
+		{
+			GraphicsPipelineDesc	desc		= ppln;
+			GPipelineID				pipeline	= _frameGraph->CreatePipeline( desc );
+			CHECK_ERR( pipeline );
+
+			CHECK_ERR( Draw( pipeline ));
+			CHECK_ERR( _frameGraph->SavePipelinePermutations( file_name ));
+
+			DeleteResources( pipeline );
+		}
+
+		// pipeline instance must be created before first draw call
+		{
+			GraphicsPipelineDesc	desc		= ppln;
+			GPipelineID				pipeline	= _frameGraph->CreatePipeline( desc );
+			CHECK_ERR( pipeline );
+
+			CHECK_ERR( _frameGraph->PrewarmPipelines( file_name ));
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));	// reset statistics
+
+			CHECK_ERR( Draw( pipeline ));
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( stat.resources.newGraphicsPipelineCount == 0 );
+
+			DeleteResources( pipeline );
+		}
+
+		DeleteResources( image );
+		std::remove( file_name );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
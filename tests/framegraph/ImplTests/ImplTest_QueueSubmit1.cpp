@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_QueueSubmit1 ()
+	{
+		static constexpr uint	batch_count	= 8;
+
+		BufferID				buffers[batch_count];
+		IFrameGraph::Statistics	stat;
+
+		for (auto& buf : buffers) {
+			buf = _frameGraph->CreateBuffer( BufferDesc{ 256_b, EBufferUsage::TransferDst }, Default, "Buffer" );
+			CHECK_ERR( buf );
+		}
+
+		CHECK_ERR( _frameGraph->WaitIdle() );
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));	// reset statistics
+
+		// independent batches, they are not submitted until 'Flush'
+		for (uint i = 0; i < batch_count; ++i)
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{ EQueueType::Graphics });
+			CHECK_ERR( cmd );
+
+			cmd->AddTask( FillBuffer().SetBuffer( buffers[i] ).SetPattern( i ));
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+		}
+
+		// all batches are ready, so they must be submitted with a single 'vkQueueSubmit'
+		CHECK_ERR( _frameGraph->Flush() );
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.renderer.queueSubmits == 1 );
+		CHECK_ERR( stat.renderer.submittedBatches == batch_count );
+
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		for (auto& buf : buffers) {
+			_frameGraph->ReleaseResource( buf );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_RedundantBinds1 ()
+	{
+		GraphicsPipelineDesc	ppln1;
+
+		ppln1.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(set=0, binding=0, std140) uniform un_Transform {
+	vec4	offset;
+} ub;
+
+in  vec2	at_Position;
+
+void main() {
+	gl_Position	= vec4( at_Position + ub.offset.xy, 0.0, 1.0 );
+}
+)#" );
+
+		ppln1.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4( 1.0 );
+}
+)#" );
+
+		// uses only descriptor set 1, so pipeline layout is incompatible with 'ppln1' in set 0
+		GraphicsPipelineDesc	ppln2;
+
+		ppln2.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2(-1.0,  3.0),
+	vec2( 3.0, -1.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+		ppln2.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(set=1, binding=0, std430) readonly buffer un_Color {
+	vec4	color;
+} sb;
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = sb.color;
+}
+)#" );
+
+		struct Vertex
+		{
+			float2	position;
+		};
+
+		const uint2		view_size	= {256, 256};
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::ColorAttachment | EImageUsage::TransferSrc }, Default, "RenderTarget" );
+		BufferID		vbuffer		= _frameGraph->CreateBuffer( BufferDesc{ SizeOf<Vertex> * 3, EBufferUsage::Vertex | EBufferUsage::TransferDst }, Default, "VertexBuffer" );
+		BufferID		ubuffer		= _frameGraph->CreateBuffer( BufferDesc{ 16_b, EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "Transform" );
+		BufferID		sbuffer		= _frameGraph->CreateBuffer( BufferDesc{ 16_b, EBufferUsage::Storage | EBufferUsage::TransferDst }, Default, "Color" );
+		GPipelineID		pipeline1	= _frameGraph->CreatePipeline( ppln1 );
+		GPipelineID		pipeline2	= _frameGraph->CreatePipeline( ppln2 );
+		CHECK_ERR( pipeline1 and pipeline2 );
+
+		const VertexInputState	vertex_input = VertexInputState{}.Bind( VertexBufferID(), SizeOf<Vertex> )
+														.Add( VertexID("at_Position"), &Vertex::position );
+
+		PipelineResources	resources1;
+		PipelineResources	resources2;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline1, DescriptorSetID("0"), OUT resources1 ));
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline2, DescriptorSetID("1"), OUT resources2 ));
+
+		resources1.BindBuffer( UniformID("un_Transform"), ubuffer );
+		resources2.BindBuffer( UniformID("un_Color"), sbuffer );
+
+		const auto	Draw1 = [&] () {
+			return DrawVertices().SetVertexInput( vertex_input ).AddBuffer( VertexBufferID(), vbuffer ).Draw( 3 )
+								 .SetPipeline( pipeline1 ).SetTopology( EPrimitive::TriangleList ).AddResources( DescriptorSetID("0"), &resources1 );
+		};
+		const auto	Draw2 = [&] () {
+			return DrawVertices().Draw( 3 ).SetPipeline( pipeline2 ).SetTopology( EPrimitive::TriangleList ).AddResources( DescriptorSetID("1"), &resources2 );
+		};
+
+		const auto	Execute = [&] (ArrayView<DrawVertices> draws)
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID(0), image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ) );
+			for (auto& draw : draws) {
+				cmd->AddTask( render_pass, draw );
+			}
+
+			Task	t_fill1	= cmd->AddTask( FillBuffer().SetBuffer( vbuffer ).SetPattern( 0 ));
+			Task	t_fill2	= cmd->AddTask( FillBuffer().SetBuffer( ubuffer ).SetPattern( 0 ));
+			Task	t_fill3	= cmd->AddTask( FillBuffer().SetBuffer( sbuffer ).SetPattern( 0 ));
+			Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass }.DependsOn( t_fill1, t_fill2, t_fill3 ));
+			FG_UNUSED( t_draw );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+			return true;
+		};
+
+		IFrameGraph::Statistics		stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));	// reset statistics
+
+		// second draw uses the same descriptor set and vertex buffer
+		CHECK_ERR( Execute({ Draw1(), Draw1() }));
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.renderer.descriptorBindsSkipped == 1 );
+		CHECK_ERR( stat.renderer.vertexBufferBindingsSkipped == 1 );
+
+		// pipeline layout is changed between draw calls, so descriptor sets must be bound again,
+		// vertex buffer bindings are not disturbed by pipeline layout
+		CHECK_ERR( Execute({ Draw1(), Draw2(), Draw1() }));
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.renderer.descriptorBindsSkipped == 0 );
+		CHECK_ERR( stat.renderer.vertexBufferBindingsSkipped == 1 );
+
+		DeleteResources( image, vbuffer, ubuffer, sbuffer, pipeline1, pipeline2 );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_StagingRing1 ()
+	{
+		const BytesU	buf_size	= 4_Mb;
+		const uint		frames		= 100;	// staging ring wraps around several times
+		BufferID		buffer		= _frameGraph->CreateBuffer( BufferDesc{ buf_size, EBufferUsage::Transfer }, Default, "Buffer" );
+		CHECK_ERR( buffer );
+
+		CommandBuffer	cmd_buffers[2]	= {};
+		Array<uint>		data;
+		uint			loaded_count	= 0;
+		bool			data_is_correct	= true;
+
+		data.resize( size_t(buf_size / SizeOf<uint>) );
+
+		for (uint i = 0; i < frames; ++i)
+		{
+			// two command batches are in flight, so staging memory is released out of allocation order
+			CHECK_ERR( _frameGraph->Wait({ cmd_buffers[i&1] }));
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			cmd_buffers[i&1] = cmd;
+
+			for (size_t j = 0; j < data.size(); ++j) {
+				data[j] = uint(j) ^ (i << 24);
+			}
+
+			const auto	OnLoaded = [i, OUT &loaded_count, OUT &data_is_correct] (BufferView view)
+			{
+				size_t	index = 0;
+
+				for (auto& part : view.Parts())
+				{
+					const uint*		ptr		= Cast<uint>( part.data() );
+					const size_t	count	= part.size() / sizeof(uint);
+
+					for (size_t j = 0; j < count; ++j, ++index) {
+						data_is_correct &= (ptr[j] == (uint(index) ^ (i << 24)));
+					}
+				}
+				ASSERT( data_is_correct );
+				++loaded_count;
+			};
+
+			Task	t_update	= cmd->AddTask( UpdateBuffer{}.SetBuffer( buffer ).AddData( data ));
+			Task	t_read		= cmd->AddTask( ReadBuffer{}.SetBuffer( buffer, 0_b, buf_size ).SetCallback( OnLoaded ).DependsOn( t_update ));
+			FG_UNUSED( t_read );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+		}
+
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( loaded_count == frames );
+		CHECK_ERR( data_is_correct );
+
+		DeleteResources( buffer );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
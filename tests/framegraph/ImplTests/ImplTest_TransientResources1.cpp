@@ -0,0 +1,118 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_TransientResources1 ()
+	{
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2(-1.0,  3.0),
+	vec2( 3.0, -1.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (push_constant, std140) uniform PushConst {
+	vec4	color;
+} pc;
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = pc.color;
+}
+)#" );
+
+		const uint2		view_size	= {256, 256};
+		const uint2		dst_size	= {view_size.x * 2, view_size.y};
+		ImageID			dst_image	= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{dst_size.x, dst_size.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::TransferDst | EImageUsage::TransferSrc }, Default, "DstImage" );
+
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+
+		bool		data_is_correct = false;
+
+		const auto	OnLoaded =	[OUT &data_is_correct] (const ImageView &imageData)
+		{
+			RGBA32f	col0, col1;
+			imageData.Load( uint3(imageData.Dimension().x / 4, imageData.Dimension().y / 2, 0), OUT col0 );
+			imageData.Load( uint3(imageData.Dimension().x * 3 / 4, imageData.Dimension().y / 2, 0), OUT col1 );
+
+			data_is_correct  = All(Equals( col0, RGBA32f{1.0f, 0.0f, 0.0f, 1.0f}, 0.1f ));
+			data_is_correct &= All(Equals( col1, RGBA32f{0.0f, 1.0f, 0.0f, 1.0f}, 0.1f ));
+			ASSERT( data_is_correct );
+		};
+
+		IFrameGraph::Statistics		stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));	// reset statistics
+
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		const ImageDesc	rt_desc{ EImage::Tex2D, uint3{view_size.x, view_size.y, 1}, EPixelFormat::RGBA8_UNorm, EImageUsage::ColorAttachment | EImageUsage::TransferSrc };
+		RawImageID		rt_image0	= cmd->CreateTransientImage( rt_desc, "RenderTarget0" );
+		RawImageID		rt_image1	= cmd->CreateTransientImage( rt_desc, "RenderTarget1" );
+		CHECK_ERR( rt_image0 and rt_image1 );
+
+		// first pass
+		LogicalPassID	render_pass0 = cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID(0), rt_image0, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ) );
+
+		cmd->AddTask( render_pass0, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList )
+										.AddPushConstant( PushConstantID("PushConst"), RGBA32f{1.0f, 0.0f, 0.0f, 1.0f} ));
+
+		Task	t_draw0	= cmd->AddTask( SubmitRenderPass{ render_pass0 });
+		Task	t_copy0	= cmd->AddTask( CopyImage().From( rt_image0 ).To( dst_image ).AddRegion( {}, int2(), {}, int2(), view_size ).DependsOn( t_draw0 ));
+
+		// second pass, render target memory may be aliased with the first render target
+		LogicalPassID	render_pass1 = cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID(0), rt_image1, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ) );
+
+		cmd->AddTask( render_pass1, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList )
+										.AddPushConstant( PushConstantID("PushConst"), RGBA32f{0.0f, 1.0f, 0.0f, 1.0f} ));
+
+		Task	t_draw1	= cmd->AddTask( SubmitRenderPass{ render_pass1 }.DependsOn( t_copy0 ));
+		Task	t_copy1	= cmd->AddTask( CopyImage().From( rt_image1 ).To( dst_image ).AddRegion( {}, int2(), {}, int2(int(view_size.x), 0), view_size ).DependsOn( t_draw1 ));
+		Task	t_read	= cmd->AddTask( ReadImage().SetImage( dst_image, int2(), dst_size ).SetCallback( OnLoaded ).DependsOn( t_copy1 ));
+		FG_UNUSED( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( data_is_correct );
+
+		// render targets have non-overlapping lifetimes
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.resources.transientResources == 2 );
+		CHECK_ERR( stat.resources.transientMemoryAllocated < stat.resources.transientMemoryRequired );
+
+		DeleteResources( dst_image, pipeline );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
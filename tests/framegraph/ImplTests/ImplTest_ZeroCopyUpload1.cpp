@@ -0,0 +1,101 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_ZeroCopyUpload1 ()
+	{
+		const BytesU	buf_size	= 256_Kb;
+		const uint2		img_dim		= {125, 67};
+		BufferID		buffer		= _frameGraph->CreateBuffer( BufferDesc{ buf_size, EBufferUsage::Transfer }, Default, "Buffer" );
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{ EImage::Tex2D, uint3{img_dim.x, img_dim.y, 1}, EPixelFormat::RGBA8_UNorm,
+																			EImageUsage::Transfer }, Default, "Image" );
+		CHECK_ERR( buffer and image );
+
+		const auto	GetPixel = [] (uint x, uint y) -> RGBA8u { return RGBA8u{ uint8_t(x), uint8_t(y), uint8_t(x ^ y), 255 }; };
+
+		bool	buf_data_is_correct	= false;
+		bool	img_data_is_correct	= false;
+
+		const auto	OnBufferLoaded = [OUT &buf_data_is_correct] (BufferView view)
+		{
+			size_t	index = 0;
+			buf_data_is_correct = true;
+
+			for (auto& part : view.Parts())
+			{
+				const uint*		ptr		= Cast<uint>( part.data() );
+				const size_t	count	= part.size() / sizeof(uint);
+
+				for (size_t i = 0; i < count; ++i, ++index) {
+					buf_data_is_correct &= (ptr[i] == uint(index) * 3);
+				}
+			}
+			ASSERT( buf_data_is_correct );
+		};
+
+		const auto	OnImageLoaded = [&GetPixel, OUT &img_data_is_correct] (const ImageView &imageData)
+		{
+			img_data_is_correct = true;
+
+			for (uint y = 0; y < imageData.Dimension().y; ++y)
+			for (uint x = 0; x < imageData.Dimension().x; ++x)
+			{
+				RGBA32f	col;
+				imageData.Load( uint3(x, y, 0), OUT col );
+
+				img_data_is_correct &= All(Equals( col, RGBA32f{GetPixel( x, y )}, 0.01f ));
+			}
+			ASSERT( img_data_is_correct );
+		};
+
+		
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		// write buffer data directly to the staging memory
+		void*	buf_mapped	= null;
+		Task	t_update0	= cmd->MapBufferUpdate( buffer, 0_b, buf_size, OUT buf_mapped );
+		CHECK_ERR( t_update0 and buf_mapped );
+
+		uint*	buf_data	= Cast<uint>( buf_mapped );
+		for (size_t i = 0, cnt = size_t(buf_size / SizeOf<uint>); i < cnt; ++i) {
+			buf_data[i] = uint(i) * 3;
+		}
+
+		// write image data row by row
+		void*	img_mapped	= null;
+		BytesU	row_pitch, slice_pitch;
+		Task	t_update1	= cmd->MapImageUpdate( image, int3(), uint3{img_dim.x, img_dim.y, 1}, Default, Default, EImageAspect::Color,
+												   OUT img_mapped, OUT row_pitch, OUT slice_pitch );
+		CHECK_ERR( t_update1 and img_mapped );
+		CHECK_ERR( row_pitch == SizeOf<RGBA8u> * img_dim.x );
+
+		for (uint y = 0; y < img_dim.y; ++y)
+		{
+			RGBA8u*	row = Cast<RGBA8u>( Cast<uint8_t>(img_mapped) + row_pitch * y );
+
+			for (uint x = 0; x < img_dim.x; ++x) {
+				row[x] = GetPixel( x, y );
+			}
+		}
+
+		Task	t_read0	= cmd->AddTask( ReadBuffer{}.SetBuffer( buffer, 0_b, buf_size ).SetCallback( OnBufferLoaded ).DependsOn( t_update0 ));
+		Task	t_read1	= cmd->AddTask( ReadImage{}.SetImage( image, int2(), img_dim ).SetCallback( OnImageLoaded ).DependsOn( t_update1 ));
+		FG_UNUSED( t_read0, t_read1 );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( buf_data_is_correct );
+		CHECK_ERR( img_data_is_correct );
+
+		DeleteResources( buffer, image );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
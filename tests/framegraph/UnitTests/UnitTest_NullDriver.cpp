@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "framegraph/FG.h"
+#include "framework/Vulkan/VulkanDevice.h"
+#include "vulkan_loader/VulkanNullDriver.h"
+#include "UnitTest_Common.h"
+
+
+static void NullDriver_Test1 ()
+{
+	TEST( VulkanLoader::InitializeNullDriver() );
+	VulkanNullDriver::ResetStatistics();
+
+	VulkanDevice	vulkan;
+	TEST( vulkan.Create( "Test", "FrameGraph", VK_API_VERSION_1_1, "", {{ VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT }} ));
+
+	VulkanDeviceInfo	vulkan_info;
+	vulkan_info.instance		= BitCast<InstanceVk_t>( vulkan.GetVkInstance() );
+	vulkan_info.physicalDevice	= BitCast<PhysicalDeviceVk_t>( vulkan.GetVkPhysicalDevice() );
+	vulkan_info.device			= BitCast<DeviceVk_t>( vulkan.GetVkDevice() );
+
+	for (auto& q : vulkan.GetVkQueues())
+	{
+		VulkanDeviceInfo::QueueInfo	qi;
+		qi.handle		= BitCast<QueueVk_t>( q.handle );
+		qi.familyFlags	= BitCast<QueueFlagsVk_t>( q.flags );
+		qi.familyIndex	= q.familyIndex;
+		qi.priority		= q.priority;
+		qi.debugName	= "";
+		vulkan_info.queues.push_back( qi );
+	}
+
+	FrameGraph	fg = IFrameGraph::CreateFrameGraph( vulkan_info );
+	TEST( fg );
+
+	BufferID		src_buffer	= fg->CreateBuffer( BufferDesc{ 256_b, EBufferUsage::Transfer }, Default, "SrcBuffer" );
+	BufferID		dst_buffer	= fg->CreateBuffer( BufferDesc{ 512_b, EBufferUsage::Transfer }, Default, "DstBuffer" );
+	TEST( src_buffer and dst_buffer );
+
+	Array<uint8_t>	src_data;	src_data.resize( 256 );
+	bool			cb_was_called	= false;
+
+	CommandBuffer	cmd = fg->Begin( CommandBufferDesc{} );
+	TEST( cmd );
+
+	Task	t_update	= cmd->AddTask( UpdateBuffer().SetBuffer( src_buffer ).AddData( src_data ));
+	Task	t_copy		= cmd->AddTask( CopyBuffer().From( src_buffer ).To( dst_buffer ).AddRegion( 0_b, 128_b, 256_b ).DependsOn( t_update ));
+	Task	t_read		= cmd->AddTask( ReadBuffer().SetBuffer( dst_buffer, 0_b, 512_b ).SetCallback( [&cb_was_called] (BufferView) { cb_was_called = true; }).DependsOn( t_copy ));
+	FG_UNUSED( t_read );
+
+	TEST( fg->Execute( cmd ));
+	TEST( fg->WaitIdle() );
+
+	// null driver doesn't execute commands, but all callbacks must be called
+	TEST( cb_was_called );
+
+	const auto	stat = VulkanNullDriver::GetStatistics();
+	TEST( stat.queueSubmits > 0 );
+	TEST( stat.commandBuffers > 0 );
+	TEST( stat.pipelineBarriers > 0 );
+	TEST( stat.commands > stat.pipelineBarriers );
+
+	fg->ReleaseResource( src_buffer );
+	fg->ReleaseResource( dst_buffer );
+	fg->Deinitialize();
+	fg = null;
+
+	vulkan.Destroy();
+	VulkanLoader::Unload();
+}
+
+
+extern void UnitTest_NullDriver ()
+{
+	NullDriver_Test1();
+	FG_LOGI( "UnitTest_NullDriver - passed" );
+}
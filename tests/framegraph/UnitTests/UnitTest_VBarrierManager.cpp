@@ -0,0 +1,192 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VBarrierManager.h"
+#include "UnitTest_Common.h"
+
+
+namespace FG
+{
+	class VBarrierManagerUnitTest
+	{
+	public:
+		static void Merge (VBarrierManager &mngr)
+		{
+			mngr._MergeImageBarriers();
+			mngr._MergeBufferBarriers();
+		}
+
+		static ArrayView<VkImageMemoryBarrier>  GetImageBarriers (const VBarrierManager &mngr) {
+			return mngr._imageBarriers;
+		}
+
+		static ArrayView<VkBufferMemoryBarrier>  GetBufferBarriers (const VBarrierManager &mngr) {
+			return mngr._bufferBarriers;
+		}
+	};
+}	// FG
+
+
+static VkImageMemoryBarrier  MakeImageBarrier (VkImage image, VkImageLayout newLayout, uint baseMip, uint levelCount, uint baseLayer, uint layerCount)
+{
+	VkImageMemoryBarrier	barrier = {};
+	barrier.sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.image				= image;
+	barrier.oldLayout			= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout			= newLayout;
+	barrier.srcAccessMask		= VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask		= VK_ACCESS_SHADER_READ_BIT;
+	barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	barrier.subresourceRange	= { VK_IMAGE_ASPECT_COLOR_BIT, baseMip, levelCount, baseLayer, layerCount };
+	return barrier;
+}
+
+
+static VkBufferMemoryBarrier  MakeBufferBarrier (VkBuffer buffer, VkAccessFlags dstAccess, VkDeviceSize offset, VkDeviceSize size)
+{
+	VkBufferMemoryBarrier	barrier = {};
+	barrier.sType				= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.buffer				= buffer;
+	barrier.offset				= offset;
+	barrier.size				= size;
+	barrier.srcAccessMask		= VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask		= dstAccess;
+	barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	return barrier;
+}
+
+
+static void VBarrierManager_Test1 ()
+{
+	// mipmaps written level by level
+	VBarrierManager		mngr;
+	const VkImage		image	= BitCast<VkImage>( uint64_t(0x1000) );
+	const uint			layers	= 6;
+
+	for (uint mip = 11; mip > 0; --mip)
+	{
+		mngr.AddImageBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+							  MakeImageBarrier( image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mip-1, 1, 0, layers ));
+	}
+	VBarrierManagerUnitTest::Merge( mngr );
+
+	auto	barriers = VBarrierManagerUnitTest::GetImageBarriers( mngr );
+	TEST( barriers.size() == 1 );
+	TEST( barriers[0].subresourceRange.baseMipLevel == 0 );
+	TEST( barriers[0].subresourceRange.levelCount == 11 );
+	TEST( barriers[0].subresourceRange.baseArrayLayer == 0 );
+	TEST( barriers[0].subresourceRange.layerCount == layers );
+
+	mngr.ClearBarriers();
+}
+
+
+static void VBarrierManager_Test2 ()
+{
+	// layers written one by one, barriers with different layouts must not be merged
+	VBarrierManager		mngr;
+	const VkImage		image	= BitCast<VkImage>( uint64_t(0x1000) );
+
+	for (uint layer = 0; layer < 8; ++layer)
+	{
+		mngr.AddImageBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+							  MakeImageBarrier( image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1, layer, 1 ));
+		mngr.AddImageBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+							  MakeImageBarrier( image, VK_IMAGE_LAYOUT_GENERAL, 1, 1, layer, 1 ));
+	}
+
+	// not adjacent layer range
+	mngr.AddImageBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+						  MakeImageBarrier( image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1, 10, 2 ));
+
+	VBarrierManagerUnitTest::Merge( mngr );
+
+	auto	barriers = VBarrierManagerUnitTest::GetImageBarriers( mngr );
+	TEST( barriers.size() == 3 );
+
+	uint	found = 0;
+	for (auto& barrier : barriers)
+	{
+		const auto&	range = barrier.subresourceRange;
+
+		if ( barrier.newLayout == VK_IMAGE_LAYOUT_GENERAL )
+		{
+			TEST( range.baseMipLevel == 1 and range.levelCount == 1 and range.baseArrayLayer == 0 and range.layerCount == 8 );
+			found |= 1;
+		}
+		else
+		if ( range.baseArrayLayer == 0 )
+		{
+			TEST( range.baseMipLevel == 0 and range.levelCount == 1 and range.layerCount == 8 );
+			found |= 2;
+		}
+		else
+		{
+			TEST( range.baseMipLevel == 0 and range.levelCount == 1 and range.baseArrayLayer == 10 and range.layerCount == 2 );
+			found |= 4;
+		}
+	}
+	TEST( found == 7 );
+
+	mngr.ClearBarriers();
+}
+
+
+static void VBarrierManager_Test3 ()
+{
+	VBarrierManager		mngr;
+	const VkBuffer		buffer1	= BitCast<VkBuffer>( uint64_t(0x1000) );
+	const VkBuffer		buffer2	= BitCast<VkBuffer>( uint64_t(0x2000) );
+
+	mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, MakeBufferBarrier( buffer1, VK_ACCESS_UNIFORM_READ_BIT, 256, 128 ));
+	mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, MakeBufferBarrier( buffer1, VK_ACCESS_UNIFORM_READ_BIT, 0, 128 ));
+	mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, MakeBufferBarrier( buffer1, VK_ACCESS_UNIFORM_READ_BIT, 64, 256 ));		// overlapped
+	mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, MakeBufferBarrier( buffer1, VK_ACCESS_UNIFORM_READ_BIT, 1024, 64 ));	// gap
+	mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, MakeBufferBarrier( buffer1, VK_ACCESS_SHADER_READ_BIT, 128, 128 ));	// other access
+	mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, MakeBufferBarrier( buffer2, VK_ACCESS_UNIFORM_READ_BIT, 384, 64 ));	// other buffer
+
+	VBarrierManagerUnitTest::Merge( mngr );
+
+	auto	barriers = VBarrierManagerUnitTest::GetBufferBarriers( mngr );
+	TEST( barriers.size() == 4 );
+
+	uint	found = 0;
+	for (auto& barrier : barriers)
+	{
+		if ( barrier.buffer == buffer2 )
+		{
+			TEST( barrier.offset == 384 and barrier.size == 64 );
+			found |= 1;
+		}
+		else
+		if ( barrier.dstAccessMask == VK_ACCESS_SHADER_READ_BIT )
+		{
+			TEST( barrier.offset == 128 and barrier.size == 128 );
+			found |= 2;
+		}
+		else
+		if ( barrier.offset == 0 )
+		{
+			TEST( barrier.size == 384 );
+			found |= 4;
+		}
+		else
+		{
+			TEST( barrier.offset == 1024 and barrier.size == 64 );
+			found |= 8;
+		}
+	}
+	TEST( found == 15 );
+
+	mngr.ClearBarriers();
+}
+
+
+extern void UnitTest_VBarrierManager ()
+{
+	VBarrierManager_Test1();
+	VBarrierManager_Test2();
+	VBarrierManager_Test3();
+	FG_LOGI( "UnitTest_VBarrierManager - passed" );
+}
@@ -40,13 +40,14 @@ static void VBuffer_Test1 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 
+	LinearAllocator<>	allocator;
 	VBuffer				global_buffer;
 	VLocalBuffer		local_buffer;
 	VLocalBuffer const*	buf			= &local_buffer;
 
 	TEST( VBufferUnitTest::Create( global_buffer, BufferDesc{ 1024_b, EBufferUsage::All } ));
 
-	TEST( local_buffer.Create( &global_buffer ));
+	TEST( local_buffer.Create( &global_buffer, 0, allocator ));
 
 
 	// pass 1
@@ -320,8 +321,93 @@ static void VBuffer_Test1 ()
 }
 
 
+static void VBuffer_Test2 ()
+{
+	// many small writes to large buffer
+	using TimePoint_t = std::chrono::high_resolution_clock::time_point;
+
+	VBarrierManager		barrier_mngr;
+
+	const uint			chunk_count	= 4096;
+	const VkDeviceSize	chunk_size	= 256;
+	const uint			iterations	= 8;
+	const auto			tasks		= GenDummyTasks( iterations * (chunk_count + 2) );
+	auto				task_iter	= tasks.begin();
+
+	LinearAllocator<>	allocator;
+	VBuffer				global_buffer;
+	VLocalBuffer		local_buffer;
+	VLocalBuffer const*	buf			= &local_buffer;
+
+	TEST( VBufferUnitTest::Create( global_buffer, BufferDesc{ BytesU{chunk_size * chunk_count}, EBufferUsage::All } ));
+
+	TEST( local_buffer.Create( &global_buffer, 0, allocator ));
+	
+	const auto	start_time = TimePoint_t::clock::now();
+
+	for (uint i = 0; i < iterations; ++i)
+	{
+		// write each chunk in separate task, in reverse order to insert records at the front
+		for (uint j = chunk_count; j > 0; --j)
+		{
+			const VkDeviceSize	offset = chunk_size * (j-1);
+
+			buf->AddPendingState(BufferState{ EResourceState::ShaderWrite | EResourceState::_ComputeShader, offset, offset + chunk_size, (task_iter++)->get() });
+			buf->CommitBarrier( barrier_mngr, null );
+		}
+		{
+			auto	w_barriers = VBufferUnitTest::GetWriteBarriers( buf );
+
+			TEST( w_barriers.size() == chunk_count );
+
+			for (uint j = 0; j < chunk_count; ++j)
+			{
+				TEST( w_barriers[j].range.begin == chunk_size * j );
+				TEST( w_barriers[j].range.end == chunk_size * (j+1) );
+			}
+		}
+		barrier_mngr.ClearBarriers();
+		
+		// read whole buffer
+		buf->AddPendingState(BufferState{ EResourceState::UniformRead | EResourceState::_VertexShader, 0, VkDeviceSize(buf->Size()), (task_iter++)->get() });
+		buf->CommitBarrier( barrier_mngr, null );
+		{
+			auto	r_barriers = VBufferUnitTest::GetReadBarriers( buf );
+
+			TEST( r_barriers.size() == 1 );
+			TEST( r_barriers[0].range.begin == 0 );
+			TEST( r_barriers[0].range.end == VkDeviceSize(buf->Size()) );
+		}
+		barrier_mngr.ClearBarriers();
+
+		// write whole buffer, all records must be replaced
+		buf->AddPendingState(BufferState{ EResourceState::TransferDst, 0, VkDeviceSize(buf->Size()), (task_iter++)->get() });
+		buf->CommitBarrier( barrier_mngr, null );
+		{
+			auto	w_barriers = VBufferUnitTest::GetWriteBarriers( buf );
+			auto	r_barriers = VBufferUnitTest::GetReadBarriers( buf );
+
+			TEST( w_barriers.size() == 1 );
+			TEST( w_barriers[0].range.begin == 0 );
+			TEST( w_barriers[0].range.end == VkDeviceSize(buf->Size()) );
+			TEST( w_barriers[0].access == VK_ACCESS_TRANSFER_WRITE_BIT );
+			TEST( r_barriers.empty() );
+		}
+		barrier_mngr.ClearBarriers();
+	}
+
+	const auto	dt = TimePoint_t::clock::now() - start_time;
+	FG_LOGI( "VBuffer_Test2: "s << ToString(iterations * chunk_count) << " buffer writes in " << ToString( dt ));
+
+	local_buffer.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+
+	local_buffer.Destroy();
+}
+
+
 extern void UnitTest_VBuffer ()
 {
 	VBuffer_Test1();
+	VBuffer_Test2();
 	FG_LOGI( "UnitTest_VBuffer - passed" );
 }
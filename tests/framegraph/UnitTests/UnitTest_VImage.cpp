@@ -55,6 +55,7 @@ static void VImage_Test1 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 
+	LinearAllocator<>	allocator;
 	VImage				global_image;
 	VLocalImage			local_image;
 	VLocalImage const*	img			= &local_image;
@@ -64,7 +65,7 @@ static void VImage_Test1 ()
 											 EImageUsage::ColorAttachment | EImageUsage::Transfer | EImageUsage::Storage | EImageUsage::Sampled,
 											 0_layer, 11_mipmap } ));
 
-	TEST( local_image.Create( &global_image ));
+	TEST( local_image.Create( &global_image, 0, allocator ));
 
 	
 	// pass 1
@@ -116,6 +117,7 @@ static void VImage_Test2 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 	
+	LinearAllocator<>	allocator;
 	VImage				global_image;
 	VLocalImage			local_image;
 	VLocalImage const*	img			= &local_image;
@@ -125,7 +127,7 @@ static void VImage_Test2 ()
 											 EImageUsage::ColorAttachment | EImageUsage::Transfer | EImageUsage::Storage | EImageUsage::Sampled,
 											 8_layer, 11_mipmap } ));
 
-	TEST( local_image.Create( &global_image ));
+	TEST( local_image.Create( &global_image, 0, allocator ));
 
 	// pass 1
 	{
@@ -172,9 +174,98 @@ static void VImage_Test2 ()
 }
 
 
+static void VImage_Test3 ()
+{
+	// per-layer writes into large texture array
+	using TimePoint_t = std::chrono::high_resolution_clock::time_point;
+
+	VBarrierManager		barrier_mngr;
+
+	const uint			layer_count	= 512;
+	const uint			mip_count	= 11;
+	const uint			iterations	= 8;
+	const auto			tasks		= GenDummyTasks( iterations * (layer_count + 1) );
+	auto				task_iter	= tasks.begin();
+
+	LinearAllocator<>	allocator;
+	VImage				global_image;
+	VLocalImage			local_image;
+	VLocalImage const*	img			= &local_image;
+
+	TEST( VImageUnitTest::Create( global_image,
+								  ImageDesc{ EImage::Tex2DArray, uint3(1024, 1024, 0), EPixelFormat::RGBA8_UNorm,
+											 EImageUsage::ColorAttachment | EImageUsage::Transfer | EImageUsage::Sampled,
+											 ImageLayer(layer_count), MipmapLevel(mip_count) } ));
+
+	TEST( local_image.Create( &global_image, 0, allocator ));
+	TEST( img->ArrayLayers() == layer_count );
+	TEST( img->MipmapLevels() == mip_count );
+	
+	const auto	start_time = TimePoint_t::clock::now();
+
+	for (uint i = 0; i < iterations; ++i)
+	{
+		// write to each layer of first mipmap in separate task
+		for (uint layer = 0; layer < layer_count; ++layer)
+		{
+			img->AddPendingState(ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+									ImageRange{ ImageLayer(layer), 1, 0_mipmap, 1 },
+									VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+			img->CommitBarrier( barrier_mngr, null );
+		}
+		{
+			auto	barriers = VImageUnitTest::GetRWBarriers( img );
+
+			// initial state is single record, after first read each mipmap has its own record
+			TEST( barriers.size() == layer_count + (i == 0 ? 1 : mip_count - 1) );
+
+			for (uint layer = 0; layer < layer_count; ++layer)
+			{
+				TEST( barriers[layer].range.begin == layer );
+				TEST( barriers[layer].range.end == layer+1 );
+				TEST( barriers[layer].layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+				TEST( barriers[layer].isWritable == true );
+			}
+		}
+		barrier_mngr.ClearBarriers();
+
+		// read all layers, per-layer records must be replaced
+		img->AddPendingState(ImageState{ EResourceState::ShaderSample | EResourceState::_FragmentShader, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+								ImageRange{ 0_layer, layer_count, 0_mipmap, mip_count },
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		{
+			auto	barriers = VImageUnitTest::GetRWBarriers( img );
+
+			TEST( barriers.size() == mip_count );
+
+			for (uint mip = 0; mip < mip_count; ++mip)
+			{
+				TEST( barriers[mip].range.begin == mip * layer_count );
+				TEST( barriers[mip].range.end == (mip+1) * layer_count );
+				TEST( barriers[mip].layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+				TEST( barriers[mip].isReadable == true );
+				TEST( barriers[mip].isWritable == false );
+			}
+		}
+		barrier_mngr.ClearBarriers();
+	}
+	
+	const auto	dt = TimePoint_t::clock::now() - start_time;
+	FG_LOGI( "VImage_Test3: "s << ToString(iterations * layer_count) << " layer writes in " << ToString( dt ));
+
+	local_image.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+
+	local_image.Destroy();
+}
+
+
 extern void UnitTest_VImage ()
 {
 	VImage_Test1();
 	VImage_Test2();
+	VImage_Test3();
 	FG_LOGI( "UnitTest_VImage - passed" );
 }
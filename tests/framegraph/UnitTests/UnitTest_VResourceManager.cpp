@@ -101,11 +101,72 @@ static void PipelineResources_Test1 (const FrameGraph &fg)
 }
 
 
+static void DescriptorManager_Test1 (const FrameGraph &fg)
+{
+	using DescriptorSet = VDescriptorSetLayout::DescriptorSet;
+
+	VResourceManager&		res_mngr	= Cast<VFrameGraph>( fg )->GetResourceManager();
+	VDescriptorManager&		desc_mngr	= res_mngr.GetDescriptorManager();
+	VDevice const&			dev			= res_mngr.GetDevice();
+	const uint				max_pools	= VDescriptorManager::MaxDescriptorPools;
+	const uint				max_sets	= VDescriptorManager::MaxDescriptorSets;
+
+	VkDescriptorSetLayoutBinding	binding = {};
+	binding.binding			= 0;
+	binding.descriptorType	= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	binding.descriptorCount	= 1;
+	binding.stageFlags		= VK_SHADER_STAGE_COMPUTE_BIT;
+
+	VkDescriptorSetLayoutCreateInfo	info = {};
+	info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	info.bindingCount	= 1;
+	info.pBindings		= &binding;
+
+	VkDescriptorSetLayout	layout = VK_NULL_HANDLE;
+	TEST( dev.vkCreateDescriptorSetLayout( dev.GetVkDevice(), &info, null, OUT &layout ) == VK_SUCCESS );
+
+	// allocate until all pools are exhausted
+	Array<DescriptorSet>	sets;
+	uint					per_pool [max_pools] = {};
+	sets.reserve( max_pools * max_sets );
+
+	for (;;)
+	{
+		DescriptorSet	ds;
+		if ( not desc_mngr.AllocDescriptorSet( layout, OUT ds ))
+			break;
+
+		TEST( sets.size() < max_pools * max_sets );
+		TEST( ds.second < max_pools );
+		TEST( ++per_pool[ds.second] <= max_sets );
+		sets.push_back( ds );
+	}
+
+	// other descriptor sets are allocated too, so pools are not completely filled by this test
+	TEST( sets.size() > (max_pools - 1) * max_sets );
+
+	for (uint count : per_pool) {
+		TEST( count > 0 );
+	}
+
+	// pools are recycled
+	TEST( desc_mngr.DeallocDescriptorSets( sets ));
+	{
+		DescriptorSet	ds;
+		TEST( desc_mngr.AllocDescriptorSet( layout, OUT ds ));
+		TEST( desc_mngr.DeallocDescriptorSet( ds ));
+	}
+
+	dev.vkDestroyDescriptorSetLayout( dev.GetVkDevice(), layout, null );
+}
+
+
 extern void UnitTest_VResourceManager (const FrameGraph &fg)
 {
 	SamplerCache_Test1( fg );
 	PipelineCache_Test1( fg );
 	PipelineResources_Test1( fg );
+	DescriptorManager_Test1( fg );
 
 	FG_LOGI( "UnitTest_VResourceManager - passed" );
 }
@@ -9,8 +9,10 @@ extern void UnitTest_VertexInput ();
 extern void UnitTest_ImageSwizzle ();
 extern void UnitTest_PixelFormat ();
 extern void UnitTest_ID ();
+extern void UnitTest_VBarrierManager ();
 extern void UnitTest_VBuffer ();
 extern void UnitTest_VImage ();
+extern void UnitTest_NullDriver ();
 
 
 int main ()
@@ -21,8 +23,10 @@ int main ()
 		UnitTest_ImageSwizzle();
 		UnitTest_PixelFormat();
 		UnitTest_ID();
+		UnitTest_VBarrierManager();
 		UnitTest_VBuffer();
 		UnitTest_VImage();
+		UnitTest_NullDriver();
 	}
 
 	FGApp::Run();
@@ -0,0 +1,91 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/Containers/FlatHashMap.h"
+#include "stl/Memory/LinearAllocator.h"
+#include "UnitTest_Common.h"
+
+
+static void FlatHashMap_Test1 ()
+{
+	FlatHashMap<uint64_t, uint>	map;
+
+	for (uint i = 1; i <= 100; ++i) {
+		TEST( map.insert({ i, i }).second );
+	}
+	TEST( map.size() == 100 );
+	TEST( not map.insert({ 5, 0 }).second );
+	TEST( map.size() == 100 );
+
+	auto	iter = map.find( 5 );	TEST( iter != map.end() );	TEST( iter->first == 5 );	TEST( iter->second == 5 );
+	iter = map.find( 99 );			TEST( iter != map.end() );	TEST( iter->first == 99 );
+	iter = map.find( 101 );			TEST( iter == map.end() );
+	iter = map.find( 0 );			TEST( iter == map.end() );
+
+	TEST( map.count( 1 ) == 1 );
+	TEST( map.count( 200 ) == 0 );
+}
+
+
+static void FlatHashMap_Test2 ()
+{
+	// keys with same low bits
+	FlatHashMap<uint64_t, uint>	map;
+
+	for (uint64_t i = 1; i <= 1000; ++i) {
+		map.insert({ i << 32, 0 }).first->second++;
+		map.insert({ i << 32, 0 }).first->second++;
+	}
+	TEST( map.size() == 1000 );
+
+	uint64_t	sum = 0;
+	for (auto[key, count] : map)
+	{
+		TEST( count == 2 );
+		sum += (key >> 32);
+	}
+	TEST( sum == 1000*1001/2 );
+
+	map.clear();
+	TEST( map.empty() );
+	TEST( map.begin() == map.end() );
+	TEST( map.find( 1ull << 32 ) == map.end() );
+}
+
+
+static void FlatHashMap_Test3 ()
+{
+	LinearAllocator<>	linear;
+	{
+		using Map_t = FlatHashMap< uint64_t, uint, std::hash<uint64_t>, UntypedLinearAllocator<> >;
+
+		Map_t	map{ linear };
+		map.reserve( 64 );
+		TEST( map.capacity() >= 64 );
+
+		for (uint i = 1; i <= 2000; ++i) {
+			map.insert({ i * 0x10001ull, i });
+		}
+		TEST( map.size() == 2000 );
+
+		for (uint i = 1; i <= 2000; ++i)
+		{
+			auto	iter = map.find( i * 0x10001ull );
+			TEST( iter != map.end() );
+			TEST( iter->second == i );
+		}
+
+		Map_t	map2{ std::move(map) };
+		TEST( map.empty() );
+		TEST( map2.size() == 2000 );
+	}
+	linear.Discard();
+}
+
+
+extern void UnitTest_FlatHashMap ()
+{
+	FlatHashMap_Test1();
+	FlatHashMap_Test2();
+	FlatHashMap_Test3();
+	FG_LOGI( "UnitTest_FlatHashMap - passed" );
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/LfFixedQueue.h"
+#include "UnitTest_Common.h"
+#include <thread>
+
+
+static void LfFixedQueue_Test1 ()
+{
+	LfFixedQueue< uint, 8 >		queue;
+	uint						value = 0;
+
+	TEST( not queue.Pop( OUT value ));
+
+	for (uint i = 0; i < 8; ++i) {
+		TEST( queue.Push( i ));
+	}
+	TEST( not queue.Push( 8u ));	// queue is full
+
+	// FIFO order
+	for (uint i = 0; i < 8; ++i) {
+		TEST( queue.Pop( OUT value ));
+		TEST( value == i );
+	}
+	TEST( not queue.Pop( OUT value ));
+
+	// wrap around
+	for (uint i = 0; i < 100; ++i) {
+		TEST( queue.Push( i ));
+		TEST( queue.Pop( OUT value ));
+		TEST( value == i );
+	}
+}
+
+
+static void LfFixedQueue_Test2 ()
+{
+	// multiple producers, single consumer
+	static constexpr uint	num_threads	= 4;
+	static constexpr uint	count		= 10000;
+
+	LfFixedQueue< uint, 64 >	queue;
+	std::thread					producers[num_threads];
+	StaticArray< uint, num_threads >	last_values;
+
+	for (uint t = 0; t < num_threads; ++t)
+	{
+		producers[t] = std::thread{ [&queue, t] ()
+		{
+			for (uint i = 1; i <= count;)
+			{
+				if ( queue.Push( (t << 24) | i ))
+					++i;
+				else
+					std::this_thread::yield();
+			}
+		}};
+	}
+
+	last_values.fill( 0 );
+
+	for (uint received = 0; received < num_threads * count;)
+	{
+		uint	value;
+		if ( not queue.Pop( OUT value ))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// values from the same producer are received in the same order
+		const uint	t = value >> 24;
+		const uint	i = value & 0xFFFFFF;
+
+		TEST( t < num_threads );
+		TEST( last_values[t] + 1 == i );
+
+		last_values[t] = i;
+		++received;
+	}
+
+	for (auto& t : producers) {
+		t.join();
+	}
+
+	for (auto& v : last_values) {
+		TEST( v == count );
+	}
+}
+
+
+extern void UnitTest_LfFixedQueue ()
+{
+	LfFixedQueue_Test1();
+	LfFixedQueue_Test2();
+
+	FG_LOGI( "UnitTest_LfFixedQueue - passed" );
+}
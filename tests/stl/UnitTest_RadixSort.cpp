@@ -0,0 +1,74 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/Algorithms/RadixSort.h"
+#include "UnitTest_Common.h"
+#include <random>
+
+
+static void RadixSort_Test1 ()
+{
+	Array<uint64_t>	data;
+	Array<uint64_t>	temp;
+	std::mt19937_64	rnd{ 1234 };
+
+	for (uint i = 0; i < 1000; ++i) {
+		data.push_back( rnd() );
+	}
+
+	Array<uint64_t>	ref = data;
+	std::sort( ref.begin(), ref.end() );
+
+	temp.resize( data.size() );
+	RadixSort( data.data(), temp.data(), data.size(), [] (uint64_t key) { return key; });
+
+	TEST( data == ref );
+}
+
+
+static void RadixSort_Test2 ()
+{
+	// sort must be stable
+	using Pair_t = Pair< uint, uint >;
+
+	Array<Pair_t>	data;
+	Array<Pair_t>	temp;
+
+	for (uint i = 0; i < 1000; ++i) {
+		data.push_back({ (i * 7) % 13, i });
+	}
+
+	Array<Pair_t>	ref = data;
+	std::stable_sort( ref.begin(), ref.end(), [] (auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+
+	temp.resize( data.size() );
+	RadixSort( data.data(), temp.data(), data.size(), [] (const Pair_t &p) { return p.first; });
+
+	TEST( data == ref );
+}
+
+
+static void RadixSort_Test3 ()
+{
+	// keys differ only in high bits, low digits are skipped
+	Array<uint>		data	= { 3u << 24, 1u << 24, 2u << 24, 1u << 24, 0u };
+	Array<uint>		temp;	temp.resize( data.size() );
+
+	RadixSort( data.data(), temp.data(), data.size(), [] (uint key) { return key; });
+
+	TEST(( data == Array<uint>{ 0u, 1u << 24, 1u << 24, 2u << 24, 3u << 24 } ));
+
+	// empty and single element
+	RadixSort( data.data(), temp.data(), 0, [] (uint key) { return key; });
+	RadixSort( data.data(), temp.data(), 1, [] (uint key) { return key; });
+	TEST( data[0] == 0 );
+}
+
+
+extern void UnitTest_RadixSort ()
+{
+	RadixSort_Test1();
+	RadixSort_Test2();
+	RadixSort_Test3();
+
+	FG_LOGI( "UnitTest_RadixSort - passed" );
+}
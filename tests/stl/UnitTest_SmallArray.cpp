@@ -0,0 +1,119 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/Containers/SmallArray.h"
+#include "UnitTest_Common.h"
+
+
+static void SmallArray_Test1 ()
+{
+	LinearAllocator<>		linear;
+	{
+		SmallArray<uint, 4>		arr{ linear };
+
+		arr.push_back( 1 );
+		arr.push_back( 3 );
+		arr.insert( arr.begin() + 1, 2 );
+		arr.insert( arr.end(), 4 );
+		TEST( arr.size() == 4 );
+		TEST( arr.IsInline() );
+
+		for (uint i = 0; i < arr.size(); ++i) {
+			TEST( arr[i] == i+1 );
+		}
+
+		// spill to linear allocator
+		arr.insert( arr.begin(), 0 );
+		TEST( arr.size() == 5 );
+		TEST( not arr.IsInline() );
+
+		for (uint i = 0; i < arr.size(); ++i) {
+			TEST( arr[i] == i );
+		}
+
+		auto	iter = arr.erase( arr.begin() + 2 );
+		TEST( *iter == 3 );
+		TEST( arr.size() == 4 );
+		TEST( arr.front() == 0 );
+		TEST( arr.back() == 4 );
+
+		ArrayView<uint>	view = arr;
+		TEST( view.size() == 4 );
+		TEST( view[1] == 1 and view[2] == 3 );
+
+		arr.clear();
+		TEST( arr.empty() );
+		TEST( arr.IsInline() );
+	}
+	linear.Discard();
+}
+
+
+static void SmallArray_Test2 ()
+{
+	LinearAllocator<>		linear;
+	{
+		SmallArray<uint, 2>		arr{ linear };
+
+		for (uint i = 0; i < 1000; ++i) {
+			arr.push_back( i );
+		}
+		TEST( arr.size() == 1000 );
+
+		// push element that is stored in the array itself
+		arr.push_back( arr[10] );
+		TEST( arr.back() == 10 );
+
+		uint	j = 0;
+		for (auto& v : arr)
+		{
+			if ( j < 1000 )	TEST( v == j );
+			++j;
+		}
+
+		for (auto iter = arr.begin(); iter != arr.end();)
+		{
+			if ( *iter & 1 )	iter = arr.erase( iter );
+			else				++iter;
+		}
+		TEST( arr.size() == 501 );
+	}
+	linear.Discard();
+}
+
+
+static void SmallArray_Test3 ()
+{
+	LinearAllocator<>		linear;
+	{
+		SmallArray<uint, 4>		arr{ linear };
+		const uint				values[] = { 10, 11, 12 };
+
+		arr.push_back( 0 );
+		arr.push_back( 1 );
+		arr.push_back( 2 );
+
+		auto	iter = arr.insert( arr.begin() + 1, std::begin(values), std::end(values) );
+		TEST( *iter == 10 );
+		TEST( arr.size() == 6 );
+		TEST( arr[0] == 0 and arr[1] == 10 and arr[2] == 11 and arr[3] == 12 and arr[4] == 1 and arr[5] == 2 );
+
+		iter = arr.erase( arr.begin() + 1, arr.begin() + 4 );
+		TEST( *iter == 1 );
+		TEST( arr.size() == 3 );
+		TEST( arr[0] == 0 and arr[1] == 1 and arr[2] == 2 );
+
+		iter = arr.erase( arr.begin(), arr.end() );
+		TEST( iter == arr.end() );
+		TEST( arr.empty() );
+	}
+	linear.Discard();
+}
+
+
+extern void UnitTest_SmallArray ()
+{
+	SmallArray_Test1();
+	SmallArray_Test2();
+	SmallArray_Test3();
+	FG_LOGI( "UnitTest_SmallArray - passed" );
+}
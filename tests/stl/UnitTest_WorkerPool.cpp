@@ -0,0 +1,91 @@
+// Copyright (c) 2018-2019,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/WorkerPool.h"
+#include "UnitTest_Common.h"
+#include <atomic>
+
+
+static void WorkerPool_Test1 ()
+{
+	WorkerPool			pool;
+	std::atomic<uint>	counter {0};
+
+	TEST( pool.Start( 4 ));
+	TEST( pool.ThreadCount() == 4 );
+
+	for (uint i = 0; i < 1000; ++i) {
+		TEST( pool.Run( [&counter] () { counter.fetch_add( 1, memory_order_relaxed ); }));
+	}
+
+	pool.WaitAll();
+	TEST( counter.load() == 1000 );
+
+	pool.Stop();
+	TEST( pool.ThreadCount() == 0 );
+}
+
+
+static void WorkerPool_Test2 ()
+{
+	// queued jobs must be completed on stop
+	std::atomic<uint>	counter {0};
+	{
+		WorkerPool	pool;
+		TEST( pool.Start( 1 ));
+
+		for (uint i = 0; i < 100; ++i) {
+			TEST( pool.Run( [&counter] () { counter.fetch_add( 1, memory_order_relaxed ); }));
+		}
+	}
+	TEST( counter.load() == 100 );
+}
+
+
+static void WorkerPool_Test3 ()
+{
+	WorkerPool	pool;
+	TEST( pool.Start( 2 ));
+
+	// each index is processed once
+	{
+		StaticArray< std::atomic<uint>, 100 >	counters;
+		for (auto& c : counters) { c.store( 0 ); }
+
+		pool.ParallelFor( uint(counters.size()), [&counters] (uint i) { counters[i].fetch_add( 1, memory_order_relaxed ); });
+
+		for (auto& c : counters) {
+			TEST( c.load() == 1 );
+		}
+	}
+
+	// nested jobs must not deadlock when all worker threads are waiting
+	{
+		std::atomic<uint>	counter {0};
+
+		pool.ParallelFor( 8, [&pool, &counter] (uint)
+		{
+			pool.ParallelFor( 8, [&counter] (uint) { counter.fetch_add( 1, memory_order_relaxed ); });
+		});
+		TEST( counter.load() == 64 );
+	}
+
+	// waiting thread processes all indices if pool is not started
+	{
+		WorkerPool			stopped;
+		std::atomic<uint>	counter {0};
+
+		auto	jobs = stopped.RunParallel( 10, [&counter] (uint) { counter.fetch_add( 1, memory_order_relaxed ); });
+		jobs.Wait();
+		TEST( counter.load() == 10 );
+	}
+}
+
+
+extern void UnitTest_WorkerPool ()
+{
+	WorkerPool_Test1();
+	WorkerPool_Test2();
+	WorkerPool_Test3();
+
+	FG_LOGI( "UnitTest_WorkerPool - passed" );
+}
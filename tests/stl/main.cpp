@@ -6,6 +6,8 @@
 extern void UnitTest_StaticString ();
 extern void UnitTest_FixedArray ();
 extern void UnitTest_FixedMap ();
+extern void UnitTest_FlatHashMap ();
+extern void UnitTest_SmallArray ();
 extern void UnitTest_IndexedPool ();
 extern void UnitTest_LinearAllocator ();
 extern void UnitTest_Math ();
@@ -21,6 +23,9 @@ extern void UnitTest_StringParser ();
 extern void UnitTest_FixedTupleArray ();
 extern void UnitTest_LfIndexedPool ();
 extern void UnitTest_Rectangle ();
+extern void UnitTest_RadixSort ();
+extern void UnitTest_WorkerPool ();
+extern void UnitTest_LfFixedQueue ();
 
 
 int main ()
@@ -32,6 +37,8 @@ int main ()
 	UnitTest_FixedArray();
 	UnitTest_ToString();
 	UnitTest_FixedMap();
+	UnitTest_FlatHashMap();
+	UnitTest_SmallArray();
 	UnitTest_IndexedPool();
 	UnitTest_LinearAllocator();
 	UnitTest_LfDoubleBuffer();
@@ -43,6 +50,9 @@ int main ()
 	UnitTest_FixedTupleArray();
 	UnitTest_LfIndexedPool();
 	UnitTest_Rectangle();
+	UnitTest_RadixSort();
+	UnitTest_WorkerPool();
+	UnitTest_LfFixedQueue();
 
 	FG_LOGI( "Tests.STL finished" );
 